@@ -0,0 +1,34 @@
+/* ----------------------------------------------------------------- 
+"@(#) chain.h version 1.0 10/17/26"
+FILE:	    chain.h                                       
+DESCRIPTION:Insert file for parallel annealing chains.
+DATE:	    Oct 17, 2026 
+REVISIONS:  
+----------------------------------------------------------------- */
+#ifndef YCHAIN_H
+#define YCHAIN_H
+
+#include <yalecad/base.h>
+
+extern INT Ychain_fork( P2(INT chains, FILE *fp ) ) ;
+/*
+Function:
+    Forks chains processes from the current state of the program.
+    Each returns with its chain number, 0 to chains - 1, and a
+    random stream of its own; chain 0 keeps the current stream.
+    Standard output and fp are captured until Ychain_finish.
+    The calling process never returns: it waits for the chains,
+    lets the one with the lowest cost go on, and exits.  Returns
+    -1 without forking if chains cannot be run on this system.
+*/
+
+extern Ychain_finish( P1(DOUBLE cost ) ) ;
+/*
+Function:
+    Reports the cost at the end of a chain.  Only the chain with
+    the lowest cost returns, after its captured output has been
+    written out; ties go to the lower chain number.  The others
+    exit without writing anything.
+*/
+
+#endif /* YCHAIN_H */
@@ -0,0 +1,346 @@
+/*
+ *   Copyright (C) 1989-1992 Yale University
+ *   Copyright (C) 2015 Tim Edwards <tim@opencircuitdesign.com>
+ *
+ *   This work is distributed in the hope that it will be useful; you can
+ *   redistribute it and/or modify it under the terms of the
+ *   GNU General Public License as published by the Free Software Foundation;
+ *   either version 2 of the License,
+ *   or any later version, on the following conditions:
+ *
+ *   (a) YALE MAKES NO, AND EXPRESSLY DISCLAIMS
+ *   ALL, REPRESENTATIONS OR WARRANTIES THAT THE MANUFACTURE, USE, PRACTICE,
+ *   SALE OR
+ *   OTHER DISPOSAL OF THE SOFTWARE DOES NOT OR WILL NOT INFRINGE UPON ANY
+ *   PATENT OR
+ *   OTHER RIGHTS NOT VESTED IN YALE.
+ *
+ *   (b) YALE MAKES NO, AND EXPRESSLY DISCLAIMS ALL, REPRESENTATIONS AND
+ *   WARRANTIES
+ *   WHATSOEVER WITH RESPECT TO THE SOFTWARE, EITHER EXPRESS OR IMPLIED,
+ *   INCLUDING,
+ *   BUT NOT LIMITED TO, WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A
+ *   PARTICULAR
+ *   PURPOSE.
+ *
+ *   (c) LICENSEE SHALL MAKE NO STATEMENTS, REPRESENTATION OR WARRANTIES
+ *   WHATSOEVER TO
+ *   ANY THIRD PARTIES THAT ARE INCONSISTENT WITH THE DISCLAIMERS BY YALE IN
+ *   ARTICLE
+ *   (a) AND (b) above.
+ *
+ *   (d) IN NO EVENT SHALL YALE, OR ITS TRUSTEES, DIRECTORS, OFFICERS,
+ *   EMPLOYEES AND
+ *   AFFILIATES BE LIABLE FOR DAMAGES OF ANY KIND, INCLUDING ECONOMIC DAMAGE OR
+ *   INJURY TO PROPERTY AND LOST PROFITS, REGARDLESS OF WHETHER YALE SHALL BE
+ *   ADVISED, SHALL HAVE OTHER REASON TO KNOW, OR IN FACT SHALL KNOW OF THE
+ *   POSSIBILITY OF THE FOREGOING.
+ *
+ */
+/* ----------------------------------------------------------------- 
+FILE:	    chain.c                                       
+DESCRIPTION:parallel annealing chains.  The placers run each
+	    temperature step as a number of processes forked from the
+	    current placement.  Every chain makes its share of the
+	    attempts with its own random stream, and the chain with
+	    the lowest cost carries the placement on to the next step.
+	    Since the winning process keeps its whole state no data
+	    has to be copied between chains.  The original process
+	    stays behind to report the exit status of the chain that
+	    finishes the run.  For a given seed and chain count the
+	    result does not depend on scheduling.
+CONTENTS:   INT Ychain_fork( chains, fp )
+		INT chains ;
+		FILE *fp ;
+	    Ychain_finish( cost )
+		DOUBLE cost ;
+DATE:	    Oct 17, 2026 
+REVISIONS:  
+----------------------------------------------------------------- */
+#ifndef lint
+static char SccsId[] = "@(#) chain.c version 1.0 10/17/26" ;
+#endif
+
+#include <yalecad/base.h>
+#include <yalecad/chain.h>
+#include <yalecad/message.h>
+#include <yalecad/program.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+/* what a chain reports back at the end of its step */
+typedef struct chain_result {
+    INT chain ;
+    DOUBLE cost ;
+} CHAINRESULT ;
+
+/* static variables */
+static BOOL supervisedS = FALSE ;	/* supervisor is in place */
+static int  mainlineS[2] ;		/* pipe naming the current carrier */
+static INT  chainS ;			/* number of this chain */
+static int  resultfdS ;			/* where a chain reports its cost */
+static int  *gofdS = NULL ;		/* verdict pipes, one per chain */
+static FILE *fpS = NULL ;		/* the program's .out file */
+static FILE *cap_outS = NULL ;		/* captured stdout of a chain */
+static FILE *cap_fpoS = NULL ;		/* captured .out file of a chain */
+static int  save_outS, save_fpoS ;	/* real descriptors of the above */
+
+static BOOL start_supervisor() ;
+static supervise() ;
+static capture_output() ;
+static release_output() ;
+static copy_capture() ;
+
+INT Ychain_fork( chains, fp )
+INT chains ;
+FILE *fp ;
+{
+    CHAINRESULT result ;
+    INT chain , best , got ;
+    DOUBLE best_cost ;
+    int resultfd[2] ;
+    pid_t pid , *pids ;
+    char verdict ;
+
+    if( !supervisedS && !start_supervisor() ) {
+	return( -1 ) ;
+    }
+
+    /* nothing buffered may be written twice by the children */
+    Ymessage_flush() ;
+    fflush( fp ) ;
+    fflush( stdout ) ;
+    fflush( stderr ) ;
+    fpS = fp ;
+
+    if( pipe( resultfd ) != 0 ) {
+	M( ERRMSG, "Ychain_fork", "could not create chain pipe\n" ) ;
+	YexitPgm( PGMFAIL ) ;
+    }
+    gofdS = (int *) Ysafe_malloc( 2 * chains * sizeof(int) ) ;
+    pids = (pid_t *) Ysafe_malloc( chains * sizeof(pid_t) ) ;
+
+    for( chain = 0 ; chain < chains ; chain++ ) {
+	if( pipe( gofdS + 2 * chain ) != 0 ) {
+	    M( ERRMSG, "Ychain_fork", "could not create chain pipe\n" ) ;
+	    YexitPgm( PGMFAIL ) ;
+	}
+	pid = fork() ;
+	if( pid < 0 ) {
+	    M( ERRMSG, "Ychain_fork", "could not fork annealing chain\n" ) ;
+	    YexitPgm( PGMFAIL ) ;
+	}
+	if( pid == 0 ) {
+	    /* ---------------- one annealing chain ---------------- */
+	    close( resultfd[0] ) ;
+	    for( got = 0 ; got <= chain ; got++ ) {
+		/* only the coordinator hands out verdicts */
+		close( gofdS[2 * got + 1] ) ;
+	    }
+	    if( mainlineS[0] >= 0 ) {
+		/* the supervisor's end of the pid pipe */
+		close( mainlineS[0] ) ;
+		mainlineS[0] = -1 ;
+	    }
+	    Ysafe_free( pids ) ;
+	    capture_output() ;
+
+	    /* chain 0 keeps the current stream, so the */
+	    /* random numbers only depend on the seed.  */
+	    if( chain > 0 ) {
+		Yset_random_seed( (INT)( ((unsigned) Yget_random_var() +
+			    1013904223U * (unsigned) chain) & 0x7fffffff ) ) ;
+	    }
+	    chainS = chain ;
+	    resultfdS = resultfd[1] ;
+	    return( chain ) ;
+	}
+	close( gofdS[2 * chain] ) ;
+	pids[chain] = pid ;
+    }
+    close( resultfd[1] ) ;
+
+    /* ----------- wait for all the chains to report ----------- */
+    best = -1 ;
+    best_cost = 0.0 ;
+    for( got = 0 ; got < chains ; ) {
+	if( read( resultfd[0], &result, sizeof(CHAINRESULT) ) !=
+						    sizeof(CHAINRESULT) ) {
+	    break ;
+	}
+	got++ ;
+	/* ties go to the lower chain so the choice is reproducible */
+	if( best < 0 || result.cost < best_cost ||
+		(result.cost == best_cost && result.chain < best) ) {
+	    best = result.chain ;
+	    best_cost = result.cost ;
+	}
+    }
+    close( resultfd[0] ) ;
+    if( got < chains ) {
+	sprintf( YmsgG, "only %d of %d annealing chains finished\n",
+						    got, chains ) ;
+	M( ERRMSG, "Ychain_fork", YmsgG ) ;
+	best = -1 ;
+    }
+    for( chain = 0 ; chain < chains ; chain++ ) {
+	verdict = (chain == best) ? 'w' : 'q' ;
+	write( gofdS[2 * chain + 1], &verdict, 1 ) ;
+	close( gofdS[2 * chain + 1] ) ;
+    }
+    Ysafe_free( gofdS ) ;
+    gofdS = NULL ;
+
+    if( best < 0 ) {
+	YexitPgm( PGMFAIL ) ;
+    }
+    /* the winning chain carries on; this process is done with it. */
+    /* Announce the winner before leaving so the supervisor never */
+    /* sees the placement without a carrier.                       */
+    pid = pids[best] ;
+    Ysafe_free( pids ) ;
+    if( mainlineS[0] >= 0 ) {
+	/* the process the user started waits for the whole run */
+	supervise( pid ) ;
+    }
+    write( mainlineS[1], &pid, sizeof(pid_t) ) ;
+    _exit( 0 ) ;
+
+} /* end Ychain_fork */
+
+
+Ychain_finish( cost )
+DOUBLE cost ;
+{
+    CHAINRESULT result ;
+    char verdict ;
+
+    result.chain = chainS ;
+    result.cost = cost ;
+    write( resultfdS, &result, sizeof(CHAINRESULT) ) ;
+    close( resultfdS ) ;
+
+    if( read( gofdS[2 * chainS], &verdict, 1 ) != 1 || verdict != 'w' ) {
+	/* this chain lost - leave without flushing anything */
+	_exit( 0 ) ;
+    }
+    close( gofdS[2 * chainS] ) ;
+    Ysafe_free( gofdS ) ;
+    gofdS = NULL ;
+    release_output() ;
+
+} /* end Ychain_finish */
+
+
+/* ----------------------------------------------------------------- 
+   The process the user started must not exit before the placement
+   is finished, but the chain that carries the placement changes at
+   every step.  Make the first process the reaper of all the chains
+   and let each new carrier announce its pid to it.
+----------------------------------------------------------------- */
+static BOOL start_supervisor()
+{
+#ifdef PR_SET_CHILD_SUBREAPER
+    if( prctl( PR_SET_CHILD_SUBREAPER, 1, 0, 0, 0 ) == 0 &&
+					pipe( mainlineS ) == 0 ) {
+	fcntl( mainlineS[0], F_SETFL, O_NONBLOCK ) ;
+	supervisedS = TRUE ;
+	return( TRUE ) ;
+    }
+#endif
+    M( WARNMSG, "Ychain_fork",
+	"parallel annealing chains are not supported here - using one\n" ) ;
+    return( FALSE ) ;
+} /* end start_supervisor */
+
+
+static supervise( mainline )
+pid_t mainline ;
+{
+    pid_t pid, announced ;
+    int status ;
+
+    /* only the pid pipe is of any further use here */
+    close( mainlineS[1] ) ;
+    for( ; ; ) {
+	pid = waitpid( -1, &status, 0 ) ;
+	if( pid < 0 ) {
+	    if( errno == EINTR ) {
+		continue ;
+	    }
+	    /* every chain has gone without finishing the run */
+	    _exit( PGMFAIL ) ;
+	}
+	/* a carrier's successor is announced before it exits */
+	while( read( mainlineS[0], &announced, sizeof(pid_t) ) ==
+						    sizeof(pid_t) ) {
+	    mainline = announced ;
+	}
+	if( pid == mainline ) {
+	    break ;
+	}
+    }
+    if( WIFEXITED(status) ) {
+	_exit( WEXITSTATUS(status) ) ;
+    }
+    _exit( PGMFAIL ) ;
+} /* end supervise */
+
+
+/* ----------------------------------------------------------------- 
+   Chains write their progress to private files.  Only the winner's
+   output is passed on, so the .out file reads as one serial run.
+----------------------------------------------------------------- */
+static capture_output()
+{
+    cap_outS = tmpfile() ;
+    cap_fpoS = tmpfile() ;
+    if( !(cap_outS) || !(cap_fpoS) ) {
+	/* run the chain anyway, its output is mixed with the others */
+	return ;
+    }
+    save_outS = dup( fileno(stdout) ) ;
+    save_fpoS = dup( fileno(fpS) ) ;
+    dup2( fileno(cap_outS), fileno(stdout) ) ;
+    dup2( fileno(cap_fpoS), fileno(fpS) ) ;
+} /* end capture_output */
+
+
+static release_output()
+{
+    if( !(cap_outS) || !(cap_fpoS) ) {
+	return ;
+    }
+    fflush( stdout ) ;
+    fflush( fpS ) ;
+    dup2( save_outS, fileno(stdout) ) ;
+    dup2( save_fpoS, fileno(fpS) ) ;
+    close( save_outS ) ;
+    close( save_fpoS ) ;
+    copy_capture( cap_fpoS, fileno(fpS) ) ;
+    copy_capture( cap_outS, fileno(stdout) ) ;
+    fclose( cap_outS ) ;
+    fclose( cap_fpoS ) ;
+    cap_outS = cap_fpoS = NULL ;
+} /* end release_output */
+
+
+static copy_capture( fp, fd )
+FILE *fp ;
+int fd ;
+{
+    char buffer[BUFSIZ] ;
+    size_t n ;
+
+    rewind( fp ) ;
+    while( (n = fread( buffer, 1, BUFSIZ, fp )) > 0 ) {
+	write( fd, buffer, n ) ;
+    }
+} /* end copy_capture */
@@ -58,6 +58,8 @@ REVISIONS:  May 25, 1989 - added needtoExecute to handle case of no
 		experiences trouble.
 	    Fri Feb 22 23:55:29 EST 1991 - fixed new library rename.
 	    Sun Apr 21 22:33:53 EDT 1991 - now allow optional files.
+	    Sat Oct 17 2026 - record each completed program in the
+		flow checkpoint and resume from it with -r.
 ----------------------------------------------------------------- */
 #ifndef lint
 static char SccsId[] = "@(#) autoflow.c version 2.4 4/21/91" ;
@@ -79,6 +81,9 @@ auto_flow()
     ADJPTR     adjptr ;         /* current edge in graph */
     ADJPTR     make_decision(); /* decides which way to travel */
     OBJECTPTR  o ;              /* current object */
+    BOOL       needtoExecute ;  /* TRUE if program must be run */
+    BOOL       checkpoint_recorded() ;
+    BOOL       checkpoint_current() ;
 
     objectS = STARTOBJECT ;
     problemsG = FALSE ;
@@ -105,7 +110,18 @@ auto_flow()
 	G( graphics_set_object( objectS ) ) ;
 	G( draw_the_data() ) ;
 
-	if( check_dependencies( adjptr ) ){
+	if( resumeG && checkpoint_recorded( adjptr ) ){
+	    /* the checkpoint decides instead of the file dates */
+	    needtoExecute = !(checkpoint_current( adjptr )) ;
+	    if( !(needtoExecute) ){
+		sprintf( YmsgG, "%s is current in the checkpoint - skipped\n",
+		    proGraphG[objectS]->name ) ;
+		M( MSG, NULL, YmsgG ) ;
+	    }
+	} else {
+	    needtoExecute = check_dependencies( adjptr ) ;
+	}
+	if( needtoExecute ){
 	    /* program files are out of date execute program */
 	    if( executePgm( adjptr ) ){
 		/* we received a non zero return code break loop */
@@ -113,6 +129,7 @@ auto_flow()
 		report_problem( adjptr ) ;
 		break ;
 	    }
+	    write_checkpoint( adjptr ) ;
 	}
 
         /* allow user to change things */
@@ -181,6 +198,8 @@ exec_single_prog()
     if( executePgm( adjptr ) ){
 	/* we received a non zero return code break loop */
 	report_problem( adjptr ) ;
+    } else {
+	write_checkpoint( adjptr ) ;
     }
     G( draw_the_data() ) ;
 } /* end exec_single_prog */
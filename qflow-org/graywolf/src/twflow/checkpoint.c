@@ -0,0 +1,364 @@
+/*
+ *   Copyright (C) 1989-1992 Yale University
+ *   Copyright (C) 2015 Tim Edwards <tim@opencircuitdesign.com>
+ *
+ *   This work is distributed in the hope that it will be useful; you can
+ *   redistribute it and/or modify it under the terms of the
+ *   GNU General Public License as published by the Free Software Foundation;
+ *   either version 2 of the License,
+ *   or any later version, on the following conditions:
+ *
+ *   (a) YALE MAKES NO, AND EXPRESSLY DISCLAIMS
+ *   ALL, REPRESENTATIONS OR WARRANTIES THAT THE MANUFACTURE, USE, PRACTICE,
+ *   SALE OR
+ *   OTHER DISPOSAL OF THE SOFTWARE DOES NOT OR WILL NOT INFRINGE UPON ANY
+ *   PATENT OR
+ *   OTHER RIGHTS NOT VESTED IN YALE.
+ *
+ *   (b) YALE MAKES NO, AND EXPRESSLY DISCLAIMS ALL, REPRESENTATIONS AND
+ *   WARRANTIES
+ *   WHATSOEVER WITH RESPECT TO THE SOFTWARE, EITHER EXPRESS OR IMPLIED,
+ *   INCLUDING,
+ *   BUT NOT LIMITED TO, WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A
+ *   PARTICULAR
+ *   PURPOSE.
+ *
+ *   (c) LICENSEE SHALL MAKE NO STATEMENTS, REPRESENTATION OR WARRANTIES
+ *   WHATSOEVER TO
+ *   ANY THIRD PARTIES THAT ARE INCONSISTENT WITH THE DISCLAIMERS BY YALE IN
+ *   ARTICLE
+ *   (a) AND (b) above.
+ *
+ *   (d) IN NO EVENT SHALL YALE, OR ITS TRUSTEES, DIRECTORS, OFFICERS,
+ *   EMPLOYEES AND
+ *   AFFILIATES BE LIABLE FOR DAMAGES OF ANY KIND, INCLUDING ECONOMIC DAMAGE OR
+ *   INJURY TO PROPERTY AND LOST PROFITS, REGARDLESS OF WHETHER YALE SHALL BE
+ *   ADVISED, SHALL HAVE OTHER REASON TO KNOW, OR IN FACT SHALL KNOW OF THE
+ *   POSSIBILITY OF THE FOREGOING.
+ *
+ */
+
+/* ----------------------------------------------------------------- 
+FILE:	    checkpoint.c 
+DESCRIPTION:This file contains routines for the flow checkpoint.
+	    After each program of the flow completes, the size and a
+	    checksum of every file the program read and wrote are
+	    recorded in the binary file design.tfc.  When resuming,
+	    a program whose recorded files are all unchanged is not
+	    run again, whatever the file dates say.  Programs without
+	    a record still go by the file dates.
+CONTENTS:   read_checkpoint()
+	    write_checkpoint( adjptr )
+		ADJPTR adjptr ;
+	    BOOL checkpoint_recorded( adjptr )
+		ADJPTR adjptr ;
+	    BOOL checkpoint_current( adjptr )
+		ADJPTR adjptr ;
+DATE:	    Oct 17, 2026 - original coding.
+REVISIONS:  
+----------------------------------------------------------------- */
+#ifndef lint
+static char SccsId[] = "@(#) checkpoint.c version 1.1 10/17/26" ;
+#endif
+
+#include <string.h>
+#include <yalecad/base.h>
+#include <yalecad/message.h>
+#include <yalecad/file.h>
+#include <yalecad/string.h>
+#include <yalecad/debug.h>
+#include <globals.h>
+
+#define CKMAGIC      0x54574643 /* "TWFC" */
+#define CKVERSION    1
+#define NOFILE       -1         /* size of a missing optional file */
+
+typedef struct ckfile {
+    char *fname           ;  /* expanded file name */
+    INT  size             ;  /* bytes in file or NOFILE */
+    UNSIGNED_INT sum      ;  /* checksum of the contents */
+} CKFILE, *CKFILEPTR ;
+
+typedef struct ckbox {       /* record of a completed program */
+    INT  numfiles         ;  /* input and output files */
+    CKFILEPTR files       ;
+} CKBOX, *CKPTR ;
+
+static CKPTR *recordS = NIL(CKPTR *) ; /* indexed by program node */
+
+static VOID expand_name() ;
+static VOID file_signature() ;
+static VOID put_word() ;
+static UNSIGNED_INT get_word() ;
+
+/* read the checkpoint of a previous run if there is one */
+read_checkpoint()
+{
+    FILE       *fp ;             /* checkpoint file */
+    char       filename[LRECL] ; /* buffer for filename */
+    INT        i, j ;            /* counters */
+    INT        numrecords ;      /* records in the file */
+    INT        node ;            /* program node of record */
+    INT        len ;             /* length of a file name */
+    CKPTR      rec ;             /* current record */
+
+    recordS = (CKPTR *) Ysafe_calloc( numobjectsG+1, sizeof(CKPTR) ) ;
+
+    sprintf( filename, "%s.tfc", cktNameG ) ;
+    if(!(fp = TWOPEN( filename, "r", NOABORT ))){
+	return ;
+    }
+    if( get_word(fp) != CKMAGIC || get_word(fp) != CKVERSION ){
+	sprintf( YmsgG, "%s is not a flow checkpoint - ignored\n",
+	    filename ) ;
+	M( WARNMSG, "read_checkpoint", YmsgG ) ;
+	TWCLOSE( fp ) ;
+	return ;
+    }
+    numrecords = (INT) get_word(fp) ;
+    for( i = 0; i < numrecords && !feof(fp); i++ ){
+	node = (INT) get_word(fp) ;
+	rec = (CKPTR) Ysafe_malloc( sizeof(CKBOX) ) ;
+	rec->numfiles = (INT) get_word(fp) ;
+	if( feof(fp) || rec->numfiles < 0 || rec->numfiles > 1024 ){
+	    Ysafe_free( rec ) ;
+	    break ;
+	}
+	rec->files = (CKFILEPTR)
+	    Ysafe_calloc( rec->numfiles+1, sizeof(CKFILE) ) ;
+	for( j = 0; j < rec->numfiles; j++ ){
+	    len = (INT) get_word(fp) ;
+	    if( len < 0 || len >= LRECL ){
+		len = 0 ;
+	    }
+	    rec->files[j].fname = Ysafe_malloc( len+1 ) ;
+	    if( len > 0 ){
+		len = fread( rec->files[j].fname, 1, len, fp ) ;
+	    }
+	    rec->files[j].fname[len] = EOS ;
+	    rec->files[j].size = (INT) (int) get_word(fp) ;
+	    rec->files[j].sum = get_word(fp) ;
+	}
+	if( node < 1 || node > numobjectsG || feof(fp) ){
+	    /* stale or truncated record - ignore it */
+	    continue ;
+	}
+	recordS[node] = rec ;
+    }
+    TWCLOSE( fp ) ;
+
+} /* end read_checkpoint */
+
+/* record the files of the program which just completed */
+write_checkpoint( adjptr )
+ADJPTR adjptr ;
+{
+    FILE       *fp ;             /* checkpoint file */
+    char       filename[LRECL] ; /* buffer for filename */
+    char       tmpname[LRECL] ;  /* new checkpoint before rename */
+    INT        i, j ;            /* counters */
+    INT        numrecords ;      /* records to write */
+    INT        len ;             /* length of a file name */
+    FPTR       fdepend ;         /* current file in question */
+    CKPTR      rec ;             /* current record */
+
+    if(!(recordS)){
+	read_checkpoint() ;
+    }
+    /* build the new record for this program */
+    rec = (CKPTR) Ysafe_malloc( sizeof(CKBOX) ) ;
+    rec->numfiles = 0 ;
+    for( fdepend = adjptr->ifiles;fdepend; fdepend = fdepend->next ){
+	rec->numfiles++ ;
+    }
+    for( fdepend = adjptr->ofiles;fdepend; fdepend = fdepend->next ){
+	rec->numfiles++ ;
+    }
+    rec->files = (CKFILEPTR) Ysafe_calloc( rec->numfiles+1, sizeof(CKFILE) ) ;
+    i = 0 ;
+    for( fdepend = adjptr->ifiles;fdepend; fdepend = fdepend->next ){
+	expand_name( fdepend, filename ) ;
+	rec->files[i].fname = Ystrclone( filename ) ;
+	file_signature( filename, &(rec->files[i]) ) ;
+	i++ ;
+    }
+    for( fdepend = adjptr->ofiles;fdepend; fdepend = fdepend->next ){
+	expand_name( fdepend, filename ) ;
+	rec->files[i].fname = Ystrclone( filename ) ;
+	file_signature( filename, &(rec->files[i]) ) ;
+	i++ ;
+    }
+    if( recordS[adjptr->node] ){
+	for( j = 0; j < recordS[adjptr->node]->numfiles; j++ ){
+	    Ysafe_free( recordS[adjptr->node]->files[j].fname ) ;
+	}
+	Ysafe_free( recordS[adjptr->node]->files ) ;
+	Ysafe_free( recordS[adjptr->node] ) ;
+    }
+    recordS[adjptr->node] = rec ;
+
+    /* now write all the records out */
+    sprintf( filename, "%s.tfc", cktNameG ) ;
+    sprintf( tmpname, "%s.tfc.tmp", cktNameG ) ;
+    if(!(fp = TWOPEN( tmpname, "w", NOABORT ))){
+	sprintf( YmsgG, "could not write flow checkpoint %s\n", tmpname ) ;
+	M( WARNMSG, "write_checkpoint", YmsgG ) ;
+	return ;
+    }
+    numrecords = 0 ;
+    for( i = 1; i <= numobjectsG; i++ ){
+	if( recordS[i] ){
+	    numrecords++ ;
+	}
+    }
+    put_word( fp, CKMAGIC ) ;
+    put_word( fp, CKVERSION ) ;
+    put_word( fp, numrecords ) ;
+    for( i = 1; i <= numobjectsG; i++ ){
+	if(!(rec = recordS[i])){
+	    continue ;
+	}
+	put_word( fp, i ) ;
+	put_word( fp, rec->numfiles ) ;
+	for( j = 0; j < rec->numfiles; j++ ){
+	    len = strlen( rec->files[j].fname ) ;
+	    put_word( fp, len ) ;
+	    fwrite( rec->files[j].fname, 1, len, fp ) ;
+	    put_word( fp, rec->files[j].size ) ;
+	    put_word( fp, rec->files[j].sum ) ;
+	}
+    }
+    TWCLOSE( fp ) ;
+    /* replace the old checkpoint in one step */
+    if( rename( tmpname, filename ) != 0 ){
+	sprintf( YmsgG, "could not update flow checkpoint %s\n", filename ) ;
+	M( WARNMSG, "write_checkpoint", YmsgG ) ;
+    }
+
+} /* end write_checkpoint */
+
+/* returns TRUE if the checkpoint has a record of the program */
+BOOL checkpoint_recorded( adjptr )
+ADJPTR adjptr ;
+{
+    if(!(recordS)){
+	read_checkpoint() ;
+    }
+    if( recordS[adjptr->node] ){
+	return( TRUE ) ;
+    }
+    return( FALSE ) ;
+} /* end BOOL checkpoint_recorded */
+
+/* returns TRUE if the program completed before and none of */
+/* its files changed since */
+BOOL checkpoint_current( adjptr )
+ADJPTR adjptr ;
+{
+    char       filename[LRECL] ; /* buffer for filename */
+    INT        i ;               /* counter */
+    INT        numfiles ;        /* files of the program */
+    FPTR       fdepend ;         /* current file in question */
+    CKPTR      rec ;             /* record of the program */
+    CKFILE     now ;             /* current signature of a file */
+
+    if(!(recordS)){
+	read_checkpoint() ;
+    }
+    if(!(rec = recordS[adjptr->node])){
+	return( FALSE ) ;
+    }
+    numfiles = 0 ;
+    for( fdepend = adjptr->ifiles;fdepend; fdepend = fdepend->next ){
+	numfiles++ ;
+    }
+    for( fdepend = adjptr->ofiles;fdepend; fdepend = fdepend->next ){
+	/* a missing output is never current */
+	expand_name( fdepend, filename ) ;
+	if(!(YfileExists( filename ))){
+	    return( FALSE ) ;
+	}
+	numfiles++ ;
+    }
+    if( numfiles != rec->numfiles ){
+	/* the flow changed */
+	return( FALSE ) ;
+    }
+    for( i = 0; i < rec->numfiles; i++ ){
+	file_signature( rec->files[i].fname, &now ) ;
+	if( now.size != rec->files[i].size || now.sum != rec->files[i].sum ){
+	    D( "twflow/checkpoint",
+		sprintf( YmsgG, "%s changed\n", rec->files[i].fname ) ) ;
+	    D( "twflow/checkpoint", M( MSG, NULL, YmsgG ) ) ;
+	    return( FALSE ) ;
+	}
+    }
+    return( TRUE ) ;
+
+} /* end BOOL checkpoint_current */
+
+static VOID expand_name( fdepend, filename )
+FPTR fdepend ;
+char *filename ;
+{
+    if( *fdepend->fname == '$' ){
+	/* suffix keyword */
+	sprintf( filename, "%s%s", cktNameG, fdepend->fname+1 ) ;
+    } else {
+	strcpy( filename, fdepend->fname ) ;
+    }
+} /* end expand_name */
+
+/* size and FNV-1a checksum of a file */
+static VOID file_signature( filename, sig )
+char *filename ;
+CKFILEPTR sig ;
+{
+    FILE         *fp ;           /* file to be read */
+    unsigned char buf[BUFSIZ] ;  /* file contents */
+    INT          i, n ;          /* counters */
+    UNSIGNED_INT sum ;           /* running checksum */
+
+    sig->size = NOFILE ;
+    sig->sum = 0 ;
+    if(!(fp = fopen( filename, "r" ))){
+	return ;
+    }
+    sig->size = 0 ;
+    sum = 0x811c9dc5 ;
+    while( (n = fread( buf, 1, BUFSIZ, fp )) > 0 ){
+	for( i = 0; i < n; i++ ){
+	    sum = ((sum ^ buf[i]) * 0x01000193) & 0xffffffff ;
+	}
+	sig->size += n ;
+    }
+    fclose( fp ) ;
+    sig->sum = sum ;
+} /* end file_signature */
+
+/* words are written most significant byte first */
+static VOID put_word( fp, word )
+FILE *fp ;
+UNSIGNED_INT word ;
+{
+    putc( (word >> 24) & 0xff, fp ) ;
+    putc( (word >> 16) & 0xff, fp ) ;
+    putc( (word >> 8) & 0xff, fp ) ;
+    putc( word & 0xff, fp ) ;
+} /* end put_word */
+
+static UNSIGNED_INT get_word( fp )
+FILE *fp ;
+{
+    UNSIGNED_INT word ;
+    INT          i, c ;
+
+    word = 0 ;
+    for( i = 0; i < 4; i++ ){
+	if( (c = getc( fp )) == EOF ){
+	    return( 0 ) ;
+	}
+	word = (word << 8) | (c & 0xff) ;
+    }
+    return( word ) ;
+} /* end get_word */
@@ -51,6 +51,7 @@ REVISIONS:  Jun 19, 1989 - added marked to ADJPTR record.
 	    Thu Apr 18 01:19:41 EDT 1991 - now user can specify a
 		flow file.
 	    Sun Apr 21 22:34:28 EDT 1991 - now allow optional files.
+	    Sat Oct 17 2026 - added resumeG for the flow checkpoint.
 ----------------------------------------------------------------- */
 #ifndef GLOBALS_H
 #define GLOBALS_H
@@ -155,5 +156,6 @@ EXTERN BOOL graphicsG ;          /* whether graphics is requested */
 EXTERN BOOL autoflowG ;          /* whether autoflow is enabled */
 EXTERN BOOL problemsG ;          /* whether problems were encountered */
 EXTERN BOOL tomusG ;             /* TRUE if called from partitioning */
+EXTERN BOOL resumeG ;            /* TRUE if resuming from checkpoint */
 
 #endif /* GLOBALS_H */
@@ -62,6 +62,8 @@ REVISIONS:  Jun 19, 1989 - added stdcell.fnog for no graphics case.
 	    Thu Apr 18 01:20:52 EDT 1991 - now user can specify
 		a flow directory.  Also added show_flows call.
 	    Sun Apr 21 22:36:29 EDT 1991 - now find the flow directory.
+	    Sat Oct 17 2026 - added -r to resume from the flow
+		checkpoint.
 ---------------------------------------------------------------- */
 #ifndef lint
 static char SccsId[] = "@(#) main.c version 2.8 4/21/91" ;
@@ -131,6 +133,7 @@ char *argv[] ;
 	debug      = FALSE ;
 	lock       = FALSE ;
 	tomusG     = FALSE ;
+	resumeG    = FALSE ;
 	parasite   = FALSE ;
 	autoflowG  = TRUE ;
 	general_mode = FALSE ;
@@ -154,6 +157,9 @@ char *argv[] ;
 		case 'p':
 		    autoflowG = FALSE ;
 		    break ;
+		case 'r':
+		    resumeG = TRUE ;
+		    break ;
 		case 't':
 		    tomusG = TRUE ;
 		    break ;
@@ -181,6 +187,9 @@ char *argv[] ;
 		YsetDebug( TRUE ) ;
 		M(MSG,NULL,"\tdebug on\n" ) ;
 	    } 
+	    if( resumeG ){
+		M(MSG,NULL,"\tresume from flow checkpoint\n" ) ;
+	    }
 	    if( graphicsG ){
 		M(MSG,NULL,"\tGraphics mode on\n" ) ;
 	    } else {
@@ -285,7 +294,7 @@ syntax()
 {
    M(ERRMSG,NULL,"\n" ) ; 
    M(MSG,NULL,"Incorrect syntax.  Correct syntax:\n");
-   sprintf( YmsgG, "\ngraywolf [-gpndw] designName [windowId] [flowdirectory]\n" );
+   sprintf( YmsgG, "\ngraywolf [-gpndrw] designName [windowId] [flowdirectory]\n" );
    M(MSG,NULL,YmsgG ) ; 
    M(MSG,NULL,"\twhose options are one or more of the following:\n");
    M(MSG,NULL,"\t\tg - general mode - does not use TimberWolf system\n");
@@ -296,6 +305,8 @@ syntax()
    M(MSG,NULL,"\t\t    display and output graphics to an Xwindow\n");
    M(MSG,NULL,"\t\td - prints debug info and performs extensive\n");
    M(MSG,NULL,"\t\t    error checking\n");
+   M(MSG,NULL,"\t\tr - resume - skip programs whose files are\n");
+   M(MSG,NULL,"\t\t    unchanged since the flow checkpoint\n");
    M(MSG,NULL,"\t\tw - parasite mode will inherit a window. Requires\n");
    M(MSG,NULL,"\t\t    a valid windowId\n");
 
@@ -29,6 +29,7 @@ REVISIONS:  Aug  7, 1988 - added control flags for pads.
 		variable.
 	    Sat Feb 23 00:22:35 EST 1991 - added defines for TOMUS.
 	    Wed May  1 16:42:30 EDT 1991 - removed defines for TOMUS.
+	    Sat Oct 17 2026 - added anneal_chainsG.
 ----------------------------------------------------------------- */
 /* *****************************************************************
    static char SccsId[] = "@(#) main.h version 3.7 5/1/91" ;
@@ -122,6 +123,7 @@ EXTERN INT scale_dataG ;  /* reduce the scale of the input data */
 EXTERN INT track_spacingXG ;
 EXTERN INT track_spacingYG ;
 EXTERN INT defaultTracksG ;
+EXTERN INT anneal_chainsG ; /* parallel chains per temperature step */
 
 /* booleans for control of program */
 EXTERN BOOL cost_onlyG ;
@@ -47,6 +47,8 @@ REVISIONS:
 		numbins based on cell area. In future, use variance.
 	    Mar  1, 1988 - added variance.
 	    Nov 20, 1988 - fixed aspect ratio.
+	    Sat Oct 17 2026 - allocate the bin records as one block so
+		the overlap sweeps walk contiguous memory.
 ----------------------------------------------------------------- */
 #ifndef lint
 static char SccsId[] = "@(#) makebins.c version 3.3 9/5/90" ;
@@ -60,6 +62,7 @@ INT numbins ;
 {
 
 BINBOXPTR bptr ;
+BINBOXPTR block ;
 DOUBLE xbins, ybins ;
 INT i, j ;
 
@@ -79,10 +82,13 @@ OUT2("maxBinXG automatically set to:%d\n", maxBinXG );
 OUT2("maxBinYG automatically set to:%d\n", maxBinYG );
 
 binptrG = (BINBOXPTR **)Ysafe_malloc( (1+maxBinXG)*sizeof(BINBOXPTR *)) ; 
+/* one block for all the bins - a column of bins is contiguous since */
+/* the overlap loops run over j inside i */
+block = (BINBOXPTR) Ysafe_malloc( (1+maxBinXG)*(1+maxBinYG)*sizeof(BINBOX) ) ;
 for( i = 0 ; i <= maxBinXG ; i++ ) {
     binptrG[i]=(BINBOXPTR*) Ysafe_malloc((1+maxBinYG)*sizeof(BINBOXPTR));
     for( j = 0 ; j <= maxBinYG ; j++ ) {
-	bptr = binptrG[i][j] = (BINBOXPTR) Ysafe_malloc( sizeof(BINBOX));
+	bptr = binptrG[i][j] = block++ ;
 	bptr->cells = 
 	    (INT *) Ysafe_malloc( (EXPCELLPERBIN+1) * sizeof(INT));
 	/* zero position holds current number cells in bin */
@@ -56,6 +56,8 @@ CONTENTS:   overlap( )
 	    find_orient() 
 	    setup_Bins( CELLBOXPTR, int, int, INT )
 	    add2bin( MOVEBOXPTR * ) 
+	    static init_penal( MOVEBOXPTR * )
+	    static copy_penal( MOVEBOXPTR * )
 DATE:	    Feb  2, 1988 
 REVISIONS:  Feb  5, 1988 - changed old_apos, new_apos, old_bpos,
 		new_bpos to global variables.  Old method remains
@@ -67,6 +69,9 @@ REVISIONS:  Feb  5, 1988 - changed old_apos, new_apos, old_bpos,
 	    Apr  4, 1989 - added instance changes.
 	    Sun Jan 20 21:34:36 PST 1991 - ported to AIX.
 	    Mon Feb  4 02:15:23 EST 1991 - added new wire estimator.
+	    Sat Oct 17 2026 - initialize and update only the bins under
+		the tiles of the move instead of the bounding box of the
+		old and new positions which spans the core on long moves.
 ----------------------------------------------------------------- */
 #ifndef lint
 static char SccsId[] = "@(#) overlap.c version 3.6 4/18/91" ;
@@ -97,6 +102,8 @@ static INT newbinpenalS ;
 static INT xcostS, ycostS ;
 static INT (*calc_Bins)() ;/* remember which bin function */
 static INT (*wire_est)() ; /* remember which wire estimation function */
+static init_penal( P1(MOVEBOXPTR *cellpos) ) ;
+static copy_penal( P1(MOVEBOXPTR *cellpos) ) ;
 
 /* global references */
 extern INT wireestxy( P3(MOVEBOXPTR pos,INT xc, INT yc) ) ;
@@ -108,9 +115,6 @@ extern INT wireestxy2( P3(MOVEBOXPTR pos,INT xc, INT yc) ) ;
 INT overlap( /* old_aposG, new_aposG */ )
 /* MOVEBOXPTR *old_aposG, *new_aposG ; */
 {
-    register BINBOXPTR *fastbin ;
-    register x, y ;
-
 
 /* ----------------------------------------------------------------- 
    Perform overlap calculation over all tiles.
@@ -146,22 +150,12 @@ ycS = new_apos0G->ycenter ;
 calcBins( new_aposG ) ;
 
 /* ----------------------------------------------------------------- 
-   Perform overlap initialization for OLD A - NEW A pair
-   minX, minY, maxX, maxY now has bounding box for this pair.
-   Store result in old_apos for latter use in update overlap
+   Perform overlap initialization for OLD A - NEW A pair.
+   Only the bins under the tiles are touched so a long move
+   does not sweep the whole bounding box of the pair.
 */
-old_apos0G->binR = maxXS ;
-old_apos0G->binL = minXS ;
-old_apos0G->binT = maxYS ;
-old_apos0G->binB = minYS ;
-
-for( x = minXS; x <= maxXS ; x++ ){
-    fastbin = binptrG[x] ;
-    for( y = minYS; y <= maxYS ; y++ ){
-	bptrS = fastbin[y] ;
-	bptrS->nupenalty = bptrS->penalty ;
-    }
-}
+init_penal( old_aposG ) ;
+init_penal( new_aposG ) ;
 
 /* ----------------------------------------------------------------- 
    INITIALIZATION COMPLETE.  NOW perform calculation.
@@ -184,9 +178,6 @@ return( newbinpenalS ) ;
 INT overlap2( /* old_aposG, new_aposG, old_bposG, new_bposG */ )
 /* MOVEBOXPTR *old_aposG, *new_aposG, *old_bposG, *new_bposG ; */
 {
-    register BINBOXPTR *fastbin ;
-    register x, y ;
-
 
 /* ----------------------------------------------------------------- 
    Perform overlap calculation over all tiles.
@@ -222,21 +213,9 @@ calcBins( new_bposG ) ;
 
 /* ----------------------------------------------------------------- 
    Perform overlap initialization for OLD A - NEW B pair
-   minX, minY, maxX, maxY now has bounding box for this pair.
-   Store result in old_apos for latter use in update overlap
 */
-old_apos0G->binR = maxXS ;
-old_apos0G->binL = minXS ;
-old_apos0G->binT = maxYS ;
-old_apos0G->binB = minYS ;
-
-for( x = minXS; x <= maxXS ; x++ ){
-    fastbin = binptrG[x] ;
-    for( y = minYS; y <= maxYS ; y++ ){
-	bptrS = fastbin[y] ;
-	bptrS->nupenalty = bptrS->penalty ;
-    }
-}
+init_penal( old_aposG ) ;
+init_penal( new_bposG ) ;
 
 /* ----------------------------------------------------------------- 
    Perform overlap calculation over all tiles.
@@ -267,21 +246,9 @@ calcBins( new_aposG ) ;
 
 /* ----------------------------------------------------------------- 
    Perform overlap initialization for OLD B - NEW A pair
-   minX, minY, maxX, maxY now has bounding box for this pair.
-   Store result in old_bpos for latter use in update overlap
 */
-old_bpos0G->binR = maxXS ;
-old_bpos0G->binL = minXS ;
-old_bpos0G->binT = maxYS ;
-old_bpos0G->binB = minYS ;
-
-for( x = minXS; x <= maxXS ; x++ ){
-    fastbin = binptrG[x] ;
-    for( y = minYS; y <= maxYS ; y++ ){
-	bptrS = fastbin[y] ;
-	bptrS->nupenalty = bptrS->penalty ;
-    }
-}
+init_penal( old_bposG ) ;
+init_penal( new_aposG ) ;
 
 /* ----------------------------------------------------------------- 
    INITIALIZATION COMPLETE.  NOW perform calculation.
@@ -304,26 +271,12 @@ return( newbinpenalS ) ;
 INT update_overlap( /* old_aposG */ )
 /* MOVEBOXPTR *old_aposG ; */
 {
-    register BINBOXPTR *fastbin ;
-    register x, y ;
-
 /* ----------------------------------------------------------------- 
-   Perform overlap update for OLD A - NEW A pair
-   Recall information stored in old_apos[0] to get bounding
-   box for this pair. 
+   Perform overlap update for OLD A - NEW A pair.  The tiles
+   still hold the bins calculated in overlap.
 */
-maxXS = old_apos0G->binR  ;
-minXS = old_apos0G->binL  ;
-maxYS = old_apos0G->binT  ;
-minYS = old_apos0G->binB ;
-
-for( x = minXS; x <= maxXS ; x++ ){
-    fastbin = binptrG[x] ;
-    for( y = minYS; y <= maxYS ; y++ ){
-	bptrS = fastbin[y] ;
-	bptrS->penalty = bptrS->nupenalty ;
-    }
-}
+copy_penal( old_aposG ) ;
+copy_penal( new_aposG ) ;
 } /* end function update_overlap */
 
 /* ***************************************************************** 
@@ -332,45 +285,67 @@ for( x = minXS; x <= maxXS ; x++ ){
 INT update_overlap2( /* old_aposG, old_bposG */ )
 /* MOVEBOXPTR *old_apos, *old_bpos ; */
 {
-    register BINBOXPTR *fastbin ;
-    register x, y ;
+copy_penal( old_aposG ) ;
+copy_penal( new_bposG ) ;
+copy_penal( old_bposG ) ;
+copy_penal( new_aposG ) ;
+} /* end function update_overlap */
 
-/* ----------------------------------------------------------------- 
-   Perform overlap update for OLD A - NEW B pair
-   Recall information stored in old_apos[0] to get bounding
-   box for this pair. 
+/* ***************************************************************** 
+   Set the nupenalty field of the bins under each tile.
 */
-maxXS = old_apos0G->binR  ;
-minXS = old_apos0G->binL  ;
-maxYS = old_apos0G->binT  ;
-minYS = old_apos0G->binB ;
-
-for( x = minXS; x <= maxXS ; x++ ){
-    fastbin = binptrG[x] ;
-    for( y = minYS; y <= maxYS ; y++ ){
-	bptrS = fastbin[y] ;
-	bptrS->penalty = bptrS->nupenalty ;
+static init_penal( cellpos )
+MOVEBOXPTR *cellpos ;
+{
+INT count, maxcount ;
+register BINBOXPTR *fastbin ;
+register x, y ;
+
+maxcount = cellpos[0]->numtiles ;
+for( count=1 ; count <= maxcount ; count++ ) {
+    posS = cellpos[count] ;
+    /* a degenerate tile may have its bins crossed - sub_penal and */
+    /* add_penal still touch both end bins so cover them here too */
+    minXS = MIN( posS->binL, posS->binR ) ;
+    maxXS = MAX( posS->binL, posS->binR ) ;
+    minYS = MIN( posS->binB, posS->binT ) ;
+    maxYS = MAX( posS->binB, posS->binT ) ;
+    for( x = minXS; x <= maxXS ; x++ ){
+	fastbin = binptrG[x] ;
+	for( y = minYS; y <= maxYS ; y++ ){
+	    bptrS = fastbin[y] ;
+	    bptrS->nupenalty = bptrS->penalty ;
+	}
     }
 }
+} /* end init_penal */
 
-/* ----------------------------------------------------------------- 
-   Perform overlap update for OLD B - NEW A pair
-   Recall information stored in old_bpos[0] to get bounding
-   box for this pair. 
+/* ***************************************************************** 
+   Accept the nupenalty field of the bins under each tile.
 */
-maxXS = old_bpos0G->binR  ;
-minXS = old_bpos0G->binL  ;
-maxYS = old_bpos0G->binT  ;
-minYS = old_bpos0G->binB ;
-
-for( x = minXS; x <= maxXS ; x++ ){
-    fastbin = binptrG[x] ;
-    for( y = minYS; y <= maxYS ; y++ ){
-	bptrS = fastbin[y] ;
-	bptrS->penalty = bptrS->nupenalty ;
+static copy_penal( cellpos )
+MOVEBOXPTR *cellpos ;
+{
+INT count, maxcount ;
+register BINBOXPTR *fastbin ;
+register x, y ;
+
+maxcount = cellpos[0]->numtiles ;
+for( count=1 ; count <= maxcount ; count++ ) {
+    posS = cellpos[count] ;
+    minXS = MIN( posS->binL, posS->binR ) ;
+    maxXS = MAX( posS->binL, posS->binR ) ;
+    minYS = MIN( posS->binB, posS->binT ) ;
+    maxYS = MAX( posS->binB, posS->binT ) ;
+    for( x = minXS; x <= maxXS ; x++ ){
+	fastbin = binptrG[x] ;
+	for( y = minYS; y <= maxYS ; y++ ){
+	    bptrS = fastbin[y] ;
+	    bptrS->penalty = bptrS->nupenalty ;
+	}
     }
 }
-} /* end function update_overlap */
+} /* end copy_penal */
 
 /* ***************************************************************** 
    Subtract penalty from bins.  
@@ -0,0 +1,85 @@
+/*
+ *   Copyright (C) 1989-1992 Yale University
+ *   Copyright (C) 2015 Tim Edwards <tim@opencircuitdesign.com>
+ *
+ *   This work is distributed in the hope that it will be useful; you can
+ *   redistribute it and/or modify it under the terms of the
+ *   GNU General Public License as published by the Free Software Foundation;
+ *   either version 2 of the License,
+ *   or any later version, on the following conditions:
+ *
+ *   (a) YALE MAKES NO, AND EXPRESSLY DISCLAIMS
+ *   ALL, REPRESENTATIONS OR WARRANTIES THAT THE MANUFACTURE, USE, PRACTICE,
+ *   SALE OR
+ *   OTHER DISPOSAL OF THE SOFTWARE DOES NOT OR WILL NOT INFRINGE UPON ANY
+ *   PATENT OR
+ *   OTHER RIGHTS NOT VESTED IN YALE.
+ *
+ *   (b) YALE MAKES NO, AND EXPRESSLY DISCLAIMS ALL, REPRESENTATIONS AND
+ *   WARRANTIES
+ *   WHATSOEVER WITH RESPECT TO THE SOFTWARE, EITHER EXPRESS OR IMPLIED,
+ *   INCLUDING,
+ *   BUT NOT LIMITED TO, WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A
+ *   PARTICULAR
+ *   PURPOSE.
+ *
+ *   (c) LICENSEE SHALL MAKE NO STATEMENTS, REPRESENTATION OR WARRANTIES
+ *   WHATSOEVER TO
+ *   ANY THIRD PARTIES THAT ARE INCONSISTENT WITH THE DISCLAIMERS BY YALE IN
+ *   ARTICLE
+ *   (a) AND (b) above.
+ *
+ *   (d) IN NO EVENT SHALL YALE, OR ITS TRUSTEES, DIRECTORS, OFFICERS,
+ *   EMPLOYEES AND
+ *   AFFILIATES BE LIABLE FOR DAMAGES OF ANY KIND, INCLUDING ECONOMIC DAMAGE OR
+ *   INJURY TO PROPERTY AND LOST PROFITS, REGARDLESS OF WHETHER YALE SHALL BE
+ *   ADVISED, SHALL HAVE OTHER REASON TO KNOW, OR IN FACT SHALL KNOW OF THE
+ *   POSSIBILITY OF THE FOREGOING.
+ *
+ */
+/* ----------------------------------------------------------------- 
+FILE:	    pchain.c                                       
+DESCRIPTION:parallel annealing chains for the macro placer.  Each
+	    temperature step is run by anneal.chains processes forked
+	    from the current placement (see Ylib/chain.c).  The chain
+	    with the lowest wire, overlap and timing cost carries the
+	    placement, bins and controller state on to the next step.
+	    The move routines share the global move boxes and overlap
+	    bins, so the chains run as processes rather than threads.
+CONTENTS:   chain_uloop( INT )
+DATE:	    Oct 17, 2026 
+REVISIONS:  
+----------------------------------------------------------------- */
+#ifndef lint
+static char SccsId[] = "@(#) pchain.c version 1.0 10/17/26" ;
+#endif
+
+#include <custom.h>
+#include <yalecad/chain.h>
+
+chain_uloop( limit )
+INT limit ;
+{
+
+INT chains , attmax ;
+
+chains = anneal_chainsG ;
+if( chains <= 1 || doGraphicsG ) {
+    uloop( limit ) ;
+    return ;
+}
+if( Ychain_fork( chains, fpoG ) < 0 ) {
+    anneal_chainsG = 1 ;
+    uloop( limit ) ;
+    return ;
+}
+/* the temperature update counts the attempts of this chain only */
+attmax = attmaxG ;
+attmaxG = (attmax + chains - 1) / chains ;
+uloop( (limit + chains - 1) / chains ) ;
+attmaxG = attmax ;
+
+Ychain_finish( (DOUBLE) funccostG + (DOUBLE) penaltyG +
+			(DOUBLE) timingcostG ) ;
+
+} /* end chain_uloop */
@@ -73,6 +73,7 @@ REVISIONS:  Mar  8, 1988 - added lambda and init_acc ;
 		weight.
 	    Fri Oct 18 00:15:59 EDT 1991 - now scale block when calling
 		TimberWolf recursively.
+	    Sat Oct 17 2026 - added anneal.chains.
 ----------------------------------------------------------------- */
 #ifndef lint
 static char SccsId[] = "@(#) readpar.c version 3.20 11/23/91" ;
@@ -140,6 +141,7 @@ static init_read_par()
     coreGivenG = FALSE ;
     wait_for_userG = FALSE ;
     defaultTracksG = 0 ;
+    anneal_chainsG = 1 ;
     restartG = FALSE ;
     contiguousG = TRUE ;
     gridCellsG = TRUE ;
@@ -239,6 +241,12 @@ INT parfile ;
 	    } else {
 		err_msg("random.seed") ;
 	    }
+	} else if( strcmp( tokens[0], "anneal.chains" ) == STRINGEQ ){
+	    if( numtokens == 2 ) {
+		anneal_chainsG = atoi( tokens[1] ) ;
+	    } else {
+		err_msg("anneal.chains") ;
+	    }
 	} else if( strcmp( tokens[0], "chip.aspect.ratio" ) == STRINGEQ ){
 	    if( numtokens == 2 ) {
 		chipaspectG = atof( tokens[1] ) ;
@@ -53,6 +53,7 @@ REVISIONS:  Dec 3, 1988 - added output info for timing.
 	    Jun 21,1989 - added verbose switch to iteration number.
 	    Oct 14,1990 - added overlap iterations.
 	    Fri Jan 25 18:09:20 PST 1991 - removed unnecessary globals.
+	    Sat Oct 17 2026 - temperature steps run as parallel chains.
 ----------------------------------------------------------------- */
 #ifndef lint
 static char SccsId[] = "@(#) utemp.c version 3.6 4/6/92" ;
@@ -82,7 +83,7 @@ BOOL multi_cell_moves ;
 	    }
 	    fflush( stdout ) ;
 	}
-	uloop( attmaxG ) ;
+	chain_uloop( attmaxG ) ;
 	savewolf( FALSE ) ; /* don't force save */
 	
     }
@@ -93,7 +94,7 @@ BOOL multi_cell_moves ;
 	lapFactorG = calc_lap_factor( (DOUBLE) 3.0 ) ;
 	funccostG = findcost() ;
 	for( i = 1; i <= 3 ; i++ ){
-	    uloop( attmaxG ) ;
+	    chain_uloop( attmaxG ) ;
 	    savewolf( FALSE ) ; /* don't force save */
 	    iterationG++ ; /* next iteration */
 	}
@@ -42,7 +42,8 @@ FILE:	    acceptt.c
 DESCRIPTION:accept routine used in simulated annealing
 CONTENTS:   acceptt( INT  )
 DATE:	    Jan 30, 1988 
-REVISIONS:
+REVISIONS:  Sat Oct 17 2026 - uphill moves are tested against a batch
+		of log uniform deviates instead of the exp() tables.
 ----------------------------------------------------------------- */
 #ifndef lint
 static char SccsId[] = "@(#) acceptt.c version 4.7 4/2/92" ;
@@ -53,23 +54,6 @@ static char SccsId[] = "@(#) acceptt.c version 4.7 4/2/92" ;
 #include "main.h"
 #include "standard.h"
 
-#define MASK 0x3ff
-
-static DOUBLE table1S[1024] , table2S[1024] , table3S[1024] ;
- 
-init_table()
-{
-    INT i2 ;
-    table1S[0] = 1.0 ;
-    table2S[0] = 1.0 ;
-    table3S[0] = 1.0 ;
-    for( i2 = 1 ; i2 <= 1023 ; i2++ ) {
-	table1S[ i2 ] = exp( -(DOUBLE) i2 / 8.0 ) ;
-	table2S[ i2 ] = exp( -(DOUBLE) i2 / 8192.0 ) ;
-	table3S[ i2 ] = exp( -(DOUBLE) i2 / 8388608.0 ) ;
-    }
-}
-
 #ifdef DEBUG_CODE
 static FILE *fpS = NULL ;
 BOOL acceptt( d_wire, d_time, d_penal )
@@ -97,43 +81,27 @@ INT d_wire, d_time, d_penal ;
     deltas to be of the form (old_cost - new_cost). If new_cost is
     less than the old_cost, the quantity will be positive and always
     acceptted.  The variable d_costG lets the statistic accumulation
-    code know of the change.
+    code know of the change.  An uphill move is accepted with
+    probability exp( d_costG / T ), that is whenever d_costG is
+    above T * log(r) for r uniform in (0,1].  The logs come in
+    batches from fastrand.c.
 ----------------------------------------------------------------- */
 BOOL acceptt( d_wire, d_time, d_penal )
 INT d_wire, d_time, d_penal ;
 {
 
-    DOUBLE fred ;
-    register unsigned fract ;
-
     /* d_time = (INT) ( 10.0 * timeFactorG * (DOUBLE) d_time ) ; */
     d_time = (INT) ( timeFactorG * (DOUBLE) d_time ) ;
     d_costG = d_wire + d_time + d_penal ; 
     if( d_costG >= 0 ){
 	return( TRUE ) ;
-    } else {
-	fred = ((DOUBLE) d_costG ) / TG ; 
     }
 
     /* Now we are left with the uphill moves */
-    if( fred < -80.0 ) {
-	return( FALSE ) ;
-    } else if( fred > -0.0001 ) {
-	if( 1.0 + fred > ( (DOUBLE) RAND / (DOUBLE)0x7fffffff ) ) { 
-	    return( TRUE ) ;
-	} else {
-	    return( FALSE ) ;
-	}
+    if( (DOUBLE) d_costG > TG * LOG_UNIFORM ) {
+	return( TRUE ) ;
     } else {
-	fract = (INT)( -fred * 8388608.0 ) ;
-	if( (table1S[ (fract >> 20) & MASK ] * 
-			table2S[ (fract >> 10) & MASK] * 
-			table3S[ fract & MASK ]) > 
-			( (DOUBLE) RAND / (DOUBLE)0x7fffffff ) ) {
-	    return( TRUE ) ;
-	} else {
-	    return( FALSE ) ;
-	}
+	return( FALSE ) ;
     }
 } /* end acceptt() */
 
@@ -0,0 +1,714 @@
+/*
+ *   Copyright (C) 1989-1992 Yale University
+ *   Copyright (C) 2015 Tim Edwards <tim@opencircuitdesign.com>
+ *
+ *   This work is distributed in the hope that it will be useful; you can
+ *   redistribute it and/or modify it under the terms of the
+ *   GNU General Public License as published by the Free Software Foundation;
+ *   either version 2 of the License,
+ *   or any later version, on the following conditions:
+ *
+ *   (a) YALE MAKES NO, AND EXPRESSLY DISCLAIMS
+ *   ALL, REPRESENTATIONS OR WARRANTIES THAT THE MANUFACTURE, USE, PRACTICE,
+ *   SALE OR
+ *   OTHER DISPOSAL OF THE SOFTWARE DOES NOT OR WILL NOT INFRINGE UPON ANY
+ *   PATENT OR
+ *   OTHER RIGHTS NOT VESTED IN YALE.
+ *
+ *   (b) YALE MAKES NO, AND EXPRESSLY DISCLAIMS ALL, REPRESENTATIONS AND
+ *   WARRANTIES
+ *   WHATSOEVER WITH RESPECT TO THE SOFTWARE, EITHER EXPRESS OR IMPLIED,
+ *   INCLUDING,
+ *   BUT NOT LIMITED TO, WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A
+ *   PARTICULAR
+ *   PURPOSE.
+ *
+ *   (c) LICENSEE SHALL MAKE NO STATEMENTS, REPRESENTATION OR WARRANTIES
+ *   WHATSOEVER TO
+ *   ANY THIRD PARTIES THAT ARE INCONSISTENT WITH THE DISCLAIMERS BY YALE IN
+ *   ARTICLE
+ *   (a) AND (b) above.
+ *
+ *   (d) IN NO EVENT SHALL YALE, OR ITS TRUSTEES, DIRECTORS, OFFICERS,
+ *   EMPLOYEES AND
+ *   AFFILIATES BE LIABLE FOR DAMAGES OF ANY KIND, INCLUDING ECONOMIC DAMAGE OR
+ *   INJURY TO PROPERTY AND LOST PROFITS, REGARDLESS OF WHETHER YALE SHALL BE
+ *   ADVISED, SHALL HAVE OTHER REASON TO KNOW, OR IN FACT SHALL KNOW OF THE
+ *   POSSIBILITY OF THE FOREGOING.
+ *
+ */
+/* ----------------------------------------------------------------- 
+FILE:	    analytic.c                                       
+DESCRIPTION:analytic initial placement of the standard cells.
+	    The wirelength is modeled as a quadratic (clique nets,
+	    star nets above CLIQUE_LIMIT pins) and minimized with a
+	    preconditioned conjugate gradient solver.  The solution
+	    is spread onto the rows by recursive bisection of the
+	    row area, and the spread positions pull the next solve
+	    with a growing weight.  The best spread placement becomes
+	    the starting point for annealing.
+CONTENTS:   BOOL analytic_placement( movable )
+		BOOL *movable ;
+DATE:	    Oct 17, 2026 
+REVISIONS:  
+----------------------------------------------------------------- */
+#ifndef VMS
+#ifndef lint
+static char SccsId[] = "@(#) analytic.c version 1.0 10/17/26" ;
+#endif
+#endif
+
+#include "standard.h"
+#include "main.h"
+#include "readpar.h"
+#include "pads.h"
+#include <yalecad/message.h>
+#include <yalecad/debug.h>
+#include <yalecad/quicksort.h>
+
+#define CLIQUE_LIMIT   8	/* larger nets get a star node */
+#define NUM_PASSES    16	/* solve and spread passes */
+#define CG_LIMIT     500	/* conjugate gradient iterations */
+#define CG_TOLERANCE 1.0e-6	/* relative residual to stop at */
+#define ANCHOR_START 0.01	/* pull of the spread placement */
+#define ANCHOR_GROWTH 1.6
+#define EPSILON   1.0e-4	/* keeps the system positive definite */
+
+/* global references */
+extern INT extra_cellsG ;
+
+/* one pin of a net that is attached to a fixed cell */
+typedef struct fixed_term {
+    INT var ;			/* the variable it pulls on */
+    INT cell ;			/* the fixed cell */
+    DOUBLE weight ;
+} FIXEDTERM ;
+
+/* static variables */
+static INT numvarS ;		/* cells being placed */
+static INT numnodeS ;		/* cells plus star nodes */
+static INT *cellS ;		/* variable -> cell */
+static INT *varS ;		/* cell -> variable, -1 if fixed */
+static INT *startS ;		/* compressed rows of the net graph */
+static INT *colS ;
+static DOUBLE *valS ;
+static DOUBLE *diagS ;		/* net part of the diagonal */
+static FIXEDTERM *fixedS ;
+static INT numfixedS ;
+static DOUBLE *xS, *yS ;	/* quadratic solution */
+static DOUBLE *sxS, *syS ;	/* spread solution */
+static INT *srowS ;		/* row of the spread solution */
+static INT *rowsS ;		/* rows in order of y */
+static DOUBLE *keyS ;		/* sort key for spread */
+static DOUBLE xcenterS, ycenterS ;
+
+static build_system() ;
+static solve() ;
+static spread() ;
+static bisect() ;
+static DOUBLE capacity() ;
+static DOUBLE spread_wirelength() ;
+static INT compare_var() ;
+static install() ;
+static set_pins() ;
+
+
+BOOL analytic_placement( movable )
+BOOL *movable ;
+{
+    INT cell, var, pass, row, best_pass ;
+    DOUBLE anchor, wire, best_wire ;
+    DOUBLE *bestx ;
+    INT *bestrow ;
+    CBOXPTR ptr ;
+
+    /* the spreading only knows horizontal rows without classes */
+    for( row = 1 ; row <= numRowsG ; row++ ) {
+	if( barrayG[row]->borient <= 0 ) {
+	    return( FALSE ) ;
+	}
+    }
+    numvarS = 0 ;
+    varS = (INT *) Ysafe_malloc( (lastpadG + 1) * sizeof(INT) ) ;
+    cellS = (INT *) Ysafe_malloc( (numcellsG + 1) * sizeof(INT) ) ;
+    for( cell = 1 ; cell <= lastpadG ; cell++ ) {
+	varS[cell] = -1 ;
+	if( cell > numcellsG - extra_cellsG || !(movable[cell]) ) {
+	    continue ;
+	}
+	ptr = carrayG[cell] ;
+	if( ptr->cclass != 0 || ptr->fence ) {
+	    Ysafe_free( varS ) ;
+	    Ysafe_free( cellS ) ;
+	    return( FALSE ) ;
+	}
+	cellS[numvarS] = cell ;
+	varS[cell] = numvarS++ ;
+    }
+    if( numvarS < 2 ) {
+	Ysafe_free( varS ) ;
+	Ysafe_free( cellS ) ;
+	return( FALSE ) ;
+    }
+
+    /* rows bottom to top */
+    rowsS = (INT *) Ysafe_malloc( numRowsG * sizeof(INT) ) ;
+    keyS = (DOUBLE *) Ysafe_malloc( (numRowsG + 1) * sizeof(DOUBLE) ) ;
+    for( row = 1 ; row <= numRowsG ; row++ ) {
+	rowsS[row-1] = row ;
+	keyS[row] = (DOUBLE) barrayG[row]->bycenter ;
+    }
+    Yquicksort( (char *) rowsS, numRowsG, sizeof(INT), compare_var ) ;
+    Ysafe_free( keyS ) ;
+
+    xcenterS = ycenterS = 0.0 ;
+    for( row = 1 ; row <= numRowsG ; row++ ) {
+	xcenterS += (DOUBLE) (barrayG[row]->bxcenter + barrayG[row]->bleft) +
+		    (DOUBLE) barrayG[row]->desire / 2.0 ;
+	ycenterS += (DOUBLE) barrayG[row]->bycenter ;
+    }
+    xcenterS /= (DOUBLE) numRowsG ;
+    ycenterS /= (DOUBLE) numRowsG ;
+
+    build_system() ;
+
+    xS = (DOUBLE *) Ysafe_malloc( numnodeS * sizeof(DOUBLE) ) ;
+    yS = (DOUBLE *) Ysafe_malloc( numnodeS * sizeof(DOUBLE) ) ;
+    sxS = (DOUBLE *) Ysafe_malloc( numvarS * sizeof(DOUBLE) ) ;
+    syS = (DOUBLE *) Ysafe_malloc( numvarS * sizeof(DOUBLE) ) ;
+    srowS = (INT *) Ysafe_malloc( numvarS * sizeof(INT) ) ;
+    keyS = (DOUBLE *) Ysafe_malloc( numnodeS * sizeof(DOUBLE) ) ;
+    bestx = (DOUBLE *) Ysafe_malloc( numvarS * sizeof(DOUBLE) ) ;
+    bestrow = (INT *) Ysafe_malloc( numvarS * sizeof(INT) ) ;
+    for( var = 0 ; var < numnodeS ; var++ ) {
+	xS[var] = xcenterS ;
+	yS[var] = ycenterS ;
+    }
+    /* the pads were placed before any pin had a position */
+    for( cell = 1 ; cell <= numcellsG - extra_cellsG ; cell++ ) {
+	set_pins( carrayG[cell] ) ;
+    }
+    placepads() ;
+
+    /* ------------------------------------------------------------
+       The first pass is pure wirelength pulled only by the fixed
+       cells.  Every later pass also pulls each cell toward where
+       the previous pass spread it, harder each time, so the
+       solution moves toward a placement that fits the rows.
+       ------------------------------------------------------------ */
+    best_wire = -1.0 ;
+    best_pass = 0 ;
+    anchor = 0.0 ;
+    for( pass = 1 ; pass <= NUM_PASSES ; pass++ ) {
+	solve( xS, anchor, TRUE ) ;
+	solve( yS, anchor, FALSE ) ;
+	spread() ;
+
+	/* let the pads follow the cells */
+	install( sxS, srowS ) ;
+	placepads() ;
+
+	wire = spread_wirelength() ;
+	D( "twsc/analytic",
+	    fprintf( stderr, "analytic pass %d anchor %g wire %g\n",
+		pass, anchor, wire ) ;
+	) ;
+	if( best_wire < 0.0 || wire < best_wire ) {
+	    best_wire = wire ;
+	    best_pass = pass ;
+	    for( var = 0 ; var < numvarS ; var++ ) {
+		bestx[var] = sxS[var] ;
+		bestrow[var] = srowS[var] ;
+	    }
+	}
+	anchor = (pass == 1) ? ANCHOR_START : anchor * ANCHOR_GROWTH ;
+    }
+    install( bestx, bestrow ) ;
+    sprintf( YmsgG, "analytic placement of %d cells: wirelength %g (pass %d)\n",
+	numvarS, best_wire, best_pass ) ;
+    M( MSG, NULL, YmsgG ) ;
+
+    Ysafe_free( bestx ) ;
+    Ysafe_free( bestrow ) ;
+    Ysafe_free( keyS ) ;
+    Ysafe_free( srowS ) ;
+    Ysafe_free( syS ) ;
+    Ysafe_free( sxS ) ;
+    Ysafe_free( yS ) ;
+    Ysafe_free( xS ) ;
+    Ysafe_free( fixedS ) ;
+    Ysafe_free( diagS ) ;
+    Ysafe_free( valS ) ;
+    Ysafe_free( colS ) ;
+    Ysafe_free( startS ) ;
+    Ysafe_free( rowsS ) ;
+    Ysafe_free( cellS ) ;
+    Ysafe_free( varS ) ;
+    return( TRUE ) ;
+
+} /* end analytic_placement */
+
+
+/* ----------------------------------------------------------------- 
+   Build the net graph once.  Edges between two variables go into a
+   compressed sparse row matrix; edges to fixed cells only add to the
+   diagonal and are kept in a list, since the pads move between
+   passes.
+----------------------------------------------------------------- */
+static build_system()
+{
+    INT net, n, i, j, k, a, b, p, star, numedge, maxedge ;
+    INT *nodes, *from, *to, *count ;
+    INT *fixed, numfix, maxfixed ;
+    DOUBLE w, *weight ;
+    PINBOXPTR pin ;
+    DBOXPTR dimptr ;
+
+    /* count the star nodes and size the edge lists */
+    numnodeS = numvarS ;
+    maxedge = 0 ;
+    maxfixed = 0 ;
+    for( net = 1 ; net <= numnetsG ; net++ ) {
+	dimptr = netarrayG[net] ;
+	if( dimptr->ignore == 1 ) {
+	    continue ;
+	}
+	p = 0 ;
+	for( pin = dimptr->pins ; pin ; pin = pin->next ) {
+	    p++ ;
+	}
+	if( p > CLIQUE_LIMIT ) {
+	    numnodeS++ ;
+	    maxedge += p ;
+	} else {
+	    maxedge += p * (p - 1) / 2 ;
+	}
+	maxfixed += (p > CLIQUE_LIMIT) ? p : p * (p - 1) ;
+    }
+    nodes = (INT *) Ysafe_malloc( (numcellsG + lastpadG + 1) * sizeof(INT) ) ;
+    fixed = nodes + numcellsG + 1 ;
+    from = (INT *) Ysafe_malloc( (maxedge + 1) * sizeof(INT) ) ;
+    to = (INT *) Ysafe_malloc( (maxedge + 1) * sizeof(INT) ) ;
+    weight = (DOUBLE *) Ysafe_malloc( (maxedge + 1) * sizeof(DOUBLE) ) ;
+    fixedS = (FIXEDTERM *) Ysafe_malloc( (maxfixed + 1) * sizeof(FIXEDTERM) ) ;
+    diagS = (DOUBLE *) Ysafe_calloc( numnodeS, sizeof(DOUBLE) ) ;
+
+    numedge = 0 ;
+    numfixedS = 0 ;
+    star = numvarS ;
+    for( net = 1 ; net <= numnetsG ; net++ ) {
+	dimptr = netarrayG[net] ;
+	if( dimptr->ignore == 1 ) {
+	    continue ;
+	}
+	/* the distinct cells on the net, movable then fixed */
+	n = numfix = 0 ;
+	for( pin = dimptr->pins ; pin ; pin = pin->next ) {
+	    a = pin->cell ;
+	    if( a > numcellsG - extra_cellsG && a <= numcellsG ) {
+		continue ;
+	    }
+	    if( varS[a] >= 0 ) {
+		for( i = 0 ; i < n && nodes[i] != varS[a] ; i++ ) ;
+		if( i == n ) {
+		    nodes[n++] = varS[a] ;
+		}
+	    } else {
+		for( i = 0 ; i < numfix && fixed[i] != a ; i++ ) ;
+		if( i == numfix ) {
+		    fixed[numfix++] = a ;
+		}
+	    }
+	}
+	p = n + numfix ;
+	if( p < 2 || n == 0 ) {
+	    continue ;
+	}
+	if( p > CLIQUE_LIMIT ) {
+	    /* a star of weight p / (p-1) equals the clique below */
+	    w = (DOUBLE) p / (DOUBLE) (p - 1) ;
+	    for( i = 0 ; i < n ; i++ ) {
+		from[numedge] = nodes[i] ;
+		to[numedge] = star ;
+		weight[numedge++] = w ;
+	    }
+	    for( i = 0 ; i < numfix ; i++ ) {
+		fixedS[numfixedS].var = star ;
+		fixedS[numfixedS].cell = fixed[i] ;
+		fixedS[numfixedS++].weight = w ;
+	    }
+	    star++ ;
+	} else {
+	    w = 1.0 / (DOUBLE) (p - 1) ;
+	    for( i = 0 ; i < n ; i++ ) {
+		for( j = i + 1 ; j < n ; j++ ) {
+		    from[numedge] = nodes[i] ;
+		    to[numedge] = nodes[j] ;
+		    weight[numedge++] = w ;
+		}
+		for( j = 0 ; j < numfix ; j++ ) {
+		    fixedS[numfixedS].var = nodes[i] ;
+		    fixedS[numfixedS].cell = fixed[j] ;
+		    fixedS[numfixedS++].weight = w ;
+		}
+	    }
+	}
+    }
+
+    /* compressed rows; duplicate entries are simply added by the */
+    /* multiply so they need not be merged.                       */
+    count = (INT *) Ysafe_calloc( numnodeS + 1, sizeof(INT) ) ;
+    for( k = 0 ; k < numedge ; k++ ) {
+	count[from[k]]++ ;
+	count[to[k]]++ ;
+	diagS[from[k]] += weight[k] ;
+	diagS[to[k]] += weight[k] ;
+    }
+    for( k = 0 ; k < numfixedS ; k++ ) {
+	diagS[fixedS[k].var] += fixedS[k].weight ;
+    }
+    startS = (INT *) Ysafe_malloc( (numnodeS + 1) * sizeof(INT) ) ;
+    startS[0] = 0 ;
+    for( i = 0 ; i < numnodeS ; i++ ) {
+	startS[i+1] = startS[i] + count[i] ;
+	count[i] = startS[i] ;
+    }
+    colS = (INT *) Ysafe_malloc( (2 * numedge + 1) * sizeof(INT) ) ;
+    valS = (DOUBLE *) Ysafe_malloc( (2 * numedge + 1) * sizeof(DOUBLE) ) ;
+    for( k = 0 ; k < numedge ; k++ ) {
+	a = from[k] ;
+	b = to[k] ;
+	colS[count[a]] = b ;
+	valS[count[a]++] = - weight[k] ;
+	colS[count[b]] = a ;
+	valS[count[b]++] = - weight[k] ;
+    }
+    Ysafe_free( count ) ;
+    Ysafe_free( weight ) ;
+    Ysafe_free( to ) ;
+    Ysafe_free( from ) ;
+    Ysafe_free( nodes ) ;
+
+} /* end build_system */
+
+
+/* ----------------------------------------------------------------- 
+   Solve one coordinate with Jacobi preconditioned conjugate
+   gradients, starting from the previous solution.  The spread
+   positions of the last pass act as fixed pins of weight anchor.
+----------------------------------------------------------------- */
+static solve( x, anchor, horizontal )
+DOUBLE *x, anchor ;
+BOOL horizontal ;
+{
+    INT i, k, iter ;
+    DOUBLE *b, *d, *r, *z, *p, *q ;
+    DOUBLE rz, rz_new, alpha, bnorm, rnorm, pos, center ;
+    DOUBLE *spread_pos ;
+    CBOXPTR ptr ;
+
+    b = (DOUBLE *) Ysafe_malloc( 6 * numnodeS * sizeof(DOUBLE) ) ;
+    d = b + numnodeS ;
+    r = d + numnodeS ;
+    z = r + numnodeS ;
+    p = z + numnodeS ;
+    q = p + numnodeS ;
+    spread_pos = horizontal ? sxS : syS ;
+    center = horizontal ? xcenterS : ycenterS ;
+
+    for( i = 0 ; i < numnodeS ; i++ ) {
+	d[i] = diagS[i] + EPSILON ;
+	b[i] = EPSILON * center ;
+	if( i < numvarS && anchor > 0.0 ) {
+	    d[i] += anchor ;
+	    b[i] += anchor * spread_pos[i] ;
+	}
+    }
+    for( k = 0 ; k < numfixedS ; k++ ) {
+	ptr = carrayG[fixedS[k].cell] ;
+	pos = horizontal ? (DOUBLE) ptr->cxcenter : (DOUBLE) ptr->cycenter ;
+	b[fixedS[k].var] += fixedS[k].weight * pos ;
+    }
+
+    /* r = b - A x */
+    bnorm = 0.0 ;
+    for( i = 0 ; i < numnodeS ; i++ ) {
+	q[i] = d[i] * x[i] ;
+	for( k = startS[i] ; k < startS[i+1] ; k++ ) {
+	    q[i] += valS[k] * x[colS[k]] ;
+	}
+	r[i] = b[i] - q[i] ;
+	z[i] = r[i] / d[i] ;
+	p[i] = z[i] ;
+	bnorm += b[i] * b[i] ;
+    }
+    rz = 0.0 ;
+    for( i = 0 ; i < numnodeS ; i++ ) {
+	rz += r[i] * z[i] ;
+    }
+    bnorm = sqrt( bnorm ) ;
+
+    for( iter = 0 ; iter < CG_LIMIT ; iter++ ) {
+	alpha = 0.0 ;
+	for( i = 0 ; i < numnodeS ; i++ ) {
+	    q[i] = d[i] * p[i] ;
+	    for( k = startS[i] ; k < startS[i+1] ; k++ ) {
+		q[i] += valS[k] * p[colS[k]] ;
+	    }
+	    alpha += p[i] * q[i] ;
+	}
+	if( alpha <= 0.0 ) {
+	    break ;
+	}
+	alpha = rz / alpha ;
+	rnorm = 0.0 ;
+	for( i = 0 ; i < numnodeS ; i++ ) {
+	    x[i] += alpha * p[i] ;
+	    r[i] -= alpha * q[i] ;
+	    rnorm += r[i] * r[i] ;
+	}
+	if( sqrt( rnorm ) <= CG_TOLERANCE * bnorm ) {
+	    break ;
+	}
+	rz_new = 0.0 ;
+	for( i = 0 ; i < numnodeS ; i++ ) {
+	    z[i] = r[i] / d[i] ;
+	    rz_new += r[i] * z[i] ;
+	}
+	for( i = 0 ; i < numnodeS ; i++ ) {
+	    p[i] = z[i] + (rz_new / rz) * p[i] ;
+	}
+	rz = rz_new ;
+    }
+    Ysafe_free( b ) ;
+
+} /* end solve */
+
+
+/* ----------------------------------------------------------------- 
+   Spread the quadratic solution over the rows.  A region of rows is
+   cut in two, across its longer side, and the cells are divided in
+   their order along the cut so that each half is filled in
+   proportion to its row length.  A single row is packed in x order.
+----------------------------------------------------------------- */
+static spread()
+{
+    INT var, *list ;
+    DOUBLE xlo, xhi, l, r ;
+    INT row ;
+
+    xlo = DBL_MAX ;
+    xhi = - DBL_MAX ;
+    for( row = 1 ; row <= numRowsG ; row++ ) {
+	l = (DOUBLE) (barrayG[row]->bxcenter + barrayG[row]->bleft) ;
+	r = l + (DOUBLE) barrayG[row]->desire ;
+	xlo = MIN( xlo, l ) ;
+	xhi = MAX( xhi, r ) ;
+    }
+    list = (INT *) Ysafe_malloc( numvarS * sizeof(INT) ) ;
+    for( var = 0 ; var < numvarS ; var++ ) {
+	list[var] = var ;
+    }
+    bisect( list, numvarS, 0, numRowsG - 1, xlo, xhi ) ;
+    Ysafe_free( list ) ;
+
+} /* end spread */
+
+
+static bisect( list, n, rlo, rhi, xlo, xhi )
+INT *list, n, rlo, rhi ;
+DOUBLE xlo, xhi ;
+{
+    INT i, var, split, rmid, row ;
+    DOUBLE width, total, c1, c2, xmid, height, used, gap, l, r ;
+    BOOL across ;
+    CBOXPTR ptr ;
+
+    if( n <= 0 ) {
+	return ;
+    }
+    if( rlo == rhi ) {
+	/* pack the row segment in x order */
+	row = rowsS[rlo] ;
+	l = (DOUBLE) (barrayG[row]->bxcenter + barrayG[row]->bleft) ;
+	r = l + (DOUBLE) barrayG[row]->desire ;
+	l = MAX( l, xlo ) ;
+	r = MIN( r, xhi ) ;
+	total = 0.0 ;
+	for( i = 0 ; i < n ; i++ ) {
+	    keyS[list[i]] = xS[list[i]] ;
+	    ptr = carrayG[cellS[list[i]]] ;
+	    total += (DOUBLE) (ptr->tileptr->right - ptr->tileptr->left) ;
+	}
+	Yquicksort( (char *) list, n, sizeof(INT), compare_var ) ;
+	gap = (r - l > total) ? (r - l - total) / (DOUBLE) n : 0.0 ;
+	used = l ;
+	for( i = 0 ; i < n ; i++ ) {
+	    var = list[i] ;
+	    ptr = carrayG[cellS[var]] ;
+	    width = (DOUBLE) (ptr->tileptr->right - ptr->tileptr->left) ;
+	    sxS[var] = used + gap / 2.0 + width / 2.0 ;
+	    syS[var] = (DOUBLE) barrayG[row]->bycenter ;
+	    srowS[var] = row ;
+	    used += width + gap ;
+	}
+	return ;
+    }
+
+    /* cut across the longer side of the region */
+    height = (DOUBLE) (barrayG[rowsS[rhi]]->bycenter -
+				barrayG[rowsS[rlo]]->bycenter) ;
+    height += height / (DOUBLE) (rhi - rlo) ;
+    across = (xhi - xlo > height) ;
+    if( across ) {
+	xmid = (xlo + xhi) / 2.0 ;
+	c1 = capacity( rlo, rhi, xlo, xmid ) ;
+	c2 = capacity( rlo, rhi, xmid, xhi ) ;
+    } else {
+	rmid = (rlo + rhi) / 2 ;
+	c1 = capacity( rlo, rmid, xlo, xhi ) ;
+	c2 = capacity( rmid + 1, rhi, xlo, xhi ) ;
+    }
+    total = 0.0 ;
+    for( i = 0 ; i < n ; i++ ) {
+	var = list[i] ;
+	keyS[var] = across ? xS[var] : yS[var] ;
+	ptr = carrayG[cellS[var]] ;
+	total += (DOUBLE) (ptr->tileptr->right - ptr->tileptr->left) ;
+    }
+    Yquicksort( (char *) list, n, sizeof(INT), compare_var ) ;
+    if( c1 + c2 > 0.0 ) {
+	total *= c1 / (c1 + c2) ;
+    }
+    used = 0.0 ;
+    for( split = 0 ; split < n && used < total ; split++ ) {
+	ptr = carrayG[cellS[list[split]]] ;
+	width = (DOUBLE) (ptr->tileptr->right - ptr->tileptr->left) ;
+	if( used + width / 2.0 > total ) {
+	    break ;
+	}
+	used += width ;
+    }
+    if( across ) {
+	bisect( list, split, rlo, rhi, xlo, xmid ) ;
+	bisect( list + split, n - split, rlo, rhi, xmid, xhi ) ;
+    } else {
+	bisect( list, split, rlo, rmid, xlo, xhi ) ;
+	bisect( list + split, n - split, rmid + 1, rhi, xlo, xhi ) ;
+    }
+
+} /* end bisect */
+
+
+/* row length available to cells between xlo and xhi */
+static DOUBLE capacity( rlo, rhi, xlo, xhi )
+INT rlo, rhi ;
+DOUBLE xlo, xhi ;
+{
+    INT i, row ;
+    DOUBLE l, r, sum ;
+
+    sum = 0.0 ;
+    for( i = rlo ; i <= rhi ; i++ ) {
+	row = rowsS[i] ;
+	l = (DOUBLE) (barrayG[row]->bxcenter + barrayG[row]->bleft) ;
+	r = l + (DOUBLE) barrayG[row]->desire ;
+	l = MAX( l, xlo ) ;
+	r = MIN( r, xhi ) ;
+	if( r > l ) {
+	    sum += r - l ;
+	}
+    }
+    return( sum ) ;
+
+} /* end capacity */
+
+
+/* order variables by keyS, then by number so the order is stable */
+static INT compare_var( a, b )
+INT *a, *b ;
+{
+    if( keyS[*a] < keyS[*b] ) {
+	return( -1 ) ;
+    } else if( keyS[*a] > keyS[*b] ) {
+	return( 1 ) ;
+    }
+    return( *a - *b ) ;
+
+} /* end compare_var */
+
+
+/* ----------------------------------------------------------------- 
+   Put the cells at a spread placement, with their pins, the same
+   way random_placement() and findcost() do.
+----------------------------------------------------------------- */
+static install( x, row )
+DOUBLE *x ;
+INT *row ;
+{
+    INT var ;
+    CBOXPTR ptr ;
+
+    for( var = 0 ; var < numvarS ; var++ ) {
+	ptr = carrayG[cellS[var]] ;
+	ptr->cblock = row[var] ;
+	ptr->cxcenter = (INT) x[var] ;
+	ptr->cycenter = barrayG[row[var]]->bycenter ;
+	ptr->corient = (barrayG[row[var]]->borient == 2) ? 1 : 0 ;
+	set_pins( ptr ) ;
+    }
+
+} /* end install */
+
+
+static set_pins( ptr )
+CBOXPTR ptr ;
+{
+    INT corient ;
+    PINBOXPTR pin ;
+
+    corient = ptr->corient ;
+    for( pin = ptr->pins ; pin ; pin = pin->nextpin ) {
+	pin->xpos = pin->txpos[corient/2] + ptr->cxcenter ;
+	pin->ypos = pin->typos[corient%2] + ptr->cycenter ;
+    }
+
+} /* end set_pins */
+
+
+/* half perimeter of the nets at the installed placement */
+static DOUBLE spread_wirelength()
+{
+    INT net, cell ;
+    DOUBLE x, y, xmin, xmax, ymin, ymax, sum ;
+    BOOL first ;
+    PINBOXPTR pin ;
+
+    sum = 0.0 ;
+    for( net = 1 ; net <= numnetsG ; net++ ) {
+	if( netarrayG[net]->ignore == 1 ) {
+	    continue ;
+	}
+	first = TRUE ;
+	for( pin = netarrayG[net]->pins ; pin ; pin = pin->next ) {
+	    cell = pin->cell ;
+	    x = (DOUBLE) carrayG[cell]->cxcenter ;
+	    y = (DOUBLE) carrayG[cell]->cycenter ;
+	    if( first ) {
+		xmin = xmax = x ;
+		ymin = ymax = y ;
+		first = FALSE ;
+	    } else {
+		xmin = MIN( xmin, x ) ;
+		xmax = MAX( xmax, x ) ;
+		ymin = MIN( ymin, y ) ;
+		ymax = MAX( ymax, y ) ;
+	    }
+	}
+	if( !first ) {
+	    sum += (xmax - xmin) + (ymax - ymin) ;
+	}
+    }
+    return( sum ) ;
+
+} /* end spread_wirelength */
@@ -62,6 +62,7 @@ static char SccsId[] = "@(#) configure.c (Yale) version 4.12 3/19/91" ;
 #include "pads.h"
 #include "main.h"
 #include "readpar.h"
+#include <yalecad/message.h>
 #include <yalecad/debug.h>
 
 /*  
@@ -80,6 +81,7 @@ extern DOUBLE indentG ;
 extern DOUBLE *relativeLenG ;
 extern DOUBLE *rowSepsG ;
 extern INT *rowSepsAbsG ;
+extern BOOL analytic_placementG ;
 
 /* static definitions */
 static INT heightS ;
@@ -960,6 +962,7 @@ INT block ;
 INT empty ;
 INT *filledTo ;
 INT *endRow ;
+BOOL *movable ;
 CBOXPTR cellptr ;
 
 /*
@@ -1008,7 +1011,9 @@ for( cell = 1 ; cell <= numcellsG - extra_cellsG ; cell++ ) {
 /*
  *  Final pass, place all unassigned cells
  */
+movable = (BOOL *) Ysafe_malloc( (numcellsG + 1) * sizeof( BOOL ) ) ;
 for( cell = 1 ; cell <= numcellsG - extra_cellsG ; cell++ ) {
+    movable[cell] = (carrayG[cell]->cblock == 0) ;
     if( carrayG[cell]->cblock != 0 ) {
 	continue ;
     }
@@ -1046,6 +1051,18 @@ for( cell = 1 ; cell <= numcellsG - extra_cellsG ; cell++ ) {
 }
 /* now finish by placing the pads */
 placepads() ;
+
+/*
+ *  If asked, replace the random placement of the unassigned
+ *  cells with an analytic one; annealing then starts cool.
+ */
+if( analytic_placementG && !(analytic_placement( movable )) ) {
+    M( WARNMSG, "random_placement",
+	"analytic placement needs horizontal rows and free cells\n" ) ;
+    M( WARNMSG, NULL, "\tusing the random placement\n" ) ;
+    analytic_placementG = FALSE ;
+}
+Ysafe_free( movable ) ;
 return ;
 }
 
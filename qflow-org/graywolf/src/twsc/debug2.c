@@ -572,10 +572,9 @@ check_cost()
 		dimptr->Tnum++ ;
 	    }
 	}
-	cost += dimptr->halfPx = dimptr->newhalfPx = 
-					     dimptr->xmax - dimptr->xmin ;
+	dimptr->halfPx = dimptr->newhalfPx = dimptr->xmax - dimptr->xmin ;
 	dimptr->halfPy = dimptr->newhalfPy = dimptr->ymax - dimptr->ymin ;
-	cost += (INT)( vertical_wire_weightG * (DOUBLE) dimptr->halfPy ) ;
+	cost += NETCOST( net, dimptr->halfPx, dimptr->halfPy ) ;
 
 	ASSERT( xmin == dimptr->xmin, NULL,"trouble\n" ) ;
 	ASSERT( xmax == dimptr->xmax, NULL,"trouble\n" ) ;
@@ -58,11 +58,15 @@ CONTENTS:   new_dbox( antrmptr , costptr )
 		TEBOXPTR antrmptr ;
 	    dbox_pos_swap( antrmptr ) 
 		TEBOXPTR antrmptr ;
+	    pack_net_pins()
 DATE:	    Mar 27, 1989 
 REVISIONS:  May 19, 1989 by Carl --- for gate swaps
 	    Nov  4, 1989 - made memoptr dynamic instead of fixed.
 	    Mon Nov 18 16:28:30 EST 1991 - fixed initialization problem
 		with check_validbound.
+	    Sat Oct 17 2026 - the bounding boxes now read the pin
+		positions from arrays packed net by net.
+	    Sat Oct 17 2026 - wire cost changes use the net weights.
 ----------------------------------------------------------------- */
 #ifndef VMS
 #ifndef lint
@@ -77,6 +81,8 @@ static INT prev_netS , curr_netS , test_newnetS ;
 static INT validLS , validRS , validBS , validTS ;
 static INT kS ;
 static PINBOXPTR *memoptrS ;
+static INT *net_slotS ;		/* first slot of each net */
+static INT num_slotS = 0 ;	/* allocated slots */
 
 init_dimbox()
 {
@@ -89,6 +95,71 @@ init_dimbox()
 } /* end init_dimbox */
 
 
+/* ----------------------------------------------------------------- 
+   Copy the pin positions into arrays with the pins of each net in
+   consecutive slots, so that the bounding box loops below walk
+   memory in order instead of following the net lists.  Only the
+   move routines update the arrays, so this is called at the start
+   of uloop() and upair() to pick up anything done in between.
+----------------------------------------------------------------- */
+pack_net_pins()
+{
+    INT cell , net , slot , count ;
+    PINBOXPTR pin ;
+
+    count = 0 ;
+    for( cell = 1 ; cell <= lastpadG ; cell++ ) {
+	for( pin = carrayG[cell]->pins ; pin ; pin = pin->nextpin ) {
+	    pin->slot = -1 ;
+	    count++ ;
+	}
+    }
+    for( net = 1 ; net <= numnetsG ; net++ ) {
+	for( pin = netarrayG[net]->pins ; pin ; pin = pin->next ) {
+	    count++ ;
+	}
+    }
+    if( count > num_slotS ) {
+	if( num_slotS > 0 ) {
+	    Ysafe_free( pinxG ) ;
+	    Ysafe_free( pinyG ) ;
+	    Ysafe_free( pinnewxG ) ;
+	    Ysafe_free( pinnewyG ) ;
+	    Ysafe_free( pinmovedG ) ;
+	    Ysafe_free( net_slotS ) ;
+	}
+	num_slotS = count ;
+	pinxG = (INT *) Ysafe_malloc( count * sizeof(INT) ) ;
+	pinyG = (INT *) Ysafe_malloc( count * sizeof(INT) ) ;
+	pinnewxG = (INT *) Ysafe_malloc( count * sizeof(INT) ) ;
+	pinnewyG = (INT *) Ysafe_malloc( count * sizeof(INT) ) ;
+	pinmovedG = (char *) Ysafe_malloc( count * sizeof(char) ) ;
+	net_slotS = (INT *) Ysafe_malloc( (numnetsG + 2) * sizeof(INT) ) ;
+    }
+    slot = 0 ;
+    for( net = 1 ; net <= numnetsG ; net++ ) {
+	net_slotS[net] = slot ;
+	for( pin = netarrayG[net]->pins ; pin ; pin = pin->next ) {
+	    pin->slot = slot ;
+	    pinxG[slot] = pin->xpos ;
+	    pinyG[slot] = pin->ypos ;
+	    pinmovedG[slot++] = FALSE ;
+	}
+    }
+    net_slotS[net] = slot ;
+    /* pins on no net still get a slot for the move routines */
+    for( cell = 1 ; cell <= lastpadG ; cell++ ) {
+	for( pin = carrayG[cell]->pins ; pin ; pin = pin->nextpin ) {
+	    if( pin->slot < 0 ) {
+		pin->slot = slot ;
+		pinmovedG[slot++] = FALSE ;
+	    }
+	}
+    }
+
+} /* end pack_net_pins */
+
+
 new_dbox( antrmptr , costptr )
 PINBOXPTR antrmptr ;
 INT *costptr ;
@@ -113,7 +184,7 @@ for( termptr = antrmptr ; termptr ; termptr = termptr->nextpin ) {
     }
     if( dimptr->numpins <= break_pt ) {
 	dimptr->dflag = 0 ;
-	wire_boundary1( dimptr ) ;
+	wire_boundary1( dimptr , curr_netS ) ;
     } else { 
 	check_validbound( dimptr , termptr , nextptr ) ;
 	if( nextptr && curr_netS == nextptr->net ) {
@@ -121,7 +192,7 @@ for( termptr = antrmptr ; termptr ; termptr = termptr->nextpin ) {
 	}
 	dimptr->dflag = 0 ;
 	wire_boundary2( validLS + 2*validBS + 4*validRS + 8*validTS  
-			                             , dimptr ) ;
+			                 , dimptr , curr_netS ) ;
         validRS = validLS = validBS = validTS = 0 ;
     }
     /* add2net_set remembers which nets are modified by this move */
@@ -130,9 +201,9 @@ for( termptr = antrmptr ; termptr ; termptr = termptr->nextpin ) {
     dimptr->newhalfPx = dimptr->newxmax - dimptr->newxmin ; 
     dimptr->newhalfPy = dimptr->newymax - dimptr->newymin ;
 
-    *costptr = *costptr + ( dimptr->newhalfPx - dimptr->halfPx +
-	    (INT)(vertical_wire_weightG * (DOUBLE)dimptr->newhalfPy) -
-	    (INT)(vertical_wire_weightG * (DOUBLE)dimptr->halfPy) );
+    *costptr = *costptr +
+	    NETCOST( curr_netS, dimptr->newhalfPx, dimptr->newhalfPy ) -
+	    NETCOST( curr_netS, dimptr->halfPx, dimptr->halfPy ) ;
 }
 }
 
@@ -207,7 +278,7 @@ for( ; termptr ; termptr = nextptr ) {
     }
     if( dimptr->numpins <= break_pt ) {
 	dimptr->dflag = 0 ;
-	wire_boundary1( dimptr ) ;
+	wire_boundary1( dimptr , curr_netS ) ;
     } else { /* The pin No. of the net is greater than break_pt */
 	check_validbound( dimptr , termptr , nextptr ) ;
 	if( nextptr && curr_netS == nextptr->net ) {
@@ -215,7 +286,7 @@ for( ; termptr ; termptr = nextptr ) {
 	}
 	dimptr->dflag = 0 ;
 	wire_boundary2( validLS + 2*validBS + 4*validRS + 8*validTS  
-			     , dimptr ) ;
+			     , dimptr , curr_netS ) ;
         validRS = validLS = validBS = validTS = 0 ;
     }
     /* add2net_set remembers which nets are modified by this move */
@@ -223,38 +294,38 @@ for( ; termptr ; termptr = nextptr ) {
     dimptr->newhalfPx = dimptr->newxmax - dimptr->newxmin ; 
     dimptr->newhalfPy = dimptr->newymax - dimptr->newymin ;
 
-    *costptr = *costptr + ( dimptr->newhalfPx - dimptr->halfPx +
-	    (INT)(vertical_wire_weightG * (DOUBLE)dimptr->newhalfPy) -
-	    (INT)(vertical_wire_weightG * (DOUBLE)dimptr->halfPy) );
+    *costptr = *costptr +
+	    NETCOST( curr_netS, dimptr->newhalfPx, dimptr->newhalfPy ) -
+	    NETCOST( curr_netS, dimptr->halfPx, dimptr->halfPy ) ;
 }
 }
 
 
-wire_boundary1( dimptr )
+wire_boundary1( dimptr , net )
 DBOXPTR dimptr ;
+INT net ;
 {
 
-PINBOXPTR netptr ;
-INT x , y ;
+INT x , y , s , last ;
 
-if( netptr = dimptr->pins ) {
-    if( netptr->flag == 1 ) {
-	dimptr->newxmin = dimptr->newxmax = netptr->newx ;
-	dimptr->newymin = dimptr->newymax = netptr->newy ;
-	netptr->flag = 0 ;
-    } else {
-	dimptr->newxmin = dimptr->newxmax = netptr->xpos ;
-	dimptr->newymin = dimptr->newymax = netptr->ypos ;
-    }
+s = net_slotS[net] ;
+last = net_slotS[net+1] ;
+if( pinmovedG[s] ) {
+    dimptr->newxmin = dimptr->newxmax = pinnewxG[s] ;
+    dimptr->newymin = dimptr->newymax = pinnewyG[s] ;
+    pinmovedG[s] = FALSE ;
+} else {
+    dimptr->newxmin = dimptr->newxmax = pinxG[s] ;
+    dimptr->newymin = dimptr->newymax = pinyG[s] ;
 }
-for( netptr = netptr->next ; netptr; netptr = netptr->next ) {
-    if( netptr->flag == 1 ) {
-	x = netptr->newx ;
-	y = netptr->newy ;
-	netptr->flag = 0 ;
+for( s++ ; s < last ; s++ ) {
+    if( pinmovedG[s] ) {
+	x = pinnewxG[s] ;
+	y = pinnewyG[s] ;
+	pinmovedG[s] = FALSE ;
     } else {
-	x = netptr->xpos ;
-	y = netptr->ypos ;
+	x = pinxG[s] ;
+	y = pinyG[s] ;
     }
     if( x < dimptr->newxmin ) {
 	dimptr->newxmin = x ;
@@ -355,136 +426,85 @@ if( nextptr == PINNULL || curr_netS != nextptr->net ) {
 }
 }
 
-wire_boundary2( c , dimptr )
+wire_boundary2( c , dimptr , net )
 DBOXPTR dimptr ;
-INT c ;
+INT c , net ;
 {
 
-PINBOXPTR netptr ;
-INT x , y , i ;
+INT x , y , i , s , last ;
 
 if( c == 15 ) {
     for( i = 0 ; i <= kS-1 ; i++ ) {
-        memoptrS[i]->flag = 0 ;
+        pinmovedG[ memoptrS[i]->slot ] = FALSE ;
     }
     return ;
 }
-if( netptr = dimptr->pins ) {
-    if( netptr->flag == 1 ) {
-	netptr->flag = 0 ;
-	switch( c ) {
-	case  0 :  /* L , R , B , T false */
-	    dimptr->newxmin = dimptr->newxmax = netptr->newx ;
-	    dimptr->newymin = dimptr->newymax = netptr->newy ;
-	    break ;
-	case  1 :  /* R , B , T false */
-	    dimptr->newxmax = netptr->newx ;
-	    dimptr->newymin = dimptr->newymax = netptr->newy ;
-	    break ;
-	case  2 :  /* L , R , T false */
-	    dimptr->newxmin = dimptr->newxmax = netptr->newx ;
-	    dimptr->newymax = netptr->newy ;
-	    break ;
-	case  3 :  /* R , T false */
-	    dimptr->newxmax = netptr->newx ;
-	    dimptr->newymax = netptr->newy ;
-	    break ;
-	case  4 :  /* L , B , T false */
-	    dimptr->newxmin = netptr->newx ;
-	    dimptr->newymin = dimptr->newymax = netptr->newy ;
-	    break ;
-	case  5 :  /* B , T false */
-	    dimptr->newymin = dimptr->newymax = netptr->newy ;
-	    break ;
-	case  6 :  /* L , T false */
-	    dimptr->newxmin = netptr->newx ;
-	    dimptr->newymax = netptr->newy ;
-	    break ;
-	case  7 :  /* T false */
-	    dimptr->newymax = netptr->newy ;
-	    break ;
-	case  8 :  /* L , R , B false */
-	    dimptr->newxmin = dimptr->newxmax = netptr->newx ;
-	    dimptr->newymin = netptr->newy ;
-	    break ;
-	case  9 :  /* R , B false */
-	    dimptr->newxmax = netptr->newx ;
-	    dimptr->newymin = netptr->newy ;
-	    break ;
-	case 10 :  /* L , R false */
-	    dimptr->newxmin = dimptr->newxmax = netptr->newx ;
-	    break ;
-	case 11 :  /* R false */
-	    dimptr->newxmax = netptr->newx ;
-	    break ;
-	case 12 :  /* L , B false */
-	    dimptr->newxmin = netptr->newx ;
-	    dimptr->newymin = netptr->newy ;
-	    break ;
-	case 13 :  /* B false */
-	    dimptr->newymin = netptr->newy ;
-	    break ;
-	case 14 :  /* L false */
-	    dimptr->newxmin = netptr->newx ;
-	    break ;
-	}
+s = net_slotS[net] ;
+last = net_slotS[net+1] ;
+if( s < last ) {
+    if( pinmovedG[s] ) {
+	x = pinnewxG[s] ;
+	y = pinnewyG[s] ;
+	pinmovedG[s] = FALSE ;
     } else {
-	switch( c ) {
-	case  0 :  /* L , R , B , T false */
-	    dimptr->newxmin = dimptr->newxmax = netptr->xpos ;
-	    dimptr->newymin = dimptr->newymax = netptr->ypos ;
-	    break ;
-	case  1 :  /* R , B , T false */
-	    dimptr->newxmax = netptr->xpos ;
-	    dimptr->newymin = dimptr->newymax = netptr->ypos ;
-	    break ;
-	case  2 :  /* L , R , T false */
-	    dimptr->newxmin = dimptr->newxmax = netptr->xpos ;
-	    dimptr->newymax = netptr->ypos ;
-	    break ;
-	case  3 :  /* R , T false */
-	    dimptr->newxmax = netptr->xpos ;
-	    dimptr->newymax = netptr->ypos ;
-	    break ;
-	case  4 :  /* L , B , T false */
-	    dimptr->newxmin = netptr->xpos ;
-	    dimptr->newymin = dimptr->newymax = netptr->ypos ;
-	    break ;
-	case  5 :  /* B , T false */
-	    dimptr->newymin = dimptr->newymax = netptr->ypos ;
-	    break ;
-	case  6 :  /* L , T false */
-	    dimptr->newxmin = netptr->xpos ;
-	    dimptr->newymax = netptr->ypos ;
-	    break ;
-	case  7 :  /* T false */
-	    dimptr->newymax = netptr->ypos ;
-	    break ;
-	case  8 :  /* L , R , B false */
-	    dimptr->newxmin = dimptr->newxmax = netptr->xpos ;
-	    dimptr->newymin = netptr->ypos ;
-	    break ;
-	case  9 :  /* R , B false */
-	    dimptr->newxmax = netptr->xpos ;
-	    dimptr->newymin = netptr->ypos ;
-	    break ;
-	case 10 :  /* L , R false */
-	    dimptr->newxmin = dimptr->newxmax = netptr->xpos ;
-	    break ;
-	case 11 :  /* R false */
-	    dimptr->newxmax = netptr->xpos ;
-	    break ;
-	case 12 :  /* L , B false */
-	    dimptr->newxmin = netptr->xpos ;
-	    dimptr->newymin = netptr->ypos ;
-	    break ;
-	case 13 :  /* B false */
-	    dimptr->newymin = netptr->ypos ;
-	    break ;
-	case 14 :  /* L false */
-	    dimptr->newxmin = netptr->xpos ;
-	    break ;
-	}
+	x = pinxG[s] ;
+	y = pinyG[s] ;
+    }
+    switch( c ) {
+    case  0 :  /* L , R , B , T false */
+	dimptr->newxmin = dimptr->newxmax = x ;
+	dimptr->newymin = dimptr->newymax = y ;
+	break ;
+    case  1 :  /* R , B , T false */
+	dimptr->newxmax = x ;
+	dimptr->newymin = dimptr->newymax = y ;
+	break ;
+    case  2 :  /* L , R , T false */
+	dimptr->newxmin = dimptr->newxmax = x ;
+	dimptr->newymax = y ;
+	break ;
+    case  3 :  /* R , T false */
+	dimptr->newxmax = x ;
+	dimptr->newymax = y ;
+	break ;
+    case  4 :  /* L , B , T false */
+	dimptr->newxmin = x ;
+	dimptr->newymin = dimptr->newymax = y ;
+	break ;
+    case  5 :  /* B , T false */
+	dimptr->newymin = dimptr->newymax = y ;
+	break ;
+    case  6 :  /* L , T false */
+	dimptr->newxmin = x ;
+	dimptr->newymax = y ;
+	break ;
+    case  7 :  /* T false */
+	dimptr->newymax = y ;
+	break ;
+    case  8 :  /* L , R , B false */
+	dimptr->newxmin = dimptr->newxmax = x ;
+	dimptr->newymin = y ;
+	break ;
+    case  9 :  /* R , B false */
+	dimptr->newxmax = x ;
+	dimptr->newymin = y ;
+	break ;
+    case 10 :  /* L , R false */
+	dimptr->newxmin = dimptr->newxmax = x ;
+	break ;
+    case 11 :  /* R false */
+	dimptr->newxmax = x ;
+	break ;
+    case 12 :  /* L , B false */
+	dimptr->newxmin = x ;
+	dimptr->newymin = y ;
+	break ;
+    case 13 :  /* B false */
+	dimptr->newymin = y ;
+	break ;
+    case 14 :  /* L false */
+	dimptr->newxmin = x ;
+	break ;
     }
 }
 if( !validLS ) {
@@ -499,14 +519,14 @@ if( !validBS ) {
 if( !validTS ) {
     dimptr->newTnum = 1 ;
 }
-for( netptr = netptr->next ; netptr; netptr = netptr->next ) {
-    if( netptr->flag == 1 ) {
-	x = netptr->newx ;
-	y = netptr->newy ;
-	netptr->flag = 0 ;
+for( s++ ; s < last ; s++ ) {
+    if( pinmovedG[s] ) {
+	x = pinnewxG[s] ;
+	y = pinnewyG[s] ;
+	pinmovedG[s] = FALSE ;
     } else {
-	x = netptr->xpos ;
-	y = netptr->ypos ;
+	x = pinxG[s] ;
+	y = pinyG[s] ;
     }
     switch( c ) {
     case  0 :  /* L , R , B , T false */
@@ -772,8 +792,8 @@ for( termptr = antrmptr ; termptr != PINNULL;termptr=termptr->nextpin ) {
 	dimptr->Bnum = dimptr->newBnum ;
 	dimptr->Tnum = dimptr->newTnum ;
     }
-    termptr->xpos = termptr->newx ;
-    termptr->ypos = termptr->newy ;
+    pinxG[termptr->slot] = termptr->xpos = termptr->newx ;
+    pinyG[termptr->slot] = termptr->ypos = termptr->newy ;
 }
 }
 
@@ -0,0 +1,134 @@
+/*
+ *   Copyright (C) 1989-1992 Yale University
+ *   Copyright (C) 2015 Tim Edwards <tim@opencircuitdesign.com>
+ *
+ *   This work is distributed in the hope that it will be useful; you can
+ *   redistribute it and/or modify it under the terms of the
+ *   GNU General Public License as published by the Free Software Foundation;
+ *   either version 2 of the License,
+ *   or any later version, on the following conditions:
+ *
+ *   (a) YALE MAKES NO, AND EXPRESSLY DISCLAIMS
+ *   ALL, REPRESENTATIONS OR WARRANTIES THAT THE MANUFACTURE, USE, PRACTICE,
+ *   SALE OR
+ *   OTHER DISPOSAL OF THE SOFTWARE DOES NOT OR WILL NOT INFRINGE UPON ANY
+ *   PATENT OR
+ *   OTHER RIGHTS NOT VESTED IN YALE.
+ *
+ *   (b) YALE MAKES NO, AND EXPRESSLY DISCLAIMS ALL, REPRESENTATIONS AND
+ *   WARRANTIES
+ *   WHATSOEVER WITH RESPECT TO THE SOFTWARE, EITHER EXPRESS OR IMPLIED,
+ *   INCLUDING,
+ *   BUT NOT LIMITED TO, WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A
+ *   PARTICULAR
+ *   PURPOSE.
+ *
+ *   (c) LICENSEE SHALL MAKE NO STATEMENTS, REPRESENTATION OR WARRANTIES
+ *   WHATSOEVER TO
+ *   ANY THIRD PARTIES THAT ARE INCONSISTENT WITH THE DISCLAIMERS BY YALE IN
+ *   ARTICLE
+ *   (a) AND (b) above.
+ *
+ *   (d) IN NO EVENT SHALL YALE, OR ITS TRUSTEES, DIRECTORS, OFFICERS,
+ *   EMPLOYEES AND
+ *   AFFILIATES BE LIABLE FOR DAMAGES OF ANY KIND, INCLUDING ECONOMIC DAMAGE OR
+ *   INJURY TO PROPERTY AND LOST PROFITS, REGARDLESS OF WHETHER YALE SHALL BE
+ *   ADVISED, SHALL HAVE OTHER REASON TO KNOW, OR IN FACT SHALL KNOW OF THE
+ *   POSSIBILITY OF THE FOREGOING.
+ *
+ */
+/* ----------------------------------------------------------------- 
+FILE:	    fastrand.c                                       
+DESCRIPTION:batched random numbers for the annealing loop.  The
+	    moves and the acceptance test draw from two buffers
+	    which are refilled RANDBATCH numbers at a time by a
+	    counter based generator (the splitmix64 finalizer applied
+	    to key + counter).  The key is drawn from the Yale
+	    generator at the start of every uloop() call, so a given
+	    seed still gives the same run, and each annealing chain
+	    gets its own stream.  The second buffer holds the log of
+	    uniform deviates so that acceptt() compares the cost
+	    change against T * log(r) with no call to exp().
+CONTENTS:   seed_fast_random()
+	    INT refill_fast_random()
+	    DOUBLE refill_log_uniform()
+DATE:	    Oct 17, 2026 
+REVISIONS:  
+----------------------------------------------------------------- */
+#ifndef VMS
+#ifndef lint
+static char SccsId[] = "@(#) fastrand.c version 1.0 10/17/26" ;
+#endif
+#endif
+
+#include "standard.h"
+
+#define GOLDEN   0x9e3779b97f7f4a7cULL	/* counter increment */
+#define LOGKEY   0x5851f42d4c957f2dULL	/* separates the log stream */
+#define TWO31    2147483648.0
+
+static unsigned long long keyS = 0 ;	/* key of the current stream */
+static unsigned long long countS = 0 ;	/* next counter of rand stream */
+static unsigned long long lcountS = 0 ;	/* next counter of log stream */
+
+static VOID fill_batch() ;
+
+/* key a new stream from the Yale generator and drop both batches */
+seed_fast_random()
+{
+    keyS = ((unsigned long long) Yacm_random() << 31) ^
+		(unsigned long long) Yacm_random() ;
+    countS = 0 ;
+    lcountS = 0 ;
+    randposG = RANDBATCH ;
+    logposG = RANDBATCH ;
+} /* end seed_fast_random */
+
+/* refill the random batch and return its first number */
+INT refill_fast_random()
+{
+    static unsigned long long raw[RANDBATCH] ;
+    INT i ;
+
+    fill_batch( raw, keyS, countS ) ;
+    countS += RANDBATCH ;
+    for( i = 0 ; i < RANDBATCH ; i++ ) {
+	/* 31 bits like RAND */
+	randbatchG[i] = (INT)(raw[i] >> 33) ;
+    }
+    randposG = 1 ;
+    return( randbatchG[0] ) ;
+} /* end refill_fast_random */
+
+/* refill the batch of log(r), r uniform in (0,1], return the first */
+DOUBLE refill_log_uniform()
+{
+    static unsigned long long raw[RANDBATCH] ;
+    INT i ;
+
+    fill_batch( raw, keyS ^ LOGKEY, lcountS ) ;
+    lcountS += RANDBATCH ;
+    for( i = 0 ; i < RANDBATCH ; i++ ) {
+	logbatchG[i] = log( ((DOUBLE)(raw[i] >> 33) + 1.0) / TWO31 ) ;
+    }
+    logposG = 1 ;
+    return( logbatchG[0] ) ;
+} /* end refill_log_uniform */
+
+/* every entry depends only on key and counter so the loop has no */
+/* carried state and the compiler is free to vectorize it */
+static VOID fill_batch( raw, key, count )
+unsigned long long *raw ;
+unsigned long long key ;
+unsigned long long count ;
+{
+    unsigned long long z ;
+    INT i ;
+
+    for( i = 0 ; i < RANDBATCH ; i++ ) {
+	z = key + (count + (unsigned long long) i + 1) * GOLDEN ;
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL ;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL ;
+	raw[i] = z ^ (z >> 31) ;
+    }
+} /* end fill_batch */
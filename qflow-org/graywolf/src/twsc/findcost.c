@@ -57,6 +57,7 @@ REVISIONS:  Apr  1, 1990 - added missing ignore test for wire penalty.
 		and added IGNORE info for large pin warning.
 	    Thu Sep 19 14:15:51 EDT 1991 - added equal width cell
 		capability.
+	    Sat Oct 17 2026 - net wire costs are timing weighted.
 ----------------------------------------------------------------- */
 #ifndef VMS
 #ifndef lint
@@ -364,10 +365,9 @@ for( net = 1 ; net <= numnetsG ; net++ ) {
 	    dimptr->ymax = y ;
 	}
     }
-    cost += dimptr->halfPx = dimptr->newhalfPx = 
-					 dimptr->xmax - dimptr->xmin ;
+    dimptr->halfPx = dimptr->newhalfPx = dimptr->xmax - dimptr->xmin ;
     dimptr->halfPy = dimptr->newhalfPy = dimptr->ymax - dimptr->ymin ;
-    cost = cost + (INT)( vertical_wire_weightG * (DOUBLE) dimptr->halfPy ) ;
+    cost += NETCOST( net, dimptr->halfPx, dimptr->halfPy ) ;
 
     iwirexS += dimptr->xmax - dimptr->xmin ;
     iwireyS += dimptr->ymax - dimptr->ymin ;
@@ -482,10 +482,9 @@ for( net = 1 ; net <= numnetsG ; net++ ) {
 	continue ;
     }
 
-    cost += dimptr->halfPx = dimptr->newhalfPx = 
-					 dimptr->xmax - dimptr->xmin ;
+    dimptr->halfPx = dimptr->newhalfPx = dimptr->xmax - dimptr->xmin ;
     dimptr->halfPy = dimptr->newhalfPy = dimptr->ymax - dimptr->ymin ;
-    cost = cost + (INT)( vertical_wire_weightG * (DOUBLE) dimptr->halfPy ) ;
+    cost += NETCOST( net, dimptr->halfPx, dimptr->halfPy ) ;
     D( "twsc/findcost",
 	fprintf( fpoG, "net:%5d cum cost:%10d\n", net, cost ) ;
 	fflush( fpoG ) ;
@@ -51,6 +51,7 @@ REVISIONS:  Apr  1, 1990 - added missing ignore test for wire penalty.
 		for reconfig problems.
 	    Wed Sep 11 11:18:19 CDT 1991 - modified
 		for new global routing algorith.
+	    Sat Oct 17 2026 - net wire costs are timing weighted.
 ----------------------------------------------------------------- */
 #ifndef VMS
 #ifndef lint
@@ -537,10 +538,9 @@ INT recompute_wirecost()
 	    n++ ;
 	}
 	dimptr->numpins = n ;
-	cost += dimptr->halfPx = dimptr->newhalfPx = 
-					     dimptr->xmax - dimptr->xmin ;
+	dimptr->halfPx = dimptr->newhalfPx = dimptr->xmax - dimptr->xmin ;
 	dimptr->halfPy = dimptr->newhalfPy = dimptr->ymax - dimptr->ymin ;
-	cost = cost + (INT)( vertical_wire_weightG * (DOUBLE) dimptr->halfPy ) ;
+	cost += NETCOST( net, dimptr->halfPx, dimptr->halfPy ) ;
     } /* end for loop */
     return( cost ) ;
 
@@ -58,6 +58,7 @@ DATE:	    Mar 27, 1989
 REVISIONS:  Thu Dec 20 00:23:46 EST 1990 - removed += operator.
 	    Wed Sep 11 11:19:25 CDT 1991 - modified
 		for new global router.
+	    Sat Oct 17 2026 - net wire costs are timing weighted.
 ----------------------------------------------------------------- */
 #ifndef VMS
 #ifndef lint
@@ -257,10 +258,9 @@ for( net = 1 ; net <= numnetsG ; net++ ) {
     xwire += dimptr->xmax - dimptr->xmin ;
     ywire += dimptr->ymax - dimptr->ymin ;
 
-    cost += dimptr->halfPx = dimptr->newhalfPx = 
-					 dimptr->xmax - dimptr->xmin ;
+    dimptr->halfPx = dimptr->newhalfPx = dimptr->xmax - dimptr->xmin ;
     dimptr->halfPy = dimptr->newhalfPy = dimptr->ymax - dimptr->ymin ;
-    cost = cost + (INT)( vertical_wire_weightG * (DOUBLE) dimptr->halfPy ) ;
+    cost += NETCOST( net, dimptr->halfPx, dimptr->halfPy ) ;
 }
 funccostG = cost ;
 
@@ -143,7 +143,7 @@ if( between_two_cells ) {
 for( term1 = term_list1 ; term1 != NULL ; term1 = term1->next ) {
     pin1 = term1->swap_pin ;
     netarrayG[ pin1->net ]->dflag = 1 ;
-    pin1->flag = 1 ;
+    pinmovedG[pin1->slot] = TRUE ;
     length = strcspn( pin1->pinname , "/" ) ;
 
     for( term2 = term_list2 ; term2 != NULL ; term2 = term2->next ) {
@@ -153,11 +153,11 @@ for( term1 = term_list1 ; term1 != NULL ; term1 = term1->next ) {
 			pin2->pinname , length ) == 0 ) {
 		/*  then this is the pair of pins to swap  */
 		netarrayG[ pin2->net ]->dflag = 1 ;
-		pin2->flag = 1 ;
-		pin1->newx = pin2->xpos ;
-		pin1->newy = pin2->ypos ;
-		pin2->newx = pin1->xpos ;
-		pin2->newy = pin1->ypos ;
+		pinmovedG[pin2->slot] = TRUE ;
+		pinnewxG[pin1->slot] = pin1->newx = pin2->xpos ;
+		pinnewyG[pin1->slot] = pin1->newy = pin2->ypos ;
+		pinnewxG[pin2->slot] = pin2->newx = pin1->xpos ;
+		pinnewyG[pin2->slot] = pin2->newy = pin1->ypos ;
 	    }
 	}
     }
@@ -228,10 +228,10 @@ if( truth ) {
 		    pin1->pinloc = pin2->pinloc ;
 		    pin2->pinloc = tmp           ;
 
-		    pin1->xpos = pin1->newx   ;
-		    pin1->ypos = pin1->newy   ;
-		    pin2->xpos = pin2->newx   ;
-		    pin2->ypos = pin2->newy   ;
+		    pinxG[pin1->slot] = pin1->xpos = pin1->newx   ;
+		    pinyG[pin1->slot] = pin1->ypos = pin1->newy   ;
+		    pinxG[pin2->slot] = pin2->xpos = pin2->newx   ;
+		    pinyG[pin2->slot] = pin2->ypos = pin2->newy   ;
 
 		    /* swap the cell relative pin positions */
 		    tmp = pin1->txpos[0] ;
@@ -41,12 +41,34 @@
 FILE:	    globroute.c                                       
 DESCRIPTION:global routing functions.
 CONTENTS:   globroute()
+	    static INT try_flip( segptr , dtracks )
+		SEGBOXPTR segptr ;
+		INT *dtracks ;
+	    static route_row( row , flips , tracks )
+		INT row , *flips , *tracks ;
+	    static cross_row( net , row , status )
+		INT net , row , status ;
+	    static VOID *route_rows( arg )
+		VOID *arg ;
+	    static BOOL row_seg( segptr , row )
+		SEGBOXPTR segptr ;
+		INT row ;
+	    static report_rows()
+	    static INT seg_span( segptr , first , last )
+		SEGBOXPTR segptr ;
+		CHANGRDPTR *first , *last ;
 	    process_cross( segptr , status )
 		INT status ;
 		SEGBOXPTR segptr ;
 DATE:	    Mar 27, 1989 
 REVISIONS:  Sat Dec 15 22:08:21 EST 1990 - modified pinloc values
 		so that it will always be positive.
+	    Sat Oct 17 2026 - replaced the random flip loop with
+		negotiated passes over the rows.  Rows of the same
+		parity share no channel and are routed in parallel.
+		Added the channel density and feedthrough report.
+	    Sat Oct 17 2026 - cross_row() no longer reads the
+		switchvalue of segments that another thread may flip.
 ----------------------------------------------------------------- */
 #ifndef VMS
 #ifndef lint
@@ -54,26 +76,54 @@ static char SccsId[] = "@(#) globroute.c (Yale) version 4.5 12/15/90" ;
 #endif
 #endif
 
+#include <unistd.h>
+#include <pthread.h>
 #include "standard.h"
 #include "groute.h"
 #include "main.h"
 
 /* global variables */
 extern INT Max_numPinsG ;
+extern INT global_routing_threadsG ;
 
 #define TOP 1
 #define BOT 0
 
+#define MAXPASSES   40  /* upper bound on the negotiated passes */
+#define STALLPASSES 4   /* stop after this many passes without gain */
+
+typedef struct routejob {
+    INT first ;		/* first row routed by this job */
+    INT step ;		/* stride to the next row */
+    INT flips ;		/* flips accepted */
+    INT tracks ;	/* change in the number of tracks */
+} ROUTEJOB ;
+
+/* switchable segments lying wholly in a row, grouped by net */
+static SEGBOXPTR **rowsegS ;
+static INT *numrowsegS ;
+/* switchable segments touching channels outside their row */
+static SEGBOXPTR *othersegS ;
+static INT numothersegS ;
+
+static INT seg_span() ;
+static INT try_flip() ;
+static route_row() ;
+static cross_row() ;
+static VOID *route_rows() ;
+static BOOL row_seg() ;
+static report_rows() ;
+
 globroute()
 {
 
-INT flips , attempts , net ;
-INT pick , number , attlimit ;
-INT found , trys , maxtrys ;
-INT x , x1 , x2 , channel ;
-SEGBOXPTR segptr , *segment ;
-DENSITYPTR denptr ;
-PINBOXPTR netptr1 , netptr2 ;
+INT flips , pass , net , row , chan , parity ;
+INT best , stall , t , nthreads , pflips ;
+INT *segcount ;
+SEGBOXPTR segptr ;
+CHANGRDPTR gptr ;
+ROUTEJOB *job ;
+pthread_t *thread ;
 
 
 changrid( ) ;
@@ -86,91 +136,331 @@ fprintf(fpoG,"\n\nTHIS IS THE ORIGINAL NUMBER OF TRACKS: %d\n\n\n" ,
 							tracksG ) ;
 fflush(fpoG);
 
-flips    =  0 ;
-attempts =  0 ;
-attlimit = 25 * numnetsG ;
-segment  = ( SEGBOXPTR *)Ysafe_malloc(
-	( Max_numPinsG + 1 ) * sizeof( SEGBOXPTR ) ) ;
-
-while( ++attempts < attlimit ) {
-    if( attempts % 1000 == 0 ) {
-	printf(" tracks = %3d at attempts = %5d\n" ,tracksG ,attempts ) ;
-    }
-    do {
-	net = (INT) ( (DOUBLE) numnetsG * ( (DOUBLE) RAND / 
-				      (DOUBLE) 0x7fffffff ) ) + 1 ;
-    } while( net == numnetsG + 1 ) ;
-    number = 0 ;
-    for( segptr = netsegHeadG[net]->next ; segptr ;
-			    segptr = segptr->next ){
-	process_cross( segptr , 1 ) ;
-	if( segptr->switchvalue != nswLINE ) {
-	    segment[ ++number ] = segptr ;
+for( chan = 1 ; chan <= numChansG ; chan++ ) {
+    for( gptr = BeginG[chan] ; gptr ; gptr = gptr->nextgrd ) {
+	gptr->channel = chan ;
+	gptr->hist = 0 ;
+    }
+}
+
+/* sort the switchable segments into their rows.  A segment belongs */
+/* to row r when it can only use channels r and r+1; its net's other */
+/* segments in those channels are then also confined to row r. */
+segcount = (INT *) Ysafe_calloc( numRowsG + 2, sizeof(INT) ) ;
+rowsegS = (SEGBOXPTR **) Ysafe_calloc( numRowsG + 2, sizeof(SEGBOXPTR *) ) ;
+numrowsegS = (INT *) Ysafe_calloc( numRowsG + 2, sizeof(INT) ) ;
+numothersegS = 0 ;
+for( pass = 0 ; pass <= 1 ; pass++ ) {
+    for( net = 1 ; net <= numnetsG ; net++ ) {
+	for( segptr = netsegHeadG[net]->next ; segptr ;
+				segptr = segptr->next ){
+	    if( segptr->switchvalue == nswLINE ) {
+		continue ;
+	    }
+	    row = segptr->pin1ptr->row ;
+	    if( row_seg( segptr , row ) ) {
+		if( pass == 0 ) {
+		    segcount[row]++ ;
+		} else {
+		    rowsegS[row][ numrowsegS[row]++ ] = segptr ;
+		}
+	    } else if( pass == 0 ) {
+		segcount[0]++ ;
+	    } else {
+		othersegS[ numothersegS++ ] = segptr ;
+	    }
 	}
     }
-    maxtrys = 4 * number ;
-    trys = 0 ;
-    while( ++trys <= maxtrys ) {
-	do {
-	    pick = (INT) ( (DOUBLE) number * ( (DOUBLE) RAND / 
-					  (DOUBLE) 0x7fffffff ) ) + 1 ;
-	} while( pick == number + 1 ) ;
-	segptr = segment[ pick ] ;
-	netptr1 = segptr->pin1ptr ;
-	netptr2 = segptr->pin2ptr ;
-	if( segptr->switchvalue == swUP ) {
-	    channel = netptr1->row + 1 ;
-	} else {
-	    channel = netptr2->row ;
+    if( pass == 0 ) {
+	for( row = 1 ; row <= numRowsG ; row++ ) {
+	    rowsegS[row] = (SEGBOXPTR *) Ysafe_malloc(
+		(segcount[row] + 1) * sizeof(SEGBOXPTR) ) ;
 	}
-	x1 = netptr1->xpos ;
-	x2 = netptr2->xpos ;
-
-	found = NO ;
-	for( denptr = DboxHeadG[ channel ][ maxTrackG[channel] ]->next
-		    ; denptr != DENSENULL ; denptr = denptr->next ) {
-	    x = denptr->grdptr->netptr->xpos ;
-	    if( x1 <= x && x2 >= x ) {
-		found = YES ;
-		break ;
+	othersegS = (SEGBOXPTR *) Ysafe_malloc(
+		(segcount[0] + 1) * sizeof(SEGBOXPTR) ) ;
+    }
+}
+Ysafe_free( segcount ) ;
+
+nthreads = global_routing_threadsG ;
+if( nthreads <= 0 ) {
+    nthreads = (INT) sysconf( _SC_NPROCESSORS_ONLN ) ;
+}
+if( nthreads > (numRowsG + 1) / 2 ) {
+    nthreads = (numRowsG + 1) / 2 ;
+}
+if( nthreads < 1 ) {
+    nthreads = 1 ;
+}
+job = (ROUTEJOB *) Ysafe_malloc( nthreads * sizeof(ROUTEJOB) ) ;
+thread = (pthread_t *) Ysafe_malloc( nthreads * sizeof(pthread_t) ) ;
+
+/* each pass offers every segment one flip.  Flips that gain */
+/* nothing must move the segment off grid points that were at */
+/* channel density in earlier passes, so the segments negotiate */
+/* for the crowded spans.  A row reads the switchvalue only of */
+/* its own segments and of those no thread flips, so the result */
+/* does not depend on the number of threads. */
+flips = 0 ;
+best  = tracksG ;
+stall = 0 ;
+for( pass = 1 ; pass <= MAXPASSES ; pass++ ) {
+    pflips = 0 ;
+    for( parity = 0 ; parity <= 1 ; parity++ ) {
+	for( t = 0 ; t < nthreads ; t++ ) {
+	    job[t].first = 1 + parity + 2 * t ;
+	    job[t].step  = 2 * nthreads ;
+	    job[t].flips = 0 ;
+	    job[t].tracks = 0 ;
+	}
+	for( t = 1 ; t < nthreads ; t++ ) {
+	    if( pthread_create( &thread[t], NULL, route_rows,
+					(VOID *) &job[t] ) ) {
+		/* run it here instead */
+		route_rows( (VOID *) &job[t] ) ;
+		thread[t] = 0 ;
 	    }
 	}
-	if( !found ) {
-	    continue ;
+	route_rows( (VOID *) &job[0] ) ;
+	for( t = 0 ; t < nthreads ; t++ ) {
+	    if( t > 0 && thread[t] ) {
+		pthread_join( thread[t], NULL ) ;
+	    }
+	    pflips  += job[t].flips ;
+	    tracksG += job[t].tracks ;
 	}
-
-	if( urcost( segptr ) ) {
-	    flips++    ;
+    }
+    /* the remaining segments reach across rows; do them in order */
+    for( t = 0 ; t < numothersegS ; t++ ) {
+	net = othersegS[t]->pin1ptr->net ;
+	for( segptr = netsegHeadG[net]->next ; segptr ;
+				segptr = segptr->next ){
+	    process_cross( segptr , 1 ) ;
+	}
+	if( try_flip( othersegS[t], &chan ) ) {
+	    pflips++ ;
+	    tracksG += chan ;
+	}
+	for( segptr = netsegHeadG[net]->next ; segptr ;
+				segptr = segptr->next ){
+	    process_cross( segptr , 0 ) ;
 	}
     }
-    for( segptr = netsegHeadG[net]->next ; segptr ;
-			    segptr = segptr->next ){
-	process_cross( segptr , 0 ) ;
+    flips += pflips ;
+    printf(" tracks = %3d at pass = %2d\n" , tracksG , pass ) ;
+
+    if( tracksG < best ) {
+	best  = tracksG ;
+	stall = 0 ;
+    } else if( ++stall >= STALLPASSES ) {
+	break ;
+    }
+    if( pflips == 0 ) {
+	break ;
     }
+    /* charge the grid points at channel density */
+    for( chan = 1 ; chan <= numChansG ; chan++ ) {
+	if( maxTrackG[chan] <= 0 ) {
+	    continue ;
+	}
+	for( gptr = BeginG[chan] ; gptr ; gptr = gptr->nextgrd ) {
+	    if( gptr->tracks >= maxTrackG[chan] ) {
+		gptr->hist++ ;
+	    }
+	}
+    }
+}
+if( pass > MAXPASSES ) {
+    pass = MAXPASSES ;
 }
 fprintf(fpoG,"no. of accepted flips: %d\n", flips ) ;
-fprintf(fpoG,"no. of attempted flips: %d\n", attempts ) ;
+fprintf(fpoG,"no. of routing passes: %d using %d thread(s)\n",
+						pass , nthreads ) ;
 fprintf(fpoG,"THIS IS THE NUMBER OF TRACKS: %d\n\n\n" , tracksG ) ;
+report_rows() ;
 fflush(fpoG);
 
+for( row = 1 ; row <= numRowsG ; row++ ) {
+    Ysafe_free( rowsegS[row] ) ;
+}
+Ysafe_free( rowsegS ) ;
+Ysafe_free( numrowsegS ) ;
+Ysafe_free( othersegS ) ;
+Ysafe_free( job ) ;
+Ysafe_free( thread ) ;
+
 return ;
 }
 
-process_cross( segptr , status )
-INT status ;
+
+/* try to flip segptr to its other channel if it spans a grid point */
+/* at channel density.  The net's segments must have been crossed. */
+static INT try_flip( segptr , dtracks )
+SEGBOXPTR segptr ;
+INT *dtracks ;
+{
+
+INT x , x1 , x2 , channel ;
+DENSITYPTR denptr ;
+PINBOXPTR netptr1 , netptr2 ;
+
+netptr1 = segptr->pin1ptr ;
+netptr2 = segptr->pin2ptr ;
+if( segptr->switchvalue == swUP ) {
+    channel = netptr1->row + 1 ;
+} else {
+    channel = netptr2->row ;
+}
+x1 = netptr1->xpos ;
+x2 = netptr2->xpos ;
+
+for( denptr = DboxHeadG[ channel ][ maxTrackG[channel] ]->next
+	    ; denptr != DENSENULL ; denptr = denptr->next ) {
+    x = denptr->grdptr->netptr->xpos ;
+    if( x1 <= x && x2 >= x ) {
+	*dtracks = 0 ;
+	return( urcost( segptr , dtracks ) ) ;
+    }
+}
+return( 0 ) ;
+}
+
+
+/* route the segments of one row.  Only channels row and row+1 */
+/* are read or written. */
+static route_row( row , flips , tracks )
+INT row , *flips , *tracks ;
+{
+
+INT i , j , k , net ;
+INT delta ;
+SEGBOXPTR *seg ;
+
+seg = rowsegS[row] ;
+for( i = 0 ; i < numrowsegS[row] ; i = j ) {
+    net = seg[i]->pin1ptr->net ;
+    for( j = i + 1 ; j < numrowsegS[row] &&
+			seg[j]->pin1ptr->net == net ; j++ ) ;
+    cross_row( net , row , 1 ) ;
+    for( k = i ; k < j ; k++ ) {
+	if( try_flip( seg[k] , &delta ) ) {
+	    (*flips)++ ;
+	    *tracks += delta ;
+	}
+    }
+    cross_row( net , row , 0 ) ;
+}
+}
+
+
+/* process_cross for the segments of net in channels row and row+1. */
+/* Segments confined to a row two or more away are skipped without */
+/* a look at their switchvalue, which that row's thread may change; */
+/* they only use channels that this row does not. */
+static cross_row( net , row , status )
+INT net , row , status ;
+{
+
+INT segrow ;
+SEGBOXPTR segptr ;
+CHANGRDPTR p1 , p2 ;
+
+for( segptr = netsegHeadG[net]->next ; segptr ; segptr = segptr->next ){
+    segrow = segptr->pin1ptr->row ;
+    if( ABS( segrow - row ) >= 2 && row_seg( segptr , segrow ) ) {
+	continue ;
+    }
+    if( seg_span( segptr , &p1 , &p2 ) &&
+		(p1->channel == row || p1->channel == row + 1) ) {
+	process_cross( segptr , status ) ;
+    }
+}
+}
+
+
+static VOID *route_rows( arg )
+VOID *arg ;
+{
+
+INT row ;
+ROUTEJOB *job ;
+
+job = (ROUTEJOB *) arg ;
+for( row = job->first ; row <= numRowsG ; row += job->step ) {
+    route_row( row , &(job->flips) , &(job->tracks) ) ;
+}
+return( NULL ) ;
+}
+
+
+/* YES if segptr lies in row and its pins reach only channels row */
+/* and row+1.  Reads nothing that the row passes change. */
+static BOOL row_seg( segptr , row )
 SEGBOXPTR segptr ;
+INT row ;
+{
+
+PINBOXPTR netptr1 , netptr2 ;
+
+netptr1 = segptr->pin1ptr ;
+netptr2 = segptr->pin2ptr ;
+return( netptr2->row == row && row >= 1 && row <= numRowsG &&
+	TgridG[netptr1->terminal]->down->channel == row &&
+	TgridG[netptr2->terminal]->down->channel == row &&
+	TgridG[netptr1->terminal]->up->channel == row + 1 &&
+	TgridG[netptr2->terminal]->up->channel == row + 1 ) ;
+}
+
+
+/* channel density and feedthroughs in use for each row */
+static report_rows()
+{
+
+INT row , net , total ;
+INT *feeds ;
+PINBOXPTR netptr ;
+
+feeds = (INT *) Ysafe_calloc( numChansG + 1, sizeof(INT) ) ;
+for( net = 1 ; net <= numnetsG ; net++ ) {
+    for( netptr = netarrayG[net]->pins ; netptr ;
+				netptr = netptr->next ) {
+	if( netptr->terminal > TotRegPinsG &&
+		netptr->terminal <= maxtermG &&
+		netptr->row >= 1 && netptr->row <= numRowsG ) {
+	    feeds[netptr->row]++ ;
+	}
+    }
+}
+fprintf(fpoG,"channel density and feedthroughs by row\n");
+fprintf(fpoG,"   row  density below  feedthrough pins\n");
+total = 0 ;
+for( row = 1 ; row <= numRowsG ; row++ ) {
+    fprintf(fpoG,"  %4d  %13d  %16d\n", row, maxTrackG[row], feeds[row] ) ;
+    total += feeds[row] ;
+}
+fprintf(fpoG,"   top  %13d\n", maxTrackG[numChansG] ) ;
+fprintf(fpoG,"  total %13d  %16d\n\n", tracksG, total ) ;
+Ysafe_free( feeds ) ;
+}
+
+
+/* the grid points crossed by segptr run from *first up to, but not */
+/* including, *last.  Returns NO for a vertical segment. */
+static INT seg_span( segptr , first , last )
+SEGBOXPTR segptr ;
+CHANGRDPTR *first , *last ;
 {
 
 INT x1 , x2 ;
 PINBOXPTR pin1ptr , pin2ptr ;
-CHANGRDPTR ptr1 , ptr2 , ptr ;
+CHANGRDPTR ptr1 , ptr2 ;
 
 pin1ptr = segptr->pin1ptr ;
 pin2ptr = segptr->pin2ptr ;
 x1 = pin1ptr->xpos ;
 x2 = pin2ptr->xpos ;
 if( x1 == x2 ) {
-    return ;
+    return( NO ) ;
 }
 
 if( pin1ptr->row < pin2ptr->row ) {
@@ -206,7 +496,22 @@ while( ptr2->nextgrd ) {
 	break ;
     }
 }
-ptr2 = ptr2->nextgrd ;
+*first = ptr1 ;
+*last  = ptr2->nextgrd ;
+return( YES ) ;
+}
+
+
+process_cross( segptr , status )
+INT status ;
+SEGBOXPTR segptr ;
+{
+
+CHANGRDPTR ptr1 , ptr2 , ptr ;
+
+if( !seg_span( segptr , &ptr1 , &ptr2 ) ) {
+    return ;
+}
 if( status == 1 ) {
     for( ptr = ptr1 ; ptr != ptr2 ; ptr = ptr->nextgrd ) {
 	ptr->cross++ ;
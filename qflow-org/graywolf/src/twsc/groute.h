@@ -8,6 +8,8 @@ REVISIONS:  Fri Jan 25 23:47:24 PST 1991 - removed redundant variables.
 	    Fri Mar 22 15:16:41 CST 1991 - changed SHORT to
 		INT since it wasn't saving space and could
 		be a problem for large designs.
+	    Sat Oct 17 2026 - added channel and congestion history
+		to the channel grid for the negotiated router.
 ----------------------------------------------------------------- */
 #ifndef GLOBE_H
 #define GLOBE_H
@@ -39,6 +41,8 @@ typedef struct changrdbox {
     PINBOXPTR netptr ;
     SHORT cross ;
     SHORT tracks ;
+    SHORT channel ;		/* channel the grid point lies in */
+    INT hist ;			/* passes spent at channel density */
     struct changrdbox *prevgrd ;
     struct changrdbox *nextgrd ;
     struct densitybox *dptr ;
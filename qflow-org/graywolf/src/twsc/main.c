@@ -81,6 +81,8 @@ REVISIONS:  Oct 20, 1990 - fixed problem with graphics close.
 	    Fri Sep 27 20:54:48 EDT 1991 - fixed ECO problem.
 	    Thu Nov  7 23:03:57 EST 1991 - fixed problem with picking
 		best global route criteria and added new row evener.
+	    Sat Oct 17 2026 - added -b switch to time the moves.
+	    Sat Oct 17 2026 - read the net slacks after the nets.
 ----------------------------------------------------------------- */
 #ifndef lint
 static char SccsId[] = "@(#) main.c (Yale) version 4.38 5/15/92" ;
@@ -162,6 +164,7 @@ INT cx, cy, cl, cr, cb, ct, cell ;
 char *ptr ;
 char *Ystrclone() ;
 BOOL debug ;
+BOOL benchmark ;
 BOOL parasite ;
 BOOL windowId ;
 BOOL verbose ;
@@ -180,6 +183,7 @@ if( argc < 2 || argc > 4 ){
     syntax() ;
 } else {
     debug      = FALSE ;
+    benchmark  = FALSE ;
     parasite   = FALSE ;
     verbose    = FALSE ;
 #ifndef NOGRAPHICS
@@ -192,6 +196,9 @@ if( argc < 2 || argc > 4 ){
     if( *argv[1] == '-' ){
 	for( ptr = ++argv[1]; *ptr; ptr++ ){
 	    switch( *ptr ){
+	    case 'b':
+		benchmark = TRUE ;
+	        break ;
 	    case 'd':
 		debug = TRUE ;
 	        break ;
@@ -220,6 +227,9 @@ if( argc < 2 || argc > 4 ){
 	    YsetDebug( TRUE ) ;
 	    M(MSG,NULL,"\tdebug on\n" ) ;
 	} 
+	if( benchmark ){
+	    M(MSG,NULL,"\tmove benchmark on\n" ) ;
+	}
 	if( doGraphicsG ){
 	    M(MSG,NULL,"\tGraphics mode on\n" ) ;
 	} else {
@@ -314,6 +324,7 @@ readnets( fp ) ;
 if( fp ) {
     TWCLOSE( fp ) ;
 }
+read_slacks() ;
 
 
 if ( Equal_Width_CellsG && file_conversionG ) {
@@ -439,6 +450,10 @@ if( ECOs_existG ) {
 if( costonlyG ) {
     orientation_optimizationG = TRUE ;
     utemp() ;
+} else if( benchmark ) {
+    init_utemp() ;
+    move_benchmark() ;
+    YexitPgm( PGMOK ) ;
 } else {
     init_utemp() ;
     utemp() ;
@@ -1009,9 +1024,10 @@ syntax()
    M(ERRMSG,NULL,"\n" ) ; 
    M(MSG,NULL,"Incorrect syntax.  Correct syntax:\n");
    sprintf( YmsgG, 
-       "\nTimberWolfSC [-dnw] designName [windowId] \n" ) ;
+       "\nTimberWolfSC [-bdnvw] designName [windowId] \n" ) ;
    M(MSG,NULL,YmsgG ) ; 
    M(MSG,NULL,"\twhose options are zero or more of the following:\n");
+   M(MSG,NULL,"\t\tb - time the annealing moves and exit\n");
    M(MSG,NULL,"\t\td - prints debug info and performs extensive\n");
    M(MSG,NULL,"\t\t    error checking\n");
    M(MSG,NULL,"\t\tn - no graphics - the default is to open the\n");
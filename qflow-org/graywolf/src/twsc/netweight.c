@@ -0,0 +1,257 @@
+/*
+ *   Copyright (C) 1989-1992 Yale University
+ *   Copyright (C) 2015 Tim Edwards <tim@opencircuitdesign.com>
+ *
+ *   This work is distributed in the hope that it will be useful; you can
+ *   redistribute it and/or modify it under the terms of the
+ *   GNU General Public License as published by the Free Software Foundation;
+ *   either version 2 of the License,
+ *   or any later version, on the following conditions:
+ *
+ *   (a) YALE MAKES NO, AND EXPRESSLY DISCLAIMS
+ *   ALL, REPRESENTATIONS OR WARRANTIES THAT THE MANUFACTURE, USE, PRACTICE,
+ *   SALE OR
+ *   OTHER DISPOSAL OF THE SOFTWARE DOES NOT OR WILL NOT INFRINGE UPON ANY
+ *   PATENT OR
+ *   OTHER RIGHTS NOT VESTED IN YALE.
+ *
+ *   (b) YALE MAKES NO, AND EXPRESSLY DISCLAIMS ALL, REPRESENTATIONS AND
+ *   WARRANTIES
+ *   WHATSOEVER WITH RESPECT TO THE SOFTWARE, EITHER EXPRESS OR IMPLIED,
+ *   INCLUDING,
+ *   BUT NOT LIMITED TO, WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A
+ *   PARTICULAR
+ *   PURPOSE.
+ *
+ *   (c) LICENSEE SHALL MAKE NO STATEMENTS, REPRESENTATION OR WARRANTIES
+ *   WHATSOEVER TO
+ *   ANY THIRD PARTIES THAT ARE INCONSISTENT WITH THE DISCLAIMERS BY YALE IN
+ *   ARTICLE
+ *   (a) AND (b) above.
+ *
+ *   (d) IN NO EVENT SHALL YALE, OR ITS TRUSTEES, DIRECTORS, OFFICERS,
+ *   EMPLOYEES AND
+ *   AFFILIATES BE LIABLE FOR DAMAGES OF ANY KIND, INCLUDING ECONOMIC DAMAGE OR
+ *   INJURY TO PROPERTY AND LOST PROFITS, REGARDLESS OF WHETHER YALE SHALL BE
+ *   ADVISED, SHALL HAVE OTHER REASON TO KNOW, OR IN FACT SHALL KNOW OF THE
+ *   POSSIBILITY OF THE FOREGOING.
+ *
+ */
+/* ----------------------------------------------------------------- 
+FILE:	    netweight.c                                       
+DESCRIPTION:timing driven net weights.  The slack of each net is
+	    read from a file written by a static timing analyzer
+	    (vesta --slack).  Each line of the file is either a net
+	    name followed by its slack, or "period" followed by the
+	    clock period;  lines starting with # are comments.  The
+	    slack is turned into a criticality between 0 and 1, and
+	    at every temperature step the weight of a net is set to
+	    1 + slack.weight * criticality ^ e, where the exponent e
+	    grows from 1 to CRIT_EXP_MAX as the annealing proceeds.
+	    So the critical nets are pulled in gently at first and
+	    the most critical ones hardest at the end.  The cost
+	    routines only look up net_weightG[].
+CONTENTS:   read_slacks()
+	    update_net_weights()
+DATE:	    Oct 17, 2026 
+REVISIONS:  
+----------------------------------------------------------------- */
+#ifndef VMS
+#ifndef lint
+static char SccsId[] = "@(#) netweight.c version 1.0 10/17/26" ;
+#endif
+#endif
+
+#include "standard.h"
+#include "main.h"
+#include "ucxxglb.h"
+#include <string.h>
+#include <yalecad/message.h>
+#include <yalecad/hash.h>
+#include <yalecad/string.h>
+
+#define CRIT_EXP_MAX  8.0	/* criticality exponent at the end */
+
+/* global references */
+extern char *slack_fileG ;
+extern DOUBLE slack_weightG ;
+
+/* static variables */
+static DOUBLE *critS = NULL ;	/* criticality of each net */
+static BOOL   timingS = FALSE ;	/* a slack file has been read */
+
+static INT find_net() ;
+
+/* ----------------------------------------------------------------- 
+   Set up the net weights, all 1.0, and read the slack file if one
+   was given in the .par file.  The criticality of a net is
+   1 - slack / period, clipped to [0,1].  Without a period line
+   the slacks are scaled by the spread between the worst and the
+   best slack in the file.
+----------------------------------------------------------------- */
+read_slacks()
+{
+
+    FILE *fp ;
+    INT net ;
+    INT line ;
+    INT numtokens ;
+    INT numfound ;
+    INT numunknown ;
+    char **tokens ;
+    char *bufferptr ;
+    char buffer[LRECL] ;
+    DOUBLE slack ;
+    DOUBLE period ;
+    DOUBLE minslack, maxslack ;
+    DOUBLE *slacks ;
+    BOOL *found ;
+    INT *netnum ;
+    YHASHPTR net_table ;
+
+    net_weightG = (DOUBLE *) Ysafe_malloc( (numnetsG+1) * sizeof(DOUBLE) ) ;
+    for( net = 0 ; net <= numnetsG ; net++ ) {
+	net_weightG[net] = 1.0 ;
+    }
+    if(!(slack_fileG)) {
+	return ;
+    }
+    fp = TWOPEN( slack_fileG, "r", NOABORT ) ;
+    if(!(fp)) {
+	sprintf( YmsgG, "could not open slack file:%s\n", slack_fileG ) ;
+	M( WARNMSG, "read_slacks", YmsgG ) ;
+	return ;
+    }
+
+    /* look the nets up by name */
+    net_table = Yhash_table_create( 2 * numnetsG ) ;
+    netnum = (INT *) Ysafe_malloc( (numnetsG+1) * sizeof(INT) ) ;
+    for( net = 1 ; net <= numnetsG ; net++ ) {
+	netnum[net] = net ;
+	if( netarrayG[net]->name ) {
+	    Yhash_search( net_table, netarrayG[net]->name,
+		(char *) &netnum[net], ENTER ) ;
+	}
+    }
+
+    slacks = (DOUBLE *) Ysafe_malloc( (numnetsG+1) * sizeof(DOUBLE) ) ;
+    found = (BOOL *) Ysafe_calloc( numnetsG+1, sizeof(BOOL) ) ;
+    period = 0.0 ;
+    minslack = maxslack = 0.0 ;
+    numfound = numunknown = 0 ;
+    line = 0 ;
+    while( bufferptr=fgets(buffer,LRECL,fp )){
+	line++ ;
+	tokens = Ystrparser( bufferptr, " \t\n", &numtokens );
+	if( numtokens == 0 || *tokens[0] == '#' ){
+	    continue ;
+	} else if( numtokens != 2 ){
+	    sprintf( YmsgG, "syntax error in slack file line:%d\n", line ) ;
+	    M( WARNMSG, "read_slacks", YmsgG ) ;
+	    continue ;
+	}
+	if( strcmp( tokens[0], "period" ) == STRINGEQ ){
+	    period = atof( tokens[1] ) ;
+	    continue ;
+	}
+	if(!(net = find_net( net_table, tokens[0] ))){
+	    numunknown++ ;
+	    continue ;
+	}
+	slack = atof( tokens[1] ) ;
+	if( found[net] && slack >= slacks[net] ){
+	    continue ;
+	}
+	if(!(found[net])){
+	    found[net] = TRUE ;
+	    numfound++ ;
+	}
+	slacks[net] = slack ;
+	if( numfound == 1 || slack < minslack ){
+	    minslack = slack ;
+	}
+	if( numfound == 1 || slack > maxslack ){
+	    maxslack = slack ;
+	}
+    }
+    TWCLOSE( fp ) ;
+    Yhash_table_delete( net_table, NULL ) ;
+    Ysafe_free( netnum ) ;
+
+    if( period <= 0.0 ){
+	/* no period given - measure against the spread of the slacks */
+	period = maxslack - minslack ;
+	for( net = 1 ; net <= numnetsG ; net++ ) {
+	    if( found[net] ){
+		slacks[net] -= minslack ;
+	    }
+	}
+    }
+    critS = (DOUBLE *) Ysafe_calloc( numnetsG+1, sizeof(DOUBLE) ) ;
+    if( numfound > 0 && period > 0.0 ){
+	for( net = 1 ; net <= numnetsG ; net++ ) {
+	    if(!(found[net])){
+		continue ;
+	    }
+	    critS[net] = 1.0 - slacks[net] / period ;
+	    if( critS[net] < 0.0 ){
+		critS[net] = 0.0 ;
+	    } else if( critS[net] > 1.0 ){
+		critS[net] = 1.0 ;
+	    }
+	}
+	timingS = TRUE ;
+    }
+    sprintf( YmsgG, "read slacks of %d nets from %s, worst slack:%g\n",
+	numfound, slack_fileG, minslack ) ;
+    M( MSG, NULL, YmsgG ) ;
+    if( numunknown > 0 ){
+	sprintf( YmsgG, "%d nets in %s are not in the design\n",
+	    numunknown, slack_fileG ) ;
+	M( WARNMSG, "read_slacks", YmsgG ) ;
+    }
+    Ysafe_free( slacks ) ;
+    Ysafe_free( found ) ;
+
+} /* end read_slacks */
+
+/* find a net by name; verilog escaped names may carry a backslash */
+static INT find_net( net_table, name )
+YHASHPTR net_table ;
+char *name ;
+{
+    INT *data ;
+
+    data = (INT *) Yhash_search( net_table, name, NULL, FIND ) ;
+    if(!(data) && *name == '\\' ){
+	data = (INT *) Yhash_search( net_table, name+1, NULL, FIND ) ;
+    }
+    return( data ? *data : 0 ) ;
+} /* end find_net */
+
+/* ----------------------------------------------------------------- 
+   Recompute the weights for the current point of the schedule.
+   Called once per temperature step before the wire cost is
+   recomputed, so the incremental costs stay consistent.
+----------------------------------------------------------------- */
+update_net_weights()
+{
+
+    INT net ;
+    DOUBLE e ;
+    DOUBLE crit ;
+
+    if(!(timingS)) {
+	return ;
+    }
+    e = 1.0 + (CRIT_EXP_MAX - 1.0) * fraction_doneG ;
+    for( net = 1 ; net <= numnetsG ; net++ ) {
+	crit = critS[net] ;
+	if( crit > 0.0 ){
+	    net_weightG[net] = 1.0 + slack_weightG * pow( crit, e ) ;
+	} else {
+	    net_weightG[net] = 1.0 ;
+	}
+    }
+
+} /* end update_net_weights */
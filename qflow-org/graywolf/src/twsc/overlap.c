@@ -361,11 +361,13 @@ INT xcenter , ycenter , newaor ;
 {
 
 register PINBOXPTR pinptr ;
+register INT s ;
 
 for( pinptr = antrmptr ; pinptr; pinptr = pinptr->nextpin ) {
     netarrayG[ pinptr->net ]->dflag = 1 ;
-    pinptr->flag = 1 ;
-    pinptr->newx = pinptr->txpos[ newaor/2 ] + xcenter ;
-    pinptr->newy = pinptr->typos[ newaor%2 ] + ycenter ;
+    s = pinptr->slot ;
+    pinmovedG[s] = TRUE ;
+    pinnewxG[s] = pinptr->newx = pinptr->txpos[ newaor/2 ] + xcenter ;
+    pinnewyG[s] = pinptr->newy = pinptr->typos[ newaor%2 ] + ycenter ;
 }
 }
@@ -0,0 +1,89 @@
+/*
+ *   Copyright (C) 1989-1992 Yale University
+ *   Copyright (C) 2015 Tim Edwards <tim@opencircuitdesign.com>
+ *
+ *   This work is distributed in the hope that it will be useful; you can
+ *   redistribute it and/or modify it under the terms of the
+ *   GNU General Public License as published by the Free Software Foundation;
+ *   either version 2 of the License,
+ *   or any later version, on the following conditions:
+ *
+ *   (a) YALE MAKES NO, AND EXPRESSLY DISCLAIMS
+ *   ALL, REPRESENTATIONS OR WARRANTIES THAT THE MANUFACTURE, USE, PRACTICE,
+ *   SALE OR
+ *   OTHER DISPOSAL OF THE SOFTWARE DOES NOT OR WILL NOT INFRINGE UPON ANY
+ *   PATENT OR
+ *   OTHER RIGHTS NOT VESTED IN YALE.
+ *
+ *   (b) YALE MAKES NO, AND EXPRESSLY DISCLAIMS ALL, REPRESENTATIONS AND
+ *   WARRANTIES
+ *   WHATSOEVER WITH RESPECT TO THE SOFTWARE, EITHER EXPRESS OR IMPLIED,
+ *   INCLUDING,
+ *   BUT NOT LIMITED TO, WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A
+ *   PARTICULAR
+ *   PURPOSE.
+ *
+ *   (c) LICENSEE SHALL MAKE NO STATEMENTS, REPRESENTATION OR WARRANTIES
+ *   WHATSOEVER TO
+ *   ANY THIRD PARTIES THAT ARE INCONSISTENT WITH THE DISCLAIMERS BY YALE IN
+ *   ARTICLE
+ *   (a) AND (b) above.
+ *
+ *   (d) IN NO EVENT SHALL YALE, OR ITS TRUSTEES, DIRECTORS, OFFICERS,
+ *   EMPLOYEES AND
+ *   AFFILIATES BE LIABLE FOR DAMAGES OF ANY KIND, INCLUDING ECONOMIC DAMAGE OR
+ *   INJURY TO PROPERTY AND LOST PROFITS, REGARDLESS OF WHETHER YALE SHALL BE
+ *   ADVISED, SHALL HAVE OTHER REASON TO KNOW, OR IN FACT SHALL KNOW OF THE
+ *   POSSIBILITY OF THE FOREGOING.
+ *
+ */
+/* ----------------------------------------------------------------- 
+FILE:	    pchain.c                                       
+DESCRIPTION:parallel annealing chains for the inner loop.  Each
+	    temperature step is run by anneal.chains processes forked
+	    from the current placement (see Ylib/chain.c).  Every chain
+	    makes its share of the attempts, and the chain with the
+	    lowest cost carries the placement on to the next step.
+CONTENTS:   chain_uloop()
+DATE:	    Oct 17, 2026 
+REVISIONS:  
+----------------------------------------------------------------- */
+#ifndef VMS
+#ifndef lint
+static char SccsId[] = "@(#) pchain.c version 1.0 10/17/26" ;
+#endif
+#endif
+
+#include "standard.h"
+#include "main.h"
+#include "readpar.h"
+#include <yalecad/chain.h>
+
+/* global references */
+extern INT anneal_chainsG ;
+
+chain_uloop()
+{
+
+INT chains , attmax ;
+
+chains = anneal_chainsG ;
+if( chains <= 1 || doGraphicsG || iterationG <= 0 ) {
+    uloop() ;
+    return ;
+}
+if( Ychain_fork( chains, fpoG ) < 0 ) {
+    anneal_chainsG = 1 ;
+    uloop() ;
+    return ;
+}
+/* the temperature update counts the attempts of this chain only */
+attmax = attmaxG ;
+attmaxG = (attmax + chains - 1) / chains ;
+uloop() ;
+attmaxG = attmax ;
+
+Ychain_finish( (DOUBLE) funccostG + (DOUBLE) penaltyG +
+			(DOUBLE) timingcostG ) ;
+
+} /* end chain_uloop */
@@ -64,6 +64,10 @@ REVISIONS:  Nov 23, 1990 - now use new readpar library function.
 		capability.
 	    Fri Nov  8 01:13:18 EST 1991 - added even the rows
 		maximally.
+	    Sat Oct 17 2026 - added anneal.chains.
+	    Sat Oct 17 2026 - added analytic.placement.
+	    Sat Oct 17 2026 - added slack.file and slack.weight.
+	    Sat Oct 17 2026 - added global_routing_threads.
 ----------------------------------------------------------------- */
 #ifndef VMS
 #ifndef lint
@@ -101,6 +105,8 @@ INT vertical_track_pitchG = 0 ;
 INT horizontal_track_pitchG = 0 ;
 INT approximately_fixed_factorG = 1 ;
 INT global_routing_iterationsG = 0 ;
+INT anneal_chainsG = 1 ;
+INT global_routing_threadsG = 0 ;
 BOOL no_feed_estG = TRUE ;
 BOOL placement_improveG = TRUE ;
 BOOL intel_debugG = FALSE ;
@@ -120,6 +126,7 @@ BOOL rigidly_fixed_cellsG = FALSE ;
 BOOL exclude_noncrossbus_padsG = TRUE ;
 BOOL stand_cell_as_gate_arrayG = FALSE ;
 BOOL good_initial_placementG = FALSE ;
+BOOL analytic_placementG = FALSE ;
 BOOL glob_route_only_crit_netsG = FALSE ;
 BOOL unused_feed_name_twspacerG = FALSE ;
 BOOL absolute_minimum_feedsG = FALSE ;
@@ -130,6 +137,8 @@ BOOL prop_rigid_cellsG = FALSE ;
 BOOL even_rows_maximallyG = FALSE ;
 DOUBLE indentG ;
 DOUBLE metal2_pitchG ;
+DOUBLE slack_weightG = 4.0 ;
+char *slack_fileG = NULL ;
 
 /* globals variable references */
 extern BOOL orientation_optimizationG ;
@@ -464,6 +473,36 @@ INT parfile ;
 	    } else {
 		err_msg("global_routing_iterations") ;
 	    }
+	} else if( strcmp( tokens[0],"global_routing_threads") == STRINGEQ ){
+	    if( numtokens == 2 ) {
+		global_routing_threadsG = atoi( tokens[1] ) ;
+	    } else {
+		err_msg("global_routing_threads") ;
+	    }
+	} else if( strcmp( tokens[0],"anneal.chains") == STRINGEQ ){
+	    if( numtokens == 2 ) {
+		anneal_chainsG = atoi( tokens[1] ) ;
+	    } else {
+		err_msg("anneal.chains") ;
+	    }
+	} else if( strcmp( tokens[0],"analytic.placement") == STRINGEQ ){
+	    if( onNotOff ){
+		analytic_placementG = TRUE ;
+	    } else {
+		analytic_placementG = FALSE ;
+	    }
+	} else if( strcmp( tokens[0],"slack.file") == STRINGEQ ){
+	    if( numtokens == 2 ) {
+		slack_fileG = Ystrclone( tokens[1] ) ;
+	    } else {
+		err_msg("slack.file") ;
+	    }
+	} else if( strcmp( tokens[0],"slack.weight") == STRINGEQ ){
+	    if( numtokens == 2 ) {
+		slack_weightG = atof( tokens[1] ) ;
+	    } else {
+		err_msg("slack.weight") ;
+	    }
 	} else if( strcmp( tokens[0],"do.global.route") == STRINGEQ ){
 	    if( onNotOff ){
 		doglobalG = TRUE ;
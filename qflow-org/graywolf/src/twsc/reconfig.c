@@ -50,6 +50,7 @@ REVISIONS:  Thu Jan 31 15:56:39 EST 1991 - now only call findcostf
 		taper from previous run.
 	    Wed Sep 11 11:27:46 CDT 1991 - added user
 		output info for blocks.
+	    Sat Oct 17 2026 - update the timing net weights.
 ----------------------------------------------------------------- */
 #ifndef VMS
 #ifndef lint
@@ -105,6 +106,9 @@ INT reconfig()
     /* place the pads */
     placepads() ;
 
+    /* the timing weights follow the schedule */
+    update_net_weights() ;
+
     /* call this since pad placement may change costs */
     funccostG = recompute_wirecost() ;
     timingcostG = recompute_timecost() ;
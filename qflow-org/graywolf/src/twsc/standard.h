@@ -13,6 +13,7 @@ REVISIONS:  Sat Dec 15 22:08:21 EST 1990 - modified pinloc values
 		definitions for large designs.
 	    Tue Mar 26 11:33:47 EST 1991 - added NO_FEED_INSTANCES
 		conditional compile.
+	    Sat Oct 17 2026 - added the batched random streams.
 ----------------------------------------------------------------- */
 #ifndef YSTANDARD_H 
 #define YSTANDARD_H 
@@ -151,6 +152,7 @@ typedef struct pinbox {
     SHORT row  ;
     char pinloc   ;
     char flag     ;
+    INT slot ;                     /* index in the packed pin arrays */
     struct adjacent_seg *adjptr ;
     struct equiv_box *eqptr ;
 } *PINBOXPTR, PINBOX ;
@@ -288,9 +290,35 @@ EXTERN BBOXPTR *barrayG ;
 EXTERN BINBOX ***binptrG ;
 EXTERN PATHPTR *patharrayG ;  /* array of timing paths */
 
+/* pin positions packed net by net for the incremental cost, */
+/* indexed by pin->slot.  See pack_net_pins() in dimbox.c.   */
+EXTERN INT *pinxG ;           /* current position */
+EXTERN INT *pinyG ;
+EXTERN INT *pinnewxG ;        /* position under a proposed move */
+EXTERN INT *pinnewyG ;
+EXTERN char *pinmovedG ;      /* TRUE if pinnewx/y is to be used */
+
 EXTERN DOUBLE vertical_path_weightG ;
 EXTERN DOUBLE horizontal_path_weightG ;
 EXTERN DOUBLE vertical_wire_weightG ;
+EXTERN DOUBLE *net_weightG ;  /* timing weight of each net, see netweight.c */
+
+/* wire cost of net n whose bounding box has half perimeters hx, hy */
+#define NETCOST(n,hx,hy) ((INT)(net_weightG[n] * (DOUBLE)((hx) + \
+			    (INT)(vertical_wire_weightG * (DOUBLE)(hy)))))
+
+/* batched random streams of the annealing loop, see fastrand.c */
+#define RANDBATCH 1024
+EXTERN INT randbatchG[RANDBATCH] ;
+EXTERN INT randposG ;
+EXTERN DOUBLE logbatchG[RANDBATCH] ;
+EXTERN INT logposG ;
+/* a number in [0..2**31 - 1] like RAND */
+#define FAST_RAND   ((randposG < RANDBATCH) ? randbatchG[randposG++] : \
+				refill_fast_random())
+/* log(r) for r uniform in (0,1] */
+#define LOG_UNIFORM ((logposG < RANDBATCH) ? logbatchG[logposG++] : \
+				refill_log_uniform())
 
 /* the configuration */
 EXTERN INT numcellsG ;
@@ -324,7 +352,9 @@ EXTERN DOUBLE timeFactorG ;
 #undef EXTERN  
 
 /* *********************** PROTOTYPES FOR TWSC ******************** */
-extern init_table( P1(void) ) ;
+extern seed_fast_random( P1(void) ) ;
+extern INT refill_fast_random( P1(void) ) ;
+extern DOUBLE refill_log_uniform( P1(void) ) ;
 extern BOOL acceptt( P3(INT d_wire,INT d_time,INT d_penal) ) ;
 extern BOOL accept_greedy( P3(INT d_wire,INT d_time,INT d_penal) ) ;
 
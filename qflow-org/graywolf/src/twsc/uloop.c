@@ -79,6 +79,7 @@ REVISIONS:  Mar 29, 1989 - removed vertical / horz wire weighting.
 		controller initialization for zero delta costs.
 	    Thu Sep 19 14:15:51 EDT 1991 - added equal width cell
 		capability.
+	    Sat Oct 17 2026 - moves draw from the batched stream.
 ----------------------------------------------------------------- */
 #ifndef VMS
 #ifndef lint
@@ -117,7 +118,7 @@ static char SccsId[] = "@(#) uloop.c (Yale) version 4.14 3/23/92" ;
 #define TABMASK 0xfff
 #define TABOFFSET 0x40000
 #define RANDFACT (1.0 / MAXINT)
-#define CHANCE(n) (!(RAND % n))
+#define CHANCE(n) (!(FAST_RAND % n))
 
 /* #define START_ITER 81  if you change this one, */
 			/* do the same in utemp    */
@@ -131,7 +132,7 @@ static char SccsId[] = "@(#) uloop.c (Yale) version 4.14 3/23/92" ;
 #define LASTTEMP       155.00 /* last iterationG */
 #define NUMTUPDATES   400 /* maximum number of T updates per iterationG */
 
-#define PICK_INT(l,u) (((l)<(u)) ? ((RAND % ((u)-(l)+1))+(l)) : (l))
+#define PICK_INT(l,u) (((l)<(u)) ? ((FAST_RAND % ((u)-(l)+1))+(l)) : (l))
 
 /* global variables */
 BOOL fences_existG ;
@@ -221,6 +222,9 @@ DOUBLE calc_time_factor() ;
 */
 
 
+/* a new batched stream for every step; see fastrand.c */
+seed_fast_random() ;
+
 attemptsG  = 0 ;
 flips     = 0 ;
 rejects   = 0 ;
@@ -260,6 +264,7 @@ dCp = 0.0;
 
 
 fds = reconfig() ;
+pack_net_pins() ;
 
 avg_rowpenalS = 0.0 ;
 num_penalS = 0.0 ;
@@ -1256,7 +1261,7 @@ DOUBLE scale ;
     DOUBLE tmp ;
     BBOXPTR bblckptr ;
 
-    m = RAND;
+    m = FAST_RAND;
     tmp = yalS * scale ;
     if( tmp > max_yalphaS ) {
 	tmp = max_yalphaS ;
@@ -1269,7 +1274,7 @@ DOUBLE scale ;
     *y = n;
     bblckptr = barrayG[n] ;
     for (i=0; i<2; i++) {
-	m = RAND;
+	m = FAST_RAND;
 	tmp = xalS * scale ;
 	if( tmp > max_xalphaS ) {
 	    tmp = max_xalphaS ;
@@ -94,6 +94,7 @@ setVirtualCore( TRUE ) ;
 placepads() ;
 funccostG = recompute_wirecost() ;
 timingcostG = recompute_timecost() ;
+pack_net_pins() ;
 
 /* assume conditions are true - prove otherwise */
 one_cell_per_row = TRUE ;
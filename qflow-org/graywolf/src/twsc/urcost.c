@@ -40,11 +40,16 @@
 /* ----------------------------------------------------------------- 
 FILE:	    urcost.c                                       
 DESCRIPTION:update global routing cost.
-CONTENTS:   urcost( segptr )
+CONTENTS:   urcost( segptr , dtracks )
 		SEGBOXPTR segptr ;
+		INT *dtracks ;
 DATE:	    Mar 27, 1989 
 REVISIONS:  Tue Mar 19 16:22:56 CST 1991 - fixed crash when
 		there are no routing tracks in a channel.
+	    Sat Oct 17 2026 - a flip that leaves the tracks as they
+		are must now move the segment off congestion history.
+		The track change is returned instead of added to
+		tracksG so that rows may be routed in parallel.
 ----------------------------------------------------------------- */
 #ifndef VMS
 #ifndef lint
@@ -56,8 +61,9 @@ static char SccsId[] = "@(#) urcost.c (Yale) version 4.4 3/19/91" ;
 #include "groute.h"
 #include <yalecad/debug.h>
 
-urcost( segptr )
+urcost( segptr , dtracks )
 SEGBOXPTR segptr ;
+INT *dtracks ;
 {
 
 CHANGRDPTR aptr1 , aptr2 , bptr1 , bptr2 , ptr ;
@@ -68,6 +74,7 @@ INT maxaa , maxbb , pin1 , pin2 ;
 INT aoutside , binside ;
 INT ax1 , ax2 , bx1 , bx2 ;
 INT track ;
+INT ahist , bhist ;
 
 penalty = 0 ;
 pin1 = segptr->pin1ptr->terminal ;
@@ -177,6 +184,19 @@ if( penalty == 0 ) {
 } else {
     check = penalty ;
 }
+if( check == 0 && penalty == 0 ) {
+    /* no gain in tracks; only leave the more congested side */
+    ahist = bhist = 0 ;
+    for( ptr = aptr1 ; ptr != aptr2 ; ptr = ptr->nextgrd ) {
+	ahist += ptr->hist ;
+    }
+    for( ptr = bptr1 ; ptr != bptr2 ; ptr = ptr->nextgrd ) {
+	bhist += ptr->hist ;
+    }
+    if( bhist >= ahist ) {
+	check = 1 ;
+    }
+}
 
 if( check <= 0 ) {
     for( ptr = aptr1 ; ptr != aptr2 ; ptr = ptr->nextgrd ) {
@@ -247,7 +267,7 @@ if( check <= 0 ) {
 	segptr->switchvalue = swUP ;
     }
 
-    tracksG += penalty ;
+    *dtracks = penalty ;
     return (1) ;
 } else {
     return (0) ;
@@ -43,6 +43,8 @@ DESCRIPTION:outer loop of simulated annealing algorithm.
 CONTENTS:   utemp()
 	    from_middle()
 	    from_beginning()
+	    from_analytic()
+	    move_benchmark()
 	    INT compute_attprcel(flag)
 		INT flag;
 	    rm_overlapping_feeds()
@@ -59,6 +61,8 @@ REVISIONS:  Fri Jan 25 23:45:25 PST 1991 - added user meter.
 		debug mode.
 	    Thu Aug 22 22:27:18 CDT 1991 - Carl made changes
 		for rigidly fixed cells.
+	    Sat Oct 17 2026 - added move_benchmark() for the -b switch.
+	    Sat Oct 17 2026 - acceptt() no longer needs init_table().
 ----------------------------------------------------------------- */
 #ifndef VMS
 #ifndef lint
@@ -77,6 +81,10 @@ static char SccsId[] = "@(#) utemp.c (Yale) version 4.19 4/5/92" ;
 #include <yalecad/message.h>
 #include <yalecad/debug.h>
 
+#define ANALYTIC_ITER   70	/* schedule iteration to start from */
+#define ANALYTIC_T    0.05	/* start T as a fraction of wire per net */
+#define BENCH_PASSES    50	/* timed uloop passes in move_benchmark */
+
 /* global variables */
 INT moveable_cellsG ;
 BOOL pairtestG;
@@ -88,6 +96,7 @@ extern INT spacer_widthG ;
 extern INT orig_max_row_lengthG ;
 extern BOOL noPairsG ;
 extern BOOL good_initial_placementG ;
+extern BOOL analytic_placementG ;
 extern BOOL orientation_optimizationG ;
 extern BOOL stand_cell_as_gate_arrayG ;
 extern BOOL prop_rigid_cellsG ;
@@ -98,6 +107,7 @@ extern DOUBLE ratioG;
 
 INT comparex() ;
 INT compute_attprcel() ;
+DOUBLE Ycpu_time() ;
 
 utemp()
 {
@@ -115,7 +125,6 @@ fraction_doneG = 0.0 ;
 
 check = 0 ;
 freeze = 10000000 ;
-init_table() ;
 
 
 attprcelG = compute_attprcel(1);
@@ -126,7 +135,9 @@ if( pairtestG == 0 ) {
     if( iterationG < 1 ) {
 	resume_runG = 0 ;
     }
-    if( !resume_runG && !good_initial_placementG ) {
+    if( !resume_runG && analytic_placementG ) {
+	from_analytic() ;
+    } else if( !resume_runG && !good_initial_placementG ) {
 	from_beginning() ;
     } else if( resume_runG ) {
 	from_middle() ;
@@ -135,7 +146,7 @@ if( pairtestG == 0 ) {
 
 for( ; ; ) {
     if( pairtestG == FALSE && TG >= 0.01 ) {
-	uloop() ;
+	chain_uloop() ;
 	savewolf(0) ; 
     } else {
 	D( "twsc/after_annealing", 
@@ -300,6 +311,81 @@ from_beginning()
     fflush(fpoG);
 }
 
+/* ----------------------------------------------------------------- 
+   The analytic placer left the cells near their final places, so
+   skip the random hot phase and start the schedule at ANALYTIC_ITER
+   with the range limiter already narrowed.  The temperature is a guess; the
+   acceptance ratio feedback in uloop corrects it within the first
+   iteration.
+----------------------------------------------------------------- */
+from_analytic()
+{
+
+    init_uloop();
+    init_control(1);		/* set move generation controller. */
+    attmaxG = attprcelG * moveable_cellsG ;
+    iterationG = ANALYTIC_ITER ;
+    update_window_size( (DOUBLE) iterationG ) ;
+    TG = ANALYTIC_T * (DOUBLE) funccostG / (DOUBLE) numnetsG ;
+    good_initial_placementG = TRUE ;
+
+    M( MSG, NULL, "\nIter T        fds    Wire     Penal  Time     P_lim ");
+    if( swappable_gates_existG ) {
+	M( MSG, NULL, " err binC  rowC timeC  s/p  rej. Acc.");
+	M( MSG, NULL, " g_sw Vwt\n");
+    } else {
+	M( MSG, NULL, " err binC  rowC timeC  s/p  rej. Acc. Vwt\n");
+    }
+    sprintf(YmsgG,"%3d: %6.2le %6ld %-8ld %-6ld %-8ld",
+	iterationG++,TG,0,funccostG,rowpenalG,timingcostG );
+    M( MSG, NULL, YmsgG ) ;
+    sprintf(YmsgG,"%6ld %4.2lf %4.2lf %5.2lf %5.2lf %4.2lf %4.2lf %5.3lf\n",
+	P_limitG,0.0,binpenConG,roLenConG,timeFactorG,0.0,0.0,ratioG);
+    M( MSG, NULL, YmsgG ) ;
+    fflush(fpoG);
+}
+
+/* ----------------------------------------------------------------- 
+   Time the move loop alone.  After the two hot passes of
+   from_beginning the temperature is dropped to where a fair share
+   of the moves is rejected, and BENCH_PASSES passes of uloop are
+   timed.  Only the cpu time of those passes is counted.
+----------------------------------------------------------------- */
+move_benchmark()
+{
+
+INT i ;
+INT moves ;
+DOUBLE start ;
+DOUBLE elapsed ;
+
+fraction_doneG = 0.0 ;
+attprcelG = compute_attprcel(1) ;
+attmaxG = attprcelG * moveable_cellsG ;
+from_beginning() ;
+TG = ANALYTIC_T * (DOUBLE) funccostG / (DOUBLE) numnetsG ;
+
+moves = 0 ;
+start = Ycpu_time() ;
+for( i = 0 ; i < BENCH_PASSES ; i++ ) {
+    uloop() ;
+    moves += attemptsG ;
+}
+elapsed = Ycpu_time() - start ;
+if( elapsed <= 0.0 ) {
+    elapsed = 1.0e-6 ;
+}
+
+sprintf( YmsgG, "\nmove benchmark: %d moves in %4.2lf sec ", moves, elapsed ) ;
+M( MSG, NULL, YmsgG ) ;
+sprintf( YmsgG, "= %8.0lf moves/sec\n", (DOUBLE) moves / elapsed ) ;
+M( MSG, NULL, YmsgG ) ;
+sprintf( YmsgG, "final wire cost:%d\n", funccostG ) ;
+M( MSG, NULL, YmsgG ) ;
+fflush( fpoG ) ;
+
+} /* end move_benchmark */
+
 INT compute_attprcel(flag)
 INT flag;
 {
@@ -130,6 +130,17 @@ else
    echo "continuing without pin placement hints" |& tee -a ${synthlog}
 endif
 
+# Check if a .slk file exists.  This file is produced by vesta (see
+# vesta.sh) and holds the slack of each net from the last timing
+# analysis.  GrayWolf uses it to weight the timing-critical nets.
+
+if ( -f ${rootname}.slk ) then
+   if ( `grep -c "slack.file" ${rootname}.par` == "0" ) then
+      echo "TWSC*slack.file : ${rootname}.slk" >> ${rootname}.par
+   endif
+   echo "Weighting critical nets from ${rootname}.slk" |& tee -a ${synthlog}
+endif
+
 #-----------------------------------------------
 # 1) Run GrayWolf
 #-----------------------------------------------
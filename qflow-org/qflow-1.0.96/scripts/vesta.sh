@@ -68,6 +68,14 @@ cd ${synthdir}
 # Generate the static timing analysis results
 #------------------------------------------------------------------
 
+# If "vesta_slacks" is set in project_vars.sh, save the net slacks
+# in the layout directory, where placement.sh will find them and have
+# GrayWolf weight the critical nets on the next placement.
+
+if ( ${?vesta_slacks} ) then
+   set vesta_options = "${vesta_options} --slack ${layoutdir}/${rootname}.slk"
+endif
+
 echo ""
 echo "Running vesta static timing analysis"
 echo ""
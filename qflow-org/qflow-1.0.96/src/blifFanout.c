@@ -44,6 +44,9 @@
 #include <string.h>
 #include <ctype.h>	/* for isdigit() */
 #include <math.h>
+#include <time.h>
+
+#include "hash.h"
 
 #define  FALSE	     0
 #define  TRUE        1
@@ -96,6 +99,7 @@ struct Gatelist {
 } Gatelist_;
 
 struct Gatelist *Gatel;
+struct hashtable Gatehash;	// Gatel entries by gate name
 
 struct Nodelist {
    struct Nodelist *next;
@@ -110,6 +114,8 @@ struct Nodelist {
 } Nodelist_;
 
 struct Nodelist *Nodel;
+struct Nodelist *Nodelast;	// Empty record at the end of Nodel
+struct hashtable Nodehash;	// Nodel entries by node name
 
 struct Drivelist {
    struct Drivelist *next;
@@ -119,10 +125,139 @@ struct Drivelist {
 } Drivelist_;
 
 struct Drivelist *Drivel;
+struct hashtable Drivehash;	// Drivel entries by drive type
 
 enum states_ {NONE, OUTPUTS, GATENAME, PINNAME, INPUTNODE, OUTPUTNODE, ENDMODEL};
 enum nodetype_ {INPUT, OUTPUT, OUTPUTPIN, UNKNOWN};
 
+// Kinds of lookup table variable
+
+#define VAR_OTHER	0
+#define VAR_TRANS	1	// Input or constrained pin transition time
+#define VAR_LOAD	2	// Output load capacitance
+
+// Kinds of timing arc
+
+#define ARC_COMB	0	// Combinational delay
+#define ARC_CLOCK	1	// Clock to output of a flop or latch
+#define ARC_SETUP	2	// Setup constraint
+#define ARC_IGNORE	3	// Anything else (hold, clear, three-state, ...)
+
+#define TIME_EPSILON	1.0E-6	// Smallest change in arrival time (ps)
+#define GAIN_EPSILON	1.0E-2	// Smallest worthwhile gain in slack (ps)
+#define SLACK_INFINITY	1.0E50
+
+struct Libtable {
+   char   var1, var2;		// Variable kind of each index
+   int    size1, size2;
+   double *index1, *index2;
+   double *values;		// size1 x size2, in ps
+};
+
+struct Libtemplate {
+   struct Libtemplate *next;
+   char   *name;
+   struct Libtable table;	// Indexes only
+};
+
+struct Libarc {
+   struct Libarc *next;
+   char   *relpin;
+   char   type;
+   struct Libtable *delay[2];	// cell_rise/fall or rise/fall_constraint
+   struct Libtable *trans[2];	// rise/fall_transition
+};
+
+struct Libpin {
+   struct Libpin *next;
+   char   *name;
+   char   output;
+   char   clock;		// Clock pin of a flop or latch
+   char   setup;		// Has a setup constraint (path end)
+   double cap;			// in fF
+   struct Libarc *arcs;
+};
+
+struct Libcell {
+   struct Libcell *next;
+   char   *name;
+   char   seq;			// Flop or latch
+   double area;
+   struct Libpin *pins;
+};
+
+struct Libcell *Libcells = NULL;
+struct Libtemplate *Libtemplates = NULL;
+struct hashtable Libhash;	// Libcells by name
+
+double TimeScale = 1000.0;	// Liberty time unit, in ps
+double CapScale = 1000.0;	// Liberty capacitance unit, in fF
+
+struct Tnet;
+struct Tgate;
+
+struct Tpin {
+   char   *name;
+   struct Libpin *lpin;
+   struct Tgate *gate;		// NULL for a module output
+   struct Tnet *net;
+   struct Tpin *nextrcv;	// Next receiver on the same net
+   int    endindex;		// Index in the path end list, or -1
+};
+
+struct Tnet {
+   char   *name;
+   struct Tpin *driver;
+   struct Tpin *receivers;
+   char   ignore;
+   double load;			// in fF
+   double arrival;		// in ps
+   double slew;			// in ps
+   double required;		// in ps
+   struct Tpin *srcpin;		// Gate input on the worst path to this net
+};
+
+struct Tgate {
+   struct Tgate *next;		// In netlist order, then inserted buffers
+   struct Libcell *cell;	// NULL if the cell is not in the liberty file
+   struct Libcell *origcell;	// Cell in the input netlist
+   char   *cellname;
+   int    npins;
+   struct Tpin *pins;
+   int    level;
+   int    fanin;		// Fanin not yet levelized
+   char   queued;
+   char   inserted;		// Buffer added by the optimization
+   char   modified;		// Cell or connections changed
+};
+
+struct Tgate *Tgates = NULL, *Tgatelast = NULL;
+int Tgatecount = 0;
+struct hashtable Tnethash;	// Tnets by name
+
+struct Tpin **Endpoints = NULL;	// Path ends
+int Endcount = 0;
+double *Endtree = NULL;		// Minimum-slack tree over Endpoints
+int Endtreesize = 0;
+
+struct Tgate **Theap = NULL;	// Level-ordered work list
+int Theapcount = 0, Theapsize = 0;
+
+struct Tjournal {		// Old value of a net or path end
+   struct Tnet *net;		// NULL for a path end
+   int    endindex;
+   double arrival;		// Or slack, for a path end
+   double slew;
+   struct Tpin *srcpin;
+};
+
+struct Tjournal *Journal = NULL;	// Values changed by a tried change
+int Journalcount = 0, Journalsize = 0;
+char Journaling = FALSE;
+
+double Period = 0.0;		// Target clock period (ps), or 0
+char *Libpath = NULL;
+
 void read_gate_file(char *gate_file_name);
 void read_ignore_file(char *ignore_file_name);
 struct Gatelist* GatelistAlloc();
@@ -137,6 +272,8 @@ char *best_size(char *gatename, double amount, char *overload);
 char *find_size(char *gatename);
 char *max_size(char *gatename);
 void count_gatetype(char *name, int num_in, int num_out);
+void read_liberty(char *libname);
+void timing_driven(FILE *infptr, FILE *outfptr);
 
 /*
  *---------------------------------------------------------------------------
@@ -188,17 +325,22 @@ int main (int argc, char *argv[])
    struct Gatelist *gl;
    struct Nodelist *nl;
    struct Drivelist *dl;
+   clock_t loadstart;
 
    SuffixIsNumeric = TRUE;	// By default, assume numeric suffixes
    Separator = NULL;		// By default, assume no separator
 
    Nodel = NodelistAlloc();
+   Nodelast = Nodel;
    nl = Nodel;
+   InitializeHashTable(&Nodehash, 1024, FALSE);
 
    Drivel = DrivelistAlloc();
    dl = Drivel;
+   InitializeHashTable(&Drivehash, 32, FALSE);
+   HashPtrInstall(Drivel->DriveType, Drivel, &Drivehash);
 
-   while ((i = getopt(argc, argv, "gnhvl:c:b:i:o:p:s:f:")) != EOF) {
+   while ((i = getopt(argc, argv, "gnhvl:c:b:i:o:p:s:f:L:t:")) != EOF) {
       switch (i) {
 	 case 'b':
 	    Buffername = strdup(optarg);
@@ -224,6 +366,12 @@ int main (int argc, char *argv[])
 	 case 's':
 	    Separator = strdup(optarg);
 	    break;
+	 case 'L':
+	    Libpath = strdup(optarg);
+	    break;
+	 case 't':
+	    Period = atof(optarg);
+	    break;
          case 'g':
 	    GatePrintFlag = 1;
 	    break;
@@ -268,6 +416,19 @@ int main (int argc, char *argv[])
    }
    i++;
 
+   if (Libpath != NULL) {
+
+      // Timing-driven mode:  The liberty file replaces gate.cfg
+
+      if (Buffername == NULL || buf_in_pin == NULL || buf_out_pin == NULL) {
+	 fprintf(stderr, "blifFanout:  Need name of buffer cell, and input/output pins.\n");
+	 exit(-1);
+      }
+      if (Separator == NULL) Separator = &default_sep;
+      timing_driven(infptr, outfptr);
+      goto summary;
+   }
+
    // Make sure we have a valid gate file path
    if (Gatepath == NULL) Gatepath = (char *)default_gatepath;
 
@@ -299,21 +460,21 @@ int main (int argc, char *argv[])
       exit(-1);
    }
 
+   loadstart = clock();
    state = NONE;
    while ((s = fgets(line, MAXLINE, infptr)) != NULL) {
       t = strtok(s, " \t=\n");
       while (t) {
 	 switch (state) {
 	    case GATENAME:
-	       for (gl = Gatel; gl->next; gl = gl->next) {
-		  if (!(strcmp(gl->gatename, t))) {
-		     if (VerboseFlag) printf("\n\n%s", t);
-		     gateinputs = gl->num_inputs;
-		     Input_node_num = 0;
-		     free(Gatename);
-		     Gatename = strdup(t);
-		     state = PINNAME;
-		  }
+	       gl = (struct Gatelist *)HashLookup(t, &Gatehash);
+	       if (gl != NULL) {
+		  if (VerboseFlag) printf("\n\n%s", t);
+		  gateinputs = gl->num_inputs;
+		  Input_node_num = 0;
+		  free(Gatename);
+		  Gatename = strdup(t);
+		  state = PINNAME;
 	       }
 	       break;
 
@@ -361,6 +522,11 @@ int main (int argc, char *argv[])
       }
    }
 
+   if (VerboseFlag) {
+      fprintf(stderr, "\nNetlist load:  %d nodes in %g seconds.\n",
+		Nodehash.nentries, (double)(clock() - loadstart) / CLOCKS_PER_SEC);
+   }
+
    /* get list of nets to ignore, if there is one, and mark nets to ignore */
    if (Ignorepath != NULL) read_ignore_file(Ignorepath);
 
@@ -402,6 +568,7 @@ int main (int argc, char *argv[])
   
    write_output(infptr, outfptr);
 
+summary:
    fprintf(stderr,"%d gates changed.\n", Changed_count);
 
    fprintf(stderr, "\nIn:\n");
@@ -452,6 +619,7 @@ int main (int argc, char *argv[])
 void read_ignore_file(char *ignore_file_name)
 {
    struct Nodelist *nl;
+   struct Tnet *tn;
    FILE *ignorefptr;
    char line[MAXLINE];
    char *s, *sp;
@@ -471,11 +639,13 @@ void read_ignore_file(char *ignore_file_name)
       while (*sp != '\0' && *sp != '\n' && !isspace(*sp)) sp++;
       *sp = '\0';
 
-      for (nl = Nodel; nl->next; nl = nl->next) {
-         if (!(strcmp(nl->nodename, s))) {
-	    nl->ignore = (char)1;
-	    break;
-         }
+      if (Libpath != NULL) {
+	 tn = (struct Tnet *)HashLookup(s, &Tnethash);
+	 if (tn != NULL) tn->ignore = (char)1;
+      }
+      else {
+	 nl = (struct Nodelist *)HashLookup(s, &Nodehash);
+	 if (nl != NULL) nl->ignore = (char)1;
       }
    }
    fclose(ignorefptr);
@@ -511,6 +681,7 @@ void read_gate_file(char *gate_file_name)
 
    Gatel = GatelistAlloc();
    gl = Gatel;
+   InitializeHashTable(&Gatehash, 256, FALSE);
 
    if (!(gatefptr = fopen(gate_file_name, "r"))) {
       fprintf(stderr, "blifFanout:  Couldn't open %s as gate file. exiting.\n",
@@ -574,6 +745,10 @@ void read_gate_file(char *gate_file_name)
 
 	 gl->strength = MaxLatency / gl->delay;
 
+	 // Gates listed more than once are found by their first entry
+	 if (HashLookup(gl->gatename, &Gatehash) == NULL)
+	    HashPtrInstall(gl->gatename, gl, &Gatehash);
+
 	 gl->next = GatelistAlloc();
 	 gl = gl->next;
 	 GateCount++;
@@ -669,53 +844,45 @@ void showgatelist(void)
 void registernode(char *nodename, int type)
 {
    struct Nodelist *nl;
-   struct Gatelist *gl;
+   struct Gatelist *gl = NULL;
 
-   for (nl = Nodel; nl->next; nl = nl->next) {
-      if (!(strcmp(nl->nodename, nodename))) {
-	 break;
-      }
-   }
+   nl = (struct Nodelist *)HashLookup(nodename, &Nodehash);
 
-   if (!nl->next) {
+   if (nl == NULL) {
+      // New node:  Fill in the empty record at the end of the list
+      nl = Nodelast;
       free(nl->nodename);
       nl->nodename = strdup(Nodename);
+      HashPtrInstall(nl->nodename, nl, &Nodehash);
+      nl->next = NodelistAlloc();
+      Nodelast = nl->next;
    }
 
    if (type == OUTPUT) {
       free(nl->outputgatename);
       nl->outputgatename = strdup(Gatename);
-      for (gl = Gatel; gl->next; gl = gl->next) {
-	 if (!(strcmp(Gatename, gl->gatename))) {
-	    nl->outputgatestrength = gl->strength;
-	    nl->total_load += gl->Cint;
-	    count_gatetype(Gatename, 1, 1);
-	    break;
-	 }
+      gl = (struct Gatelist *)HashLookup(Gatename, &Gatehash);
+      if (gl != NULL) {
+	 nl->outputgatestrength = gl->strength;
+	 nl->total_load += gl->Cint;
+	 count_gatetype(Gatename, 1, 1);
       }
    }
    else if (type == INPUT) {
-      for (gl = Gatel; gl->next; gl = gl->next) {
-	 if (!(strcmp(Gatename, gl->gatename))) {
-	    nl->total_load += gl->Cpin[Input_node_num];
-	    nl->num_inputs++;
-	    break;
-	 }
+      gl = (struct Gatelist *)HashLookup(Gatename, &Gatehash);
+      if (gl != NULL) {
+	 nl->total_load += gl->Cpin[Input_node_num];
+	 nl->num_inputs++;
       }
    }
    else if (type == OUTPUTPIN) {
       nl->is_outputpin = TRUE;
    }
 
-   if ((nl->is_outputpin == FALSE) && !gl->next) {
+   if ((nl->is_outputpin == FALSE) && (gl == NULL)) {
       fprintf(stderr, "\nError: gate %s not found\n", Gatename);
       fflush(stderr);
    }
-
-   if (!nl->next) {
-      nl->next = NodelistAlloc();
-      nl = nl->next;
-   }
 }
 
 /*
@@ -732,10 +899,7 @@ void count_gatetype(char *name, int num_in, int num_out)
    if ((s = find_suffix(name)) == NULL)
       return;
 
-   for (dl = Drivel; dl; dl = dl->next) {
-      if (!strcmp(dl->DriveType, s))
-	 break;
-   }
+   dl = (struct Drivelist *)HashLookup(s, &Drivehash);
 
    if (dl == NULL) {
 
@@ -747,6 +911,7 @@ void count_gatetype(char *name, int num_in, int num_out)
 
       free(dl->DriveType);
       dl->DriveType = strdup(s);
+      HashPtrInstall(dl->DriveType, dl, &Drivehash);
    }
 
    dl->NgatesIn += num_in;	// Number of these gates before processing
@@ -808,15 +973,14 @@ void write_output(FILE *infptr, FILE *outfptr)
       while (t) { 
 	 switch (state) {
 	    case GATENAME:
-	       for (gl = Gatel; gl->next; gl = gl->next) {
-		  if (!(strcmp(gl->gatename, t))) {
-		     gateinputs = gl->num_inputs;
-		     Input_node_num = 0;
-		     needscorrecting = 0;
-		     free(Gatename);
-		     Gatename = strdup(t);
-		     state = PINNAME;
-		  }
+	       gl = (struct Gatelist *)HashLookup(t, &Gatehash);
+	       if (gl != NULL) {
+		  gateinputs = gl->num_inputs;
+		  Input_node_num = 0;
+		  needscorrecting = 0;
+		  free(Gatename);
+		  Gatename = strdup(t);
+		  state = PINNAME;
 	       }
 	       break;
 	  
@@ -840,35 +1004,33 @@ void write_output(FILE *infptr, FILE *outfptr)
 	       free(Nodename);
 	       Nodename = strdup(t);
 
-	       for (nl = Nodel; nl->next ; nl = nl->next) {
-		  if (!strcmp(Nodename, nl->nodename)) {
-		     if ((nl->ignore == FALSE) && (nl->ratio > 1.0)) {
-			if (VerboseFlag)
-			   printf("\nGate should be %g times stronger", nl->ratio);
-			needscorrecting = TRUE;
-			orig = find_size(Gatename);
-			stren = best_size(Gatename, nl->total_load + WireCap, NULL);
-			if (stren && VerboseFlag)
-			   printf("\nGate changed from %s to %s\n", Gatename, stren);
-			inv_size = nl->total_load;
-		     }
+	       nl = (struct Nodelist *)HashLookup(Nodename, &Nodehash);
+	       if (nl != NULL) {
+		  if ((nl->ignore == FALSE) && (nl->ratio > 1.0)) {
+		     if (VerboseFlag)
+			printf("\nGate should be %g times stronger", nl->ratio);
+		     needscorrecting = TRUE;
+		     orig = find_size(Gatename);
+		     stren = best_size(Gatename, nl->total_load + WireCap, NULL);
+		     if (stren && VerboseFlag)
+			printf("\nGate changed from %s to %s\n", Gatename, stren);
+		     inv_size = nl->total_load;
+		  }
 
-		     // Is this node an output pin?  Check required output drive.
-		     if ((nl->ignore == FALSE) && (nl->is_outputpin == TRUE)) {
-		        orig = find_size(Gatename);
-			stren = best_size(Gatename, nl->total_load + MaxOutputCap
+		  // Is this node an output pin?  Check required output drive.
+		  if ((nl->ignore == FALSE) && (nl->is_outputpin == TRUE)) {
+		     orig = find_size(Gatename);
+		     stren = best_size(Gatename, nl->total_load + MaxOutputCap
 					+ WireCap, NULL);
-			if (stren && strcmp(stren, Gatename)) {
-			   needscorrecting = TRUE;
-			   if (VerboseFlag)
-			      printf("\nOutput Gate changed from %s to %s\n",
+		     if (stren && strcmp(stren, Gatename)) {
+			needscorrecting = TRUE;
+			if (VerboseFlag)
+			   printf("\nOutput Gate changed from %s to %s\n",
 					Gatename, stren);
-			}
 		     }
-		     // Don't attempt to correct gates for which we cannot find a suffix
-		     if (orig == NULL) needscorrecting = FALSE;
-		     break;
 		  }
+		  // Don't attempt to correct gates for which we cannot find a suffix
+		  if (orig == NULL) needscorrecting = FALSE;
 	       }
 	       state = PINNAME;
 	       break;
@@ -915,32 +1077,17 @@ void write_output(FILE *infptr, FILE *outfptr)
 		  }
 		  cend = find_size(cbest);
 
-		  // This really ought to be done with hash tables. . .
-		  for (dl = Drivel; dl; dl = dl->next) {
-		     if (!strcmp(dl->DriveType, cend)) {
-			dl->NgatesOut++;
-			break;
-		     }
-		  }
+		  dl = (struct Drivelist *)HashLookup(cend, &Drivehash);
+		  if (dl != NULL) dl->NgatesOut++;
 
 		  /* Recompute size of the gate driving the buffer */
 		  sprintf(bufferline, "%s", cbest);
-	          for (nl = Nodel; nl->next ; nl = nl->next) {
-		     if (!strcmp(Nodename, nl->nodename)) {
-	                for (gl = Gatel; gl->next; gl = gl->next) {
-		           if (!(strcmp(gl->gatename, bufferline))) {
-		              nl->total_load = gl->Cpin[0];
-			      break;
-			   }
-			}
-	                for (gl = Gatel; gl->next; gl = gl->next) {
-		           if (!(strcmp(gl->gatename, Gatename))) {
-		              nl->total_load += gl->Cint;
-			      break;
-			   }
-			}
-			break;
-		     }
+		  nl = (struct Nodelist *)HashLookup(Nodename, &Nodehash);
+		  if (nl != NULL) {
+		     gl = (struct Gatelist *)HashLookup(bufferline, &Gatehash);
+		     if (gl != NULL) nl->total_load = gl->Cpin[0];
+		     gl = (struct Gatelist *)HashLookup(Gatename, &Gatehash);
+		     if (gl != NULL) nl->total_load += gl->Cint;
 		  }
 		  orig = find_size(Gatename);
 		  stren = best_size(Gatename, nl->total_load + WireCap, NULL);
@@ -1106,6 +1253,1883 @@ char *best_size(char *gatename, double amount, char *overload)
    return stren;
 }
 
+/*
+ *---------------------------------------------------------------------------
+ * Timing-driven mode
+ *
+ * With "-L <liberty>", the cell timing tables are read from the liberty
+ * file, and arrival times and slack are computed for the netlist.  Gates
+ * on the critical path are then resized, and buffers are inserted to
+ * take non-critical receivers off of critical nets, one change at a
+ * time, and only where the worst slack improves.  After each change,
+ * arrival times are updated incrementally, starting at the gates whose
+ * load or cell changed and stopping wherever the arrival times do not
+ * change.  Nets off of the critical path are left alone.
+ *
+ * With "-t <period>", the optimization stops as soon as the design meets
+ * the clock period, and then gates are downsized wherever the period is
+ * still met, to recover area.  If the period cannot be met, no gates are
+ * downsized.  Without a period, the critical path is improved until no
+ * further change gains anything.
+ *
+ * The delay model is that of the liberty tables:  Rise and fall delays
+ * and transition times are looked up by input transition time and output
+ * load, and the worse of rise and fall is kept.  Flops and latches start
+ * paths at their clock pins and end paths at inputs with a setup check.
+ *---------------------------------------------------------------------------
+ */
+
+/*
+ *---------------------------------------------------------------------------
+ * Liberty file tokenizer.  Returns punctuation "(){}:;," as
+ * single tokens, and quoted strings without the quotes.
+ *---------------------------------------------------------------------------
+ */
+
+FILE *Libfptr;
+char *Libpushback = NULL;
+
+static char *libtoken(void)
+{
+   static char *token = NULL;
+   static int toksize = 0;
+   char *t;
+   int c, n;
+
+   if (Libpushback != NULL) {
+      t = Libpushback;
+      Libpushback = NULL;
+      return t;
+   }
+   if (token == NULL) {
+      toksize = 256;
+      token = (char *)malloc(toksize);
+   }
+
+   while (1) {
+      c = getc(Libfptr);
+      if (c == EOF) return NULL;
+      if (isspace(c) || (c == '\\')) continue;
+      if (c == '/') {
+	 c = getc(Libfptr);
+	 if (c == '*') {
+	    n = 0;
+	    while ((c = getc(Libfptr)) != EOF) {
+	       if ((n == '*') && (c == '/')) break;
+	       n = c;
+	    }
+	    continue;
+	 }
+	 ungetc(c, Libfptr);
+	 c = '/';
+      }
+      break;
+   }
+
+   n = 0;
+   if (c == '\"') {
+      while (((c = getc(Libfptr)) != EOF) && (c != '\"')) {
+	 if (c == '\\') {
+	    c = getc(Libfptr);
+	    if (c == '\n') continue;
+	 }
+	 if (n >= toksize - 1) {
+	    toksize *= 2;
+	    token = (char *)realloc(token, toksize);
+	 }
+	 token[n++] = c;
+      }
+   }
+   else if (strchr("(){}:;,", c) != NULL) {
+      token[n++] = c;
+   }
+   else {
+      while (1) {
+	 if (n >= toksize - 1) {
+	    toksize *= 2;
+	    token = (char *)realloc(token, toksize);
+	 }
+	 token[n++] = c;
+	 c = getc(Libfptr);
+	 if ((c == EOF) || isspace(c) || (strchr("(){}:;,\"", c) != NULL)) {
+	    if (c != EOF) ungetc(c, Libfptr);
+	    break;
+	 }
+      }
+   }
+   token[n] = '\0';
+   return token;
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Parse a list of numbers from a liberty string, appending
+ * them to "*list", which has "*count" entries.
+ *---------------------------------------------------------------------------
+ */
+
+static void lib_numbers(char *s, double **list, int *count)
+{
+   char *end;
+   double v;
+
+   while (*s != '\0') {
+      v = strtod(s, &end);
+      if (end == s) {
+	 s++;
+	 continue;
+      }
+      *list = (double *)realloc(*list, (*count + 1) * sizeof(double));
+      (*list)[(*count)++] = v;
+      s = end;
+   }
+}
+
+static char lib_varkind(char *name)
+{
+   if (!strcasecmp(name, "input_net_transition") ||
+		!strcasecmp(name, "constrained_pin_transition"))
+      return VAR_TRANS;
+   else if (!strcasecmp(name, "total_output_net_capacitance"))
+      return VAR_LOAD;
+   return VAR_OTHER;
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Convert a table read from the liberty file to ps and fF.
+ *---------------------------------------------------------------------------
+ */
+
+static void lib_scale_table(struct Libtable *t, char isdelay)
+{
+   int i;
+
+   for (i = 0; i < t->size1; i++)
+      t->index1[i] *= (t->var1 == VAR_LOAD) ? CapScale : TimeScale;
+   for (i = 0; i < t->size2; i++)
+      t->index2[i] *= (t->var2 == VAR_LOAD) ? CapScale : TimeScale;
+   if (isdelay)
+      for (i = 0; i < t->size1 * t->size2; i++)
+	 t->values[i] *= TimeScale;
+}
+
+// Parser contexts
+
+#define LIB_TOP		0
+#define LIB_LIBRARY	1
+#define LIB_TEMPLATE	2
+#define LIB_CELL	3
+#define LIB_PIN		4
+#define LIB_TIMING	5
+#define LIB_TABLE	6
+#define LIB_SKIP	7
+
+/*
+ *---------------------------------------------------------------------------
+ * Parse the contents of a liberty group up to its closing
+ * brace.  "obj" is the record being filled in for "context".
+ * Only what the timing-driven mode needs is kept;  all other
+ * groups and attributes are skipped.
+ *---------------------------------------------------------------------------
+ */
+
+static void lib_group(int context, void *obj)
+{
+   char *tok, *name, *value, **args;
+   int nargs, i;
+   double *nums;
+   int numcount;
+   struct Libtemplate *tmpl;
+   struct Libtable *table;
+   struct Libcell *cell;
+   struct Libpin *pin;
+   struct Libarc *arc;
+
+   while ((tok = libtoken()) != NULL) {
+      if (!strcmp(tok, "}")) return;
+      if (!strcmp(tok, ";")) continue;
+      name = strdup(tok);
+
+      tok = libtoken();
+      if (tok == NULL) {
+	 free(name);
+	 return;
+      }
+
+      if (!strcmp(tok, ":")) {
+
+	 /* Simple attribute "name : value ;" */
+
+	 tok = libtoken();
+	 value = strdup((tok) ? tok : "");
+	 tok = libtoken();
+	 if (tok && strcmp(tok, ";")) Libpushback = tok;
+
+	 if ((context == LIB_LIBRARY) && !strcasecmp(name, "time_unit")) {
+	    TimeScale = strtod(value, &tok);
+	    if (TimeScale == 0.0) TimeScale = 1.0;
+	    if (!strncasecmp(tok, "ns", 2)) TimeScale *= 1000.0;
+	    else if (!strncasecmp(tok, "us", 2)) TimeScale *= 1.0E6;
+	    else if (!strncasecmp(tok, "fs", 2)) TimeScale *= 1.0E-3;
+	 }
+	 else if (context == LIB_TEMPLATE) {
+	    tmpl = (struct Libtemplate *)obj;
+	    if (!strcasecmp(name, "variable_1"))
+	       tmpl->table.var1 = lib_varkind(value);
+	    else if (!strcasecmp(name, "variable_2"))
+	       tmpl->table.var2 = lib_varkind(value);
+	 }
+	 else if ((context == LIB_CELL) && !strcasecmp(name, "area")) {
+	    ((struct Libcell *)obj)->area = atof(value);
+	 }
+	 else if (context == LIB_PIN) {
+	    pin = (struct Libpin *)obj;
+	    if (!strcasecmp(name, "direction"))
+	       pin->output = (!strcasecmp(value, "output")) ? TRUE : FALSE;
+	    else if (!strcasecmp(name, "capacitance"))
+	       pin->cap = atof(value) * CapScale;
+	 }
+	 else if (context == LIB_TIMING) {
+	    arc = (struct Libarc *)obj;
+	    if (!strcasecmp(name, "related_pin")) {
+	       free(arc->relpin);
+	       arc->relpin = strdup(value);
+	    }
+	    else if (!strcasecmp(name, "timing_type")) {
+	       if (!strcasecmp(value, "combinational"))
+		  arc->type = ARC_COMB;
+	       else if (!strcasecmp(value, "rising_edge") ||
+			!strcasecmp(value, "falling_edge"))
+		  arc->type = ARC_CLOCK;
+	       else if (!strcasecmp(value, "setup_rising") ||
+			!strcasecmp(value, "setup_falling"))
+		  arc->type = ARC_SETUP;
+	       else
+		  arc->type = ARC_IGNORE;
+	    }
+	 }
+	 free(value);
+      }
+      else if (!strcmp(tok, "(")) {
+
+	 /* Group "name (args) { ... }" or complex attribute "name (args) ;" */
+
+	 args = NULL;
+	 nargs = 0;
+	 while (((tok = libtoken()) != NULL) && strcmp(tok, ")")) {
+	    if (!strcmp(tok, ",")) continue;
+	    args = (char **)realloc(args, (nargs + 1) * sizeof(char *));
+	    args[nargs++] = strdup(tok);
+	 }
+	 tok = libtoken();
+
+	 if (tok && !strcmp(tok, "{")) {
+	    if ((context == LIB_TOP) && !strcasecmp(name, "library"))
+	       lib_group(LIB_LIBRARY, NULL);
+	    else if ((context == LIB_LIBRARY) && (nargs > 0) &&
+			(!strcasecmp(name, "lu_table_template"))) {
+	       tmpl = (struct Libtemplate *)calloc(1, sizeof(struct Libtemplate));
+	       tmpl->name = strdup(args[0]);
+	       tmpl->next = Libtemplates;
+	       Libtemplates = tmpl;
+	       lib_group(LIB_TEMPLATE, tmpl);
+	    }
+	    else if ((context == LIB_LIBRARY) && (nargs > 0) &&
+			(!strcasecmp(name, "cell"))) {
+	       cell = (struct Libcell *)calloc(1, sizeof(struct Libcell));
+	       cell->name = strdup(args[0]);
+	       lib_group(LIB_CELL, cell);
+	       cell->next = Libcells;
+	       Libcells = cell;
+	       if (HashLookup(cell->name, &Libhash) == NULL)
+		  HashPtrInstall(cell->name, cell, &Libhash);
+	    }
+	    else if ((context == LIB_CELL) && (!strcasecmp(name, "ff") ||
+			!strcasecmp(name, "latch"))) {
+	       ((struct Libcell *)obj)->seq = TRUE;
+	       lib_group(LIB_SKIP, NULL);
+	    }
+	    else if ((context == LIB_CELL) && (nargs > 0) &&
+			(!strcasecmp(name, "pin"))) {
+	       cell = (struct Libcell *)obj;
+	       pin = (struct Libpin *)calloc(1, sizeof(struct Libpin));
+	       pin->name = strdup(args[0]);
+	       lib_group(LIB_PIN, pin);
+	       pin->next = cell->pins;
+	       cell->pins = pin;
+	    }
+	    else if ((context == LIB_PIN) && !strcasecmp(name, "timing")) {
+	       pin = (struct Libpin *)obj;
+	       arc = (struct Libarc *)calloc(1, sizeof(struct Libarc));
+	       arc->type = ARC_COMB;
+	       lib_group(LIB_TIMING, arc);
+	       if ((arc->type == ARC_IGNORE) || (arc->relpin == NULL))
+		  free(arc);		/* (tables are not reclaimed) */
+	       else {
+		  arc->next = pin->arcs;
+		  pin->arcs = arc;
+	       }
+	    }
+	    else if (context == LIB_TIMING) {
+	       arc = (struct Libarc *)obj;
+	       table = (struct Libtable *)calloc(1, sizeof(struct Libtable));
+	       if (nargs > 0) {
+		  for (tmpl = Libtemplates; tmpl; tmpl = tmpl->next)
+		     if (!strcmp(tmpl->name, args[0])) break;
+		  if (tmpl != NULL) {
+		     table->var1 = tmpl->table.var1;
+		     table->var2 = tmpl->table.var2;
+		     table->size1 = tmpl->table.size1;
+		     table->size2 = tmpl->table.size2;
+		     table->index1 = (double *)malloc((table->size1 + 1)
+				* sizeof(double));
+		     table->index2 = (double *)malloc((table->size2 + 1)
+				* sizeof(double));
+		     for (i = 0; i < table->size1; i++)
+			table->index1[i] = tmpl->table.index1[i];
+		     for (i = 0; i < table->size2; i++)
+			table->index2[i] = tmpl->table.index2[i];
+		  }
+	       }
+	       lib_group(LIB_TABLE, table);
+
+	       // A table with no index is a single value
+
+	       if (table->size1 == 0) table->size1 = 1;
+	       if (table->size2 == 0) table->size2 = 1;
+	       if (table->index1 == NULL)
+		  table->index1 = (double *)calloc(1, sizeof(double));
+	       if (table->index2 == NULL)
+		  table->index2 = (double *)calloc(1, sizeof(double));
+
+	       if (table->values == NULL) {
+		  free(table);
+		  table = NULL;
+	       }
+	       else
+		  lib_scale_table(table, TRUE);
+
+	       if (!strcasecmp(name, "cell_rise") ||
+			!strcasecmp(name, "rise_constraint"))
+		  arc->delay[0] = table;
+	       else if (!strcasecmp(name, "cell_fall") ||
+			!strcasecmp(name, "fall_constraint"))
+		  arc->delay[1] = table;
+	       else if (!strcasecmp(name, "rise_transition"))
+		  arc->trans[0] = table;
+	       else if (!strcasecmp(name, "fall_transition"))
+		  arc->trans[1] = table;
+	    }
+	    else
+	       lib_group(LIB_SKIP, NULL);
+	 }
+	 else {
+	    if (tok && strcmp(tok, ";")) Libpushback = tok;
+
+	    if ((context == LIB_LIBRARY) && (nargs > 1) &&
+			!strcasecmp(name, "capacitive_load_unit")) {
+	       CapScale = atof(args[0]);
+	       if (!strcasecmp(args[1], "pf")) CapScale *= 1000.0;
+	       else if (!strcasecmp(args[1], "nf")) CapScale *= 1.0E6;
+	       else if (!strcasecmp(args[1], "af")) CapScale *= 1.0E-3;
+	    }
+	    else if ((context == LIB_TEMPLATE) || (context == LIB_TABLE)) {
+	       table = (context == LIB_TEMPLATE) ?
+			&((struct Libtemplate *)obj)->table :
+			(struct Libtable *)obj;
+	       nums = NULL;
+	       numcount = 0;
+	       for (i = 0; i < nargs; i++)
+		  lib_numbers(args[i], &nums, &numcount);
+
+	       if (!strcasecmp(name, "index_1")) {
+		  free(table->index1);
+		  table->index1 = nums;
+		  table->size1 = numcount;
+	       }
+	       else if (!strcasecmp(name, "index_2")) {
+		  free(table->index2);
+		  table->index2 = nums;
+		  table->size2 = numcount;
+	       }
+	       else if (!strcasecmp(name, "values") && (context == LIB_TABLE)) {
+		  if (numcount != ((table->size1 > 0) ? table->size1 : 1) *
+				((table->size2 > 0) ? table->size2 : 1)) {
+		     // Mismatched table:  Keep the first value only
+		     table->size1 = table->size2 = 0;
+		  }
+		  table->values = nums;
+	       }
+	       else
+		  free(nums);
+	    }
+	 }
+	 for (i = 0; i < nargs; i++) free(args[i]);
+	 free(args);
+      }
+      else if (!strcmp(tok, "{")) {
+	 lib_group(LIB_SKIP, NULL);
+      }
+      else {
+	 Libpushback = tok;
+      }
+      free(name);
+   }
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Read the liberty file "libname".  Mark the clock pins and
+ * the path end pins of each flop and latch.
+ *---------------------------------------------------------------------------
+ */
+
+void read_liberty(char *libname)
+{
+   struct Libcell *cell;
+   struct Libpin *pin, *pin2;
+   struct Libarc *arc;
+   int numcells = 0;
+
+   if (!(Libfptr = fopen(libname, "r"))) {
+      fprintf(stderr, "blifFanout:  Couldn't open %s as liberty file. exiting.\n",
+		libname);
+      fflush(stderr);
+      exit(-2);
+   }
+   InitializeHashTable(&Libhash, 256, FALSE);
+   lib_group(LIB_TOP, NULL);
+   fclose(Libfptr);
+
+   for (cell = Libcells; cell; cell = cell->next) {
+      numcells++;
+      for (pin = cell->pins; pin; pin = pin->next) {
+	 for (arc = pin->arcs; arc; arc = arc->next) {
+	    if (arc->type == ARC_SETUP)
+	       pin->setup = TRUE;
+	    else if (arc->type == ARC_CLOCK) {
+	       for (pin2 = cell->pins; pin2; pin2 = pin2->next)
+		  if (!strcmp(pin2->name, arc->relpin))
+		     pin2->clock = TRUE;
+	    }
+	 }
+      }
+   }
+   if (VerboseFlag)
+      fprintf(stderr, "Read %d cells from liberty file %s\n", numcells, libname);
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Look up a value in a table by input transition time "trans"
+ * and output load "load", interpolating or extrapolating
+ * linearly in each index.
+ *---------------------------------------------------------------------------
+ */
+
+static int table_segment(double *index, int size, double x)
+{
+   int i;
+
+   if (size < 2) return 0;
+   for (i = 0; i < size - 2; i++)
+      if (x < index[i + 1]) break;
+   return i;
+}
+
+static double table_value(struct Libtable *t, double trans, double load)
+{
+   double x1, x2, f1, f2, v0, v1;
+   int i, j, i2, j2;
+
+   if (t == NULL) return 0.0;
+   if (t->size1 == 0) return t->values[0];
+
+   x1 = (t->var1 == VAR_TRANS) ? trans : (t->var1 == VAR_LOAD) ? load : 0.0;
+   x2 = (t->var2 == VAR_TRANS) ? trans : (t->var2 == VAR_LOAD) ? load : 0.0;
+
+   i = table_segment(t->index1, t->size1, x1);
+   j = table_segment(t->index2, t->size2, x2);
+   i2 = (t->size1 > 1) ? i + 1 : i;
+   j2 = (t->size2 > 1) ? j + 1 : j;
+   f1 = (i2 == i) ? 0.0 : (x1 - t->index1[i]) / (t->index1[i2] - t->index1[i]);
+   f2 = (j2 == j) ? 0.0 : (x2 - t->index2[j]) / (t->index2[j2] - t->index2[j]);
+
+   v0 = t->values[i * t->size2 + j] + f2 * (t->values[i * t->size2 + j2]
+		- t->values[i * t->size2 + j]);
+   v1 = t->values[i2 * t->size2 + j] + f2 * (t->values[i2 * t->size2 + j2]
+		- t->values[i2 * t->size2 + j]);
+   return v0 + f1 * (v1 - v0);
+}
+
+/* The worse of the rise and fall tables */
+
+static double arc_value(struct Libtable **tables, double trans, double load)
+{
+   double r, f;
+
+   r = table_value(tables[0], trans, load);
+   f = table_value(tables[1], trans, load);
+   return (r > f) ? r : f;
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Netlist for the timing-driven mode
+ *---------------------------------------------------------------------------
+ */
+
+static struct Tnet *get_tnet(char *name)
+{
+   struct Tnet *net;
+
+   net = (struct Tnet *)HashLookup(name, &Tnethash);
+   if (net == NULL) {
+      net = (struct Tnet *)calloc(1, sizeof(struct Tnet));
+      net->name = strdup(name);
+      HashPtrInstall(net->name, net, &Tnethash);
+   }
+   return net;
+}
+
+static void add_receiver(struct Tnet *net, struct Tpin *pin)
+{
+   pin->net = net;
+   pin->nextrcv = net->receivers;
+   net->receivers = pin;
+}
+
+static void remove_receiver(struct Tnet *net, struct Tpin *pin)
+{
+   struct Tpin **pp;
+
+   for (pp = &net->receivers; *pp; pp = &(*pp)->nextrcv) {
+      if (*pp == pin) {
+	 *pp = pin->nextrcv;
+	 break;
+      }
+   }
+   pin->nextrcv = NULL;
+}
+
+/* Point the pins of "gate" at the pins of its current cell */
+
+static void bind_pins(struct Tgate *gate)
+{
+   struct Libpin *lpin;
+   int i;
+
+   for (i = 0; i < gate->npins; i++) {
+      gate->pins[i].lpin = NULL;
+      if (gate->cell == NULL) continue;
+      for (lpin = gate->cell->pins; lpin; lpin = lpin->next)
+	 if (!strcmp(lpin->name, gate->pins[i].name)) {
+	    gate->pins[i].lpin = lpin;
+	    break;
+	 }
+   }
+}
+
+static struct Tgate *new_tgate(char *cellname, int npins)
+{
+   struct Tgate *gate;
+
+   gate = (struct Tgate *)calloc(1, sizeof(struct Tgate));
+   gate->cellname = strdup(cellname);
+   gate->cell = (struct Libcell *)HashLookup(cellname, &Libhash);
+   gate->origcell = gate->cell;
+   gate->npins = npins;
+   gate->pins = (struct Tpin *)calloc(npins, sizeof(struct Tpin));
+   if (Tgatelast == NULL)
+      Tgates = gate;
+   else
+      Tgatelast->next = gate;
+   Tgatelast = gate;
+   Tgatecount++;
+   return gate;
+}
+
+/* Connect pin "pin" of "gate" as a driver or receiver of "net" */
+
+static void connect_pin(struct Tgate *gate, struct Tpin *pin, struct Tnet *net)
+{
+   pin->gate = gate;
+   pin->endindex = -1;
+   if (pin->lpin && pin->lpin->output) {
+      pin->net = net;
+      if (net->driver != NULL)
+	 fprintf(stderr, "Warning:  Net %s has more than one driver\n", net->name);
+      net->driver = pin;
+   }
+   else
+      add_receiver(net, pin);
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Read one record of the BLIF file, joining continuation
+ * lines.  The record is returned in "*record" (allocated and
+ * grown as needed), and the original text in "*text".
+ *---------------------------------------------------------------------------
+ */
+
+static int read_record(FILE *infptr, char **record, int *recsize, char **text,
+		int *textsize)
+{
+   char line[MAXLINE];
+   int len, rlen = 0, tlen = 0;
+   char more;
+
+   (*record)[0] = '\0';
+   (*text)[0] = '\0';
+   do {
+      if (fgets(line, MAXLINE, infptr) == NULL) return (tlen > 0);
+      len = strlen(line);
+      if (tlen + len + 1 > *textsize) {
+	 *textsize = 2 * (tlen + len + 1);
+	 *text = (char *)realloc(*text, *textsize);
+      }
+      strcpy(*text + tlen, line);
+      tlen += len;
+
+      more = FALSE;
+      while ((len > 0) && isspace(line[len - 1])) line[--len] = '\0';
+      if ((len > 0) && (line[len - 1] == '\\')) {
+	 line[--len] = '\0';
+	 more = TRUE;
+      }
+      if (rlen + len + 2 > *recsize) {
+	 *recsize = 2 * (rlen + len + 2);
+	 *record = (char *)realloc(*record, *recsize);
+      }
+      strcpy(*record + rlen, line);
+      rlen += len;
+      (*record)[rlen++] = ' ';
+      (*record)[rlen] = '\0';
+   } while (more);
+   return 1;
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Read the netlist for the timing-driven mode.
+ *---------------------------------------------------------------------------
+ */
+
+static void read_timing_netlist(FILE *infptr)
+{
+   char *record, *text, *t, *eq;
+   int recsize = MAXLINE, textsize = MAXLINE;
+   char **tokens = NULL;
+   int ntokens, maxtokens = 0, i, unknown = 0;
+   struct Tgate *gate;
+   struct Tpin *pin;
+   struct Tnet *net;
+
+   record = (char *)malloc(recsize);
+   text = (char *)malloc(textsize);
+   InitializeHashTable(&Tnethash, 1024, FALSE);
+
+   while (read_record(infptr, &record, &recsize, &text, &textsize)) {
+      ntokens = 0;
+      for (t = strtok(record, " \t\n"); t; t = strtok(NULL, " \t\n")) {
+	 if (ntokens >= maxtokens) {
+	    maxtokens = 2 * maxtokens + 16;
+	    tokens = (char **)realloc(tokens, maxtokens * sizeof(char *));
+	 }
+	 tokens[ntokens++] = t;
+      }
+      if (ntokens == 0) continue;
+
+      if (!strcmp(tokens[0], ".outputs")) {
+	 for (i = 1; i < ntokens; i++) {
+	    net = get_tnet(tokens[i]);
+	    pin = (struct Tpin *)calloc(1, sizeof(struct Tpin));
+	    pin->name = strdup(tokens[i]);
+	    pin->endindex = -1;
+	    add_receiver(net, pin);
+	 }
+      }
+      else if (!strcmp(tokens[0], ".gate") && (ntokens > 1)) {
+	 gate = new_tgate(tokens[1], ntokens - 2);
+	 if (gate->cell == NULL) {
+	    if (unknown++ == 0 || VerboseFlag)
+	       fprintf(stderr, "Warning:  Cell %s is not in the liberty file\n",
+			tokens[1]);
+	 }
+	 for (i = 2; i < ntokens; i++) {
+	    eq = strchr(tokens[i], '=');
+	    if (eq != NULL) *eq++ = '\0';
+	    gate->pins[i - 2].name = strdup(tokens[i]);
+	    tokens[i] = eq;			/* Net name, or NULL */
+	 }
+	 bind_pins(gate);
+	 for (i = 2; i < ntokens; i++) {
+	    gate->pins[i - 2].gate = gate;
+	    gate->pins[i - 2].endindex = -1;
+	    if (tokens[i] != NULL)
+	       connect_pin(gate, &gate->pins[i - 2], get_tnet(tokens[i]));
+	 }
+	 count_gatetype(tokens[1], 1, 1);
+      }
+   }
+   if (unknown > 1)
+      fprintf(stderr, "Warning:  %d gates have cells not in the liberty file\n",
+		unknown);
+
+   free(record);
+   free(text);
+   free(tokens);
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Timing analysis
+ *---------------------------------------------------------------------------
+ */
+
+/* Compute the load on "net" from its receivers */
+
+static void net_load(struct Tnet *net)
+{
+   struct Tpin *rcv;
+
+   net->load = WireCap;
+   for (rcv = net->receivers; rcv; rcv = rcv->nextrcv) {
+      if (rcv->gate == NULL)
+	 net->load += MaxOutputCap;
+      else if (rcv->lpin != NULL)
+	 net->load += rcv->lpin->cap;
+   }
+}
+
+/* Return TRUE if a change at receiver "rcv" can change the	*/
+/* outputs of its gate (that is, anything but the data inputs	*/
+/* of flops and latches, and module outputs).			*/
+
+static int timing_edge(struct Tpin *rcv)
+{
+   if (rcv->gate == NULL) return FALSE;
+   if ((rcv->gate->cell != NULL) && rcv->gate->cell->seq)
+      return (rcv->lpin != NULL) && rcv->lpin->clock;
+   return TRUE;
+}
+
+static struct Tpin *clock_pin(struct Tgate *gate)
+{
+   int i;
+
+   for (i = 0; i < gate->npins; i++)
+      if (gate->pins[i].lpin && gate->pins[i].lpin->clock)
+	 return &gate->pins[i];
+   return NULL;
+}
+
+/* Name used for a gate in messages:  the net it drives */
+
+static char *gate_label(struct Tgate *gate)
+{
+   int i;
+
+   for (i = 0; i < gate->npins; i++)
+      if (gate->pins[i].lpin && gate->pins[i].lpin->output && gate->pins[i].net)
+	 return gate->pins[i].net->name;
+   return gate->cellname;
+}
+
+/* Required arrival time at the path end "pin" */
+
+static double end_required(struct Tpin *pin)
+{
+   struct Tpin *clk;
+   struct Libarc *arc;
+   double setup, s;
+
+   if (pin->gate == NULL) return Period;
+
+   clk = clock_pin(pin->gate);
+   setup = 0.0;
+   for (arc = pin->lpin->arcs; arc; arc = arc->next) {
+      if (arc->type != ARC_SETUP) continue;
+      s = arc_value(arc->delay, pin->net->slew, 0.0);
+      if (s > setup) setup = s;
+   }
+   return Period + ((clk && clk->net) ? clk->net->arrival : 0.0) - setup;
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * While a change is being tried, the old values of everything that the
+ * change updates are kept in Journal, so that the change can be undone
+ * without evaluating the gates again.
+ *---------------------------------------------------------------------------
+ */
+
+static void journal_record(struct Tnet *net, int endindex)
+{
+   struct Tjournal *jp;
+
+   if (Journalcount >= Journalsize) {
+      Journalsize = 2 * Journalsize + 256;
+      Journal = (struct Tjournal *)realloc(Journal, Journalsize
+		* sizeof(struct Tjournal));
+      if (Journal == NULL) {
+	 fprintf(stderr, "blifFanout:  Out of memory.\n");
+	 exit(-1);
+      }
+   }
+   jp = &Journal[Journalcount++];
+   jp->net = net;
+   jp->endindex = endindex;
+   if (net != NULL) {
+      jp->arrival = net->arrival;
+      jp->slew = net->slew;
+      jp->srcpin = net->srcpin;
+   }
+   else
+      jp->arrival = Endtree[Endtreesize + endindex];
+}
+
+static void set_end(int index, double slack);
+
+/* Put back everything recorded in the journal, latest first */
+
+static void journal_undo(void)
+{
+   struct Tjournal *jp;
+
+   Journaling = FALSE;
+   while (Journalcount > 0) {
+      jp = &Journal[--Journalcount];
+      if (jp->net != NULL) {
+	 jp->net->arrival = jp->arrival;
+	 jp->net->slew = jp->slew;
+	 jp->net->srcpin = jp->srcpin;
+      }
+      else
+	 set_end(jp->endindex, jp->arrival);
+   }
+}
+
+static void set_end(int index, double slack)
+{
+   int j;
+
+   j = Endtreesize + index;
+   if (Journaling) journal_record(NULL, index);
+   Endtree[j] = slack;
+   for (j >>= 1; j > 0; j >>= 1)
+      Endtree[j] = (Endtree[2 * j] < Endtree[2 * j + 1]) ?
+		Endtree[2 * j] : Endtree[2 * j + 1];
+}
+
+static void update_pin_end(struct Tpin *pin)
+{
+   if ((pin->endindex >= 0) && (pin->net != NULL))
+      set_end(pin->endindex, end_required(pin) - pin->net->arrival);
+}
+
+static void update_gate_ends(struct Tgate *gate)
+{
+   int i;
+
+   for (i = 0; i < gate->npins; i++)
+      update_pin_end(&gate->pins[i]);
+}
+
+static double end_slack(int index)
+{
+   return Endtree[Endtreesize + index];
+}
+
+/* Index of the path end with the worst slack */
+
+static int worst_end(void)
+{
+   int j = 1;
+
+   while (j < Endtreesize)
+      j = (Endtree[2 * j] <= Endtree[2 * j + 1]) ? 2 * j : 2 * j + 1;
+   return j - Endtreesize;
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Work list of gates to evaluate, in order of level.
+ *---------------------------------------------------------------------------
+ */
+
+static void push_gate(struct Tgate *gate)
+{
+   int i, p;
+
+   if (gate->queued) return;
+   gate->queued = TRUE;
+   if (Theapcount >= Theapsize) {
+      Theapsize = 2 * Theapsize + 64;
+      Theap = (struct Tgate **)realloc(Theap, Theapsize * sizeof(struct Tgate *));
+      if (Theap == NULL) {
+	 fprintf(stderr, "blifFanout:  Out of memory.\n");
+	 exit(-1);
+      }
+   }
+   for (i = Theapcount++; i > 0; i = p) {
+      p = (i - 1) / 2;
+      if (Theap[p]->level <= gate->level) break;
+      Theap[i] = Theap[p];
+   }
+   Theap[i] = gate;
+}
+
+static struct Tgate *pop_gate(void)
+{
+   struct Tgate *top, *last;
+   int i, c;
+
+   if (Theapcount == 0) return NULL;
+   top = Theap[0];
+   last = Theap[--Theapcount];
+   for (i = 0; (c = 2 * i + 1) < Theapcount; i = c) {
+      if ((c + 1 < Theapcount) && (Theap[c + 1]->level < Theap[c]->level)) c++;
+      if (last->level <= Theap[c]->level) break;
+      Theap[i] = Theap[c];
+   }
+   Theap[i] = last;
+   top->queued = FALSE;
+   return top;
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Recompute the arrival and transition times at the outputs of
+ * "gate".  Where they change, the receivers are queued for
+ * evaluation and their path ends are updated.
+ *---------------------------------------------------------------------------
+ */
+
+static void eval_gate(struct Tgate *gate)
+{
+   struct Tpin *out, *in, *src, *rcv;
+   struct Tnet *net;
+   struct Libarc *arc;
+   double arrival, slew, d, t;
+   int i, j;
+
+   for (i = 0; i < gate->npins; i++) {
+      out = &gate->pins[i];
+      if ((out->lpin == NULL) || !out->lpin->output || (out->net == NULL))
+	 continue;
+      net = out->net;
+
+      arrival = slew = 0.0;
+      src = in = NULL;
+      for (arc = out->lpin->arcs; arc; arc = arc->next) {
+	 if ((arc->type != ARC_COMB) && (arc->type != ARC_CLOCK)) continue;
+	 for (j = 0; j < gate->npins; j++) {
+	    in = &gate->pins[j];
+	    if ((in->net != NULL) && (in != out) && !strcmp(in->name, arc->relpin))
+	       break;
+	 }
+	 if (j == gate->npins) continue;
+
+	 d = in->net->arrival + arc_value(arc->delay, in->net->slew, net->load);
+	 if ((src == NULL) || (d > arrival)) {
+	    arrival = d;
+	    src = in;
+	 }
+	 t = arc_value(arc->trans, in->net->slew, net->load);
+	 if (t > slew) slew = t;
+      }
+      if ((fabs(arrival - net->arrival) > TIME_EPSILON) ||
+		(fabs(slew - net->slew) > TIME_EPSILON)) {
+	 if (Journaling) journal_record(net, -1);
+	 net->srcpin = src;
+	 net->arrival = arrival;
+	 net->slew = slew;
+	 for (rcv = net->receivers; rcv; rcv = rcv->nextrcv) {
+	    if (rcv->gate == NULL)
+	       update_pin_end(rcv);
+	    else {
+	       update_gate_ends(rcv->gate);
+	       if (timing_edge(rcv) && (rcv->gate->level > gate->level))
+		  push_gate(rcv->gate);
+	    }
+	 }
+      }
+      else if (net->srcpin != src) {
+	 if (Journaling) journal_record(net, -1);
+	 net->srcpin = src;
+      }
+   }
+}
+
+static void propagate(void)
+{
+   struct Tgate *gate;
+
+   while ((gate = pop_gate()) != NULL)
+      eval_gate(gate);
+}
+
+/* Empty the work list without evaluating anything */
+
+static void clear_queue(void)
+{
+   while (pop_gate() != NULL);
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Assign each gate a level greater than that of every gate
+ * driving it.  Gates in combinational loops are put after all
+ * the others, and timing through the loop is not followed.
+ *---------------------------------------------------------------------------
+ */
+
+static void levelize(void)
+{
+   struct Tgate *gate, **queue;
+   struct Tpin *rcv;
+   int i, head, tail, maxlevel = 0, loops = 0;
+
+   for (gate = Tgates; gate; gate = gate->next) {
+      gate->level = 0;
+      gate->fanin = 0;
+   }
+   for (gate = Tgates; gate; gate = gate->next)
+      for (i = 0; i < gate->npins; i++)
+	 if (gate->pins[i].lpin && gate->pins[i].lpin->output && gate->pins[i].net)
+	    for (rcv = gate->pins[i].net->receivers; rcv; rcv = rcv->nextrcv)
+	       if (timing_edge(rcv)) rcv->gate->fanin++;
+
+   queue = (struct Tgate **)malloc((Tgatecount + 1) * sizeof(struct Tgate *));
+   head = tail = 0;
+   for (gate = Tgates; gate; gate = gate->next)
+      if (gate->fanin == 0) queue[tail++] = gate;
+
+   while (head < tail) {
+      gate = queue[head++];
+      if (gate->level > maxlevel) maxlevel = gate->level;
+      for (i = 0; i < gate->npins; i++) {
+	 if (!gate->pins[i].lpin || !gate->pins[i].lpin->output || !gate->pins[i].net)
+	    continue;
+	 for (rcv = gate->pins[i].net->receivers; rcv; rcv = rcv->nextrcv) {
+	    if (!timing_edge(rcv)) continue;
+	    if (rcv->gate->level <= gate->level)
+	       rcv->gate->level = gate->level + 1;
+	    if (--rcv->gate->fanin == 0) queue[tail++] = rcv->gate;
+	 }
+      }
+   }
+
+   for (gate = Tgates; gate; gate = gate->next) {
+      if (gate->fanin > 0) {
+	 gate->level = maxlevel + 1;
+	 loops++;
+      }
+   }
+   if (loops > 0)
+      fprintf(stderr, "Warning:  %d gates are in combinational loops.\n", loops);
+   free(queue);
+}
+
+/* Raise the level of "gate" to "level", and raise the gates	*/
+/* that it drives to keep them in order.			*/
+
+static void raise_level(struct Tgate *gate, int level)
+{
+   struct Tpin *rcv;
+   int i, oldlevel;
+
+   oldlevel = gate->level;
+   gate->level = level;
+   for (i = 0; i < gate->npins; i++) {
+      if (!gate->pins[i].lpin || !gate->pins[i].lpin->output || !gate->pins[i].net)
+	 continue;
+      for (rcv = gate->pins[i].net->receivers; rcv; rcv = rcv->nextrcv)
+	 if (timing_edge(rcv) && (rcv->gate->level > oldlevel) &&
+			(rcv->gate->level <= level))
+	    raise_level(rcv->gate, level + 1);
+   }
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Full timing analysis of the netlist, done once.  After this,
+ * arrival times are kept up to date incrementally.
+ *---------------------------------------------------------------------------
+ */
+
+static void analyze_timing(void)
+{
+   struct Tgate *gate;
+   struct Tnet *net;
+   struct Tpin *rcv;
+   struct hashlist *hl;
+   int i;
+
+   levelize();
+
+   Endcount = 0;
+   for (i = 0; i < Tnethash.hashsize; i++) {
+      for (hl = Tnethash.hashtab[i]; hl; hl = hl->next) {
+	 net = (struct Tnet *)hl->ptr;
+	 net_load(net);
+	 net->arrival = net->slew = 0.0;
+	 for (rcv = net->receivers; rcv; rcv = rcv->nextrcv)
+	    if ((rcv->gate == NULL) || (rcv->lpin && rcv->lpin->setup &&
+			rcv->gate->cell->seq && clock_pin(rcv->gate))) {
+	       Endpoints = (struct Tpin **)realloc(Endpoints,
+			(Endcount + 1) * sizeof(struct Tpin *));
+	       rcv->endindex = Endcount;
+	       Endpoints[Endcount++] = rcv;
+	    }
+      }
+   }
+
+   for (Endtreesize = 1; Endtreesize < Endcount; Endtreesize <<= 1);
+   Endtree = (double *)malloc(2 * Endtreesize * sizeof(double));
+   for (i = 0; i < 2 * Endtreesize; i++) Endtree[i] = SLACK_INFINITY;
+
+   for (gate = Tgates; gate; gate = gate->next) push_gate(gate);
+   propagate();
+   for (i = 0; i < Endcount; i++) update_pin_end(Endpoints[i]);
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Compute required times on all nets, from the path ends back.
+ * This is done once per pass of the optimization, and is only
+ * used to choose which receivers to put behind a buffer.
+ *---------------------------------------------------------------------------
+ */
+
+static int level_compare(const void *a, const void *b)
+{
+   return (*(struct Tgate **)b)->level - (*(struct Tgate **)a)->level;
+}
+
+static double pin_required(struct Tpin *pin)
+{
+   struct Tgate *gate = pin->gate;
+   struct Tpin *out;
+   struct Libarc *arc;
+   double req, r;
+   int i;
+
+   req = (pin->endindex >= 0) ? end_required(pin) : SLACK_INFINITY;
+   if (gate == NULL) return req;
+
+   for (i = 0; i < gate->npins; i++) {
+      out = &gate->pins[i];
+      if (!out->lpin || !out->lpin->output || !out->net) continue;
+      for (arc = out->lpin->arcs; arc; arc = arc->next) {
+	 if ((arc->type != ARC_COMB) && (arc->type != ARC_CLOCK)) continue;
+	 if (strcmp(arc->relpin, pin->name)) continue;
+	 r = out->net->required - arc_value(arc->delay, pin->net->slew,
+			out->net->load);
+	 if (r < req) req = r;
+      }
+   }
+   return req;
+}
+
+static void compute_required(void)
+{
+   static struct Tgate **order = NULL;
+   struct Tgate *gate;
+   struct Tpin *pin;
+   struct hashlist *hl;
+   double r;
+   int i, j, n;
+
+   for (i = 0; i < Tnethash.hashsize; i++)
+      for (hl = Tnethash.hashtab[i]; hl; hl = hl->next)
+	 ((struct Tnet *)hl->ptr)->required = SLACK_INFINITY;
+
+   for (i = 0; i < Endcount; i++) {
+      pin = Endpoints[i];
+      r = end_required(pin);
+      if (r < pin->net->required) pin->net->required = r;
+   }
+
+   order = (struct Tgate **)realloc(order, (Tgatecount + 1) * sizeof(struct Tgate *));
+   n = 0;
+   for (gate = Tgates; gate; gate = gate->next) order[n++] = gate;
+   qsort(order, n, sizeof(struct Tgate *), level_compare);
+
+   for (j = 0; j < n; j++) {
+      gate = order[j];
+      for (i = 0; i < gate->npins; i++) {
+	 pin = &gate->pins[i];
+	 if (!pin->net || (pin->lpin && pin->lpin->output)) continue;
+	 r = pin_required(pin);
+	 if (r < pin->net->required) pin->net->required = r;
+      }
+   }
+}
+
+static double total_area(void)
+{
+   struct Tgate *gate;
+   double area = 0.0;
+
+   for (gate = Tgates; gate; gate = gate->next)
+      if (gate->cell) area += gate->cell->area;
+   return area;
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Changes to the netlist.  Each is followed by propagate() to
+ * bring the arrival times up to date.
+ *---------------------------------------------------------------------------
+ */
+
+/* Change the cell of "gate" to "cell" */
+
+static void set_cell(struct Tgate *gate, struct Libcell *cell)
+{
+   struct Tnet *net;
+   int i;
+
+   gate->cell = cell;
+   gate->cellname = cell->name;
+   bind_pins(gate);
+   for (i = 0; i < gate->npins; i++) {
+      net = gate->pins[i].net;
+      if (!net || gate->pins[i].lpin->output) continue;
+      net_load(net);
+      if (net->driver) push_gate(net->driver->gate);
+   }
+   push_gate(gate);
+   update_gate_ends(gate);
+}
+
+/* Return TRUE if "cell" is another size of the cell of "gate"	*/
+
+static int same_family(struct Tgate *gate, struct Libcell *cell)
+{
+   char *s1, *s2;
+   struct Libpin *lpin;
+   int i;
+
+   if ((cell == gate->cell) || (cell->seq != gate->cell->seq)) return FALSE;
+   s1 = find_suffix(gate->cell->name);
+   s2 = find_suffix(cell->name);
+   if ((s1 == NULL) || (s2 == NULL)) return FALSE;
+   if ((s1 - gate->cell->name) != (s2 - cell->name)) return FALSE;
+   if (strncmp(gate->cell->name, cell->name, s1 - gate->cell->name)) return FALSE;
+
+   for (i = 0; i < gate->npins; i++) {
+      for (lpin = cell->pins; lpin; lpin = lpin->next)
+	 if (!strcmp(lpin->name, gate->pins[i].name)) break;
+      if ((lpin == NULL) || (gate->pins[i].lpin == NULL) ||
+		(lpin->output != gate->pins[i].lpin->output))
+	 return FALSE;
+   }
+   return TRUE;
+}
+
+/* Put the receivers "moved" of "net" behind a new buffer of	*/
+/* cell "bufcell".  The buffer is added to the end of Tgates.	*/
+
+static struct Tgate *insert_buffer(struct Tnet *net, struct Libcell *bufcell,
+		struct Tpin **moved, int nmoved)
+{
+   struct Tgate *buf;
+   struct Tnet *newnet;
+   int i;
+
+   buf = new_tgate(bufcell->name, 2);
+   buf->inserted = TRUE;
+   buf->modified = TRUE;
+   buf->pins[0].name = strdup(buf_in_pin);
+   buf->pins[1].name = strdup(buf_out_pin);
+   bind_pins(buf);
+
+   newnet = (struct Tnet *)calloc(1, sizeof(struct Tnet));
+   connect_pin(buf, &buf->pins[0], net);
+   connect_pin(buf, &buf->pins[1], newnet);
+
+   buf->level = ((net->driver) ? net->driver->gate->level : 0) + 1;
+   for (i = 0; i < nmoved; i++) {
+      remove_receiver(net, moved[i]);
+      add_receiver(newnet, moved[i]);
+      if (timing_edge(moved[i]) && (moved[i]->gate->level <= buf->level))
+	 raise_level(moved[i]->gate, buf->level + 1);
+      push_gate(moved[i]->gate);
+   }
+   net_load(net);
+   net_load(newnet);
+
+   if (net->driver) push_gate(net->driver->gate);
+   push_gate(buf);
+   return buf;
+}
+
+/* Undo insert_buffer() for "buf", the last gate in Tgates,	*/
+/* where "prev" is the gate before it.				*/
+
+static void remove_buffer(struct Tgate *buf, struct Tgate *prev)
+{
+   struct Tnet *net, *newnet;
+   struct Tpin *rcv;
+   int i;
+
+   net = buf->pins[0].net;
+   newnet = buf->pins[1].net;
+   remove_receiver(net, &buf->pins[0]);
+   while ((rcv = newnet->receivers) != NULL) {
+      remove_receiver(newnet, rcv);
+      add_receiver(net, rcv);
+      push_gate(rcv->gate);
+      update_gate_ends(rcv->gate);
+   }
+   net_load(net);
+   if (net->driver) push_gate(net->driver->gate);
+
+   Tgatelast = prev;
+   if (prev) prev->next = NULL;
+   else Tgates = NULL;
+   Tgatecount--;
+   for (i = 0; i < buf->npins; i++) free(buf->pins[i].name);
+   free(buf->pins);
+   free(buf->cellname);
+   free(buf);
+   free(newnet);
+}
+
+/* Give the net driven by the buffer "buf" a unique name	*/
+
+static void name_buffer_net(struct Tgate *buf)
+{
+   struct Tnet *net = buf->pins[0].net;
+   struct Tnet *newnet = buf->pins[1].net;
+   char *bptr;
+   int n, len;
+
+   len = strlen(net->name);
+   newnet->name = (char *)malloc(len + 20);
+   bptr = strrchr(net->name, '[');
+   if ((bptr == NULL) || (net->name[len - 1] != ']')) bptr = net->name + len;
+
+   for (n = 1; ; n++) {
+      sprintf(newnet->name, "%.*s_buf%d%s", (int)(bptr - net->name), net->name,
+		n, bptr);
+      if (HashLookup(newnet->name, &Tnethash) == NULL) break;
+   }
+   HashPtrInstall(newnet->name, newnet, &Tnethash);
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Collect the gate receivers of "net" into Rcvpins, most critical (earliest
+ * required time) first, and return how many there are.  The number of
+ * module outputs on the net is returned in "nports".
+ *---------------------------------------------------------------------------
+ */
+
+static struct Tpin **Rcvpins = NULL;
+static double *Rcvrequired = NULL;
+static int *Rcvorder = NULL;
+static int Rcvsize = 0;
+
+static int required_compare(const void *a, const void *b)
+{
+   double ra = Rcvrequired[*(int *)a];
+   double rb = Rcvrequired[*(int *)b];
+
+   return (ra < rb) ? -1 : (ra > rb) ? 1 : (*(int *)a - *(int *)b);
+}
+
+static int sort_receivers(struct Tnet *net, int *nports)
+{
+   struct Tpin *pin, **sorted;
+   int nrcv = 0, i;
+
+   *nports = 0;
+   for (pin = net->receivers; pin; pin = pin->nextrcv) {
+      if (pin->gate == NULL) {
+	 (*nports)++;
+	 continue;
+      }
+      if (nrcv >= Rcvsize) {
+	 Rcvsize = 2 * Rcvsize + 16;
+	 Rcvpins = (struct Tpin **)realloc(Rcvpins, 2 * Rcvsize * sizeof(struct Tpin *));
+	 Rcvrequired = (double *)realloc(Rcvrequired, Rcvsize * sizeof(double));
+	 Rcvorder = (int *)realloc(Rcvorder, Rcvsize * sizeof(int));
+      }
+      Rcvpins[nrcv] = pin;
+      Rcvrequired[nrcv] = pin_required(pin);
+      Rcvorder[nrcv] = nrcv;
+      nrcv++;
+   }
+   qsort(Rcvorder, nrcv, sizeof(int), required_compare);
+
+   /* Sorted list goes in the upper half of Rcvpins */
+   sorted = Rcvpins + Rcvsize;
+   for (i = 0; i < nrcv; i++) sorted[i] = Rcvpins[Rcvorder[i]];
+   for (i = 0; i < nrcv; i++) Rcvpins[i] = sorted[i];
+   return nrcv;
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Local estimates of the gain of a change, used to decide which changes
+ * are worth trying.  Only the delays of the gates next to the change, on
+ * the critical path, are counted.
+ *---------------------------------------------------------------------------
+ */
+
+static struct Libpin *cell_pin(struct Libcell *cell, char *name)
+{
+   struct Libpin *lpin;
+
+   for (lpin = cell->pins; lpin; lpin = lpin->next)
+      if (!strcmp(lpin->name, name)) return lpin;
+   return NULL;
+}
+
+/* Delay from input "inname" to output "out", for the given input	*/
+/* transition time and output load.					*/
+
+static double arc_delay(struct Libpin *out, char *inname, double slew, double load)
+{
+   struct Libarc *arc;
+   double d, delay = 0.0;
+
+   if (out == NULL) return 0.0;
+   for (arc = out->arcs; arc; arc = arc->next) {
+      if ((arc->type != ARC_COMB) && (arc->type != ARC_CLOCK)) continue;
+      if (strcmp(arc->relpin, inname)) continue;
+      d = arc_value(arc->delay, slew, load);
+      if (d > delay) delay = d;
+   }
+   return delay;
+}
+
+/* Delay through the gate driving "net" on the critical path, if the	*/
+/* net had load "load".							*/
+
+static double path_delay(struct Tnet *net, double load)
+{
+   struct Tpin *in = net->srcpin;
+
+   if ((in == NULL) || (net->driver == NULL)) return 0.0;
+   return arc_delay(net->driver->lpin, in->name, in->net->slew, load);
+}
+
+/* Gain from changing the cell of the gate driving "net" to "cell" */
+
+static double resize_gain(struct Tnet *net, struct Libcell *cell)
+{
+   struct Tpin *in = net->srcpin, *out = net->driver;
+   struct Libpin *newin;
+   double before, after, load;
+
+   if (in == NULL) return 0.0;
+   newin = cell_pin(cell, in->name);
+   before = path_delay(net, net->load);
+   after = arc_delay(cell_pin(cell, out->name), in->name, in->net->slew, net->load);
+   if (in->net->driver && (in->lpin != NULL) && (newin != NULL)) {
+      load = in->net->load - in->lpin->cap + newin->cap;
+      before += path_delay(in->net, in->net->load);
+      after += path_delay(in->net, load);
+   }
+   return before - after;
+}
+
+/* Gain from moving the receivers Rcvpins[keep...nrcv-1] of "net" behind	*/
+/* a buffer of cell "bufcell".  "next" is the pin on the critical path.	*/
+
+static double buffer_gain(struct Tnet *net, struct Libcell *bufcell, int keep,
+		int nrcv, struct Tpin *next)
+{
+   struct Libpin *bin, *bout;
+   double load, moved, gain;
+   int j, onpath = FALSE;
+
+   bin = cell_pin(bufcell, buf_in_pin);
+   bout = cell_pin(bufcell, buf_out_pin);
+   moved = 0.0;
+   for (j = keep; j < nrcv; j++) {
+      if (Rcvpins[j]->lpin) moved += Rcvpins[j]->lpin->cap;
+      if (Rcvpins[j] == next) onpath = TRUE;
+   }
+   load = net->load - moved + ((bin) ? bin->cap : 0.0);
+   gain = path_delay(net, net->load) - path_delay(net, load);
+   if (onpath)
+      gain -= arc_delay(bout, buf_in_pin, net->slew, WireCap + moved);
+   return gain;
+}
+
+struct Tmove {
+   int    type;
+   double gain;			// Estimated
+   struct Tgate *gate;		// Gate to resize
+   struct Libcell *cell;	// New cell for the gate
+   struct Tnet *net;		// Net to buffer
+   int    keep;			// Number of receivers left on the net
+};
+
+static int move_compare(const void *a, const void *b)
+{
+   double ga = ((struct Tmove *)a)->gain;
+   double gb = ((struct Tmove *)b)->gain;
+
+   return (ga > gb) ? -1 : (ga < gb) ? 1 : 0;
+}
+
+/* TRUE if a tried change with worst slack "w" and critical path	*/
+/* end slack "e" is better than the best so far.			*/
+
+static int better_move(double w, double e, double bestworst, double bestend)
+{
+   if (w > bestworst + GAIN_EPSILON) return TRUE;
+   return (w > bestworst - GAIN_EPSILON) && (e > bestend + GAIN_EPSILON);
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Improve the critical path.  On each pass, the resizings of the gates on
+ * the critical path, and the bufferings of the nets on the path that leave
+ * only their most critical receivers on the net, are listed and ranked by
+ * a local estimate of their gain.  Those that look like they gain anything
+ * are then tried and undone in that order, at least MIN_TRIES of them, up
+ * to the first that really gains;  the best of those tried is kept.  A
+ * change is kept only if it improves the worst slack, or improves the
+ * slack at the end of the critical path without making the worst slack
+ * any worse.
+ *---------------------------------------------------------------------------
+ */
+
+#define MOVE_RESIZE	1
+#define MOVE_BUFFER	2
+
+#define MIN_TRIES	8
+
+static void optimize_timing(void)
+{
+   struct Tgate **path, *gate, *buf, *prev;
+   struct Tnet **pathnets, *net;
+   struct Tpin *pin, *next;
+   struct Libcell *cell, *oldcell, *bufcell;
+   struct Tmove *moves = NULL, *move, *best;
+   double worst, w, e, bestworst, bestend, gain;
+   int npath, maxpath, ci, j, k, m, nrcv, nports, nmoves, maxmoves, tries;
+   int changes = 0, maxchanges;
+
+   bufcell = (struct Libcell *)HashLookup(Buffername, &Libhash);
+   if ((bufcell != NULL) && (bufcell->seq || !cell_pin(bufcell, buf_in_pin)
+		|| !cell_pin(bufcell, buf_out_pin))) bufcell = NULL;
+   if (bufcell == NULL)
+      fprintf(stderr, "Warning:  Buffer cell %s is not in the liberty file;"
+		" no buffers will be added.\n", Buffername);
+
+   maxpath = Tgatecount + 1;
+   path = (struct Tgate **)malloc(maxpath * sizeof(struct Tgate *));
+   pathnets = (struct Tnet **)malloc(maxpath * sizeof(struct Tnet *));
+   maxmoves = 0;
+   maxchanges = Tgatecount + 100;
+
+   while (changes < maxchanges) {
+      worst = Endtree[1];
+      if ((Period > 0.0) && (worst >= 0.0)) break;
+      compute_required();
+
+      /* Trace the critical path back from its end */
+
+      ci = worst_end();
+      npath = 0;
+      net = Endpoints[ci]->net;
+      while (net && net->driver && (npath < maxpath)) {
+	 gate = net->driver->gate;
+	 path[npath] = gate;
+	 pathnets[npath++] = net;
+	 if (gate->cell && gate->cell->seq) break;
+	 if ((pin = net->srcpin) == NULL) break;
+	 net = pin->net;
+      }
+
+      /* List the changes that may gain */
+
+      nmoves = 0;
+      for (k = 0; k < npath; k++) {
+	 gate = path[k];
+	 net = pathnets[k];
+	 next = (k == 0) ? Endpoints[ci] : pathnets[k - 1]->srcpin;
+	 if (gate->cell == NULL) continue;
+
+	 for (cell = Libcells; cell; cell = cell->next) {
+	    if (!same_family(gate, cell)) continue;
+	    gain = resize_gain(net, cell);
+	    if (gain <= GAIN_EPSILON) continue;
+	    if (nmoves >= maxmoves) {
+	       maxmoves = 2 * maxmoves + 64;
+	       moves = (struct Tmove *)realloc(moves, maxmoves * sizeof(struct Tmove));
+	    }
+	    move = &moves[nmoves++];
+	    move->type = MOVE_RESIZE;
+	    move->gain = gain;
+	    move->gate = gate;
+	    move->cell = cell;
+	 }
+
+	 if ((bufcell == NULL) || net->ignore) continue;
+	 nrcv = sort_receivers(net, &nports);
+	 if (nrcv + nports < 2) continue;
+	 for (m = (nports > 0) ? 0 : 1; m < nrcv; m = (m == 0) ? 1 : 2 * m) {
+	    gain = buffer_gain(net, bufcell, m, nrcv, next);
+	    if (gain <= GAIN_EPSILON) continue;
+	    if (nmoves >= maxmoves) {
+	       maxmoves = 2 * maxmoves + 64;
+	       moves = (struct Tmove *)realloc(moves, maxmoves * sizeof(struct Tmove));
+	    }
+	    move = &moves[nmoves++];
+	    move->type = MOVE_BUFFER;
+	    move->gain = gain;
+	    move->net = net;
+	    move->keep = m;
+	 }
+      }
+      qsort(moves, nmoves, sizeof(struct Tmove), move_compare);
+
+      /* Try them, with the arrival times updated for each */
+
+      best = NULL;
+      bestworst = worst;
+      bestend = end_slack(ci);
+      for (tries = 0; tries < nmoves; tries++) {
+	 if ((tries >= MIN_TRIES) && (best != NULL)) break;
+	 move = &moves[tries];
+	 Journaling = TRUE;
+	 if (move->type == MOVE_RESIZE) {
+	    oldcell = move->gate->cell;
+	    set_cell(move->gate, move->cell);
+	    propagate();
+	    w = Endtree[1];
+	    e = end_slack(ci);
+	    journal_undo();
+	    set_cell(move->gate, oldcell);
+	 }
+	 else {
+	    nrcv = sort_receivers(move->net, &nports);
+	    prev = Tgatelast;
+	    buf = insert_buffer(move->net, bufcell, Rcvpins + move->keep,
+			nrcv - move->keep);
+	    propagate();
+	    w = Endtree[1];
+	    e = end_slack(ci);
+	    journal_undo();
+	    remove_buffer(buf, prev);
+	 }
+	 clear_queue();
+	 if (better_move(w, e, bestworst, bestend)) {
+	    bestworst = w;
+	    bestend = e;
+	    best = move;
+	 }
+      }
+      if (best == NULL) break;
+
+      if (best->type == MOVE_RESIZE) {
+	 if (VerboseFlag)
+	    fprintf(stderr, "Gate driving %s changed from %s to %s (slack %g ps)\n",
+			gate_label(best->gate), best->gate->cellname,
+			best->cell->name, bestworst);
+	 set_cell(best->gate, best->cell);
+	 best->gate->modified = TRUE;
+      }
+      else {
+	 nrcv = sort_receivers(best->net, &nports);
+	 buf = insert_buffer(best->net, bufcell, Rcvpins + best->keep,
+			nrcv - best->keep);
+	 name_buffer_net(buf);
+	 for (j = best->keep; j < nrcv; j++) Rcvpins[j]->gate->modified = TRUE;
+	 if (VerboseFlag)
+	    fprintf(stderr, "Buffer driving %s added to net %s for %d receivers"
+			" (slack %g ps)\n", buf->pins[1].net->name, best->net->name,
+			nrcv - best->keep, bestworst);
+      }
+      propagate();
+      changes++;
+   }
+
+   free(path);
+   free(pathnets);
+   free(moves);
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * With a target period that the design meets, try each gate at
+ * each smaller size, and keep the smallest that does not make
+ * the worst slack go negative.  This is not called when the
+ * period is not met, since a downsized gate on a path that
+ * already fails would make that path worse without changing
+ * the worst slack.
+ *---------------------------------------------------------------------------
+ */
+
+static void recover_area(void)
+{
+   struct Tgate *gate;
+   struct Libcell *cell, *oldcell, *bestcell;
+
+   for (gate = Tgates; gate; gate = gate->next) {
+      if (gate->cell == NULL) continue;
+      oldcell = gate->cell;
+      bestcell = oldcell;
+      for (cell = Libcells; cell; cell = cell->next) {
+	 if (!same_family(gate, cell)) continue;
+	 if (cell->area >= bestcell->area) continue;
+	 Journaling = TRUE;
+	 set_cell(gate, cell);
+	 propagate();
+	 if (Endtree[1] >= -TIME_EPSILON) bestcell = cell;
+	 journal_undo();
+	 set_cell(gate, oldcell);
+	 clear_queue();
+      }
+      if (bestcell != oldcell) {
+	 if (VerboseFlag)
+	    fprintf(stderr, "Gate driving %s changed from %s to %s (area)\n",
+			gate_label(gate), oldcell->name, bestcell->name);
+	 set_cell(gate, bestcell);
+	 propagate();
+	 gate->modified = TRUE;
+      }
+   }
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Write the netlist.  Records of gates that did not change are
+ * copied from the input;  the others are written out again,
+ * and added buffers are written before ".end".
+ *---------------------------------------------------------------------------
+ */
+
+static void write_gate(FILE *outfptr, struct Tgate *gate)
+{
+   int i;
+
+   fprintf(outfptr, ".gate %s", gate->cellname);
+   for (i = 0; i < gate->npins; i++) {
+      if (gate->pins[i].net)
+	 fprintf(outfptr, " %s=%s", gate->pins[i].name, gate->pins[i].net->name);
+      else
+	 fprintf(outfptr, " %s", gate->pins[i].name);
+   }
+   fprintf(outfptr, "\n");
+}
+
+static void write_timing_output(FILE *infptr, FILE *outfptr)
+{
+   char *record, *text, *t;
+   int recsize = MAXLINE, textsize = MAXLINE;
+   struct Tgate *gate;
+
+   record = (char *)malloc(recsize);
+   text = (char *)malloc(textsize);
+   rewind(infptr);
+
+   gate = Tgates;
+   Changed_count = 0;
+   while (read_record(infptr, &record, &recsize, &text, &textsize)) {
+      t = strtok(record, " \t\n");
+      if ((t != NULL) && !strcmp(t, ".gate") && (strtok(NULL, " \t\n") != NULL)
+		&& (gate != NULL)) {
+	 if (gate->modified) {
+	    write_gate(outfptr, gate);
+	    if (gate->cell != gate->origcell) {
+	       count_gatetype(gate->origcell->name, 0, -1);
+	       count_gatetype(gate->cellname, 0, 1);
+	       Changed_count++;
+	    }
+	 }
+	 else
+	    fputs(text, outfptr);
+	 gate = gate->next;
+      }
+      else if ((t != NULL) && !strcmp(t, ".end")) {
+	 for (; gate; gate = gate->next) {
+	    write_gate(outfptr, gate);
+	    count_gatetype(gate->cellname, 0, 1);
+	    Changed_count++;
+	 }
+	 fputs(text, outfptr);
+      }
+      else
+	 fputs(text, outfptr);
+   }
+   free(record);
+   free(text);
+}
+
+/*
+ *---------------------------------------------------------------------------
+ * Timing-driven mode, from reading the liberty file through
+ * writing the output netlist.
+ *---------------------------------------------------------------------------
+ */
+
+void timing_driven(FILE *infptr, FILE *outfptr)
+{
+   double worst, area;
+   clock_t start;
+
+   read_liberty(Libpath);
+
+   start = clock();
+   read_timing_netlist(infptr);
+   if (Ignorepath != NULL) read_ignore_file(Ignorepath);
+   analyze_timing();
+   if (VerboseFlag)
+      fprintf(stderr, "Netlist load and timing:  %d gates, %d nets in %g seconds.\n",
+		Tgatecount, Tnethash.nentries,
+		(double)(clock() - start) / CLOCKS_PER_SEC);
+
+   if (Endcount == 0) {
+      fprintf(stderr, "blifFanout:  No timing path ends found in netlist.\n");
+      write_timing_output(infptr, outfptr);
+      return;
+   }
+
+   worst = Endtree[1];
+   area = total_area();
+   if (Period > 0.0)
+      fprintf(stderr, "Target clock period %g ps, worst slack %g ps, area %g\n",
+		Period, worst, area);
+   else
+      fprintf(stderr, "Critical path delay %g ps, area %g\n", -worst, area);
+
+   start = clock();
+   optimize_timing();
+   if (Period > 0.0) {
+      if (Endtree[1] >= 0.0)
+	 recover_area();
+      else
+	 fprintf(stderr, "Period not met;  no area recovery.\n");
+   }
+
+   worst = Endtree[1];
+   area = total_area();
+   if (Period > 0.0)
+      fprintf(stderr, "After optimization:  worst slack %g ps, area %g\n",
+		worst, area);
+   else
+      fprintf(stderr, "After optimization:  critical path delay %g ps, area %g\n",
+		-worst, area);
+   if (VerboseFlag)
+      fprintf(stderr, "Optimization time %g seconds.\n",
+		(double)(clock() - start) / CLOCKS_PER_SEC);
+
+   write_timing_output(infptr, outfptr);
+}
+
 /*
  *---------------------------------------------------------------------------
  *---------------------------------------------------------------------------
@@ -1135,6 +3159,9 @@ void helpmessage(void)
 		MaxOutputCap);
    printf("\t-p filepath\tSpecify an alternate path and filename for gate.cfg\n");
    printf("\t-f filepath\tSpecify a path and filename for list of nets to ignore\n");
+   printf("\t-L filepath\tTiming-driven mode: size and buffer the critical path\n");
+   printf("\t\t\tusing the timing tables in this liberty file\n");
+   printf("\t-t period\tTiming-driven mode: target clock period (ps)\n");
    printf("\t-h\t\tprint this help message\n\n");
 
    printf("This will not work at all for tristate gates.\n");
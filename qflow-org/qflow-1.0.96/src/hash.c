@@ -0,0 +1,181 @@
+/*--------------------------------------------------------------*/
+/* hash.c --							*/
+/*								*/
+/* Hashed symbol tables, shared by the qflow netlist tools.	*/
+/* Each table maps a name to a pointer.  The table doubles in	*/
+/* size when it holds twice as many entries as bins, so it	*/
+/* may be started small no matter how large the netlist is.	*/
+/*--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+#include "hash.h"
+
+/*--------------------------------------------------------------*/
+/* Compute the hash of "name" for a table of "hashsize" bins.	*/
+/* (FNV-1a, folded to lower case if "nocase" is set)		*/
+/*--------------------------------------------------------------*/
+
+static unsigned long hash(char *name, int hashsize, char nocase)
+{
+   unsigned long hashval = 2166136261UL;
+   unsigned char c;
+
+   for (; *name != '\0'; name++) {
+      c = (unsigned char)*name;
+      if (nocase) c = tolower(c);
+      hashval = (hashval ^ c) * 16777619UL;
+   }
+   return (hashval % hashsize);
+}
+
+/*--------------------------------------------------------------*/
+/* Compare two names according to the table's case rule		*/
+/*--------------------------------------------------------------*/
+
+static int namecmp(char *s1, char *s2, struct hashtable *table)
+{
+   return (table->nocase) ? strcasecmp(s1, s2) : strcmp(s1, s2);
+}
+
+/*--------------------------------------------------------------*/
+/* Prepare an empty table with "hashsize" bins.			*/
+/*--------------------------------------------------------------*/
+
+void InitializeHashTable(struct hashtable *table, int hashsize, char nocase)
+{
+   if (hashsize < 1) hashsize = 1;
+   table->hashsize = hashsize;
+   table->nentries = 0;
+   table->nocase = nocase;
+   table->hashtab = (struct hashlist **)calloc(hashsize,
+		sizeof(struct hashlist *));
+   if (table->hashtab == NULL) {
+      fprintf(stderr, "Out of memory creating hash table.\n");
+      exit(1);
+   }
+}
+
+/*--------------------------------------------------------------*/
+/* Double the number of bins in the table, and move each entry	*/
+/* to its new bin.						*/
+/*--------------------------------------------------------------*/
+
+static void HashGrow(struct hashtable *table)
+{
+   struct hashlist **newtab, *np, *npnext;
+   unsigned long hashval;
+   int i, newsize;
+
+   newsize = table->hashsize * 2;
+   newtab = (struct hashlist **)calloc(newsize, sizeof(struct hashlist *));
+   if (newtab == NULL) return;		/* Keep the table as it is */
+
+   for (i = 0; i < table->hashsize; i++) {
+      for (np = table->hashtab[i]; np; np = npnext) {
+	 npnext = np->next;
+	 hashval = hash(np->name, newsize, table->nocase);
+	 np->next = newtab[hashval];
+	 newtab[hashval] = np;
+      }
+   }
+   free(table->hashtab);
+   table->hashtab = newtab;
+   table->hashsize = newsize;
+}
+
+/*--------------------------------------------------------------*/
+/* Return the pointer stored under "name", or NULL if "name" is	*/
+/* not in the table.						*/
+/*--------------------------------------------------------------*/
+
+void *HashLookup(char *name, struct hashtable *table)
+{
+   struct hashlist *np;
+
+   for (np = table->hashtab[hash(name, table->hashsize, table->nocase)];
+		np != NULL; np = np->next)
+      if (!namecmp(name, np->name, table))
+	 return (np->ptr);
+   return NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Store "ptr" under "name".  If "name" is already in the	*/
+/* table, its pointer is replaced.  Return the table entry.	*/
+/*--------------------------------------------------------------*/
+
+struct hashlist *HashPtrInstall(char *name, void *ptr, struct hashtable *table)
+{
+   struct hashlist *np;
+   unsigned long hashval;
+
+   hashval = hash(name, table->hashsize, table->nocase);
+   for (np = table->hashtab[hashval]; np != NULL; np = np->next) {
+      if (!namecmp(name, np->name, table)) {
+	 np->ptr = ptr;
+	 return np;
+      }
+   }
+
+   np = (struct hashlist *)malloc(sizeof(struct hashlist));
+   if (np == NULL) return NULL;
+   np->name = strdup(name);
+   np->ptr = ptr;
+   np->next = table->hashtab[hashval];
+   table->hashtab[hashval] = np;
+
+   if (++table->nentries > 2 * table->hashsize) HashGrow(table);
+   return np;
+}
+
+/*--------------------------------------------------------------*/
+/* Remove "name" from the table.  The pointer stored under it	*/
+/* is not freed.						*/
+/*--------------------------------------------------------------*/
+
+void HashDelete(char *name, struct hashtable *table)
+{
+   struct hashlist *np, **npp;
+
+   npp = &table->hashtab[hash(name, table->hashsize, table->nocase)];
+   for (np = *npp; np != NULL; npp = &np->next, np = np->next) {
+      if (!namecmp(name, np->name, table)) {
+	 *npp = np->next;
+	 free(np->name);
+	 free(np);
+	 table->nentries--;
+	 return;
+      }
+   }
+}
+
+/*--------------------------------------------------------------*/
+/* Free all entries of the table and the table's bins.  The	*/
+/* pointers stored in the table are not freed.			*/
+/*--------------------------------------------------------------*/
+
+void HashKill(struct hashtable *table)
+{
+   struct hashlist *np, *npnext;
+   int i;
+
+   if (table->hashtab == NULL) return;
+   for (i = 0; i < table->hashsize; i++) {
+      for (np = table->hashtab[i]; np; np = npnext) {
+	 npnext = np->next;
+	 free(np->name);
+	 free(np);
+      }
+   }
+   free(table->hashtab);
+   table->hashtab = NULL;
+   table->hashsize = 0;
+   table->nentries = 0;
+}
+
+/* end of hash.c */
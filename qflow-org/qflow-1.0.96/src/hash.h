@@ -0,0 +1,32 @@
+/*--------------------------------------------------------------*/
+/* hash.h --							*/
+/*								*/
+/* Hashed symbol tables, shared by the qflow netlist tools	*/
+/* for looking up cells, nets, and gates by name.		*/
+/*--------------------------------------------------------------*/
+
+#ifndef _HASH_H
+#define _HASH_H
+
+struct hashlist {
+   char *name;
+   void *ptr;
+   struct hashlist *next;
+};
+
+struct hashtable {
+   int hashsize;		/* Number of bins */
+   int nentries;		/* Number of entries, for growing the table */
+   char nocase;			/* Compare names without regard to case */
+   struct hashlist **hashtab;
+};
+
+extern void InitializeHashTable(struct hashtable *table, int hashsize,
+		char nocase);
+extern void *HashLookup(char *name, struct hashtable *table);
+extern struct hashlist *HashPtrInstall(char *name, void *ptr,
+		struct hashtable *table);
+extern void HashDelete(char *name, struct hashtable *table);
+extern void HashKill(struct hashtable *table);
+
+#endif /* _HASH_H */
@@ -18,6 +18,10 @@
 /*		-v <level>	set verbose mode		*/
 /*		-V		report version number		*/
 /*		-e		exhaustive search		*/
+/*		-g		graph-based analysis		*/
+/*		-n <number>	number of paths reported (20)	*/
+/*		-m <p>[,<t>]	analysis mode (repeatable)	*/
+/*		-s <slack_file>	write net slacks (implies -g)	*/
 /*								*/
 /*	Currently the only output this tool generates is a	*/
 /*	list of paths with negative slack.  If no paths have	*/
@@ -28,6 +32,26 @@
 /*	delay path, and the 20 paths with the smallest positive	*/
 /*	slack are output, following a statement indicated the	*/
 /*	computed minimum clock period.				*/
+/*								*/
+/*	The default analysis follows every path from each path	*/
+/*	start to each path end.  With "-g", arrival times are	*/
+/*	instead propagated once through the levelized netlist,	*/
+/*	and only the worst path to each path end is kept.  This	*/
+/*	is much faster on deep logic, and the paths reported	*/
+/*	are the same as long as the delay tables are monotonic.	*/
+/*								*/
+/*	More than one liberty file may be given, one for each	*/
+/*	process corner, and "-m" may be given more than once	*/
+/*	to analyze more than one clock period and input		*/
+/*	transition time.  The netlist is read only once, and	*/
+/*	each corner is analyzed in each mode using graph-based	*/
+/*	analysis, with the corners run in parallel.  Paths are	*/
+/*	then reported with the worst slack over all of them.	*/
+/*								*/
+/*	With "-s", the worst slack of every net over all	*/
+/*	scenarios is written to <slack_file>, one net per line	*/
+/*	after a line "period <ps>".  The placer (TimberWolfSC	*/
+/*	"slack.file") reads this to weight the critical nets.	*/
 /*--------------------------------------------------------------*/
 
 /*--------------------------------------------------------------*/
@@ -52,6 +76,10 @@
 #include <errno.h>
 #include <stdarg.h>
 #include <math.h>	// Temporary, for fabs()
+#include <pthread.h>
+#include <time.h>
+
+#include "hash.h"
  
 #define LIB_LINE_MAX  65535
 
@@ -264,6 +292,7 @@ typedef struct _net {
    connptr *receivers;
    double loadr;	/* Total load capacitance for rising input */
    double loadf;	/* Total load capacitance for falling input */
+   int index;		/* Position in the netlist (graph mode) */
    netptr next;
 } net;
 
@@ -279,6 +308,7 @@ typedef struct _connect {
    double   *pfvector;		/* Prop delay falling (at load condition) vector */
    double   *trvector;		/* Transition time rising (at load condition) vector */
    double   *tfvector;		/* Transition time falling (at load condition) vector */
+   int	    index;		/* Position among all gate inputs, or -1 (graph mode) */
    connptr  next;
 } connect;
 
@@ -287,6 +317,8 @@ typedef struct _instance {
    cellptr refcell;
    connptr in_connects;
    connptr out_connects;
+   int level;		/* Logic level from the path starts (graph mode) */
+   int pending;		/* Inputs not yet levelized (graph mode) */
    instptr next;
 } instance;
 
@@ -322,10 +354,82 @@ typedef struct _connlist {
    connlistptr next;
 } connlist;
 
+// Timing of one net in one scenario (graph mode)
+
+typedef struct _nettiming {
+   double  arrival[2][2];	/* Arrival time [minmax][rise/fall] */
+   double  slew[2][2];		/* Transition time with the arrival */
+   double  required[2];		/* Required time [rise/fall] */
+   connptr source[2][2];	/* Gate input on the arrival path */
+   short   srcdir[2][2];	/* Edge direction at "source" */
+} nettiming;
+
+// Path end record (graph mode).  "receiver" is NULL in an unused slot.
+
+typedef struct _endpoint *endptr;
+
+typedef struct _endpoint {
+   double  delay;	/* Path delay, including setup or hold and clock skew */
+   short   dir;		/* Edge direction at the path end */
+   connptr receiver;	/* Connection at the path end */
+} endpoint;
+
+// Process corner:  One liberty file.  The netlist is read against the
+// cells of the first corner.  Other corners have their own copy of each
+// gate input connection, with the corner's pin and delay vectors.
+
+typedef struct _corner *cornerptr;
+
+typedef struct _corner {
+   char	    *libfile;	/* Liberty file name */
+   lutable  *tables;
+   cell     *cells;
+   connptr  *conns;	/* Gate inputs by index, or NULL for the first corner */
+   cornerptr next;
+} corner;
+
+// Analysis mode:  Clock period and input transition time
+
+typedef struct _mode *modeptr;
+
+typedef struct _mode {
+   double  period;	/* Clock period, in ps (0 to compute it) */
+   double  inTrans;	/* Transition time at module inputs, in ps */
+   int	   index;	/* Mode number, for reporting */
+   modeptr next;
+} mode;
+
+// One corner analyzed in one mode
+
+typedef struct _scenario *scenptr;
+
+typedef struct _scenario {
+   cornerptr  tcorner;
+   modeptr    tmode;
+   nettiming  *timing;	/* Timing of each net, by net index */
+   endptr     maxends;	/* Maximum delay path ends, one slot per receiver */
+   endptr     minends;	/* Minimum delay path ends, one slot per receiver */
+   int	      nummax;	/* Number of used slots in maxends */
+   int	      nummin;	/* Number of used slots in minends */
+   double     period;	/* Clock period (computed, if the mode has none) */
+   double     worstslack; /* Worst slack of any net */
+   int	      numneg;	/* Number of nets with negative slack */
+} scenario;
+
+// Edge direction (RISING or FALLING) to index of the timing arrays
+#define EDGE_INDEX(dir)	(((dir) == FALLING) ? 1 : 0)
+
+// Timing arrays hold +/-TIME_INFINITY where there is no arrival
+#define TIME_INFINITY	1E50
+#define ARRIVAL_VALID(t, minmax, e) (((minmax) == MAXIMUM_TIME) ? \
+		((t)->arrival[minmax][e] > -TIME_INFINITY) : \
+		((t)->arrival[minmax][e] < TIME_INFINITY))
+
 /* Global variables */
 
 unsigned char verbose;		/* Level of debug output generated */
 unsigned char exhaustive;	/* Exhaustive search mode */
+unsigned char graphmode;	/* Graph-based (levelized) analysis */
 
 /*--------------------------------------------------------------*/
 /* Grab a token from the input					*/
@@ -547,6 +651,7 @@ netptr create_net(netptr *netlist) {
     newnet->loadr = 0.0;
     newnet->loadf = 0.0;
     newnet->type = NET;
+    newnet->index = 0;
 
     return newnet;
 }
@@ -1316,6 +1421,28 @@ short find_edge_dir(short dir, netptr sourcenet, netptr destnet) {
     return 0;
 }
 
+/*--------------------------------------------------------------*/
+/* Print one step of a traced path for verbose output:  the	*/
+/* delay, the net, the pin driving it, and the pin receiving	*/
+/* it.  A net driven from a module input has no driving gate.	*/
+/*--------------------------------------------------------------*/
+
+void print_path_step(btptr backtrace)
+{
+    connptr driver = backtrace->receiver->refnet->driver;
+
+    fprintf(stdout, "   %g (%s) ", backtrace->delay, backtrace->receiver->refnet->name);
+    if (driver && driver->refinst)
+	fprintf(stdout, "%s/%s", driver->refinst->name, driver->refpin->name);
+    else
+	fprintf(stdout, "[input pin]");
+    if (backtrace->receiver->refinst)
+	fprintf(stdout, " -> %s/%s\n", backtrace->receiver->refinst->name,
+		backtrace->receiver->refpin->name);
+    else
+	fprintf(stdout, " -> [output pin]\n");
+}
+
 /*--------------------------------------------------------------*/
 /* Search all paths from the clocked data outputs of		*/
 /* "clockedlist" to either output pins or data inputs of other	*/
@@ -1392,12 +1519,17 @@ int find_clock_to_term_paths(connlistptr clockedlist, ddataptr *masterlist, netp
 	    // Connection is an input pin;  must calculate both rising and falling edges.
 	    srcdir = EITHER;
 	    tdriver = 0.0;	// To-do: use designated input transition time
+	    selectedsource = NULL;
 	}
 
 	// Report on paths and their maximum delays
 	if (verbose > 0) {
-	    fprintf(stdout, "Paths starting at flop \"%s\" clock:\n\n",
+	    if (thisconn->refinst != NULL)
+		fprintf(stdout, "Paths starting at flop \"%s\" clock:\n\n",
 			thisconn->refinst->name);
+	    else
+		fprintf(stdout, "Paths starting at input pin \"%s\":\n\n",
+			thisconn->refnet->name);
 	    fflush(stdout);
 	}
 
@@ -1472,22 +1604,20 @@ int find_clock_to_term_paths(connlistptr clockedlist, ddataptr *masterlist, netp
 
 		    for (backtrace = testddata->backtrace; backtrace->next;
 				backtrace = backtrace->next) {
-			if (verbose > 0)
-			    fprintf(stdout, "   %g (%s) %s/%s -> %s/%s\n",
-					backtrace->delay,
-					backtrace->receiver->refnet->name,
-					backtrace->receiver->refnet->driver->refinst->name,
-					backtrace->receiver->refnet->driver->refpin->name,
-					backtrace->receiver->refinst->name,
-					backtrace->receiver->refpin->name);
+			if (verbose > 0) print_path_step(backtrace);
 		    }
-		    if (verbose > 0)
-			fprintf(stdout, "   000.000 (%s) %s/%s -> %s/%s\n",
+		    if (verbose > 0) {
+			if (backtrace->receiver->refinst != NULL)
+			    fprintf(stdout, "   000.000 (%s) %s/%s -> %s/%s\n",
 				backtrace->receiver->refnet->name,
 				backtrace->receiver->refinst->name,
 				backtrace->receiver->refpin->name,
 				backtrace->receiver->refinst->name,
 				backtrace->receiver->refinst->out_connects->refpin->name);
+			else
+			    fprintf(stdout, "   000.000 (%s) [input pin]\n",
+				backtrace->receiver->refnet->name);
+		    }
 
 		    if (selecteddest != NULL && selectedsource != NULL) {
 			if (verbose > 0) {
@@ -1533,28 +1663,19 @@ int find_clock_to_term_paths(connlistptr clockedlist, ddataptr *masterlist, netp
 		fprintf(stdout, "Path terminated on output \"%s\" with max delay %g ps\n",
 				testddata->backtrace->receiver->refnet->name, testddata->delay);
 
-		backtrace = testddata->backtrace;
-		fprintf(stdout, "   %g (%s) %s/%s -> [output pin]\n",
-			backtrace->delay,
-			backtrace->receiver->refnet->name,
-			backtrace->receiver->refnet->driver->refinst->name,
-			backtrace->receiver->refnet->driver->refpin->name);
-
-		for (backtrace = backtrace->next; backtrace->next; backtrace = backtrace->next) {
-		    fprintf(stdout, "   %g (%s) %s/%s -> %s/%s\n",
-				backtrace->delay,
-				backtrace->receiver->refnet->name,
-				backtrace->receiver->refnet->driver->refinst->name,
-				backtrace->receiver->refnet->driver->refpin->name,
-				backtrace->receiver->refinst->name,
-				backtrace->receiver->refpin->name);
-		}
-		fprintf(stdout, "   000.000 (%s) %s/%s -> %s/%s\n\n",
+		for (backtrace = testddata->backtrace; backtrace->next;
+				backtrace = backtrace->next)
+		    print_path_step(backtrace);
+		if (backtrace->receiver->refinst != NULL)
+		    fprintf(stdout, "   000.000 (%s) %s/%s -> %s/%s\n\n",
 			backtrace->receiver->refnet->name,
 			backtrace->receiver->refinst->name,
 			backtrace->receiver->refpin->name,
 			backtrace->receiver->refinst->name,
 			backtrace->receiver->refinst->out_connects->refpin->name);
+		else
+		    fprintf(stdout, "   000.000 (%s) [input pin]\n\n",
+			backtrace->receiver->refnet->name);
 	    }
 
 	    // Clean up clock2list
@@ -2525,6 +2646,17 @@ verilogRead(FILE *fsrc, cell *cells, net **netlist, instance **instlist,
 
     int vstart, vend, vtarget, isinput;
 
+    // Cells are looked up by name without regard to case, and nets
+    // with regard to case, as in the verilog source.
+
+    struct hashtable celltab, nettab;
+
+    InitializeHashTable(&celltab, 256, 1);
+    for (testcell = cells; testcell; testcell = testcell->next)
+	if (HashLookup(testcell->name, &celltab) == NULL)
+	    HashPtrInstall(testcell->name, testcell, &celltab);
+    InitializeHashTable(&nettab, 1024, 0);
+
     /* Read tokens off of the line */
     token = advancetoken(fsrc, 0);
 
@@ -2575,6 +2707,7 @@ verilogRead(FILE *fsrc, cell *cells, net **netlist, instance **instlist,
 		    if (vstart == 0 && vend == 0) {
 			newnet = create_net(netlist);
 			newnet->name = strdup(token);
+			HashPtrInstall(newnet->name, newnet, &nettab);
 
 			testconn = (connptr)malloc(sizeof(connect));
 			testconn->refnet = newnet;
@@ -2586,6 +2719,7 @@ verilogRead(FILE *fsrc, cell *cells, net **netlist, instance **instlist,
 			testconn->pfvector = NULL;
 			testconn->trvector = NULL;
 			testconn->tfvector = NULL;
+			testconn->index = -1;
 
 			if (isinput) {			// driver (input)
 			    testconn->next = *inputlist;
@@ -2602,6 +2736,7 @@ verilogRead(FILE *fsrc, cell *cells, net **netlist, instance **instlist,
 			    newnet = create_net(netlist);
 			    newnet->name = (char *)malloc(strlen(token) + 6);
 			    sprintf(newnet->name, "%s[%d]", token, vstart);
+			    HashPtrInstall(newnet->name, newnet, &nettab);
 
 			    vstart += (vtarget > vend) ? 1 : -1;
 
@@ -2615,6 +2750,7 @@ verilogRead(FILE *fsrc, cell *cells, net **netlist, instance **instlist,
 			    testconn->pfvector = NULL;
 			    testconn->trvector = NULL;
 			    testconn->tfvector = NULL;
+			    testconn->index = -1;
 
 			    if (isinput) {		// driver (input)
 				testconn->next = *inputlist;
@@ -2642,9 +2778,7 @@ verilogRead(FILE *fsrc, cell *cells, net **netlist, instance **instlist,
 		/* Confirm that the token is a known cell, and continue parsing line if so */
 		/* Otherwise, parse to semicolon line end and continue */
 
-		for (testcell = cells; testcell; testcell = testcell->next)
-		    if (!strcasecmp(testcell->name, token))
-			break;
+		testcell = (cellptr)HashLookup(token, &celltab);
 
 		if (testcell != NULL) {
 		    section = INSTANCE;
@@ -2654,6 +2788,8 @@ verilogRead(FILE *fsrc, cell *cells, net **netlist, instance **instlist,
 		    newinst->refcell = testcell;
 		    newinst->in_connects = NULL;
 		    newinst->out_connects = NULL;
+		    newinst->level = 0;
+		    newinst->pending = 0;
 		}
 		else {
 		    /* Ignore all wire and assign statements	*/
@@ -2709,6 +2845,7 @@ verilogRead(FILE *fsrc, cell *cells, net **netlist, instance **instlist,
 		    newconn->pfvector = NULL;
 		    newconn->trvector = NULL;
 		    newconn->tfvector = NULL;
+		    newconn->index = -1;
 		    token = advancetoken(fsrc, '(');	// Read to beginning of pin name
 		    section = PINCONN;
 		}
@@ -2725,14 +2862,12 @@ verilogRead(FILE *fsrc, cell *cells, net **netlist, instance **instlist,
 
 	    case PINCONN:
 		// Token is net name
-		for (testnet = *netlist; testnet; testnet = testnet->next) {
-		    if (!strcmp(testnet->name, token))
-			break;
-		}
+		testnet = (netptr)HashLookup(token, &nettab);
 		if (testnet == NULL) {
 		    // This is a new net, and we need to record it
 		    newnet = create_net(netlist);
 		    newnet->name = strdup(token);
+		    HashPtrInstall(newnet->name, newnet, &nettab);
 		    newconn->refnet = newnet;
 		}
 		else
@@ -2745,6 +2880,8 @@ verilogRead(FILE *fsrc, cell *cells, net **netlist, instance **instlist,
 	else
 	    token = advancetoken(fsrc, 0);
     }
+    HashKill(&celltab);
+    HashKill(&nettab);
 }
 
 /*--------------------------------------------------------------*/
@@ -2931,6 +3068,1170 @@ createLinks(netptr netlist, instptr instlist, connptr inputlist, connptr outputl
     }
 }
 
+/*--------------------------------------------------------------*/
+/* Number the nets and the gate input connections of the	*/
+/* netlist, so that timing and per-corner data can be kept in	*/
+/* arrays.  Return the number of nets in "numnets" and the	*/
+/* total number of net receivers in "numrcvrs".  Return value	*/
+/* is the number of gate input connections.			*/
+/*--------------------------------------------------------------*/
+
+int
+index_netlist(netptr netlist, instptr instlist, int *numnets, int *numrcvrs)
+{
+    netptr testnet;
+    instptr testinst;
+    connptr testconn;
+    int numconns;
+
+    *numnets = 0;
+    *numrcvrs = 0;
+    for (testnet = netlist; testnet; testnet = testnet->next) {
+	testnet->index = (*numnets)++;
+	*numrcvrs += testnet->fanout;
+    }
+
+    numconns = 0;
+    for (testinst = instlist; testinst; testinst = testinst->next)
+	for (testconn = testinst->in_connects; testconn; testconn = testconn->next)
+	    testconn->index = numconns++;
+
+    return numconns;
+}
+
+/*--------------------------------------------------------------*/
+/* Set up the connection records of corner "tcorner" for a	*/
+/* netlist that was read against the cells of another corner.	*/
+/* Each gate input gets a copy of its connection record	with	*/
+/* the pin of the same name in the corner's cell, and with the	*/
+/* delay tables collapsed at the loads computed from the	*/
+/* corner's pin capacitances.					*/
+/*								*/
+/* Return the number of instances whose cell is missing from	*/
+/* the corner;  these keep the timing of the first corner.	*/
+/*--------------------------------------------------------------*/
+
+int
+corner_setup(cornerptr tcorner, netptr netlist, instptr instlist, int numnets,
+		int numconns, double out_load)
+{
+    instptr testinst;
+    netptr testnet, loadnet;
+    connptr testconn, newconn;
+    cellptr testcell;
+    pinptr testpin;
+    double *loadr, *loadf;
+    int i, missing;
+    struct hashtable celltab;
+
+    InitializeHashTable(&celltab, 256, 1);
+    for (testcell = tcorner->cells; testcell; testcell = testcell->next)
+	if (HashLookup(testcell->name, &celltab) == NULL)
+	    HashPtrInstall(testcell->name, testcell, &celltab);
+
+    tcorner->conns = (connptr *)malloc((numconns + 1) * sizeof(connptr));
+    missing = 0;
+
+    for (testinst = instlist; testinst; testinst = testinst->next) {
+	testcell = (cellptr)HashLookup(testinst->refcell->name, &celltab);
+	if (testcell == NULL) missing++;
+
+	for (testconn = testinst->in_connects; testconn; testconn = testconn->next) {
+	    newconn = (connptr)malloc(sizeof(connect));
+	    memcpy(newconn, testconn, sizeof(connect));
+	    newconn->prvector = NULL;
+	    newconn->pfvector = NULL;
+	    newconn->trvector = NULL;
+	    newconn->tfvector = NULL;
+	    newconn->next = NULL;
+
+	    testpin = NULL;
+	    if (testcell != NULL) {
+		for (testpin = testcell->pins; testpin; testpin = testpin->next)
+		    if (!strcmp(testpin->name, testconn->refpin->name))
+			break;
+		if (testpin == NULL)
+		    fprintf(stderr, "No pin \"%s\" in cell \"%s\" of corner %s!\n",
+				testconn->refpin->name, testcell->name,
+				tcorner->libfile);
+	    }
+	    if (testpin != NULL) newconn->refpin = testpin;
+	    tcorner->conns[testconn->index] = newconn;
+	}
+    }
+
+    // Compute the load on each net from this corner's pins
+
+    loadr = (double *)calloc(numnets, sizeof(double));
+    loadf = (double *)calloc(numnets, sizeof(double));
+
+    for (testnet = netlist; testnet; testnet = testnet->next) {
+	for (i = 0; i < testnet->fanout; i++) {
+	    testconn = testnet->receivers[i];
+	    if (testconn->index < 0) {
+		loadr[testnet->index] += out_load;
+		loadf[testnet->index] += out_load;
+	    }
+	    else {
+		testpin = tcorner->conns[testconn->index]->refpin;
+		loadr[testnet->index] += testpin->capr;
+		loadf[testnet->index] += testpin->capf;
+	    }
+	}
+    }
+
+    for (testinst = instlist; testinst; testinst = testinst->next) {
+	loadnet = testinst->out_connects->refnet;
+	for (testconn = testinst->in_connects; testconn; testconn = testconn->next) {
+	    newconn = tcorner->conns[testconn->index];
+	    testpin = newconn->refpin;
+
+	    if (testpin->propdelr)
+		newconn->prvector = table_collapse(testpin->propdelr,
+				loadr[loadnet->index]);
+	    if (testpin->propdelf)
+		newconn->pfvector = table_collapse(testpin->propdelf,
+				loadf[loadnet->index]);
+	    if (testpin->transr)
+		newconn->trvector = table_collapse(testpin->transr,
+				loadr[loadnet->index]);
+	    if (testpin->transf)
+		newconn->tfvector = table_collapse(testpin->transf,
+				loadf[loadnet->index]);
+	}
+    }
+
+    free(loadr);
+    free(loadf);
+    HashKill(&celltab);
+    return missing;
+}
+
+/*--------------------------------------------------------------*/
+/* Return the record of connection "testconn" in corner		*/
+/* "tcorner", which has the corner's pin and delay vectors.	*/
+/*--------------------------------------------------------------*/
+
+connptr
+corner_conn(cornerptr tcorner, connptr testconn)
+{
+    if ((tcorner->conns == NULL) || (testconn->index < 0)) return testconn;
+    return tcorner->conns[testconn->index];
+}
+
+/*--------------------------------------------------------------*/
+/* Determine if a gate input connection carries a signal to	*/
+/* the gate output in graph mode.  Signals pass through all	*/
+/* inputs of a combinational gate, but only through the clock	*/
+/* or enable input of a flop or latch;  its other inputs are	*/
+/* path ends.							*/
+/*--------------------------------------------------------------*/
+
+char
+is_timing_arc(connptr testconn)
+{
+    instptr testinst;
+    pinptr testpin;
+
+    testinst = testconn->refinst;
+    testpin = testconn->refpin;
+    if ((testinst == NULL) || (testpin == NULL)) return 0;
+
+    if (testinst->refcell->type & (DFF | LATCH))
+	return (testpin->type & (DFFCLK | LATCHEN)) ? 1 : 0;
+    return 1;
+}
+
+/*--------------------------------------------------------------*/
+/* Sort the instances of the netlist in topological order, so	*/
+/* that every gate comes after all of the gates driving its	*/
+/* inputs (Kahn's algorithm).  Path starts are module inputs	*/
+/* and flop outputs.  The logic level of each instance is	*/
+/* recorded in the instance record.				*/
+/*								*/
+/* Gates on combinational loops can never be ordered.  They	*/
+/* are put at the end of the list, and the signals arriving	*/
+/* around the loop are ignored.					*/
+/*								*/
+/* Return the array of instances in "orderptr", and the number	*/
+/* of instances in "numinst".  Return value is the number of	*/
+/* levels.							*/
+/*--------------------------------------------------------------*/
+
+int
+levelize(instptr instlist, instptr **orderptr, int *numinst)
+{
+    instptr testinst, driverinst, *order;
+    connptr testconn, testrcvr;
+    netptr testnet;
+    int i, head, tail, count, maxlevel;
+
+    count = 0;
+    for (testinst = instlist; testinst; testinst = testinst->next) count++;
+    order = (instptr *)malloc((count + 1) * sizeof(instptr));
+
+    // Count the inputs of each gate that are driven by other gates
+
+    tail = 0;
+    for (testinst = instlist; testinst; testinst = testinst->next) {
+	testinst->level = 0;
+	testinst->pending = 0;
+	for (testconn = testinst->in_connects; testconn; testconn = testconn->next) {
+	    if (!is_timing_arc(testconn)) continue;
+	    testnet = testconn->refnet;
+	    if ((testnet->driver != NULL) && (testnet->driver->refinst != NULL))
+		testinst->pending++;
+	}
+	if (testinst->pending == 0) order[tail++] = testinst;
+    }
+
+    // Take gates off the front of the list, and add each gate that
+    // they drive once all of its inputs have been seen.
+
+    maxlevel = 0;
+    for (head = 0; head < tail; head++) {
+	testinst = order[head];
+	for (testconn = testinst->in_connects; testconn; testconn = testconn->next) {
+	    if (!is_timing_arc(testconn)) continue;
+	    testnet = testconn->refnet;
+	    if (testnet->driver == NULL) continue;
+	    driverinst = testnet->driver->refinst;
+	    if ((driverinst != NULL) && (driverinst->level >= testinst->level))
+		testinst->level = driverinst->level + 1;
+	}
+	if (testinst->level > maxlevel) maxlevel = testinst->level;
+
+	for (testconn = testinst->out_connects; testconn; testconn = testconn->next) {
+	    testnet = testconn->refnet;
+	    if ((testnet == NULL) || (testnet->driver != testconn)) continue;
+	    for (i = 0; i < testnet->fanout; i++) {
+		testrcvr = testnet->receivers[i];
+		if (!is_timing_arc(testrcvr)) continue;
+		if (--testrcvr->refinst->pending == 0)
+		    order[tail++] = testrcvr->refinst;
+	    }
+	}
+    }
+
+    if (tail < count) {
+	fprintf(stderr, "Warning:  %d gates are on combinational loops;  "
+		"loop paths are not timed.\n", count - tail);
+	for (testinst = instlist; testinst; testinst = testinst->next) {
+	    if (testinst->pending > 0) {
+		testinst->pending = 0;
+		testinst->level = maxlevel + 1;
+		order[tail++] = testinst;
+	    }
+	}
+	maxlevel++;
+    }
+
+    *orderptr = order;
+    *numinst = count;
+    return maxlevel + 1;
+}
+
+/*--------------------------------------------------------------*/
+/* Compute the arrival times at the output of "testinst" from	*/
+/* the arrival times at its inputs in scenario "sc", for both	*/
+/* edges and for both minimum and maximum delay.  Each output	*/
+/* edge keeps the input connection and edge on its worst path,	*/
+/* for tracing the path back afterward.				*/
+/*								*/
+/* A flop or latch launches its maximum delay paths from the	*/
+/* earliest arrival of the clock, and its minimum delay paths	*/
+/* from the latest arrival, which is the same clock arrival	*/
+/* that endpoint_delay() checks them against.  Launch and	*/
+/* capture on the same clock net then cancel exactly, as they	*/
+/* do in path mode.						*/
+/*--------------------------------------------------------------*/
+
+void
+gate_arrival(scenptr sc, instptr testinst)
+{
+    connptr testconn, cornerconn;
+    nettiming *intime, *outtime;
+    cellptr testcell;
+    double delay;
+    short indir, outdir, odir;
+    int minmax, im, ie, oe, active;
+
+    if (testinst->out_connects == NULL) return;
+    if (testinst->out_connects->refnet == NULL) return;
+    outtime = &sc->timing[testinst->out_connects->refnet->index];
+
+    // A flop or latch output changes only on the active clock edge
+
+    testcell = testinst->refcell;
+    if (testcell->type & DFF)
+	active = (testcell->type & CLK_SENSE_MASK) ? 1 : 0;
+    else if (testcell->type & LATCH)
+	active = (testcell->type & EN_SENSE_MASK) ? 1 : 0;
+    else
+	active = -1;
+
+    for (testconn = testinst->in_connects; testconn; testconn = testconn->next) {
+	if (!is_timing_arc(testconn)) continue;
+	intime = &sc->timing[testconn->refnet->index];
+	cornerconn = corner_conn(sc->tcorner, testconn);
+
+	for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+	    im = (active < 0) ? minmax : (minmax == MAXIMUM_TIME) ?
+			MINIMUM_TIME : MAXIMUM_TIME;
+	    for (ie = 0; ie < 2; ie++) {
+		if ((active >= 0) && (ie != active)) continue;
+		if (!ARRIVAL_VALID(intime, im, ie)) continue;
+		indir = (ie == 0) ? RISING : FALLING;
+		outdir = calc_dir(cornerconn->refpin, indir);
+
+		for (oe = 0; oe < 2; oe++) {
+		    odir = (oe == 0) ? RISING : FALLING;
+		    if (!(outdir & odir)) continue;
+
+		    delay = intime->arrival[im][ie] + calc_prop_delay(
+				intime->slew[im][ie], cornerconn, odir, minmax);
+		    if ((minmax == MAXIMUM_TIME) ?
+				(delay > outtime->arrival[minmax][oe]) :
+				(delay < outtime->arrival[minmax][oe])) {
+			outtime->arrival[minmax][oe] = delay;
+			outtime->slew[minmax][oe] = calc_transition(
+				intime->slew[im][ie], cornerconn, odir, minmax);
+			outtime->source[minmax][oe] = testconn;
+			outtime->srcdir[minmax][oe] = indir;
+		    }
+		}
+	    }
+	}
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Find the arrival time and transition time of the clock at	*/
+/* the flop or latch "testinst" in scenario "sc", for its	*/
+/* active clock edge.  If the clock has no arrival time (e.g.,	*/
+/* it is not driven from a module input), both are zero.	*/
+/*--------------------------------------------------------------*/
+
+void
+find_clock_arrival(scenptr sc, instptr testinst, int minmax, double *arrival,
+		double *slew)
+{
+    connptr testconn;
+    nettiming *clktime;
+    int e;
+
+    *arrival = 0.0;
+    *slew = 0.0;
+
+    for (testconn = testinst->in_connects; testconn; testconn = testconn->next)
+	if (testconn->refpin && (testconn->refpin->type & (DFFCLK | LATCHEN)))
+	    break;
+    if (testconn == NULL) return;
+
+    clktime = &sc->timing[testconn->refnet->index];
+    if (testinst->refcell->type & DFF)
+	e = (testinst->refcell->type & CLK_SENSE_MASK) ? 1 : 0;
+    else
+	e = (testinst->refcell->type & EN_SENSE_MASK) ? 1 : 0;
+
+    if (ARRIVAL_VALID(clktime, minmax, e)) {
+	*arrival = clktime->arrival[minmax][e];
+	*slew = clktime->slew[minmax][e];
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Compute the path delay at the path end "testrcvr" for edge	*/
+/* "e" of the signal in scenario "sc", as checked against a	*/
+/* clock period.  For maximum delay, this is the arrival time	*/
+/* plus the setup time, less the earliest arrival of the clock	*/
+/* at the destination.  For minimum delay, it is the arrival	*/
+/* time less the hold time, less the latest arrival of the	*/
+/* clock.  These are the clock arrivals that gate_arrival()	*/
+/* launches from, so that a path starting and ending on the	*/
+/* same clock net sees no clock skew.  The delay at a module	*/
+/* output is the arrival time.					*/
+/*--------------------------------------------------------------*/
+
+double
+endpoint_delay(scenptr sc, connptr testrcvr, int e, int minmax)
+{
+    nettiming *testtime;
+    pinptr testpin;
+    double delay, clkarrival, clkslew;
+    short dir;
+
+    testtime = &sc->timing[testrcvr->refnet->index];
+    delay = testtime->arrival[minmax][e];
+    if (testrcvr->refinst == NULL) return delay;
+
+    testpin = corner_conn(sc->tcorner, testrcvr)->refpin;
+    dir = (e == 0) ? RISING : FALLING;
+    if (minmax == MAXIMUM_TIME) {
+	find_clock_arrival(sc, testrcvr->refinst, MINIMUM_TIME, &clkarrival, &clkslew);
+	delay += calc_setup_time(testtime->slew[minmax][e], testpin, clkslew,
+			dir, minmax);
+    }
+    else {
+	find_clock_arrival(sc, testrcvr->refinst, MAXIMUM_TIME, &clkarrival, &clkslew);
+	delay -= calc_hold_time(testtime->slew[minmax][e], testpin, clkslew,
+			dir, minmax);
+    }
+    return delay - clkarrival;
+}
+
+/*--------------------------------------------------------------*/
+/* Collect all path ends (module outputs and flop or latch	*/
+/* data inputs) that have an arrival time in scenario "sc",	*/
+/* keeping the worst edge of each.  "endlist" has one slot for	*/
+/* each net receiver, in netlist order, so that the slots of	*/
+/* different scenarios can be compared.  Slots that are not	*/
+/* path ends get a NULL receiver.  Return the number of path	*/
+/* ends.							*/
+/*--------------------------------------------------------------*/
+
+int
+collect_endpoints(scenptr sc, netptr netlist, endptr endlist, int minmax)
+{
+    netptr testnet;
+    connptr testrcvr;
+    nettiming *testtime;
+    endptr newend;
+    double delay;
+    int i, e, numends;
+
+    numends = 0;
+    newend = endlist;
+    for (testnet = netlist; testnet; testnet = testnet->next) {
+	testtime = &sc->timing[testnet->index];
+	for (i = 0; i < testnet->fanout; i++, newend++) {
+	    newend->receiver = NULL;
+	    testrcvr = testnet->receivers[i];
+	    if (testrcvr->refpin && !(testrcvr->refpin->type & REG_IN_NOT_CLK))
+		continue;
+
+	    for (e = 0; e < 2; e++) {
+		if (!ARRIVAL_VALID(testtime, minmax, e)) continue;
+		delay = endpoint_delay(sc, testrcvr, e, minmax);
+		if ((newend->receiver == NULL) || ((minmax == MAXIMUM_TIME) ?
+				(delay > newend->delay) : (delay < newend->delay))) {
+		    newend->delay = delay;
+		    newend->dir = (e == 0) ? RISING : FALLING;
+		    newend->receiver = testrcvr;
+		}
+	    }
+	    if (newend->receiver != NULL) numends++;
+	}
+    }
+    return numends;
+}
+
+/*--------------------------------------------------------------*/
+/* Return the worst of the rise and fall slacks of a net with	*/
+/* timing record "testtime", or TIME_INFINITY if the net has	*/
+/* no timed path through it.					*/
+/*--------------------------------------------------------------*/
+
+double
+net_slack(nettiming *testtime)
+{
+    double slack, netslack;
+    int e;
+
+    netslack = TIME_INFINITY;
+    for (e = 0; e < 2; e++) {
+	if (!ARRIVAL_VALID(testtime, MAXIMUM_TIME, e)) continue;
+	if (testtime->required[e] >= TIME_INFINITY) continue;
+	slack = testtime->required[e] - testtime->arrival[MAXIMUM_TIME][e];
+	if (slack < netslack) netslack = slack;
+    }
+    return netslack;
+}
+
+/*--------------------------------------------------------------*/
+/* Compute the required time of each net in scenario "sc" for	*/
+/* maximum delay against the scenario's clock period, working	*/
+/* backward from the path ends in reverse topological order.	*/
+/* Required times are not carried into the clock network.	*/
+/* Set the number of nets with negative slack, and the worst	*/
+/* slack, in the scenario record.				*/
+/*--------------------------------------------------------------*/
+
+void
+propagate_required(scenptr sc, netptr netlist, instptr *order, int numinst,
+		int numslots)
+{
+    netptr testnet;
+    connptr testconn, cornerconn;
+    instptr testinst;
+    nettiming *testtime, *intime, *outtime;
+    endptr testend;
+    double required, netslack;
+    short indir, outdir, odir;
+    int i, e, ie, oe;
+
+    for (i = 0; i < numslots; i++) {
+	testend = &sc->maxends[i];
+	if (testend->receiver == NULL) continue;
+	testtime = &sc->timing[testend->receiver->refnet->index];
+	for (e = 0; e < 2; e++) {
+	    if (!ARRIVAL_VALID(testtime, MAXIMUM_TIME, e)) continue;
+	    required = sc->period - endpoint_delay(sc, testend->receiver, e,
+			MAXIMUM_TIME) + testtime->arrival[MAXIMUM_TIME][e];
+	    if (required < testtime->required[e])
+		testtime->required[e] = required;
+	}
+    }
+
+    for (i = numinst - 1; i >= 0; i--) {
+	testinst = order[i];
+	if (testinst->refcell->type & (DFF | LATCH)) continue;
+	if (testinst->out_connects == NULL) continue;
+	if (testinst->out_connects->refnet == NULL) continue;
+	outtime = &sc->timing[testinst->out_connects->refnet->index];
+
+	for (testconn = testinst->in_connects; testconn; testconn = testconn->next) {
+	    intime = &sc->timing[testconn->refnet->index];
+	    cornerconn = corner_conn(sc->tcorner, testconn);
+	    for (ie = 0; ie < 2; ie++) {
+		if (!ARRIVAL_VALID(intime, MAXIMUM_TIME, ie)) continue;
+		indir = (ie == 0) ? RISING : FALLING;
+		outdir = calc_dir(cornerconn->refpin, indir);
+
+		for (oe = 0; oe < 2; oe++) {
+		    odir = (oe == 0) ? RISING : FALLING;
+		    if (!(outdir & odir)) continue;
+		    if (outtime->required[oe] >= TIME_INFINITY) continue;
+
+		    required = outtime->required[oe] - calc_prop_delay(
+				intime->slew[MAXIMUM_TIME][ie], cornerconn, odir,
+				MAXIMUM_TIME);
+		    if (required < intime->required[ie])
+			intime->required[ie] = required;
+		}
+	    }
+	}
+    }
+
+    sc->numneg = 0;
+    sc->worstslack = TIME_INFINITY;
+    for (testnet = netlist; testnet; testnet = testnet->next) {
+	netslack = net_slack(&sc->timing[testnet->index]);
+	if (netslack < 0.0) sc->numneg++;
+	if (netslack < sc->worstslack) sc->worstslack = netslack;
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Run the timing analysis of one scenario:  Propagate arrival	*/
+/* times forward through the levelized netlist "order", find	*/
+/* the path ends, and propagate required times backward.	*/
+/* Scenarios share the netlist but write only to their own	*/
+/* records, so they may be run at the same time.		*/
+/*--------------------------------------------------------------*/
+
+void
+scenario_timing(scenptr sc, netptr netlist, connptr inputlist, instptr *order,
+		int numinst, int numnets, int numslots)
+{
+    connptr testconn;
+    nettiming *testtime;
+    int i, e, minmax;
+
+    sc->timing = (nettiming *)malloc(numnets * sizeof(nettiming));
+    sc->maxends = (endptr)malloc((numslots + 1) * sizeof(endpoint));
+    sc->minends = (endptr)malloc((numslots + 1) * sizeof(endpoint));
+
+    // Initialize timing, and set arrival times at module inputs
+
+    for (i = 0; i < numnets; i++) {
+	testtime = &sc->timing[i];
+	for (e = 0; e < 2; e++) {
+	    testtime->arrival[MINIMUM_TIME][e] = TIME_INFINITY;
+	    testtime->arrival[MAXIMUM_TIME][e] = -TIME_INFINITY;
+	    testtime->required[e] = TIME_INFINITY;
+	    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+		testtime->slew[minmax][e] = 0.0;
+		testtime->source[minmax][e] = NULL;
+		testtime->srcdir[minmax][e] = EDGE_UNKNOWN;
+	    }
+	}
+    }
+
+    for (testconn = inputlist; testconn; testconn = testconn->next) {
+	testtime = &sc->timing[testconn->refnet->index];
+	for (e = 0; e < 2; e++) {
+	    for (minmax = MINIMUM_TIME; minmax <= MAXIMUM_TIME; minmax++) {
+		testtime->arrival[minmax][e] = 0.0;
+		testtime->slew[minmax][e] = sc->tmode->inTrans;
+	    }
+	}
+    }
+
+    // Forward propagation of arrival times
+
+    for (i = 0; i < numinst; i++)
+	gate_arrival(sc, order[i]);
+
+    sc->nummax = collect_endpoints(sc, netlist, sc->maxends, MAXIMUM_TIME);
+    sc->nummin = collect_endpoints(sc, netlist, sc->minends, MINIMUM_TIME);
+
+    // With no clock period given, the longest path sets the period
+
+    sc->period = sc->tmode->period;
+    if ((sc->period <= 0.0) && (sc->nummax > 0)) {
+	sc->period = -TIME_INFINITY;
+	for (i = 0; i < numslots; i++)
+	    if ((sc->maxends[i].receiver != NULL) &&
+			(sc->maxends[i].delay > sc->period))
+		sc->period = sc->maxends[i].delay;
+    }
+
+    // Backward propagation of required times
+
+    propagate_required(sc, netlist, order, numinst, numslots);
+}
+
+/*--------------------------------------------------------------*/
+/* Thread to run all scenarios of one corner.			*/
+/*--------------------------------------------------------------*/
+
+typedef struct _cornerjob {
+   cornerptr tcorner;
+   scenptr   scenarios;
+   int	     numscen;
+   netptr    netlist;
+   connptr   inputlist;
+   instptr   *order;
+   int	     numinst;
+   int	     numnets;
+   int	     numslots;
+} cornerjob;
+
+void *
+corner_thread(void *arg)
+{
+    cornerjob *job = (cornerjob *)arg;
+    int i;
+
+    for (i = 0; i < job->numscen; i++)
+	if (job->scenarios[i].tcorner == job->tcorner)
+	    scenario_timing(&job->scenarios[i], job->netlist, job->inputlist,
+			job->order, job->numinst, job->numnets, job->numslots);
+    return NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* Trace the worst path to the path end "testend" in scenario	*/
+/* "sc" back to its start, which is either a flop or latch	*/
+/* clock input or a net with no driving gate (normally a	*/
+/* module input).  Print each stage of the path if "print" is	*/
+/* set.  Return the connection at the path start, or NULL if	*/
+/* the path starts at a net, which is returned in "startnet".	*/
+/*--------------------------------------------------------------*/
+
+connptr
+trace_path(scenptr sc, endptr testend, int minmax, netptr *startnet, char print)
+{
+    connptr testconn, srcconn;
+    netptr testnet;
+    nettiming *testtime;
+    short dir;
+
+    testconn = testend->receiver;
+    dir = testend->dir;
+    while (1) {
+	testnet = testconn->refnet;
+	testtime = &sc->timing[testnet->index];
+	if (print) {
+	    fprintf(stdout, "   %g (%s) ", testtime->arrival[minmax][EDGE_INDEX(dir)],
+			testnet->name);
+	    if (testnet->driver && testnet->driver->refinst)
+		fprintf(stdout, "%s/%s", testnet->driver->refinst->name,
+			testnet->driver->refpin->name);
+	    else
+		fprintf(stdout, "[input pin]");
+	    if (testconn->refinst)
+		fprintf(stdout, " -> %s/%s\n", testconn->refinst->name,
+			testconn->refpin->name);
+	    else
+		fprintf(stdout, " -> [output pin]\n");
+	}
+
+	srcconn = testtime->source[minmax][EDGE_INDEX(dir)];
+	if (srcconn == NULL) {
+	    *startnet = testnet;
+	    return NULL;
+	}
+	if (srcconn->refpin->type & (DFFCLK | LATCHEN)) {
+	    *startnet = srcconn->refnet;
+	    return srcconn;
+	}
+	dir = testtime->srcdir[minmax][EDGE_INDEX(dir)];
+	testconn = srcconn;
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Delay comparison used by qsort() to sort path ends in order	*/
+/* from longest to shortest delay.				*/
+/*--------------------------------------------------------------*/
+
+int
+compendpoint(endptr p, endptr q)
+{
+    if (p->delay < q->delay)
+	return (1);
+    if (p->delay > q->delay)
+	return (-1);
+    return (0);
+}
+
+/*--------------------------------------------------------------*/
+/* Report on the path to one path end in scenario "sc".  If	*/
+/* "label" is set, name the corner and mode of the scenario.	*/
+/* Slack is reported for maximum delay if "sc" has a clock	*/
+/* period.  Set "badtiming" if the path fails.			*/
+/*--------------------------------------------------------------*/
+
+void
+report_endpoint(scenptr sc, endptr testend, int minmax, char label,
+		char *badtiming)
+{
+    connptr startconn, endconn;
+    netptr startnet;
+    double slack;
+
+    startconn = trace_path(sc, testend, minmax, &startnet, 0);
+    endconn = testend->receiver;
+
+    if (startconn != NULL)
+	fprintf(stdout, "Path %s/%s", startconn->refinst->name,
+		startconn->refpin->name);
+    else
+	fprintf(stdout, "Path input pin %s", startnet->name);
+
+    if (endconn->refinst != NULL)
+	fprintf(stdout, " to %s/%s delay %g ps", endconn->refinst->name,
+		endconn->refpin->name, testend->delay);
+    else
+	fprintf(stdout, " to output pin %s delay %g ps", endconn->refnet->name,
+		testend->delay);
+
+    if (minmax == MAXIMUM_TIME) {
+	if (sc->tmode->period > 0.0) {
+	    slack = sc->tmode->period - testend->delay;
+	    fprintf(stdout, "   Slack = %g ps", slack);
+	    if (slack < 0.0) *badtiming = 1;
+	}
+    }
+    else if (testend->delay < 0.0)
+	*badtiming = 1;
+
+    if (label)
+	fprintf(stdout, "   (%s, mode %d)", sc->tcorner->libfile, sc->tmode->index);
+    fprintf(stdout, "\n");
+
+    if (verbose > 0) {
+	trace_path(sc, testend, minmax, &startnet, 1);
+	fprintf(stdout, "\n");
+    }
+}
+
+/*--------------------------------------------------------------*/
+/* Copy the used slots of "slots" into "endlist" and sort them	*/
+/* from longest to shortest delay.				*/
+/*--------------------------------------------------------------*/
+
+void
+sort_endpoints(endptr slots, int numslots, endptr endlist, int numends)
+{
+    int i, j;
+
+    for (i = 0, j = 0; (i < numslots) && (j < numends); i++)
+	if (slots[i].receiver != NULL)
+	    endlist[j++] = slots[i];
+    qsort(endlist, numends, sizeof(endpoint), (__compar_fn_t)compendpoint);
+}
+
+/*--------------------------------------------------------------*/
+/* Report on the maximum and minimum delay paths of a single	*/
+/* scenario.							*/
+/*--------------------------------------------------------------*/
+
+void
+report_scenario(scenptr sc, int numslots, int numreport)
+{
+    endptr endlist;
+    int i;
+    char badtiming;
+
+    endlist = (endptr)malloc((numslots + 1) * sizeof(endpoint));
+
+    /*--------------------------------------------------*/
+    /* Maximum delay paths				*/
+    /*--------------------------------------------------*/
+
+    fprintf(stdout, "Number of paths analyzed:  %d\n", sc->nummax);
+    sort_endpoints(sc->maxends, numslots, endlist, sc->nummax);
+
+    if (verbose > 0 && sc->worstslack < TIME_INFINITY)
+	fprintf(stdout, "Worst net slack %g ps, %d nets with negative slack.\n",
+		sc->worstslack, sc->numneg);
+
+    fprintf(stdout, "\nTop %d maximum delay paths:\n",
+		(sc->nummax >= numreport) ? numreport : sc->nummax);
+    badtiming = 0;
+    for (i = 0; (i < numreport) && (i < sc->nummax); i++)
+	report_endpoint(sc, &endlist[i], MAXIMUM_TIME, 0, &badtiming);
+
+    if (sc->tmode->period > 0.0) {
+	if (badtiming) {
+	    fprintf(stdout, "ERROR:  Design fails timing requirements.\n");
+	}
+	else {
+	    fprintf(stdout, "Design meets timing requirements.\n");
+	}
+    }
+    else if ((sc->nummax > 0) && (endlist[0].delay > 0.0)) {
+	fprintf(stdout, "Computed maximum clock frequency (zero slack) = %g MHz\n",
+		(1.0E6 / endlist[0].delay));
+    }
+    fprintf(stdout, "-----------------------------------------\n\n");
+    fflush(stdout);
+
+    /*--------------------------------------------------*/
+    /* Minimum delay paths				*/
+    /*--------------------------------------------------*/
+
+    fprintf(stdout, "Number of paths analyzed:  %d\n", sc->nummin);
+    sort_endpoints(sc->minends, numslots, endlist, sc->nummin);
+
+    fprintf(stdout, "\nTop %d minimum delay paths:\n",
+		(sc->nummin >= numreport) ? numreport : sc->nummin);
+    badtiming = 0;
+    for (i = sc->nummin; (i > (sc->nummin - numreport)) && (i > 0); i--)
+	report_endpoint(sc, &endlist[i - 1], MINIMUM_TIME, 0, &badtiming);
+
+    if (badtiming)
+	fprintf(stdout, "ERROR:  Design fails minimum hold timing.\n");
+    else
+	fprintf(stdout, "Design meets minimum hold timing.\n");
+
+    fprintf(stdout, "-----------------------------------------\n\n");
+    fflush(stdout);
+
+    free(endlist);
+}
+
+/*--------------------------------------------------------------*/
+/* Worst slack of a path end over all scenarios			*/
+/*--------------------------------------------------------------*/
+
+typedef struct _mergedend *mergedptr;
+
+typedef struct _mergedend {
+   double  slack;	/* Worst slack over all scenarios */
+   scenptr sc;		/* Scenario with the worst slack */
+   endptr  testend;	/* Path end record in that scenario */
+} mergedend;
+
+/*--------------------------------------------------------------*/
+/* Slack comparison used by qsort() to sort merged path ends	*/
+/* from the worst (smallest) slack to the best.			*/
+/*--------------------------------------------------------------*/
+
+int
+compmerged(mergedptr p, mergedptr q)
+{
+    if (p->slack > q->slack)
+	return (1);
+    if (p->slack < q->slack)
+	return (-1);
+    return (0);
+}
+
+/*--------------------------------------------------------------*/
+/* Report on all scenarios together:  A summary of each		*/
+/* scenario, then the path ends with the worst setup slack and	*/
+/* the worst hold slack over all scenarios, each with the	*/
+/* scenario in which it is worst.  The setup slack of a		*/
+/* scenario with no clock period is taken against the longest	*/
+/* path of that scenario.					*/
+/*--------------------------------------------------------------*/
+
+void
+report_merged(scenptr scenarios, int numscen, int numslots, int numreport)
+{
+    scenptr sc;
+    endptr testend;
+    mergedptr merged;
+    double slack;
+    int i, j, numends;
+    char badtiming;
+
+    fprintf(stdout, "Analyzed %d scenarios:\n", numscen);
+    for (j = 0; j < numscen; j++) {
+	sc = &scenarios[j];
+	fprintf(stdout, "   %s, mode %d:  ", sc->tcorner->libfile, sc->tmode->index);
+	if (sc->tmode->period > 0.0)
+	    fprintf(stdout, "period %g ps, worst slack %g ps\n", sc->tmode->period,
+			(sc->worstslack < TIME_INFINITY) ? sc->worstslack : 0.0);
+	else if (sc->period > 0.0)
+	    fprintf(stdout, "maximum clock frequency %g MHz\n", 1.0E6 / sc->period);
+	else
+	    fprintf(stdout, "no timed paths\n");
+    }
+    fprintf(stdout, "\n");
+
+    merged = (mergedptr)malloc((numslots + 1) * sizeof(mergedend));
+
+    /*--------------------------------------------------*/
+    /* Worst setup slack over all scenarios		*/
+    /*--------------------------------------------------*/
+
+    numends = 0;
+    for (i = 0; i < numslots; i++) {
+	merged[numends].sc = NULL;
+	for (j = 0; j < numscen; j++) {
+	    sc = &scenarios[j];
+	    testend = &sc->maxends[i];
+	    if (testend->receiver == NULL) continue;
+	    slack = sc->period - testend->delay;
+	    if ((merged[numends].sc == NULL) || (slack < merged[numends].slack)) {
+		merged[numends].slack = slack;
+		merged[numends].sc = sc;
+		merged[numends].testend = testend;
+	    }
+	}
+	if (merged[numends].sc != NULL) numends++;
+    }
+    qsort(merged, numends, sizeof(mergedend), (__compar_fn_t)compmerged);
+
+    fprintf(stdout, "Top %d maximum delay paths (worst over all scenarios):\n",
+		(numends >= numreport) ? numreport : numends);
+    badtiming = 0;
+    for (i = 0; (i < numreport) && (i < numends); i++)
+	report_endpoint(merged[i].sc, merged[i].testend, MAXIMUM_TIME, 1,
+		&badtiming);
+    for (; i < numends; i++)
+	if ((merged[i].sc->tmode->period > 0.0) && (merged[i].slack < 0.0))
+	    badtiming = 1;
+
+    if (badtiming)
+	fprintf(stdout, "ERROR:  Design fails timing requirements.\n");
+    else
+	fprintf(stdout, "Design meets timing requirements.\n");
+    fprintf(stdout, "-----------------------------------------\n\n");
+
+    /*--------------------------------------------------*/
+    /* Worst hold slack over all scenarios		*/
+    /*--------------------------------------------------*/
+
+    numends = 0;
+    for (i = 0; i < numslots; i++) {
+	merged[numends].sc = NULL;
+	for (j = 0; j < numscen; j++) {
+	    sc = &scenarios[j];
+	    testend = &sc->minends[i];
+	    if (testend->receiver == NULL) continue;
+	    if ((merged[numends].sc == NULL) ||
+			(testend->delay < merged[numends].slack)) {
+		merged[numends].slack = testend->delay;
+		merged[numends].sc = sc;
+		merged[numends].testend = testend;
+	    }
+	}
+	if (merged[numends].sc != NULL) numends++;
+    }
+    qsort(merged, numends, sizeof(mergedend), (__compar_fn_t)compmerged);
+
+    fprintf(stdout, "Top %d minimum delay paths (worst over all scenarios):\n",
+		(numends >= numreport) ? numreport : numends);
+    badtiming = 0;
+    for (i = 0; (i < numreport) && (i < numends); i++)
+	report_endpoint(merged[i].sc, merged[i].testend, MINIMUM_TIME, 1,
+		&badtiming);
+    if ((numends > 0) && (merged[0].slack < 0.0)) badtiming = 1;
+
+    if (badtiming)
+	fprintf(stdout, "ERROR:  Design fails minimum hold timing.\n");
+    else
+	fprintf(stdout, "Design meets minimum hold timing.\n");
+    fprintf(stdout, "-----------------------------------------\n\n");
+    fflush(stdout);
+
+    free(merged);
+}
+
+/*--------------------------------------------------------------*/
+/* Write the worst slack of each net over all scenarios to	*/
+/* "slackfile", for timing-driven placement.  The period	*/
+/* written is the shortest clock period of the scenarios.	*/
+/* Nets with no timed path through them are left out.		*/
+/*--------------------------------------------------------------*/
+
+void
+write_slacks(char *slackfile, scenptr scenarios, int numscen, netptr netlist)
+{
+    FILE *fslk;
+    netptr testnet;
+    double period, slack, netslack;
+    int j, numwritten;
+
+    fslk = fopen(slackfile, "w");
+    if (fslk == NULL) {
+	fprintf(stderr, "Cannot open %s for writing\n", slackfile);
+	return;
+    }
+
+    period = 0.0;
+    for (j = 0; j < numscen; j++)
+	if ((scenarios[j].period > 0.0) &&
+			((period == 0.0) || (scenarios[j].period < period)))
+	    period = scenarios[j].period;
+
+    fprintf(fslk, "# Net slacks from vesta, worst of %d scenario%s (ps)\n",
+		numscen, (numscen == 1) ? "" : "s");
+    if (period > 0.0) fprintf(fslk, "period %g\n", period);
+
+    numwritten = 0;
+    for (testnet = netlist; testnet; testnet = testnet->next) {
+	netslack = TIME_INFINITY;
+	for (j = 0; j < numscen; j++) {
+	    slack = net_slack(&scenarios[j].timing[testnet->index]);
+	    if (slack < netslack) netslack = slack;
+	}
+	if (netslack >= TIME_INFINITY) continue;
+	fprintf(fslk, "%s %g\n", testnet->name, netslack);
+	numwritten++;
+    }
+    fclose(fslk);
+
+    if (verbose > 0)
+	fprintf(stdout, "Wrote slacks of %d nets to %s.\n", numwritten, slackfile);
+}
+
+/*--------------------------------------------------------------*/
+/* Graph-based static timing analysis.				*/
+/*								*/
+/* The netlist is levelized once, and the rise and fall arrival	*/
+/* and transition times at every net are propagated in		*/
+/* topological order, for both maximum and minimum delay.  The	*/
+/* module inputs arrive at time zero;  flop outputs arrive at	*/
+/* the time the clock arrives at the flop, plus the		*/
+/* clock-to-output delay.  Then required times are propagated	*/
+/* backward from the path ends to find the slack of each net.	*/
+/* Only the worst "numreport" paths in each direction are	*/
+/* traced and reported.						*/
+/*								*/
+/* This is done for each mode in "modelist" at each corner in	*/
+/* "cornerlist", with the corners on parallel threads.  With	*/
+/* more than one scenario, the report merges the scenarios,	*/
+/* giving the worst slack of each path end.  "out_load" is the	*/
+/* load on module outputs, for computing the loads of corners	*/
+/* other than the first.  If "slackfile" is not NULL, the net	*/
+/* slacks are written to it.					*/
+/*--------------------------------------------------------------*/
+
+void
+graph_analysis(netptr netlist, instptr instlist, connptr inputlist,
+		cornerptr cornerlist, modeptr modelist, double out_load,
+		int numreport, char *slackfile)
+{
+    cornerptr tcorner;
+    modeptr tmode;
+    instptr *order;
+    scenptr scenarios;
+    cornerjob *jobs;
+    pthread_t *threads;
+    int numinst, numlevels, numnets, numslots, numconns, numscen, numcorners;
+    int i, missing;
+
+    numlevels = levelize(instlist, &order, &numinst);
+    if (verbose > 0)
+	fprintf(stdout, "Levelized %d gates into %d levels.\n", numinst, numlevels);
+
+    numconns = index_netlist(netlist, instlist, &numnets, &numslots);
+
+    // The netlist was read against the first corner.  Set up the
+    // connection records of the others.
+
+    numcorners = 0;
+    for (tcorner = cornerlist; tcorner; tcorner = tcorner->next) {
+	if (numcorners++ == 0) continue;
+	missing = corner_setup(tcorner, netlist, instlist, numnets, numconns,
+		out_load);
+	if (missing > 0)
+	    fprintf(stderr, "Warning:  %d gates have no cell in %s.\n",
+			missing, tcorner->libfile);
+    }
+    numscen = 0;
+    for (tmode = modelist; tmode; tmode = tmode->next) numscen++;
+    numscen *= numcorners;
+
+    scenarios = (scenptr)malloc(numscen * sizeof(scenario));
+    i = 0;
+    for (tcorner = cornerlist; tcorner; tcorner = tcorner->next) {
+	for (tmode = modelist; tmode; tmode = tmode->next) {
+	    scenarios[i].tcorner = tcorner;
+	    scenarios[i].tmode = tmode;
+	    i++;
+	}
+    }
+
+    // One thread per corner.  The modes of a corner share its pin
+    // records, and are run one after another.
+
+    jobs = (cornerjob *)malloc(numcorners * sizeof(cornerjob));
+    threads = (pthread_t *)malloc(numcorners * sizeof(pthread_t));
+    i = 0;
+    for (tcorner = cornerlist; tcorner; tcorner = tcorner->next, i++) {
+	jobs[i].tcorner = tcorner;
+	jobs[i].scenarios = scenarios;
+	jobs[i].numscen = numscen;
+	jobs[i].netlist = netlist;
+	jobs[i].inputlist = inputlist;
+	jobs[i].order = order;
+	jobs[i].numinst = numinst;
+	jobs[i].numnets = numnets;
+	jobs[i].numslots = numslots;
+    }
+
+    if (numcorners == 1)
+	corner_thread(&jobs[0]);
+    else {
+	for (i = 0; i < numcorners; i++) {
+	    if (pthread_create(&threads[i], NULL, corner_thread, &jobs[i]) != 0) {
+		// Run it here instead
+		threads[i] = (pthread_t)0;
+		corner_thread(&jobs[i]);
+	    }
+	}
+	for (i = 0; i < numcorners; i++)
+	    if (threads[i] != (pthread_t)0)
+		pthread_join(threads[i], NULL);
+    }
+
+    if (numscen == 1)
+	report_scenario(&scenarios[0], numslots, numreport);
+    else
+	report_merged(scenarios, numscen, numslots, numreport);
+
+    if (slackfile != NULL)
+	write_slacks(slackfile, scenarios, numscen, netlist);
+
+    for (i = 0; i < numscen; i++) {
+	free(scenarios[i].timing);
+	free(scenarios[i].maxends);
+	free(scenarios[i].minends);
+    }
+    free(scenarios);
+    free(jobs);
+    free(threads);
+    free(order);
+}
+
 /*--------------------------------------------------------------*/
 /* Delay comparison used by qsort() to sort paths in order from	*/
 /* longest to shortest propagation delay.			*/
@@ -2962,13 +4263,23 @@ main(int objc, char *argv[])
     double outLoad = 0.0;
     double inTrans = 0.0;
     char *delayfile = NULL;
+    char *slackfile = NULL;
     int ival, firstarg = 1;
+    int numreport = 20;
 
     // Liberty database
 
     lutable *tables = NULL;
     cell *cells = NULL;
 
+    // Corners (one per liberty file) and modes (graph mode only)
+
+    cornerptr	cornerlist = NULL, newcorner, *lastcorner;
+    modeptr	modelist = NULL, newmode, *lastmode;
+    int		numcorners, nummodes = 0;
+    char	*sptr;
+    clock_t	loadstart;
+
     // Verilog netlist database
 
     instptr     instlist = NULL;
@@ -2988,6 +4299,8 @@ main(int objc, char *argv[])
 
     verbose = 0;
     exhaustive = 0;
+    graphmode = 0;
+    lastmode = &modelist;
 
     while ((firstarg < objc) && (*argv[firstarg] == '-')) {
        if (!strcmp(argv[firstarg], "-d") || !strcmp(argv[firstarg], "--delay")) {
@@ -3015,6 +4328,29 @@ main(int objc, char *argv[])
 	  exhaustive = 1;
 	  firstarg++;
        }
+       else if (!strcmp(argv[firstarg], "-g") || !strcmp(argv[firstarg], "--graph")) {
+	  graphmode = 1;
+	  firstarg++;
+       }
+       else if (!strcmp(argv[firstarg], "-n") || !strcmp(argv[firstarg], "--paths")) {
+	  sscanf(argv[firstarg + 1], "%d", &numreport);
+	  firstarg += 2;
+       }
+       else if (!strcmp(argv[firstarg], "-m") || !strcmp(argv[firstarg], "--mode")) {
+	  newmode = (modeptr)malloc(sizeof(mode));
+	  newmode->period = strtod(argv[firstarg + 1], &sptr);
+	  newmode->inTrans = (*sptr == ',') ? strtod(sptr + 1, NULL) : -1.0;
+	  newmode->index = ++nummodes;
+	  newmode->next = NULL;
+	  *lastmode = newmode;
+	  lastmode = &newmode->next;
+	  firstarg += 2;
+       }
+       else if (!strcmp(argv[firstarg], "-s") || !strcmp(argv[firstarg], "--slack")) {
+	  slackfile = strdup(argv[firstarg + 1]);
+	  graphmode = 1;
+	  firstarg += 2;
+       }
        else if (!strcmp(argv[firstarg], "-V") || !strcmp(argv[firstarg], "--version")) {
 	  fprintf(stderr, "Vesta Static Timing Analzyer version 0.2\n");
 	  exit(0);
@@ -3025,14 +4361,18 @@ main(int objc, char *argv[])
        }
     }
 
-    if (objc - firstarg != 2) {
-	fprintf(stderr, "Usage:  vesta [options] <name.v> <name.lib>\n");
+    if (objc - firstarg < 2) {
+	fprintf(stderr, "Usage:  vesta [options] <name.v> <name.lib> [<name.lib> ...]\n");
 	fprintf(stderr, "Options:\n");
 	fprintf(stderr, "--delay <delay_file>	or	-d <delay_file>\n");
 	fprintf(stderr, "--period <period>	or	-p <period>\n");
 	fprintf(stderr, "--load <load>		or	-l <load>\n");
 	fprintf(stderr, "--verbose <level>	or	-v <level>\n");
 	fprintf(stderr, "--exhaustive		or 	-e\n");
+	fprintf(stderr, "--graph			or	-g\n");
+	fprintf(stderr, "--paths <number>	or	-n <number>\n");
+	fprintf(stderr, "--mode <period>[,<trans>]	or	-m <period>[,<trans>]\n");
+	fprintf(stderr, "--slack <slack_file>	or	-s <slack_file>\n");
 	fprintf(stderr, "--version		or	-V\n");
 	exit (1);
     }
@@ -3051,21 +4391,58 @@ main(int objc, char *argv[])
 	exit (1);
     }
 
-    flib = fopen(argv[firstarg + 1], "r");
-    if (flib == NULL) {
-	fprintf(stderr, "Cannot open %s for reading\n", argv[firstarg + 1]);
-	exit (1);
-    }
-
     /*------------------------------------------------------------------*/
-    /* Read the liberty format file.  This is not a rigorous parser!	*/
+    /* Read the liberty format files.  This is not a rigorous parser!	*/
+    /* Each file is one corner.  The netlist is read against the first.	*/
     /*------------------------------------------------------------------*/
 
-    fileCurrentLine = 0;
-    libertyRead(flib, &tables, &cells);
-    fflush(stdout);
-    fprintf(stdout, "Lib Read:  Processed %d lines.\n", fileCurrentLine);
-    if (flib != NULL) fclose(flib);
+    lastcorner = &cornerlist;
+    for (numcorners = 0; numcorners < objc - firstarg - 1; numcorners++) {
+	flib = fopen(argv[firstarg + 1 + numcorners], "r");
+	if (flib == NULL) {
+	    fprintf(stderr, "Cannot open %s for reading\n",
+			argv[firstarg + 1 + numcorners]);
+	    exit (1);
+	}
+
+	newcorner = (cornerptr)malloc(sizeof(corner));
+	newcorner->libfile = argv[firstarg + 1 + numcorners];
+	newcorner->tables = NULL;
+	newcorner->cells = NULL;
+	newcorner->conns = NULL;
+	newcorner->next = NULL;
+	*lastcorner = newcorner;
+	lastcorner = &newcorner->next;
+
+	fileCurrentLine = 0;
+	libertyRead(flib, &newcorner->tables, &newcorner->cells);
+	fflush(stdout);
+	fprintf(stdout, "Lib Read:  Processed %d lines.\n", fileCurrentLine);
+	if (flib != NULL) fclose(flib);
+    }
+    tables = cornerlist->tables;
+    cells = cornerlist->cells;
+
+    // Modes without a transition time use "-t".  Without "-m", the
+    // one mode is set by "-p" and "-t".
+
+    for (newmode = modelist; newmode; newmode = newmode->next)
+	if (newmode->inTrans < 0.0) newmode->inTrans = inTrans;
+
+    if (modelist == NULL) {
+	modelist = (modeptr)malloc(sizeof(mode));
+	modelist->period = period;
+	modelist->inTrans = inTrans;
+	modelist->index = ++nummodes;
+	modelist->next = NULL;
+    }
+
+    // Only graph mode can analyze more than one scenario
+
+    if ((numcorners > 1 || nummodes > 1) && !graphmode) {
+	fprintf(stdout, "Multiple corners or modes:  Using graph-based analysis.\n");
+	graphmode = 1;
+    }
 
     /*--------------------------------------------------*/
     /* Debug:  Print summary of liberty database	*/
@@ -3097,11 +4474,23 @@ main(int objc, char *argv[])
     /*------------------------------------------------------------------*/
 
     fileCurrentLine = 0;
+    loadstart = clock();
     verilogRead(fsrc, cells, &netlist, &instlist, &inputlist, &outputlist);
     fflush(stdout);
     fprintf(stdout, "Verilog netlist read:  Processed %d lines.\n", fileCurrentLine);
     if (fsrc != NULL) fclose(fsrc);
 
+    if (verbose > 0) {
+	instptr testinst;
+	netptr testnet;
+	int numinst = 0, numnets = 0;
+
+	for (testinst = instlist; testinst; testinst = testinst->next) numinst++;
+	for (testnet = netlist; testnet; testnet = testnet->next) numnets++;
+	fprintf(stdout, "Netlist load:  %d instances, %d nets in %g seconds.\n",
+		numinst, numnets, (double)(clock() - loadstart) / CLOCKS_PER_SEC);
+    }
+
     /*--------------------------------------------------*/
     /* Debug:  Print summary of verilog source		*/
     /*--------------------------------------------------*/
@@ -3160,6 +4549,16 @@ main(int objc, char *argv[])
     if (verbose > 1) 
 	fprintf(stdout, "Number of terminals to check: %d\n", numterms);
 
+    /*--------------------------------------------------*/
+    /* Graph-based analysis replaces the path search	*/
+    /*--------------------------------------------------*/
+
+    if (graphmode) {
+	graph_analysis(netlist, instlist, inputlist, cornerlist, modelist,
+		outLoad, numreport, slackfile);
+	return 0;
+    }
+
     /*--------------------------------------------------*/
     /* Identify all clock-to-terminal paths		*/
     /*--------------------------------------------------*/
@@ -3183,12 +4582,12 @@ main(int objc, char *argv[])
     qsort(orderedpaths, numpaths, sizeof(ddataptr), (__compar_fn_t)compdelay);
 
     /*--------------------------------------------------*/
-    /* Report on top 20 maximum delay paths		*/
+    /* Report on top maximum delay paths		*/
     /*--------------------------------------------------*/
 
-    fprintf(stdout, "\nTop %d maximum delay paths:\n", (numpaths >= 20) ? 20 : numpaths);
+    fprintf(stdout, "\nTop %d maximum delay paths:\n", (numpaths >= numreport) ? numreport : numpaths);
     badtiming = 0;
-    for (i = 0; ((i < 20) && (i < numpaths)); i++) {
+    for (i = 0; ((i < numreport) && (i < numpaths)); i++) {
 	testddata = orderedpaths[i];
 	for (testbt = testddata->backtrace; testbt->next; testbt = testbt->next);
 		
@@ -3272,12 +4671,12 @@ main(int objc, char *argv[])
     qsort(orderedpaths, numpaths, sizeof(ddataptr), (__compar_fn_t)compdelay);
 
     /*--------------------------------------------------*/
-    /* Report on top 20 minimum delay paths		*/
+    /* Report on top minimum delay paths		*/
     /*--------------------------------------------------*/
 
-    fprintf(stdout, "\nTop %d minimum delay paths:\n", (numpaths >= 20) ? 20 : numpaths);
+    fprintf(stdout, "\nTop %d minimum delay paths:\n", (numpaths >= numreport) ? numreport : numpaths);
     badtiming = 0;
-    for (i = numpaths; (i > (numpaths - 20)) && (i > 0); i--) {
+    for (i = numpaths; (i > (numpaths - numreport)) && (i > 0); i--) {
 	testddata = orderedpaths[i - 1];
 	for (testbt = testddata->backtrace; testbt->next; testbt = testbt->next);
 		
@@ -3353,11 +4752,11 @@ main(int objc, char *argv[])
     qsort(orderedpaths, numpaths, sizeof(ddataptr), (__compar_fn_t)compdelay);
 
     /*--------------------------------------------------*/
-    /* Report on top 20 maximum delay paths		*/
+    /* Report on top maximum delay paths		*/
     /*--------------------------------------------------*/
 
-    fprintf(stdout, "\nTop %d maximum delay paths:\n", (numpaths >= 20) ? 20 : numpaths);
-    for (i = 0; ((i < 20) && (i < numpaths)); i++) {
+    fprintf(stdout, "\nTop %d maximum delay paths:\n", (numpaths >= numreport) ? numreport : numpaths);
+    for (i = 0; ((i < numreport) && (i < numpaths)); i++) {
 	testddata = orderedpaths[i];
 	for (testbt = testddata->backtrace; testbt->next; testbt = testbt->next);
 		
@@ -3425,11 +4824,11 @@ main(int objc, char *argv[])
     qsort(orderedpaths, numpaths, sizeof(ddataptr), (__compar_fn_t)compdelay);
 
     /*--------------------------------------------------*/
-    /* Report on top 20 minimum delay paths		*/
+    /* Report on top minimum delay paths		*/
     /*--------------------------------------------------*/
 
-    fprintf(stdout, "\nTop %d minimum delay paths:\n", (numpaths >= 20) ? 20 : numpaths);
-    for (i = numpaths; (i > (numpaths - 20)) && (i > 0); i--) {
+    fprintf(stdout, "\nTop %d minimum delay paths:\n", (numpaths >= numreport) ? numreport : numpaths);
+    for (i = numpaths; (i > (numpaths - numreport)) && (i > 0); i--) {
 	testddata = orderedpaths[i - 1];
 	for (testbt = testddata->backtrace; testbt->next; testbt = testbt->next);
 		
@@ -0,0 +1,129 @@
+#!/bin/sh
+#
+# check_timing.sh --- run blifFanout in timing-driven mode (-L) on the
+# netlist of the vesta tests, and check the result.
+#
+# The netlist is run once with a target period, and once without one.
+# For each run, the worst slack that blifFanout reports after its
+# changes must not be below the one it reports before.  The input and
+# output netlists are then timed by vesta (graph mode), and vesta must
+# not find the output worse either.  The two tools do not give the same
+# numbers:  blifFanout adds an estimate for the wire to the load of each
+# net, and vesta has no wire load.  Last, the output must be the input
+# netlist with only gate sizes changed and buffers added:  with the
+# buffers taken out and all cells at size X1, the gates must be the
+# same.
+#
+# Usage:  check_timing.sh [<bindir>]
+#
+
+BIN=${1:-../../src}
+DIR=`dirname $0`
+LIB=$DIR/../vesta/clocktree.lib
+PERIOD=1000
+TOL=0.001	# ps
+
+# Write the verilog netlist of the vesta tests as BLIF
+awk '
+    /^module/ { print ".model top"; next; }
+    /^input/ {
+	gsub(/;/, "");
+	for (i = 1; i < NF; i += 2)
+	    if ($i == "input") ins = ins " " $(i + 1);
+	    else outs = outs " " $(i + 1);
+	print ".inputs" ins;
+	print ".outputs" outs;
+	next;
+    }
+    /^endmodule/ { print ".end"; next; }
+    {
+	line = ".gate " $1;
+	for (i = 4; i <= NF; i++)
+	    if ($i ~ /^\./) {
+		split($i, a, /[.()]/);
+		line = line " " a[2] "=" a[3];
+	    }
+	print line;
+    }
+' $DIR/../vesta/clocknet.v > fanout_in.blif
+
+$BIN/blif2Verilog -p fanout_in.blif > fanout_in.v || exit 1
+$BIN/vesta -g -p $PERIOD fanout_in.v $LIB > fanout_in.out || exit 1
+
+bad=0
+for target in "-t $PERIOD" ""; do
+    $BIN/blifFanout -L $LIB -b BUFX2 -i A -o Y $target \
+	fanout_in.blif fanout_out.blif 2> fanout.log
+    label="blifFanout ${target:-without period}"
+    $BIN/blif2Verilog -p fanout_out.blif > fanout_out.v || exit 1
+    $BIN/vesta -g -p $PERIOD fanout_out.v $LIB > fanout_out.out || exit 1
+
+    awk -v tol=$TOL -v label="$label" '
+	# blifFanout reports the slack, or the path delay without a period
+	FILENAME ~ /fanout.log$/ {
+	    if (/worst slack/) {
+		s = $0; sub(/.*worst slack /, "", s); slack[n++] = s + 0;
+	    }
+	    else if (/ritical path delay/) {
+		s = $0; sub(/.*ritical path delay /, "", s); slack[n++] = -s;
+	    }
+	    next;
+	}
+	# The first maximum delay path in vesta output is the worst
+	/maximum delay paths/ { getline; vslack[FILENAME] = $NF == "ps" ? $(NF - 1) : $NF; }
+	END {
+	    bad = 0;
+	    if (n != 2) {
+		print "FAIL: blifFanout did not report the slack";
+		exit 1;
+	    }
+	    if (slack[1] < slack[0] - tol) {
+		printf("FAIL %s: worst slack %g ps before, %g ps after\n",
+			label, slack[0], slack[1]);
+		bad++;
+	    }
+	    if (vslack["fanout_out.out"] < vslack["fanout_in.out"] - tol) {
+		printf("FAIL %s: vesta worst slack %g ps before, %g ps after\n",
+			label, vslack["fanout_in.out"], vslack["fanout_out.out"]);
+		bad++;
+	    }
+	    printf("%s: worst slack %g -> %g ps, vesta %g -> %g ps\n",
+		label, slack[0], slack[1], vslack["fanout_in.out"],
+		vslack["fanout_out.out"]);
+	    exit (bad > 0);
+	}
+    ' fanout.log fanout_in.out fanout_out.out || bad=1
+
+    # Take out the buffers and the sizes, and compare the gates
+    for f in fanout_in fanout_out; do
+	awk '
+	    $1 == ".gate" && $2 ~ /^BUFX/ {
+		split($3, a, "="); split($4, y, "=");
+		buf[y[2]] = a[2];
+		next;
+	    }
+	    $1 == ".gate" {
+		sub(/X[0-9]+$/, "X1", $2);
+		gate[ngates++] = $0;
+	    }
+	    END {
+		for (i = 0; i < ngates; i++) {
+		    n = split(gate[i], p, " ");
+		    line = p[1] " " p[2];
+		    for (j = 3; j <= n; j++) {
+			split(p[j], a, "=");
+			net = a[2];
+			while (net in buf) net = buf[net];
+			line = line " " a[1] "=" net;
+		    }
+		    print line;
+		}
+	    }
+	' $f.blif | sort > $f.gates
+    done
+    if ! cmp -s fanout_in.gates fanout_out.gates; then
+	echo "FAIL $label: gates other than sizes and buffers changed"
+	bad=1
+    fi
+done
+exit $bad
@@ -0,0 +1,112 @@
+#!/bin/sh
+#
+# bench_lookup.sh --- time the name lookups of vesta and blifFanout on
+# generated netlists of growing size, for two builds of the tools.
+#
+# Both tools look up every cell, net, and gate name of the netlist as
+# they read it.  With a linear search of the lists this grows with the
+# square of the netlist size;  with the hash tables it grows linearly.
+# The rest of each run (graph-mode timing in vesta, fanout buffering in
+# blifFanout) is linear in either build, so the difference between the
+# two builds at each size is the time spent in lookups.
+#
+# Usage:  bench_lookup.sh <before_dir> <after_dir> [<size> ...]
+#
+# where each directory holds a "vesta" and a "blifFanout" executable.
+#
+
+if [ $# -lt 2 ]; then
+    echo "Usage:  bench_lookup.sh <before_dir> <after_dir> [<size> ...]"
+    exit 1
+fi
+
+BEFORE=$1
+AFTER=$2
+shift 2
+SIZES=${*:-"5000 10000 20000 40000"}
+
+DIR=`dirname $0`
+LIB=$DIR/../vesta/clocktree.lib
+GATECFG=$DIR/../../tech/osu035/gate.cfg
+
+# Run a command and print its run time in seconds
+runtime() {
+    start=`date +%s.%N`
+    "$@" > /dev/null 2>&1
+    end=`date +%s.%N`
+    echo "$start $end" | awk '{printf("%8.2f", $2 - $1)}'
+}
+
+# Random logic of "n" gates with n/16 flops, as verilog for vesta
+genverilog() {
+    awk -v n=$1 'BEGIN {
+	srand(1);
+	nff = int(n / 16);
+	printf("module top (clk, in0, in1, out0);\n");
+	printf("input clk; input in0; input in1; output out0;\n");
+	for (i = 0; i < nff; i++) node[i] = "q" i;
+	node[nff] = "in0"; node[nff + 1] = "in1";
+	nn = nff + 2;
+	for (i = 0; i < n; i++) {
+	    a = node[nn - 1 - int(rand() * (nn < 200 ? nn : 200))];
+	    b = node[int(rand() * nn)];
+	    if (rand() < 0.3)
+		printf("INVX1 g%d ( .A(%s), .Y(n%d) );\n", i, a, i);
+	    else
+		printf("NAND2X1 g%d ( .A(%s), .B(%s), .Y(n%d) );\n", i, a, b, i);
+	    node[nn++] = "n" i;
+	}
+	for (i = 0; i < nff; i++)
+	    printf("DFFPOSX1 f%d ( .CLK(clk), .D(n%d), .Q(q%d) );\n",
+			i, n - 1 - i, i);
+	printf("INVX1 ob ( .A(n%d), .Y(out0) );\n", n - 1);
+	printf("endmodule\n");
+    }'
+}
+
+# The same kind of logic as BLIF for blifFanout
+genblif() {
+    awk -v n=$1 'BEGIN {
+	srand(1);
+	printf(".model top\n.inputs in0 in1\n.outputs out0\n");
+	node[0] = "in0"; node[1] = "in1";
+	nn = 2;
+	for (i = 0; i < n; i++) {
+	    a = node[nn - 1 - int(rand() * (nn < 200 ? nn : 200))];
+	    b = node[int(rand() * nn)];
+	    if (rand() < 0.3)
+		printf(".gate INVX1 A=%s Y=n%d\n", a, i);
+	    else
+		printf(".gate NAND2X1 A=%s B=%s Y=n%d\n", a, b, i);
+	    node[nn++] = "n" i;
+	}
+	printf(".gate INVX1 A=n%d Y=out0\n.end\n", n - 1);
+    }'
+}
+
+TMP=${TMPDIR:-/tmp}/bench_lookup.$$
+mkdir -p $TMP || exit 1
+
+echo "                      vesta -g              blifFanout"
+echo "   gates        before     after      before     after   (seconds)"
+for n in $SIZES; do
+    genverilog $n > $TMP/bench.v
+    genblif $n > $TMP/bench.blif
+    printf "%8d    " $n
+    runtime $BEFORE/vesta -g $TMP/bench.v $LIB
+    printf "  "
+    runtime $AFTER/vesta -g $TMP/bench.v $LIB
+    printf "    "
+    runtime $BEFORE/blifFanout -p $GATECFG -b BUFX2 -i A -o Y \
+		$TMP/bench.blif $TMP/before.blif
+    printf "  "
+    runtime $AFTER/blifFanout -p $GATECFG -b BUFX2 -i A -o Y \
+		$TMP/bench.blif $TMP/after.blif
+    if cmp -s $TMP/before.blif $TMP/after.blif; then
+	echo
+    else
+	echo "   (outputs differ)"
+    fi
+done
+
+rm -rf $TMP
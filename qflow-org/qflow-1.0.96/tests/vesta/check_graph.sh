@@ -0,0 +1,59 @@
+#!/bin/sh
+#
+# check_graph.sh --- compare vesta graph mode (-g) against exhaustive
+# path mode (-e) on a design with a buffered clock tree.
+#
+# Flops f0, f2, ... are clocked from one inverter of the clock tree, and
+# flops f1, f3, ... from the inverter after it.  For every path that
+# starts and ends on the same clock net the clock skew is zero, and the
+# two modes must report the same setup delay, apart from the clock
+# transition time:  path mode takes the clock at the flop as ideal,
+# while graph mode propagates its slew through the clock tree, which
+# can only make clock-to-Q slower.  Graph mode may therefore be up to
+# TOL percent slower than path mode, but never faster.
+#
+# Usage:  check_graph.sh [<vesta>]
+#
+
+VESTA=${1:-../../src/vesta}
+DIR=`dirname $0`
+TOL=5.0		# percent
+
+$VESTA -e -n 10000 -p 3000 $DIR/clocktree.v $DIR/clocktree.lib > path.out || exit 1
+$VESTA -g -n 10000 -p 3000 $DIR/clocktree.v $DIR/clocktree.lib > graph.out || exit 1
+
+awk -v tol=$TOL '
+    # Clock net of each flop, from the netlist
+    FILENAME ~ /clocktree.v$/ && /^DFF/ {
+	split($0, a, /[()]/);
+	clk[$2] = a[3];
+	next;
+    }
+    # Setup delays are reported first, before the minimum delay paths
+    /maximum delay paths/ { keep = 1; next; }
+    /minimum delay paths/ { keep = 0; next; }
+    keep && /^Path .*\/CLK to .*\/D delay/ {
+	split($2, s, "/"); split($4, d, "/");
+	if (clk[s[1]] != clk[d[1]]) next;
+	key = s[1] " " d[1];
+	if (FILENAME ~ /path.out$/) pathdelay[key] = $6;
+	else graphdelay[key] = $6;
+    }
+    END {
+	n = 0; bad = 0;
+	for (key in pathdelay) {
+	    if (!(key in graphdelay)) continue;
+	    n++;
+	    diff = graphdelay[key] - pathdelay[key];
+	    if ((diff < -0.001) || (diff > pathdelay[key] * tol / 100.0)) {
+		printf("FAIL %s: path mode %g ps, graph mode %g ps\n",
+			key, pathdelay[key], graphdelay[key]);
+		bad++;
+	    }
+	}
+	if (n == 0) { print "FAIL: no paths compared"; exit 1; }
+	printf("%d same-clock paths compared, %d outside 0 to +%g%%\n",
+		n, bad, tol);
+	exit (bad > 0);
+    }
+' $DIR/clocktree.v path.out graph.out
@@ -0,0 +1,76 @@
+#!/bin/sh
+#
+# check_slacks.sh --- compare the net slacks that vesta writes with
+# --slack (for timing-driven placement) against the worst slack of the
+# paths through each net found by exhaustive path mode (-e).
+#
+# Path mode reports only the worst path between each pair of path
+# start and end, so it gives the exact worst slack of the nets at the
+# start (flop outputs) and end (flop inputs) of each path, and an upper
+# bound for the nets in between.  The check is that the slack file is
+# never optimistic, and that at the path starts and ends it matches.
+#
+# All flops of the design sit on one buffered clock net, so the clock
+# latency cancels on every register-to-register path.  The slacks still
+# differ by the clock transition time:  path mode takes the clock at the
+# flop as ideal, while graph mode propagates its slew into clock-to-Q.
+# Graph-mode slack may be lower by up to TOL percent of the period, but
+# never higher.  Path mode gives no slack for paths from module inputs,
+# so nets that are only on those paths are not compared.
+#
+# Usage:  check_slacks.sh [<vesta>]
+#
+
+VESTA=${1:-../../src/vesta}
+DIR=`dirname $0`
+PERIOD=3000
+TOL=1.0		# percent of the period
+
+$VESTA -e -v 1 -n 10000 -p $PERIOD $DIR/clocknet.v $DIR/clocktree.lib \
+	> path.out || exit 1
+$VESTA -s clocknet.slk -p $PERIOD $DIR/clocknet.v $DIR/clocktree.lib \
+	> graph.out || exit 1
+
+awk -v tol=$TOL -v period=$PERIOD '
+    # Each traced path lists the nets on it, from the path end back to
+    # the clock pin of the flop at the path start.
+    FILENAME ~ /path.out$/ {
+	if (/^Path terminated on flop .* with max delay/) {
+	    slack = period - $(NF - 1);
+	    n = 0;
+	    inpath = 1;
+	    next;
+	}
+	if (inpath && /^ +[-0-9.e+]+ \(.*\) /) {
+	    net[n] = $2;
+	    gsub(/[()]/, "", net[n]);
+	    if ($3 !~ /\/CLK$/) { n++; next; }
+	    # Path start is a flop clock:  keep the nets up to its output
+	    for (i = 0; i < n; i++)
+		if (!(net[i] in pathslack) || (slack < pathslack[net[i]]))
+		    pathslack[net[i]] = slack;
+	    if (n > 0) { exact[net[0]] = 1; exact[net[n - 1]] = 1; }
+	}
+	inpath = 0;
+	next;
+    }
+    # Slack file:  "period <ps>", then "<net> <slack>"
+    /^#/ || /^period / { next; }
+    !($1 in pathslack) { next; }
+    {
+	nslk++;
+	diff = pathslack[$1] - $2;
+	if ((diff < -0.001) || (($1 in exact) && (diff > period * tol / 100.0))) {
+	    printf("FAIL %s: path mode %g ps, slack file %g ps\n",
+			$1, pathslack[$1], $2);
+	    bad++;
+	}
+	if ($1 in exact) nexact++;
+    }
+    END {
+	if (nexact == 0) { print "FAIL: no net slacks compared"; exit 1; }
+	printf("%d net slacks compared (%d path starts and ends), %d failed\n",
+		nslk, nexact, bad);
+	exit (bad > 0);
+    }
+' path.out clocknet.slk
@@ -0,0 +1,182 @@
+module top (clk, in0, in1, out0);
+input clk; input in0; input in1; output out0;
+INVX1 g1 ( .A(q7), .Y(n0) );
+NAND2X1 g2 ( .A(q15), .B(q2), .Y(n1) );
+NAND2X1 g3 ( .A(q15), .B(q8), .Y(n2) );
+NAND2X1 g4 ( .A(q6), .B(q15), .Y(n3) );
+NAND2X1 g5 ( .A(in1), .B(q15), .Y(n4) );
+NAND2X1 g6 ( .A(q4), .B(q7), .Y(n5) );
+NAND2X1 g7 ( .A(in0), .B(q12), .Y(n6) );
+NAND2X1 g8 ( .A(q2), .B(q5), .Y(n7) );
+NAND2X1 g9 ( .A(q1), .B(q9), .Y(n8) );
+NAND2X1 g10 ( .A(q8), .B(q15), .Y(n9) );
+NAND2X1 g11 ( .A(q12), .B(q13), .Y(n10) );
+NAND2X1 g12 ( .A(q14), .B(q4), .Y(n11) );
+INVX1 g13 ( .A(q3), .Y(n12) );
+NAND2X1 g14 ( .A(q6), .B(q8), .Y(n13) );
+NAND2X1 g15 ( .A(q13), .B(q9), .Y(n14) );
+NAND2X1 g16 ( .A(q12), .B(q11), .Y(n15) );
+NAND2X1 g17 ( .A(n8), .B(q14), .Y(n16) );
+NAND2X1 g18 ( .A(q1), .B(in1), .Y(n17) );
+NAND2X1 g19 ( .A(q10), .B(n2), .Y(n18) );
+NAND2X1 g20 ( .A(q6), .B(q13), .Y(n19) );
+INVX1 g21 ( .A(in1), .Y(n20) );
+INVX1 g22 ( .A(n12), .Y(n21) );
+NAND2X1 g23 ( .A(q4), .B(n8), .Y(n22) );
+NAND2X1 g24 ( .A(q1), .B(n0), .Y(n23) );
+INVX1 g25 ( .A(n8), .Y(n24) );
+NAND2X1 g26 ( .A(q2), .B(n6), .Y(n25) );
+NAND2X1 g27 ( .A(n3), .B(in1), .Y(n26) );
+INVX1 g28 ( .A(q2), .Y(n27) );
+NAND2X1 g29 ( .A(q6), .B(q2), .Y(n28) );
+NAND2X1 g30 ( .A(n8), .B(n0), .Y(n29) );
+NAND2X1 g31 ( .A(q9), .B(q2), .Y(n30) );
+NAND2X1 g32 ( .A(n3), .B(n2), .Y(n31) );
+NAND2X1 g33 ( .A(q10), .B(n6), .Y(n32) );
+NAND2X1 g34 ( .A(n17), .B(n6), .Y(n33) );
+NAND2X1 g35 ( .A(n22), .B(n25), .Y(n34) );
+INVX1 g36 ( .A(n23), .Y(n35) );
+NAND2X1 g37 ( .A(n24), .B(n28), .Y(n36) );
+NAND2X1 g38 ( .A(n3), .B(n9), .Y(n37) );
+NAND2X1 g39 ( .A(n17), .B(n1), .Y(n38) );
+NAND2X1 g40 ( .A(q2), .B(n8), .Y(n39) );
+NAND2X1 g41 ( .A(n4), .B(q1), .Y(n40) );
+INVX1 g42 ( .A(n21), .Y(n41) );
+NAND2X1 g43 ( .A(n24), .B(n22), .Y(n42) );
+NAND2X1 g44 ( .A(n6), .B(n25), .Y(n43) );
+INVX1 g45 ( .A(n22), .Y(n44) );
+NAND2X1 g46 ( .A(n15), .B(q1), .Y(n45) );
+NAND2X1 g47 ( .A(n27), .B(q1), .Y(n46) );
+NAND2X1 g48 ( .A(n0), .B(n22), .Y(n47) );
+INVX1 g49 ( .A(n37), .Y(n48) );
+NAND2X1 g50 ( .A(n11), .B(n22), .Y(n49) );
+NAND2X1 g51 ( .A(n38), .B(n15), .Y(n50) );
+NAND2X1 g52 ( .A(n24), .B(q13), .Y(n51) );
+NAND2X1 g53 ( .A(n1), .B(in0), .Y(n52) );
+INVX1 g54 ( .A(n14), .Y(n53) );
+NAND2X1 g55 ( .A(n11), .B(n37), .Y(n54) );
+NAND2X1 g56 ( .A(n6), .B(q13), .Y(n55) );
+NAND2X1 g57 ( .A(n21), .B(n10), .Y(n56) );
+NAND2X1 g58 ( .A(n10), .B(q10), .Y(n57) );
+NAND2X1 g59 ( .A(n41), .B(n9), .Y(n58) );
+INVX1 g60 ( .A(n28), .Y(n59) );
+NAND2X1 g61 ( .A(n7), .B(q4), .Y(n60) );
+NAND2X1 g62 ( .A(n12), .B(n22), .Y(n61) );
+NAND2X1 g63 ( .A(n36), .B(n5), .Y(n62) );
+NAND2X1 g64 ( .A(n21), .B(q10), .Y(n63) );
+INVX1 g65 ( .A(n38), .Y(n64) );
+NAND2X1 g66 ( .A(n34), .B(n48), .Y(n65) );
+NAND2X1 g67 ( .A(n33), .B(n41), .Y(n66) );
+NAND2X1 g68 ( .A(n42), .B(n19), .Y(n67) );
+NAND2X1 g69 ( .A(n42), .B(q4), .Y(n68) );
+INVX1 g70 ( .A(n25), .Y(n69) );
+NAND2X1 g71 ( .A(n55), .B(n47), .Y(n70) );
+INVX1 g72 ( .A(n61), .Y(n71) );
+NAND2X1 g73 ( .A(n45), .B(n48), .Y(n72) );
+NAND2X1 g74 ( .A(n50), .B(n25), .Y(n73) );
+NAND2X1 g75 ( .A(n20), .B(n57), .Y(n74) );
+INVX1 g76 ( .A(n23), .Y(n75) );
+NAND2X1 g77 ( .A(n60), .B(n47), .Y(n76) );
+INVX1 g78 ( .A(n43), .Y(n77) );
+INVX1 g79 ( .A(n46), .Y(n78) );
+NAND2X1 g80 ( .A(n35), .B(n12), .Y(n79) );
+NAND2X1 g81 ( .A(n65), .B(n50), .Y(n80) );
+NAND2X1 g82 ( .A(n71), .B(q14), .Y(n81) );
+NAND2X1 g83 ( .A(n48), .B(n51), .Y(n82) );
+INVX1 g84 ( .A(n35), .Y(n83) );
+NAND2X1 g85 ( .A(n39), .B(n50), .Y(n84) );
+INVX1 g86 ( .A(n39), .Y(n85) );
+NAND2X1 g87 ( .A(n49), .B(in0), .Y(n86) );
+NAND2X1 g88 ( .A(n32), .B(n44), .Y(n87) );
+NAND2X1 g89 ( .A(n57), .B(q6), .Y(n88) );
+NAND2X1 g90 ( .A(n47), .B(n16), .Y(n89) );
+INVX1 g91 ( .A(n65), .Y(n90) );
+NAND2X1 g92 ( .A(n52), .B(q0), .Y(n91) );
+INVX1 g93 ( .A(n40), .Y(n92) );
+NAND2X1 g94 ( .A(n36), .B(n43), .Y(n93) );
+NAND2X1 g95 ( .A(n77), .B(q11), .Y(n94) );
+INVX1 g96 ( .A(n63), .Y(n95) );
+NAND2X1 g97 ( .A(n52), .B(n26), .Y(n96) );
+NAND2X1 g98 ( .A(n72), .B(n57), .Y(n97) );
+NAND2X1 g99 ( .A(n64), .B(n6), .Y(n98) );
+INVX1 g100 ( .A(n75), .Y(n99) );
+NAND2X1 g101 ( .A(n48), .B(n73), .Y(n100) );
+INVX1 g102 ( .A(n53), .Y(n101) );
+NAND2X1 g103 ( .A(n71), .B(n40), .Y(n102) );
+NAND2X1 g104 ( .A(n82), .B(n30), .Y(n103) );
+NAND2X1 g105 ( .A(n50), .B(n61), .Y(n104) );
+NAND2X1 g106 ( .A(n51), .B(n29), .Y(n105) );
+NAND2X1 g107 ( .A(n92), .B(n22), .Y(n106) );
+NAND2X1 g108 ( .A(n92), .B(n35), .Y(n107) );
+NAND2X1 g109 ( .A(n63), .B(n9), .Y(n108) );
+INVX1 g110 ( .A(n92), .Y(n109) );
+NAND2X1 g111 ( .A(n75), .B(n10), .Y(n110) );
+NAND2X1 g112 ( .A(n49), .B(n23), .Y(n111) );
+INVX1 g113 ( .A(n99), .Y(n112) );
+NAND2X1 g114 ( .A(n108), .B(n13), .Y(n113) );
+NAND2X1 g115 ( .A(n110), .B(n78), .Y(n114) );
+NAND2X1 g116 ( .A(n110), .B(n63), .Y(n115) );
+NAND2X1 g117 ( .A(n70), .B(q1), .Y(n116) );
+INVX1 g118 ( .A(n79), .Y(n117) );
+NAND2X1 g119 ( .A(n69), .B(n7), .Y(n118) );
+NAND2X1 g120 ( .A(n88), .B(n27), .Y(n119) );
+INVX1 g121 ( .A(n85), .Y(n120) );
+NAND2X1 g122 ( .A(n71), .B(n105), .Y(n121) );
+NAND2X1 g123 ( .A(n82), .B(n58), .Y(n122) );
+INVX1 g124 ( .A(n66), .Y(n123) );
+NAND2X1 g125 ( .A(n111), .B(n7), .Y(n124) );
+NAND2X1 g126 ( .A(n67), .B(n65), .Y(n125) );
+INVX1 g127 ( .A(n75), .Y(n126) );
+NAND2X1 g128 ( .A(n75), .B(n45), .Y(n127) );
+INVX1 g129 ( .A(n124), .Y(n128) );
+NAND2X1 g130 ( .A(n118), .B(n83), .Y(n129) );
+NAND2X1 g131 ( .A(n115), .B(n89), .Y(n130) );
+INVX1 g132 ( .A(n104), .Y(n131) );
+NAND2X1 g133 ( .A(n106), .B(n23), .Y(n132) );
+NAND2X1 g134 ( .A(n116), .B(n114), .Y(n133) );
+NAND2X1 g135 ( .A(n89), .B(n84), .Y(n134) );
+INVX1 g136 ( .A(n89), .Y(n135) );
+NAND2X1 g137 ( .A(n127), .B(n105), .Y(n136) );
+NAND2X1 g138 ( .A(n113), .B(n95), .Y(n137) );
+INVX1 g139 ( .A(n91), .Y(n138) );
+NAND2X1 g140 ( .A(n92), .B(n19), .Y(n139) );
+NAND2X1 g141 ( .A(n100), .B(n41), .Y(n140) );
+NAND2X1 g142 ( .A(n114), .B(n57), .Y(n141) );
+NAND2X1 g143 ( .A(n106), .B(n50), .Y(n142) );
+INVX1 g144 ( .A(n99), .Y(n143) );
+INVX1 g145 ( .A(n120), .Y(n144) );
+NAND2X1 g146 ( .A(n119), .B(n43), .Y(n145) );
+NAND2X1 g147 ( .A(n105), .B(n89), .Y(n146) );
+INVX1 g148 ( .A(n126), .Y(n147) );
+INVX1 g149 ( .A(n133), .Y(n148) );
+NAND2X1 g150 ( .A(n142), .B(n0), .Y(n149) );
+NAND2X1 g151 ( .A(n121), .B(q11), .Y(n150) );
+NAND2X1 g152 ( .A(n110), .B(n42), .Y(n151) );
+NAND2X1 g153 ( .A(n139), .B(in1), .Y(n152) );
+NAND2X1 g154 ( .A(n112), .B(n43), .Y(n153) );
+INVX1 g155 ( .A(n112), .Y(n154) );
+NAND2X1 g156 ( .A(n141), .B(q9), .Y(n155) );
+NAND2X1 g157 ( .A(n112), .B(n25), .Y(n156) );
+NAND2X1 g158 ( .A(n116), .B(n28), .Y(n157) );
+INVX1 g159 ( .A(n142), .Y(n158) );
+INVX1 g160 ( .A(n112), .Y(n159) );
+INVX1 cb ( .A(clk), .Y(clkb) );
+INVX1 cb2 ( .A(clkb), .Y(clkbb) );
+DFFPOSX1 f0 ( .CLK(clkb), .D(n159), .Q(q0) );
+DFFPOSX1 f1 ( .CLK(clkbb), .D(n158), .Q(q1) );
+DFFPOSX1 f2 ( .CLK(clkb), .D(n157), .Q(q2) );
+DFFPOSX1 f3 ( .CLK(clkbb), .D(n156), .Q(q3) );
+DFFPOSX1 f4 ( .CLK(clkb), .D(n155), .Q(q4) );
+DFFPOSX1 f5 ( .CLK(clkbb), .D(n154), .Q(q5) );
+DFFPOSX1 f6 ( .CLK(clkb), .D(n153), .Q(q6) );
+DFFPOSX1 f7 ( .CLK(clkbb), .D(n152), .Q(q7) );
+DFFPOSX1 f8 ( .CLK(clkb), .D(n151), .Q(q8) );
+DFFPOSX1 f9 ( .CLK(clkbb), .D(n150), .Q(q9) );
+DFFPOSX1 f10 ( .CLK(clkb), .D(n149), .Q(q10) );
+DFFPOSX1 f11 ( .CLK(clkbb), .D(n148), .Q(q11) );
+DFFPOSX1 f12 ( .CLK(clkb), .D(n147), .Q(q12) );
+DFFPOSX1 f13 ( .CLK(clkbb), .D(n146), .Q(q13) );
+DFFPOSX1 f14 ( .CLK(clkb), .D(n145), .Q(q14) );
+DFFPOSX1 f15 ( .CLK(clkbb), .D(n144), .Q(q15) );
+INVX1 ob ( .A(n159), .Y(out0) );
+endmodule
@@ -61,6 +61,26 @@ DefHashInstance(GATE gateginfo)
 
 #endif	/* TCL_QROUTER */
 
+/*
+ *------------------------------------------------------------
+ *
+ * DefOffGrid --
+ *
+ *	Return TRUE if position "v" (in microns) does not fall
+ *	on a route track with origin "lower" and spacing
+ *	"pitch".
+ *
+ *------------------------------------------------------------
+ */
+
+static char
+DefOffGrid(double v, double lower, double pitch)
+{
+    double g = (v - lower) / pitch;
+
+    return (fabs(g - floor(g + 0.5)) > EPS) ? TRUE : FALSE;
+}
+
 /*
  *------------------------------------------------------------
  *
@@ -86,10 +106,13 @@ DefAddRoutes(FILE *f, float oscale, NET net, char special)
 {
     char *token;
     SEG newRoute = NULL;
+    SEG lastRoute = NULL;
     DSEG lr, drect;
     struct point_ refp;
     char valid = FALSE;		/* is there a valid reference point? */
     char initial = TRUE;
+    char offgrid = FALSE;	/* is the reference point off-grid? */
+    char lastoff;
     struct dseg_ locarea;
     double x, y, lx, ly, w;
     int routeLayer, paintLayer;
@@ -112,6 +135,7 @@ DefAddRoutes(FILE *f, float oscale, NET net, char special)
 
 	    /* invalidate reference point */
 	    valid = FALSE;
+	    offgrid = FALSE;
 
 	    token = LefNextToken(f, TRUE);
 	    routeLayer = LefFindLayerNum(token);
@@ -173,11 +197,20 @@ DefAddRoutes(FILE *f, float oscale, NET net, char special)
 		    if (lefl->lefClass == CLASS_VIA) {
 			paintLayer = Num_layers - 1;
 			routeLayer = -1;
+
+			/* The first metal layer is in info.via.area, and the	*/
+			/* cut layer (type -1) does not count.			*/
+			if (lefl->info.via.area.layer >= 0) {
+			   routeLayer = lefl->info.via.area.layer;
+			   if (routeLayer < paintLayer) paintLayer = routeLayer;
+			}
 			lr = lefl->info.via.lr;
 			while (lr != NULL) {
-			   routeLayer = lr->layer;
-			   if (routeLayer < paintLayer) paintLayer = routeLayer;
-			   if ((routeLayer >= 0) && (special == (char)1) &&
+			   if (lr->layer >= 0) {
+			      routeLayer = lr->layer;
+			      if (routeLayer < paintLayer) paintLayer = routeLayer;
+			   }
+			   if ((lr->layer >= 0) && (special == (char)1) &&
 					(valid == TRUE)) {
 			      drect = (DSEG)malloc(sizeof(struct dseg_));
 			      drect->x1 = x + lr->x1;
@@ -219,8 +252,14 @@ DefAddRoutes(FILE *f, float oscale, NET net, char special)
 			routednet->segments = NULL;
 			routednet->flags = (u_char)0;
 		    }
-		    newRoute->next = routednet->segments;
-		    routednet->segments = newRoute;
+
+		    /* Keep the segments in the order of the route */
+		    newRoute->next = NULL;
+		    if (routednet->segments == NULL)
+			routednet->segments = newRoute;
+		    else
+			lastRoute->next = newRoute;
+		    lastRoute = newRoute;
 		}
 		else
 		    LefError("Via \"%s\" does not define a metal layer!\n", token);
@@ -283,6 +322,13 @@ DefAddRoutes(FILE *f, float oscale, NET net, char special)
 		goto endCoord;
 	    }
 
+	    /* Points off the route grid are the ends of stubs to	*/
+	    /* off-grid taps.						*/
+
+	    lastoff = offgrid;
+	    offgrid = DefOffGrid(x, Xlowerbound, PitchX[paintLayer]) ||
+			DefOffGrid(y, Ylowerbound, PitchY[paintLayer]);
+
 	    /* Indicate that we have a valid reference point */
 
 	    if (valid == FALSE)
@@ -332,6 +378,23 @@ DefAddRoutes(FILE *f, float oscale, NET net, char special)
 		   }
 		}
 		else if (paintLayer >= 0) {
+
+		   /* Stubs are regenerated from the tap geometry when	*/
+		   /* the route is written out, so collapse a stub onto	*/
+		   /* its end on the grid.				*/
+
+		   if (offgrid) {
+		      refp.x1 = locarea.x2 = locarea.x1;
+		      refp.y1 = locarea.y2 = locarea.y1;
+		      offgrid = FALSE;
+		   }
+		   else if (lastoff) {
+		      locarea.x1 = locarea.x2;
+		      locarea.y1 = locarea.y2;
+		   }
+		   if ((locarea.x1 == locarea.x2) && (locarea.y1 == locarea.y2))
+		      goto endCoord;
+
 		   newRoute = (SEG)malloc(sizeof(struct seg_));
 		   newRoute->segtype = ST_WIRE;
 		   newRoute->x1 = locarea.x1;
@@ -349,8 +412,14 @@ DefAddRoutes(FILE *f, float oscale, NET net, char special)
 			routednet->segments = NULL;
 			routednet->flags = (u_char)0;
 		   }
-		   newRoute->next = routednet->segments;
-		   routednet->segments = newRoute;
+
+		   /* Keep the segments in the order of the route */
+		   newRoute->next = NULL;
+		   if (routednet->segments == NULL)
+			routednet->segments = newRoute;
+		   else
+			lastRoute->next = newRoute;
+		   lastRoute = newRoute;
 		}
 	    }
 
@@ -365,9 +434,6 @@ endCoord:
     /* Make sure we have allocated memory for nets */
     allocate_obs_array();
 
-    /* Write the route(s) back into Obs[] */
-    writeback_all_routes(net);
-
     return token;	/* Pass back the last token found */
 }
 
@@ -666,6 +732,9 @@ DefReadNets(FILE *f, char *sname, float oscale, char special, int total)
 			    // responsibility for this route.
 			    while (token && (*token != ';'))
 			        token = DefAddRoutes(f, oscale, net, special);
+
+			    /* Write the route(s) back into Obs[] */
+			    writeback_all_routes(net);
 			    break;
 			case DEF_NETPROP_FIXED:
 			case DEF_NETPROP_COVER:
@@ -1600,22 +1669,7 @@ enum def_sections {DEF_VERSION = 0, DEF_NAMESCASESENSITIVE,
 	DEF_CONSTRAINTS, DEF_GROUPS, DEF_EXTENSION,
 	DEF_END};
 
-float
-DefRead(char *inName)
-{
-    FILE *f;
-    char filename[256];
-    char *token;
-    int keyword, dscale, total;
-    int curlayer, channels;
-    int v, h, i;
-    float oscale;
-    double start, step;
-    double llx, lly, urx, ury;
-    char corient = '.';
-    DSEG diearea;
-
-    static char *sections[] = {
+static char *sections[] = {
 	"VERSION",
 	"NAMESCASESENSITIVE",
 	"UNITS",
@@ -1645,7 +1699,22 @@ DefRead(char *inName)
 	"BEGINEXT",
 	"END",
 	NULL
-    };
+};
+
+float
+DefRead(char *inName)
+{
+    FILE *f;
+    char filename[256];
+    char *token;
+    int keyword, dscale, total;
+    int curlayer, channels;
+    int v, h, i;
+    float oscale;
+    double start, step;
+    double llx, lly, urx, ury;
+    char corient = '.';
+    DSEG diearea;
 
     if (!strrchr(inName, '.'))
 	sprintf(filename, "%s.def", inName);
@@ -1927,3 +1996,667 @@ DefRead(char *inName)
     if (f != NULL) fclose(f);
     return oscale;
 }
+
+/*
+ *------------------------------------------------------------
+ *
+ * DefEcoMarkGate --
+ *
+ *	Mark every net connected to a pin of "gate" as
+ *	changed, so that its old routes are not reused.
+ *
+ *------------------------------------------------------------
+ */
+
+static void
+DefEcoMarkGate(GATE gate, u_char *changed)
+{
+    int i, netnum;
+
+    for (i = 0; i < gate->nodes; i++) {
+	netnum = gate->netnum[i];
+	if ((netnum > 0) && (netnum < MAXNETNUM))
+	    changed[netnum] = (u_char)1;
+    }
+}
+
+/*
+ *------------------------------------------------------------
+ *
+ * DefEcoMoved --
+ *
+ *	Return TRUE if the location read from the old DEF
+ *	file into "old" differs from that of "gate".
+ *
+ *------------------------------------------------------------
+ */
+
+static char
+DefEcoMoved(GATE gate, GATE old)
+{
+    if (fabs(gate->placedX - old->placedX) > EPS) return TRUE;
+    if (fabs(gate->placedY - old->placedY) > EPS) return TRUE;
+    if (gate->orient != old->orient) return TRUE;
+    return FALSE;
+}
+
+/*
+ *------------------------------------------------------------
+ *
+ * DefReadEcoComponents --
+ *
+ *	Read the COMPONENTS section of the old DEF file and
+ *	mark the nets of every instance which has been moved,
+ *	flipped, or given a different macro.  Instances which
+ *	have been added or removed show up as a change in the
+ *	connectivity of their nets instead.
+ *
+ *------------------------------------------------------------
+ */
+
+static void
+DefReadEcoComponents(FILE *f, char *sname, float oscale, u_char *changed)
+{
+    GATE gate;
+    struct gate_ old;
+    char *token;
+    char macroname[512];
+    int keyword;
+    char located;
+
+    static char *component_keys[] = {
+	"-",
+	"END",
+	NULL
+    };
+
+    static char *location_keys[] = {
+	"FIXED",
+	"COVER",
+	"PLACED",
+	"UNPLACED",
+	NULL
+    };
+
+    while ((token = LefNextToken(f, TRUE)) != NULL)
+    {
+	keyword = Lookup(token, component_keys);
+	if (keyword < 0)
+	{
+	    LefEndStatement(f);
+	    continue;
+	}
+	if (keyword == DEF_COMP_END)
+	{
+	    if (!LefParseEndStatement(f, sname))
+		LefError("Component END statement missing.\n");
+	    break;
+	}
+
+	/* Get use and macro names */
+	token = LefNextToken(f, TRUE);
+	gate = DefFindInstance(token);
+	token = LefNextToken(f, TRUE);
+	strncpy(macroname, token, 511);
+	macroname[511] = '\0';
+
+	located = FALSE;
+	while ((token = LefNextToken(f, TRUE)) != NULL)
+	{
+	    if (*token == ';') break;
+	    if (*token != '+') continue;
+
+	    token = LefNextToken(f, TRUE);
+	    if (Lookup(token, location_keys) >= 0)
+		if (DefReadLocation(&old, f, oscale) == 0)
+		    located = TRUE;
+	}
+
+	if ((gate == NULL) || (gate->gatetype == PinMacro)) continue;
+	if (!located || DefEcoMoved(gate, &old) ||
+		strcasecmp(gate->gatetype->gatename, macroname))
+	    DefEcoMarkGate(gate, changed);
+    }
+}
+
+/*
+ *------------------------------------------------------------
+ *
+ * DefReadEcoPins --
+ *
+ *	Read the PINS section of the old DEF file and mark
+ *	the nets of every pin which has been moved.
+ *
+ *------------------------------------------------------------
+ */
+
+static void
+DefReadEcoPins(FILE *f, char *sname, float oscale, u_char *changed)
+{
+    GATE gate;
+    struct gate_ old;
+    char *token;
+    char pinname[MAX_NAME_LEN], netname[MAX_NAME_LEN];
+    int keyword;
+    char located;
+
+    static char *pin_keys[] = {
+	"-",
+	"END",
+	NULL
+    };
+
+    static char *location_keys[] = {
+	"FIXED",
+	"COVER",
+	"PLACED",
+	NULL
+    };
+
+    while ((token = LefNextToken(f, TRUE)) != NULL)
+    {
+	keyword = Lookup(token, pin_keys);
+	if (keyword < 0)
+	{
+	    LefEndStatement(f);
+	    continue;
+	}
+	if (keyword == DEF_PINS_END)
+	{
+	    if (!LefParseEndStatement(f, sname))
+		LefError("Pin END statement missing.\n");
+	    break;
+	}
+
+	token = LefNextToken(f, TRUE);
+	strncpy(pinname, token, MAX_NAME_LEN - 1);
+	pinname[MAX_NAME_LEN - 1] = '\0';
+	netname[0] = '\0';
+
+	located = FALSE;
+	while ((token = LefNextToken(f, TRUE)) != NULL)
+	{
+	    if (*token == ';') break;
+	    if (*token != '+') continue;
+
+	    token = LefNextToken(f, TRUE);
+	    if (!strcmp(token, "NET")) {
+		token = LefNextToken(f, TRUE);
+		strncpy(netname, token, MAX_NAME_LEN - 1);
+		netname[MAX_NAME_LEN - 1] = '\0';
+	    }
+	    else if (Lookup(token, location_keys) >= 0)
+		if (DefReadLocation(&old, f, oscale) == 0)
+		    located = TRUE;
+	}
+
+	/* Pin records are named by net, as in DefReadPins() */
+	gate = DefFindInstance((netname[0] != '\0') ? netname : pinname);
+	if ((gate == NULL) || (gate->gatetype != PinMacro)) continue;
+	if (!located || DefEcoMoved(gate, &old))
+	    DefEcoMarkGate(gate, changed);
+    }
+}
+
+/*
+ *------------------------------------------------------------
+ *
+ * DefEcoFindNet --
+ *
+ *	Find the net called "name".  Nets nearly always
+ *	appear in the same order in the old and the new DEF
+ *	files, so the search starts after the net that was
+ *	found last ("*hint").
+ *
+ *------------------------------------------------------------
+ */
+
+static NET
+DefEcoFindNet(char *name, int *hint)
+{
+    NET net;
+    int i, j;
+
+    for (j = 0; j < Numnets; j++) {
+	i = (*hint + j) % Numnets;
+	net = Nlnets[i];
+	if (!strcmp(net->netname, name)) {
+	    *hint = i + 1;
+	    return net;
+	}
+    }
+    return NULL;
+}
+
+/*
+ *------------------------------------------------------------
+ *
+ * DefEcoCheckPin --
+ *
+ *	Return TRUE if pin "pinname" of instance "instname"
+ *	is connected to "net" in the current netlist.
+ *
+ *------------------------------------------------------------
+ */
+
+static char
+DefEcoCheckPin(NET net, char *instname, char *pinname)
+{
+    GATE g;
+    int i;
+
+    g = DefFindInstance(instname);
+    if ((g == NULL) || (g->gatetype == NULL)) return FALSE;
+
+    for (i = 0; i < g->gatetype->nodes; i++)
+	if (!strcasecmp(g->gatetype->node[i], pinname))
+	    return (g->netnum[i] == net->netnum) ? TRUE : FALSE;
+
+    return FALSE;
+}
+
+/*
+ *------------------------------------------------------------
+ *
+ * DefEcoOnRoute --
+ *
+ *	Return TRUE if grid position (x, y, lay) lies on one
+ *	of the routes of "net".
+ *
+ *------------------------------------------------------------
+ */
+
+static char
+DefEcoOnRoute(NET net, int x, int y, int lay)
+{
+    ROUTE rt;
+    SEG seg;
+
+    for (rt = net->routes; rt; rt = rt->next) {
+	for (seg = rt->segments; seg; seg = seg->next) {
+	    if (seg->segtype & ST_VIA) {
+		if ((lay != seg->layer) && (lay != seg->layer + 1)) continue;
+		if ((x == seg->x1) && (y == seg->y1)) return TRUE;
+	    }
+	    else {
+		if (lay != seg->layer) continue;
+		if ((x >= MIN(seg->x1, seg->x2)) && (x <= MAX(seg->x1, seg->x2)) &&
+			(y >= MIN(seg->y1, seg->y2)) && (y <= MAX(seg->y1, seg->y2)))
+		    return TRUE;
+	    }
+	}
+    }
+    return FALSE;
+}
+
+/*
+ *------------------------------------------------------------
+ *
+ * DefEcoRoutesValid --
+ *
+ *	Check the routes read from the old DEF file for "net"
+ *	before they are written into Obs[].  The routes are
+ *	usable only if they reach a tap of every node of the
+ *	net, and do not cross any position now belonging to
+ *	another net or to an obstruction, other than those
+ *	obstructions covering the taps of the net itself.
+ *
+ *------------------------------------------------------------
+ */
+
+static char
+DefEcoRoutesValid(NET net)
+{
+    ROUTE rt;
+    SEG seg;
+    NODE node, nsav;
+    DPOINT ntap;
+    int x, y, lay, orignet;
+    char found;
+
+    for (node = net->netnodes; node; node = node->next) {
+	found = FALSE;
+	for (ntap = node->taps; ntap && !found; ntap = ntap->next)
+	    found = DefEcoOnRoute(net, ntap->gridx, ntap->gridy, ntap->layer);
+	for (ntap = node->extend; ntap && !found; ntap = ntap->next)
+	    found = DefEcoOnRoute(net, ntap->gridx, ntap->gridy, ntap->layer);
+	if (!found) return FALSE;
+    }
+
+    for (rt = net->routes; rt; rt = rt->next) {
+	for (seg = rt->segments; seg; seg = seg->next) {
+	    lay = seg->layer;
+	    x = seg->x1;
+	    y = seg->y1;
+	    if ((x < 0) || (y < 0) || (seg->x2 < 0) || (seg->y2 < 0) ||
+			(x >= NumChannelsX[lay]) || (y >= NumChannelsY[lay]) ||
+			(seg->x2 >= NumChannelsX[lay]) ||
+			(seg->y2 >= NumChannelsY[lay]))
+		return FALSE;
+	    if ((seg->segtype & ST_VIA) && (lay + 1 < Num_layers)) {
+		orignet = Obs[lay + 1][OGRID(x, y, lay + 1)] & NETNUM_MASK;
+		if ((orignet != 0) && (orignet != net->netnum)) {
+		    nsav = NODESAV(x, y, lay + 1);
+		    if ((nsav == NULL) || (nsav->netnum != net->netnum))
+			return FALSE;
+		}
+	    }
+	    while (1) {
+		orignet = Obs[lay][OGRID(x, y, lay)] & NETNUM_MASK;
+		if ((orignet != 0) && (orignet != net->netnum)) {
+		    nsav = NODESAV(x, y, lay);
+		    if ((nsav == NULL) || (nsav->netnum != net->netnum))
+			return FALSE;
+		}
+		if ((x == seg->x2) && (y == seg->y2)) break;
+
+		if (x < seg->x2) x++;
+		else if (x > seg->x2) x--;
+		if (y < seg->y2) y++;
+		else if (y > seg->y2) y--;
+	    }
+	}
+    }
+    return TRUE;
+}
+
+/*
+ *------------------------------------------------------------
+ *
+ * DefEcoKeepRoutes --
+ *
+ *	Write the reused routes of "net" into Obs[], and
+ *	remove the net's taps from Nodeloc[] the same way a
+ *	successful route does.
+ *
+ *------------------------------------------------------------
+ */
+
+static void
+DefEcoKeepRoutes(NET net)
+{
+    NODE node;
+    DPOINT ntap;
+    int pass;
+
+    writeback_all_routes(net);
+
+    for (node = net->netnodes; node; node = node->next) {
+	for (pass = 0; pass < 2; pass++) {
+	    for (ntap = (pass == 0) ? node->taps : node->extend; ntap;
+			ntap = ntap->next) {
+		if (NODELOC(ntap->gridx, ntap->gridy, ntap->layer) == node)
+		    SetNodeinfo(ntap->gridx, ntap->gridy, ntap->layer)->nodeloc
+				= (NODE)NULL;
+	    }
+	}
+    }
+    net->flags |= NET_ROUTED;
+}
+
+/*
+ *------------------------------------------------------------
+ *
+ * DefEcoFreeRoutes --
+ *
+ *	Discard routes read for "net" which cannot be reused.
+ *
+ *------------------------------------------------------------
+ */
+
+static void
+DefEcoFreeRoutes(NET net)
+{
+    ROUTE rt;
+    SEG seg;
+
+    while (net->routes) {
+	rt = net->routes;
+	net->routes = rt->next;
+	while (rt->segments) {
+	    seg = rt->segments->next;
+	    free(rt->segments);
+	    rt->segments = seg;
+	}
+	free(rt);
+    }
+}
+
+/*
+ *------------------------------------------------------------
+ *
+ * DefReadEcoNets --
+ *
+ *	Read the NETS section of the old DEF file.  The routes
+ *	of each net are reused if the net connects the same
+ *	pins as it does now, none of its instances or pins
+ *	has changed (see DefReadEcoComponents()), and the
+ *	routes pass DefEcoRoutesValid().  All other nets are
+ *	left to be routed.
+ *
+ * Results:
+ *	The number of nets whose routes were reused.
+ *
+ *------------------------------------------------------------
+ */
+
+static int
+DefReadEcoNets(FILE *f, char *sname, float oscale, u_char *changed)
+{
+    NET net;
+    char *token;
+    char instname[MAX_NAME_LEN];
+    int keyword, count, hint, kept;
+    char usable;
+
+    static char *net_keys[] = {
+	"-",
+	"END",
+	NULL
+    };
+
+    hint = kept = 0;
+
+    while ((token = LefNextToken(f, TRUE)) != NULL)
+    {
+	keyword = Lookup(token, net_keys);
+	if (keyword < 0)
+	{
+	    LefEndStatement(f);
+	    continue;
+	}
+	if (keyword == DEF_NET_END)
+	{
+	    if (!LefParseEndStatement(f, sname))
+		LefError("Net END statement missing.\n");
+	    break;
+	}
+
+	/* Nets which already have routes in the new DEF file keep them */
+
+	token = LefNextToken(f, TRUE);
+	net = DefEcoFindNet(token, &hint);
+	usable = ((net != NULL) && (net->routes == NULL) &&
+		!changed[net->netnum]) ? TRUE : FALSE;
+	count = 0;
+
+	token = LefNextToken(f, TRUE);
+	while (token && (*token != ';'))
+	{
+	    if (*token == '(')
+	    {
+		token = LefNextToken(f, TRUE);	/* get pin or gate */
+		strncpy(instname, token, MAX_NAME_LEN - 1);
+		instname[MAX_NAME_LEN - 1] = '\0';
+		token = LefNextToken(f, TRUE);	/* get node name */
+
+		if (usable) {
+		    if (!strcasecmp(instname, "pin"))
+			usable = DefEcoCheckPin(net, token, "pin");
+		    else
+			usable = DefEcoCheckPin(net, instname, token);
+		}
+		count++;
+
+		token = LefNextToken(f, TRUE);	/* should be ')' */
+		token = LefNextToken(f, TRUE);
+		continue;
+	    }
+	    else if (*token != '+')
+	    {
+		token = LefNextToken(f, TRUE);
+		continue;
+	    }
+
+	    token = LefNextToken(f, TRUE);
+	    if (!strcmp(token, "ROUTED") && usable &&
+			(count == net->numnodes))
+	    {
+		token = DefAddRoutes(f, oscale, net, (char)0);
+		continue;
+	    }
+
+	    /* Skip the property and its values */
+	    while ((token = LefNextToken(f, TRUE)) != NULL)
+		if ((*token == ';') || (*token == '+')) break;
+	}
+
+	if ((net == NULL) || !usable || (count != net->numnodes)) {
+	    if (usable && net->routes) DefEcoFreeRoutes(net);
+	    continue;
+	}
+	if (net->routes == NULL) continue;
+
+	if (DefEcoRoutesValid(net)) {
+	    DefEcoKeepRoutes(net);
+	    kept++;
+	}
+	else
+	    DefEcoFreeRoutes(net);
+    }
+    return kept;
+}
+
+/*
+ *------------------------------------------------------------
+ *
+ * DefReadEco --
+ *
+ *	Read the routes of a previously routed DEF file for
+ *	the same design, after the new (placed) DEF file has
+ *	been read and set up, for an incremental (ECO) route.
+ *	Nets which are unaffected by the changes keep their
+ *	old routes and are flagged NET_ROUTED, so that they
+ *	are passed over by the first stage.  Everything else
+ *	is routed as usual.
+ *
+ * Results:
+ *	The number of nets whose routes were reused, or -1
+ *	if the file could not be read.
+ *
+ *------------------------------------------------------------
+ */
+
+int
+DefReadEco(char *inName)
+{
+    FILE *f;
+    char filename[256];
+    char *token;
+    int keyword, dscale, kept;
+    float oscale;
+    u_char *changed;
+
+    if (!strrchr(inName, '.'))
+	sprintf(filename, "%s.def", inName);
+    else
+	strcpy(filename, inName);
+
+    f = fopen(filename, "r");
+
+    if (f == NULL)
+    {
+	Fprintf(stderr, "Cannot open ECO file: ");
+	perror(filename);
+	return -1;
+    }
+
+    if (Verbose > 0) {
+	Fprintf(stdout, "Reading routes to reuse from file %s.\n", filename);
+	Flush(stdout);
+    }
+
+    changed = (u_char *)calloc(MAXNETNUM, sizeof(u_char));
+    oscale = 1;
+    kept = 0;
+    lefCurrentLine = 0;
+
+    while ((token = LefNextToken(f, TRUE)) != NULL)
+    {
+	keyword = Lookup(token, sections);
+	if (keyword < 0)
+	{
+	    LefEndStatement(f);
+	    continue;
+	}
+
+	switch (keyword)
+	{
+	    case DEF_UNITS:
+		token = LefNextToken(f, TRUE);
+		token = LefNextToken(f, TRUE);
+		token = LefNextToken(f, TRUE);
+		if (sscanf(token, "%d", &dscale) != 1)
+		{
+		    LefError("Invalid syntax for UNITS statement.\n");
+		    dscale = 100;
+		}
+		oscale *= (float)dscale;
+		LefEndStatement(f);
+		break;
+	    case DEF_COMPONENTS:
+		LefEndStatement(f);
+		DefReadEcoComponents(f, sections[DEF_COMPONENTS], oscale,
+			changed);
+		break;
+	    case DEF_PINS:
+		LefEndStatement(f);
+		DefReadEcoPins(f, sections[DEF_PINS], oscale, changed);
+		break;
+	    case DEF_NETS:
+		LefEndStatement(f);
+		kept += DefReadEcoNets(f, sections[DEF_NETS], oscale, changed);
+		break;
+	    case DEF_REGIONS:
+	    case DEF_PROPERTYDEFINITIONS:
+	    case DEF_DEFAULTCAP:
+	    case DEF_VIAS:
+	    case DEF_PINPROPERTIES:
+	    case DEF_SPECIALNETS:
+	    case DEF_IOTIMINGS:
+	    case DEF_SCANCHAINS:
+	    case DEF_BLOCKAGES:
+	    case DEF_CONSTRAINTS:
+	    case DEF_GROUPS:
+	    case DEF_EXTENSION:
+		LefSkipSection(f, sections[keyword]);
+		break;
+	    case DEF_END:
+		LefParseEndStatement(f, "DESIGN");
+		break;
+	    default:
+		LefEndStatement(f);
+		break;
+	}
+	if (keyword == DEF_END) break;
+    }
+    LefError(NULL);	/* print statement of errors, if any, and reset */
+
+    if (Verbose > 0)
+	Fprintf(stdout, "ECO:  Reused the routes of %d of %d nets.\n",
+		kept, Numnets);
+
+    free(changed);
+    fclose(f);
+    return kept;
+}
@@ -0,0 +1,660 @@
+/*--------------------------------------------------------------*/
+/* global.c -- coarse global routing ahead of the first stage.	*/
+/*								*/
+/* The route grid is divided into square "gcells" of		*/
+/* GlobalGcell tracks on a side.  Each boundary between two	*/
+/* neighboring gcells has a capacity, which is the number of	*/
+/* tracks in the preferred direction crossing the boundary	*/
+/* that are not blocked in Obs[].  Every net is routed as a	*/
+/* tree of gcells, and nets crossing overfull boundaries are	*/
+/* ripped up and rerouted with rising present and history	*/
+/* costs, the same way as negotiate.c does it on the detailed	*/
+/* grid, but on a grid small enough to route all nets many	*/
+/* times over.							*/
+/*								*/
+/* The gcells of each net's tree make up its corridor, which	*/
+/* createGlobalMask() turns into the route mask RMask[] for the	*/
+/* first stage of the detailed router, in place of the trunk	*/
+/* and branch guess of createMask().  The corridor is only a	*/
+/* hint:  A net that fails inside it is routed again with the	*/
+/* regular mask (see doroute()).  Global routing is off unless	*/
+/* "global route gcell" is set, as it does not yet give fewer	*/
+/* failed nets on all designs.					*/
+/*--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "qrouter.h"
+#include "qconfig.h"
+#include "node.h"
+#include "maze.h"
+
+#define GLOBAL_ITERATIONS 8	// Maximum rip-up and reroute passes
+#define GLOBAL_BASE	10	// Cost of crossing one gcell boundary
+#define GLOBAL_OVER	20	// Cost per track of overflow, times
+				// the present cost factor
+#define GLOBAL_HIST	10	// Cost per pass a boundary overflowed
+#define GLOBAL_MARGIN	4	// Search window margin, in gcells
+
+// Boundaries are numbered (cell << 1) for the boundary to the
+// gcell on the right (x + 1), and (cell << 1) | 1 for the boundary
+// to the gcell above (y + 1).
+
+typedef struct gnet_ {
+   int *cells;		// gcells in the corridor of the net
+   int numcells;
+   int *edges;		// gcell boundaries crossed by the net
+   int numedges;
+} GNET;
+
+static GNET *GNets = NULL;	// Indexed by net number
+static int GNetCount = 0;
+
+static int GX = 0, GY = 0;	// Size of the gcell grid
+static int GG = 0;		// Size of a gcell, in tracks
+static u_short *Cap = NULL;	// Capacity of each boundary
+static u_short *Demand = NULL;	// Number of nets crossing each boundary
+static u_short *Hist = NULL;	// Number of passes each boundary overflowed
+static int GlobalPresFactor = 1;
+
+static int *Dist = NULL;	// Search cost to each gcell
+static int *Prev = NULL;	// Boundary through which each gcell
+				// was reached, or -1
+static int *Mark = NULL;	// Search marks for each gcell
+static int MarkCount = 0;
+static int *Tree = NULL;	// Tree marks for each gcell
+static int TreeCount = 0;
+
+typedef struct gentry_ {
+   int cost;
+   int cell;
+} GENTRY;
+
+static GENTRY *GHeap = NULL;
+static int GHeapCount = 0;
+static int GHeapAlloc = 0;
+
+/*--------------------------------------------------------------*/
+/* Binary heap of gcells ordered by cost.			*/
+/*--------------------------------------------------------------*/
+
+static void gcell_push(int cell, int cost)
+{
+   int i, p;
+
+   if (GHeapCount == GHeapAlloc) {
+      GHeapAlloc = (GHeapAlloc == 0) ? 256 : GHeapAlloc << 1;
+      GHeap = (GENTRY *)realloc(GHeap, GHeapAlloc * sizeof(GENTRY));
+      if (GHeap == NULL) {
+	 fprintf(stderr, "Out of memory 15.\n");
+	 exit(15);
+      }
+   }
+   i = GHeapCount++;
+   while (i > 0) {
+      p = (i - 1) >> 1;
+      if (GHeap[p].cost <= cost) break;
+      GHeap[i] = GHeap[p];
+      i = p;
+   }
+   GHeap[i].cost = cost;
+   GHeap[i].cell = cell;
+}
+
+static int gcell_pop(int *cost)
+{
+   GENTRY last;
+   int i, c, cell;
+
+   if (GHeapCount == 0) return -1;
+   cell = GHeap[0].cell;
+   *cost = GHeap[0].cost;
+
+   last = GHeap[--GHeapCount];
+   i = 0;
+   while ((c = (i << 1) + 1) < GHeapCount) {
+      if ((c + 1 < GHeapCount) && (GHeap[c + 1].cost < GHeap[c].cost)) c++;
+      if (GHeap[c].cost >= last.cost) break;
+      GHeap[i] = GHeap[c];
+      i = c;
+   }
+   if (GHeapCount > 0) GHeap[i] = last;
+   return cell;
+}
+
+/*--------------------------------------------------------------*/
+/* Append a value to a growing array of integers		*/
+/*--------------------------------------------------------------*/
+
+static void append_int(int **list, int *count, int value)
+{
+   // Arrays grow in powers of two starting from 8
+   if ((*count == 0) || ((*count >= 8) && !(*count & (*count - 1)))) {
+      *list = (int *)realloc(*list, ((*count < 8) ? 8 : (*count << 1))
+		* sizeof(int));
+      if (*list == NULL) {
+	 fprintf(stderr, "Out of memory 15.\n");
+	 exit(15);
+      }
+   }
+   (*list)[(*count)++] = value;
+}
+
+/*--------------------------------------------------------------*/
+/* track_free() ---						*/
+/*								*/
+/* Return 1 if the track position (x, y, lay) can take a route	*/
+/* of a net that has not been routed yet.			*/
+/*--------------------------------------------------------------*/
+
+static int track_free(int x, int y, int lay)
+{
+   if ((x < 0) || (y < 0) || (x >= NumChannelsX[lay]) ||
+		(y >= NumChannelsY[lay]))
+      return 0;
+   return (Obs[lay][OGRID(x, y, lay)] & (NO_NET | ROUTED_NET)) ? 0 : 1;
+}
+
+/*--------------------------------------------------------------*/
+/* global_capacity() ---					*/
+/*								*/
+/* Count the tracks crossing each gcell boundary.  A track	*/
+/* counts if it is free on both sides of the boundary, on a	*/
+/* layer whose preferred direction crosses the boundary.  If	*/
+/* no layer has the preferred direction, all layers count.	*/
+/*--------------------------------------------------------------*/
+
+static void global_capacity()
+{
+   int gx, gy, x, y, i, cell, cap, hcount, vcount;
+
+   hcount = vcount = 0;
+   for (i = 0; i < Num_layers; i++) {
+      if (Vert[i]) vcount++;
+      else hcount++;
+   }
+
+   for (gy = 0; gy < GY; gy++) {
+      for (gx = 0; gx < GX; gx++) {
+	 cell = gy * GX + gx;
+
+	 cap = 0;
+	 if (gx < GX - 1) {
+	    x = (gx + 1) * GG;
+	    for (i = 0; i < Num_layers; i++) {
+	       if (Vert[i] && (hcount > 0)) continue;
+	       for (y = gy * GG; y < (gy + 1) * GG; y++)
+		  cap += track_free(x - 1, y, i) & track_free(x, y, i);
+	    }
+	 }
+	 Cap[cell << 1] = (u_short)cap;
+
+	 cap = 0;
+	 if (gy < GY - 1) {
+	    y = (gy + 1) * GG;
+	    for (i = 0; i < Num_layers; i++) {
+	       if (!Vert[i] && (vcount > 0)) continue;
+	       for (x = gx * GG; x < (gx + 1) * GG; x++)
+		  cap += track_free(x, y - 1, i) & track_free(x, y, i);
+	    }
+	 }
+	 Cap[(cell << 1) | 1] = (u_short)cap;
+      }
+   }
+}
+
+/*--------------------------------------------------------------*/
+/* Cost of adding one more net to boundary "edge"		*/
+/*--------------------------------------------------------------*/
+
+static int edge_cost(int edge)
+{
+   int cost, over;
+
+   cost = GLOBAL_BASE + Hist[edge] * GLOBAL_HIST;
+   over = (int)Demand[edge] + 1 - (int)Cap[edge];
+   if (over > 0)
+      cost += over * GLOBAL_OVER * GlobalPresFactor;
+   else if (Cap[edge] > 0)
+      // Spread the nets out before the boundary is full
+      cost += (GLOBAL_BASE * (int)Demand[edge]) / (int)Cap[edge];
+   return cost;
+}
+
+/*--------------------------------------------------------------*/
+/* Gcell containing the first tap (or extension) of a node	*/
+/*--------------------------------------------------------------*/
+
+static int node_gcell(NODE node)
+{
+   DPOINT dtap;
+
+   dtap = (node->taps == NULL) ? node->extend : node->taps;
+   if (dtap == NULL) return -1;
+   return (dtap->gridy / GG) * GX + (dtap->gridx / GG);
+}
+
+/*--------------------------------------------------------------*/
+/* global_connect() ---						*/
+/*								*/
+/* Find the cheapest path from the gcells already in the tree	*/
+/* of "gn" (those with Tree[] == "tree") to gcell "target",	*/
+/* within the window (wx1, wy1) to (wx2, wy2), and add the path	*/
+/* to the tree.							*/
+/*--------------------------------------------------------------*/
+
+static void global_connect(GNET *gn, int target, int tree,
+		int wx1, int wy1, int wx2, int wy2)
+{
+   int i, cell, ncell, edge, cost, ncost, gx, gy, tx, ty, search;
+   int nbr[4], nedge[4];
+
+   search = ++MarkCount;
+   tx = target % GX;
+   ty = target / GX;
+   GHeapCount = 0;
+
+   for (i = 0; i < gn->numcells; i++) {
+      cell = gn->cells[i];
+      Dist[cell] = 0;
+      Prev[cell] = -1;
+      Mark[cell] = search;
+      gx = cell % GX;
+      gy = cell / GX;
+      gcell_push(cell, (ABSDIFF(gx, tx) + ABSDIFF(gy, ty)) * GLOBAL_BASE);
+   }
+
+   while ((cell = gcell_pop(&cost)) >= 0) {
+      if (cell == target) break;
+      gx = cell % GX;
+      gy = cell / GX;
+      if (cost - (ABSDIFF(gx, tx) + ABSDIFF(gy, ty)) * GLOBAL_BASE
+		> Dist[cell])
+	 continue;		// Stale heap entry
+
+      nbr[0] = (gx < wx2) ? cell + 1 : -1;
+      nedge[0] = cell << 1;
+      nbr[1] = (gx > wx1) ? cell - 1 : -1;
+      nedge[1] = (cell - 1) << 1;
+      nbr[2] = (gy < wy2) ? cell + GX : -1;
+      nedge[2] = (cell << 1) | 1;
+      nbr[3] = (gy > wy1) ? cell - GX : -1;
+      nedge[3] = ((cell - GX) << 1) | 1;
+
+      for (i = 0; i < 4; i++) {
+	 ncell = nbr[i];
+	 if (ncell < 0) continue;
+	 ncost = Dist[cell] + edge_cost(nedge[i]);
+	 if ((Mark[ncell] == search) && (Dist[ncell] <= ncost)) continue;
+	 Mark[ncell] = search;
+	 Dist[ncell] = ncost;
+	 Prev[ncell] = nedge[i];
+	 gcell_push(ncell, ncost + (ABSDIFF(ncell % GX, tx) +
+			ABSDIFF(ncell / GX, ty)) * GLOBAL_BASE);
+      }
+   }
+
+   // Trace back from the target to the tree.  The window always
+   // contains the target, so the target is always reached.
+
+   for (cell = target; Prev[cell] >= 0; ) {
+      edge = Prev[cell];
+      append_int(&gn->edges, &gn->numedges, edge);
+      if (Demand[edge] < 0xffff) Demand[edge]++;
+      append_int(&gn->cells, &gn->numcells, cell);
+      Tree[cell] = tree;
+      if ((edge & 1) == 0)
+	 cell = ((edge >> 1) == cell) ? cell + 1 : (edge >> 1);
+      else
+	 cell = ((edge >> 1) == cell) ? cell + GX : (edge >> 1);
+   }
+}
+
+/*--------------------------------------------------------------*/
+/* global_route_net() ---					*/
+/*								*/
+/* Route "net" as a tree of gcells, adding the pins in order of	*/
+/* distance from the part of the tree already routed (Prim's	*/
+/* ordering).							*/
+/*--------------------------------------------------------------*/
+
+static void global_route_net(NET net)
+{
+   GNET *gn = &GNets[net->netnum];
+   NODE node;
+   int *pins, *mind, npins, i, best, d, cell, tree;
+   int wx1, wy1, wx2, wy2, gx, gy;
+
+   pins = (int *)malloc(net->numnodes * sizeof(int));
+   mind = (int *)malloc(net->numnodes * sizeof(int));
+   npins = 0;
+   wx1 = GX;
+   wy1 = GY;
+   wx2 = wy2 = -1;
+   for (node = net->netnodes; node; node = node->next) {
+      cell = node_gcell(node);
+      if (cell < 0) continue;
+      pins[npins++] = cell;
+      gx = cell % GX;
+      gy = cell / GX;
+      if (gx < wx1) wx1 = gx;
+      if (gx > wx2) wx2 = gx;
+      if (gy < wy1) wy1 = gy;
+      if (gy > wy2) wy2 = gy;
+   }
+
+   // The search may detour a short distance outside the bounding box
+   wx1 = MAX(wx1 - GLOBAL_MARGIN, 0);
+   wy1 = MAX(wy1 - GLOBAL_MARGIN, 0);
+   wx2 = MIN(wx2 + GLOBAL_MARGIN, GX - 1);
+   wy2 = MIN(wy2 + GLOBAL_MARGIN, GY - 1);
+
+   tree = ++TreeCount;
+   for (i = 0; i < npins; i++) mind[i] = MAXRT;
+   if (npins > 0) mind[0] = 0;
+
+   while (npins > 0) {
+
+      // Pick the pin closest to a pin already connected, and
+      // connect it to the tree.
+
+      best = 0;
+      for (i = 1; i < npins; i++)
+	 if (mind[i] < mind[best]) best = i;
+
+      cell = pins[best];
+      npins--;
+      pins[best] = pins[npins];
+      mind[best] = mind[npins];
+
+      if (gn->numcells == 0) {
+	 append_int(&gn->cells, &gn->numcells, cell);
+	 Tree[cell] = tree;
+      }
+      else if (Tree[cell] != tree)
+	 global_connect(gn, cell, tree, wx1, wy1, wx2, wy2);
+
+      for (i = 0; i < npins; i++) {
+	 d = ABSDIFF(pins[i] % GX, cell % GX) + ABSDIFF(pins[i] / GX, cell / GX);
+	 if (d < mind[i]) mind[i] = d;
+      }
+   }
+   free(mind);
+   free(pins);
+}
+
+/*--------------------------------------------------------------*/
+/* Remove the global route of "net"				*/
+/*--------------------------------------------------------------*/
+
+static void global_ripup_net(NET net)
+{
+   GNET *gn = &GNets[net->netnum];
+   int i;
+
+   for (i = 0; i < gn->numedges; i++)
+      if (Demand[gn->edges[i]] > 0) Demand[gn->edges[i]]--;
+   free(gn->edges);
+   free(gn->cells);
+   gn->edges = gn->cells = NULL;
+   gn->numedges = gn->numcells = 0;
+}
+
+/*--------------------------------------------------------------*/
+/* Return the number of tracks of overflow over all boundaries	*/
+/*--------------------------------------------------------------*/
+
+static int global_overflow(int *edges)
+{
+   int i, overflow = 0;
+
+   *edges = 0;
+   for (i = 0; i < (GX * GY) << 1; i++) {
+      if (Demand[i] > Cap[i]) {
+	 overflow += Demand[i] - Cap[i];
+	 (*edges)++;
+      }
+   }
+   return overflow;
+}
+
+/*--------------------------------------------------------------*/
+/* free_global_route() ---					*/
+/*								*/
+/* Release all global routing information.  After this, the	*/
+/* detailed router goes back to using createMask().		*/
+/*--------------------------------------------------------------*/
+
+void free_global_route()
+{
+   int i;
+
+   for (i = 0; i < GNetCount; i++) {
+      free(GNets[i].cells);
+      free(GNets[i].edges);
+   }
+   free(GNets);
+   GNets = NULL;
+   GNetCount = 0;
+
+   free(Cap);
+   free(Demand);
+   free(Hist);
+   free(Dist);
+   free(Prev);
+   free(Mark);
+   free(Tree);
+   free(GHeap);
+   Cap = Demand = Hist = NULL;
+   Dist = Prev = Mark = Tree = NULL;
+   GHeap = NULL;
+   GHeapCount = GHeapAlloc = 0;
+   GX = GY = GG = 0;
+}
+
+/*--------------------------------------------------------------*/
+/* global_route() ---						*/
+/*								*/
+/* Route all nets on a grid of gcells "gcell" tracks on a side,	*/
+/* for use as masks by the detailed router.  Nets which already	*/
+/* have routes are part of the blockages.  Power and ground	*/
+/* nets are not masked by the detailed router and are skipped.	*/
+/*								*/
+/* Return value:  The remaining overflow, in tracks		*/
+/*--------------------------------------------------------------*/
+
+int global_route(int gcell)
+{
+   NET net;
+   GNET *gn;
+   int i, j, iter, overflow, oedges, rerouted, ncells;
+
+   free_global_route();
+   if ((gcell <= 0) || (Numnets == 0) || (Obs[0] == NULL)) return 0;
+
+   GG = gcell;
+   GX = (NumChannelsX[0] + GG - 1) / GG;
+   GY = (NumChannelsY[0] + GG - 1) / GG;
+   ncells = GX * GY;
+
+   GNetCount = MAXNETNUM;
+   GNets = (GNET *)calloc(GNetCount, sizeof(GNET));
+   Cap = (u_short *)calloc(ncells << 1, sizeof(u_short));
+   Demand = (u_short *)calloc(ncells << 1, sizeof(u_short));
+   Hist = (u_short *)calloc(ncells << 1, sizeof(u_short));
+   Dist = (int *)malloc(ncells * sizeof(int));
+   Prev = (int *)malloc(ncells * sizeof(int));
+   Mark = (int *)calloc(ncells, sizeof(int));
+   Tree = (int *)calloc(ncells, sizeof(int));
+   if (!GNets || !Cap || !Demand || !Hist || !Dist || !Prev || !Mark ||
+		!Tree) {
+      fprintf(stderr, "Out of memory 15.\n");
+      exit(15);
+   }
+   MarkCount = TreeCount = 0;
+   GlobalPresFactor = 1;
+
+   global_capacity();
+
+   for (iter = 0; iter < GLOBAL_ITERATIONS; iter++) {
+      rerouted = 0;
+      for (i = 0; i < Numnets; i++) {
+	 net = getnettoroute(i);
+	 if ((net == NULL) || (net->netnodes == NULL)) continue;
+	 if ((net->netnum == VDD_NET) || (net->netnum == GND_NET)) continue;
+
+	 gn = &GNets[net->netnum];
+	 if (iter > 0) {
+	    // Only nets crossing an overfull boundary are rerouted
+	    for (j = 0; j < gn->numedges; j++)
+	       if (Demand[gn->edges[j]] > Cap[gn->edges[j]]) break;
+	    if (j == gn->numedges) continue;
+	    global_ripup_net(net);
+	 }
+	 global_route_net(net);
+	 rerouted++;
+      }
+
+      overflow = global_overflow(&oedges);
+      if (Verbose > 0)
+	 Fprintf(stdout, "Global route pass %d:  %d nets routed, overflow "
+		"%d on %d of %d boundaries\n", iter + 1, rerouted, overflow,
+		oedges, ncells << 1);
+      if (overflow == 0) break;
+
+      for (i = 0; i < ncells << 1; i++)
+	 if ((Demand[i] > Cap[i]) && (Hist[i] < 0xffff)) Hist[i]++;
+      GlobalPresFactor <<= 1;
+   }
+
+   if (Verbose > 1) print_congestion_map(stdout);
+   Flush(stdout);
+
+   return overflow;
+}
+
+/*--------------------------------------------------------------*/
+/* print_congestion_map() ---					*/
+/*								*/
+/* Print the usage of each gcell, as the highest ratio of	*/
+/* demand to capacity on its boundaries, top row first:		*/
+/* "." for unused, "0" to "9" for up to 10% to 100%, and "#"	*/
+/* for overfull.						*/
+/*--------------------------------------------------------------*/
+
+void print_congestion_map(FILE *f)
+{
+   int gx, gy, cell, e, k, use, worst;
+   int edges[4];
+   char *row;
+
+   if (Cap == NULL) {
+      Fprintf(f, "No global route has been made.\n");
+      return;
+   }
+
+   Fprintf(f, "Congestion map, %d x %d gcells of %d tracks:\n", GX, GY, GG);
+   row = (char *)malloc(GX + 1);
+   for (gy = GY - 1; gy >= 0; gy--) {
+      for (gx = 0; gx < GX; gx++) {
+	 cell = gy * GX + gx;
+	 edges[0] = (gx < GX - 1) ? cell << 1 : -1;
+	 edges[1] = (gx > 0) ? (cell - 1) << 1 : -1;
+	 edges[2] = (gy < GY - 1) ? (cell << 1) | 1 : -1;
+	 edges[3] = (gy > 0) ? ((cell - GX) << 1) | 1 : -1;
+
+	 worst = -1;
+	 for (k = 0; k < 4; k++) {
+	    e = edges[k];
+	    if ((e < 0) || (Demand[e] == 0)) continue;
+	    if (Demand[e] > Cap[e])
+	       use = 10;
+	    else
+	       use = (9 * Demand[e] + Cap[e] - 1) / Cap[e];
+	    if (use > worst) worst = use;
+	 }
+	 row[gx] = (worst < 0) ? '.' : (worst == 10) ? '#' : '0' + worst;
+      }
+      row[GX] = '\0';
+      Fprintf(f, "%s\n", row);
+   }
+   free(row);
+}
+
+/*--------------------------------------------------------------*/
+/* createGlobalMask() ---					*/
+/*								*/
+/* Create the route mask for "net" from its global route:  0	*/
+/* over the gcells of its corridor and within "slack" tracks	*/
+/* of it, rising by one per track beyond that, up to "halo".	*/
+/*								*/
+/* Return FALSE if the net has no global route, in which case	*/
+/* RMask[] is left unchanged.					*/
+/*--------------------------------------------------------------*/
+
+u_char createGlobalMask(NET net, u_char slack, u_char halo)
+{
+   GNET *gn;
+   NODE n1;
+   DPOINT dtap;
+   int c, v, i, j, x1, y1, x2, y2, gx1, gy1, gx2, gy2;
+   u_char *m;
+
+   if ((GNets == NULL) || (net->netnum >= GNetCount)) return FALSE;
+   gn = &GNets[net->netnum];
+   if (gn->numcells == 0) return FALSE;
+
+   fillMask((u_char)halo);
+
+   for (c = 0; c < gn->numcells; c++) {
+      x1 = (gn->cells[c] % GX) * GG;
+      y1 = (gn->cells[c] / GX) * GG;
+      x2 = x1 + GG - 1;
+      y2 = y1 + GG - 1;
+
+      for (v = 0; v < halo; v++) {
+	 gx1 = MAX(x1 - slack - v, 0);
+	 gy1 = MAX(y1 - slack - v, 0);
+	 gx2 = MIN(x2 + slack + v, NumChannelsX[0] - 1);
+	 gy2 = MIN(y2 + slack + v, NumChannelsY[0] - 1);
+
+	 if (v == 0) {
+	    for (j = gy1; j <= gy2; j++)
+	       for (i = gx1; i <= gx2; i++)
+		  RMask[OGRID(i, j, 0)] = (u_char)0;
+	    continue;
+	 }
+
+	 // Ring at distance v around the area
+	 for (i = gx1; i <= gx2; i++) {
+	    m = &RMask[OGRID(i, gy1, 0)];
+	    if (*m > v) *m = (u_char)v;
+	    m = &RMask[OGRID(i, gy2, 0)];
+	    if (*m > v) *m = (u_char)v;
+	 }
+	 for (j = gy1; j <= gy2; j++) {
+	    m = &RMask[OGRID(gx1, j, 0)];
+	    if (*m > v) *m = (u_char)v;
+	    m = &RMask[OGRID(gx2, j, 0)];
+	    if (*m > v) *m = (u_char)v;
+	 }
+      }
+   }
+
+   // Allow routes at all tap and extension points
+   for (n1 = net->netnodes; n1 != NULL; n1 = n1->next) {
+      for (dtap = n1->taps; dtap != NULL; dtap = dtap->next)
+	 RMask[OGRID(dtap->gridx, dtap->gridy, 0)] = (u_char)0;
+      for (dtap = n1->extend; dtap != NULL; dtap = dtap->next)
+	 RMask[OGRID(dtap->gridx, dtap->gridy, 0)] = (u_char)0;
+   }
+
+   if (Verbose > 2)
+      Fprintf(stdout, "Global route mask has %d gcells\n", gn->numcells);
+
+   return TRUE;
+}
+
+/* end of global.c */
@@ -235,7 +235,7 @@ map_obstruction()
 	for (x = 0; x < NumChannelsX[i]; x++) {
 	    xspc = (x + 1) * spacing - hspc;
 	    for (y = 0; y < NumChannelsY[i]; y++) {
-		if (Nodesav[i][OGRID(x, y, i)] != NULL) {
+		if (NODESAV(x, y, i) != NULL) {
 		    yspc = height - (y + 1) * spacing - hspc;
 		    XFillRectangle(dpy, buffer, gc, xspc, yspc,
 				spacing, spacing);
@@ -259,8 +259,7 @@ map_congestion()
 
     hspc = spacing >> 1;
 
-    Congestion = (u_char *)calloc(NumChannelsX[0] * NumChannelsY[0],
-			sizeof(u_char));
+    Congestion = (u_char *)calloc(GRIDSIZE(0), sizeof(u_char));
 
     // Analyze Obs[] array for congestion
     for (i = 0; i < Num_layers; i++) {
@@ -314,8 +313,7 @@ map_estimate()
 
     hspc = spacing >> 1;
 
-    Congestion = (float *)calloc(NumChannelsX[0] * NumChannelsY[0],
-			sizeof(float));
+    Congestion = (float *)calloc(GRIDSIZE(0), sizeof(float));
 
     // Use net bounding boxes to estimate congestion
 
@@ -137,6 +137,7 @@ void   LefHashCell(GATE gateginfo);
 
 void   LefRead(char *inName);
 float  DefRead(char *inName);
+int    DefReadEco(char *inName);
 
 void LefError(char *fmt, ...);	/* Variable argument procedure requires */
 				/* parameter list.			*/
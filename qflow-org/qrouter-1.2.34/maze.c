@@ -21,7 +21,212 @@
 #include "maze.h"
 #include "lef.h"
 
-extern int TotalRoutes;
+/*--------------------------------------------------------------*/
+/* Pooled allocation of POINT records.  The search creates and	*/
+/* discards these at a very high rate, so they are carved out	*/
+/* of large blocks and recycled through a free list instead of	*/
+/* going through malloc() and free() for each grid position.	*/
+/*--------------------------------------------------------------*/
+
+#define POINT_BLOCK	4096	// Number of POINT records per block
+
+static THREAD_LOCAL POINT FreePoints = (POINT)NULL;
+static THREAD_LOCAL POINT PointBlocks = (POINT)NULL;
+
+POINT allocPOINT()
+{
+    POINT gpoint;
+    int i;
+
+    if (FreePoints == (POINT)NULL) {
+	gpoint = (POINT)malloc(POINT_BLOCK * sizeof(struct point_));
+	if (gpoint == NULL) {
+	    Fprintf(stderr, "Out of memory 10.\n");
+	    exit(10);
+	}
+	// The first record of each block links the list of blocks
+	gpoint[0].next = PointBlocks;
+	PointBlocks = gpoint;
+	for (i = 1; i < POINT_BLOCK - 1; i++)
+	    gpoint[i].next = &gpoint[i + 1];
+	gpoint[POINT_BLOCK - 1].next = (POINT)NULL;
+	FreePoints = &gpoint[1];
+    }
+    gpoint = FreePoints;
+    FreePoints = gpoint->next;
+    gpoint->next = (POINT)NULL;
+    return gpoint;
+}
+
+void freePOINT(POINT gpoint)
+{
+    gpoint->next = FreePoints;
+    FreePoints = gpoint;
+}
+
+/*--------------------------------------------------------------*/
+/* Priority queue for the best-first (A*) route search.		*/
+/*								*/
+/* The queue is a binary heap of grid positions ordered by the	*/
+/* route cost to reach the position plus a lower bound on the	*/
+/* cost remaining to reach a target.  Ties are broken in favor	*/
+/* of the position with the higher route cost (i.e., the one	*/
+/* closer to the target), which keeps the search front narrow.	*/
+/* The heap array is kept between searches and only grows, so	*/
+/* in steady state no memory is allocated during routing.	*/
+/*--------------------------------------------------------------*/
+
+typedef struct hentry_ {
+    u_int key;		// route cost + lower bound to target
+    u_int cost;		// route cost to this position
+    int x, y;
+    int lay;
+} HENTRY;
+
+static THREAD_LOCAL HENTRY *Heap = (HENTRY *)NULL;
+static THREAD_LOCAL int HeapCount = 0;
+static THREAD_LOCAL int HeapAlloc = 0;
+
+#define HEAP_BEFORE(a, b) (((a)->key < (b)->key) || \
+		(((a)->key == (b)->key) && ((a)->cost > (b)->cost)))
+
+/*--------------------------------------------------------------*/
+/* gheap_push() ---						*/
+/*								*/
+/* Add grid position "ept" (with route cost ept->cost) to the	*/
+/* search queue, ordered by ept->cost + "bound".		*/
+/*--------------------------------------------------------------*/
+
+void gheap_push(GRIDP *ept, u_int bound)
+{
+    HENTRY *h;
+    int i, p;
+
+    if (HeapCount == HeapAlloc) {
+	HeapAlloc = (HeapAlloc == 0) ? 1024 : HeapAlloc << 1;
+	Heap = (HENTRY *)realloc(Heap, HeapAlloc * sizeof(HENTRY));
+	if (Heap == NULL) {
+	    Fprintf(stderr, "Out of memory 11.\n");
+	    exit(11);
+	}
+    }
+
+    // Sift up from the bottom of the heap
+    i = HeapCount++;
+    while (i > 0) {
+	p = (i - 1) >> 1;
+	h = &Heap[p];
+	if ((h->key < ept->cost + bound) || ((h->key == ept->cost + bound)
+			&& (h->cost >= ept->cost)))
+	    break;
+	Heap[i] = *h;
+	i = p;
+    }
+    h = &Heap[i];
+    h->key = ept->cost + bound;
+    h->cost = ept->cost;
+    h->x = ept->x;
+    h->y = ept->y;
+    h->lay = ept->lay;
+}
+
+/*--------------------------------------------------------------*/
+/* gheap_pop() ---						*/
+/*								*/
+/* Remove the lowest-cost entry from the search queue and	*/
+/* return it in "ept".  Returns 0 if the queue is empty.	*/
+/*--------------------------------------------------------------*/
+
+int gheap_pop(GRIDP *ept)
+{
+    HENTRY last;
+    int i, c;
+
+    if (HeapCount == 0) return 0;
+
+    ept->x = Heap[0].x;
+    ept->y = Heap[0].y;
+    ept->lay = Heap[0].lay;
+    ept->cost = Heap[0].cost;
+
+    // Sift the last entry down from the top of the heap
+    last = Heap[--HeapCount];
+    i = 0;
+    while ((c = (i << 1) + 1) < HeapCount) {
+	if ((c + 1 < HeapCount) && HEAP_BEFORE(&Heap[c + 1], &Heap[c])) c++;
+	if (!HEAP_BEFORE(&Heap[c], &last)) break;
+	Heap[i] = Heap[c];
+	i = c;
+    }
+    if (HeapCount > 0) Heap[i] = last;
+    return 1;
+}
+
+/*--------------------------------------------------------------*/
+/* gheap_key() ---						*/
+/*								*/
+/* Return the ordering key (route cost plus bound) of the next	*/
+/* position on the search queue in "key", without removing it.	*/
+/* Returns 0 if the queue is empty.				*/
+/*--------------------------------------------------------------*/
+
+int gheap_key(u_int *key)
+{
+    if (HeapCount == 0) return 0;
+    *key = Heap[0].key;
+    return 1;
+}
+
+/*--------------------------------------------------------------*/
+/* gheap_drain() ---						*/
+/*								*/
+/* Empty the search queue.  If "pushlist" is non-NULL, the	*/
+/* unprocessed positions are returned on the list so that the	*/
+/* search can be resumed from them for the next route of the	*/
+/* same net.							*/
+/*--------------------------------------------------------------*/
+
+void gheap_drain(POINT *pushlist)
+{
+    POINT gpoint;
+
+    if (pushlist != NULL) {
+	while (HeapCount > 0) {
+	    HeapCount--;
+	    gpoint = allocPOINT();
+	    gpoint->x1 = Heap[HeapCount].x;
+	    gpoint->y1 = Heap[HeapCount].y;
+	    gpoint->layer = Heap[HeapCount].lay;
+	    gpoint->next = *pushlist;
+	    *pushlist = gpoint;
+	}
+    }
+    HeapCount = 0;
+}
+
+/*--------------------------------------------------------------*/
+/* free_search_memory() ---					*/
+/*								*/
+/* Release the POINT pool and the search queue.  This must only	*/
+/* be called when no POINT records are in use, and is needed	*/
+/* only by route threads (see mthread.c) before they exit.	*/
+/*--------------------------------------------------------------*/
+
+void free_search_memory()
+{
+    POINT gblock;
+
+    while (PointBlocks != (POINT)NULL) {
+	gblock = PointBlocks;
+	PointBlocks = gblock->next;
+	free(gblock);
+    }
+    FreePoints = (POINT)NULL;
+
+    free(Heap);
+    Heap = (HENTRY *)NULL;
+    HeapCount = HeapAlloc = 0;
+}
 
 /*--------------------------------------------------------------*/
 /* find_unrouted_node() --					*/
@@ -194,7 +399,7 @@ void clear_non_source_targets(NET net, POINT *pushlist)
 	 if (Pr->flags & PR_TARGET) {
 	    if (Pr->flags & PR_PROCESSED) {
 		Pr->flags &= ~PR_PROCESSED;
-		gpoint = (POINT)malloc(sizeof(struct point_));
+		gpoint = allocPOINT();
 		gpoint->x1 = x;
 		gpoint->y1 = y;
 		gpoint->layer = lay;
@@ -213,7 +418,7 @@ void clear_non_source_targets(NET net, POINT *pushlist)
 	    if (Pr->flags & PR_TARGET) {
 		if (Pr->flags & PR_PROCESSED) {
 		    Pr->flags &= ~PR_PROCESSED;
-		    gpoint = (POINT)malloc(sizeof(struct point_));
+		    gpoint = allocPOINT();
 		    gpoint->x1 = x;
 		    gpoint->y1 = y;
 		    gpoint->layer = lay;
@@ -244,7 +449,7 @@ int clear_target_node(NODE node)
        lay = ntap->layer;
        x = ntap->gridx;
        y = ntap->gridy;
-       if (Nodeloc[lay][OGRID(x, y, lay)] == (NODE)NULL)
+       if (NODELOC(x, y, lay) == (NODE)NULL)
 	  continue;
        Pr = &Obs2[lay][OGRID(x, y, lay)];
        Pr->flags = 0;
@@ -256,8 +461,8 @@ int clear_target_node(NODE node)
        x = ntap->gridx;
        y = ntap->gridy;
 
-       if (Nodesav[lay][OGRID(x, y, lay)] == (NODE)NULL ||
-       	   Nodesav[lay][OGRID(x, y, lay)] != node)
+       if (NODESAV(x, y, lay) == (NODE)NULL ||
+       	   NODESAV(x, y, lay) != node)
        continue;
 	
        Pr = &Obs2[lay][OGRID(x, y, lay)];
@@ -401,7 +606,7 @@ int set_node_to_net(NODE node, int newflags, POINT *pushlist, SEG bbox, u_char s
 	  // push this point on the stack to process
 
 	  if (pushlist != NULL) {
-	     gpoint = (POINT)malloc(sizeof(struct point_));
+	     gpoint = allocPOINT();
 	     gpoint->x1 = x;
 	     gpoint->y1 = y;
 	     gpoint->layer = lay;
@@ -431,12 +636,12 @@ int set_node_to_net(NODE node, int newflags, POINT *pushlist, SEG bbox, u_char s
 
        // Don't process extended areas if they coincide with other nodes.
 
-       // if (Nodeloc[lay][OGRID(x, y, lay)] != (NODE)NULL &&
-       //	Nodeloc[lay][OGRID(x, y, lay)] != node)
+       // if (NODELOC(x, y, lay) != (NODE)NULL &&
+       //	NODELOC(x, y, lay) != node)
        //    continue;
 
-       if (Nodesav[lay][OGRID(x, y, lay)] == (NODE)NULL ||
-			Nodesav[lay][OGRID(x, y, lay)] != node)
+       if (NODESAV(x, y, lay) == (NODE)NULL ||
+			NODESAV(x, y, lay) != node)
 	  continue;
 
        Pr = &Obs2[lay][OGRID(x, y, lay)];
@@ -455,7 +660,7 @@ int set_node_to_net(NODE node, int newflags, POINT *pushlist, SEG bbox, u_char s
 	  // push this point on the stack to process
 
 	  if (pushlist != NULL) {
-	     gpoint = (POINT)malloc(sizeof(struct point_));
+	     gpoint = allocPOINT();
 	     gpoint->x1 = x;
 	     gpoint->y1 = y;
 	     gpoint->layer = lay;
@@ -574,7 +779,7 @@ int set_route_to_net(NET net, ROUTE rt, int newflags, POINT *pushlist,
 		// push this point on the stack to process
 
 		if (pushlist != NULL) {
-	  	   gpoint = (POINT)malloc(sizeof(struct point_));
+	  	   gpoint = allocPOINT();
 	  	   gpoint->x1 = x;
 	  	   gpoint->y1 = y;
 	  	   gpoint->layer = lay;
@@ -593,7 +798,7 @@ int set_route_to_net(NET net, ROUTE rt, int newflags, POINT *pushlist,
 		// If we found another node connected to the route,
 		// then process it, too.
 
-		n2 = Nodeloc[lay][OGRID(x, y, lay)];
+		n2 = NODELOC(x, y, lay);
 		if ((n2 != (NODE)NULL) && (n2 != net->netnodes)) {
 		   if (newflags == PR_SOURCE) clear_target_node(n2);
 		   result = set_node_to_net(n2, newflags, pushlist, bbox, stage);
@@ -754,7 +959,7 @@ u_char ripup_net(NET net, u_char restore)
 		  // were routed over obstructions to reach off-grid
 		  // taps are returned to obstructions.
 
-	          if (Nodesav[lay][OGRID(x, y, lay)] == (NODE)NULL) {
+	          if (NODESAV(x, y, lay) == (NODE)NULL) {
 		     dir = Obs[lay][OGRID(x, y, lay)] & PINOBSTRUCTMASK;
 		     if (dir == 0)
 		        Obs[lay][OGRID(x, y, lay)] = 0;
@@ -810,7 +1015,7 @@ u_char ripup_net(NET net, u_char restore)
 	    lay = ntap->layer;
 	    x = ntap->gridx;
 	    y = ntap->gridy;
-	    Nodeloc[lay][OGRID(x, y, lay)] = Nodesav[lay][OGRID(x, y, lay)];
+	    SetNodeinfo(x, y, lay)->nodeloc = NODESAV(x, y, lay);
 	 }
       }
    }
@@ -827,6 +1032,7 @@ u_char ripup_net(NET net, u_char restore)
       }
       free(rt);
    }
+   net->flags &= ~NET_ROUTED;	// No longer has routes reused from ECO
 
    return TRUE;
 }
@@ -847,6 +1053,10 @@ u_char ripup_net(NET net, u_char restore)
 /*	those nets, add them to the "failed" stack, and re-	*/
 /*	route this one.						*/
 /*								*/
+/*	All step costs are positive and no planar step costs	*/
+/*	less than MIN(SegCost, JogCost), which is what makes	*/
+/*	the lower bound used by route_segs() admissible.	*/
+/*								*/
 /*  ARGS: none							*/
 /*  RETURNS: 1 if node needs to be (re)processed, 0 if not.	*/
 /*  SIDE EFFECTS: none (get this right or else)			*/
@@ -858,6 +1068,7 @@ int eval_pt(GRIDP *ept, u_char flags, u_char stage)
     NODE node;
     NETLIST nl;
     PROUTE *Pr, *Pt;
+    CONGEST *cg;
     GRIDP newpt;
 
     newpt = *ept;
@@ -888,8 +1099,8 @@ int eval_pt(GRIDP *ept, u_char flags, u_char stage)
     if (!(Pr->flags & (PR_COST | PR_SOURCE))) {
        // 2nd stage allows routes to cross existing routes
        if (stage && (Pr->prdata.net < MAXNETNUM)) {
-	  // if (Nodeloc[newpt.lay][OGRID(newpt.x, newpt.y, newpt.lay)] != NULL)
-	  if (Nodesav[newpt.lay][OGRID(newpt.x, newpt.y, newpt.lay)] != NULL)
+	  // if (NODELOC(newpt.x, newpt.y, newpt.lay) != NULL)
+	  if (NODESAV(newpt.x, newpt.y, newpt.lay) != NULL)
 	     return 0;			// But cannot route over terminals!
 
 	  // Is net k in the "noripup" list?  If so, don't route it */
@@ -917,7 +1128,7 @@ int eval_pt(GRIDP *ept, u_char flags, u_char stage)
     // so that routing over it could block it entirely.
 
     if (newpt.lay > 0) {
-	if ((node = Nodeloc[newpt.lay - 1][OGRID(newpt.x, newpt.y, newpt.lay - 1)])
+	if ((node = NODELOC(newpt.x, newpt.y, newpt.lay - 1))
 			!= (NODE)NULL) {
 	    Pt = &Obs2[newpt.lay - 1][OGRID(newpt.x, newpt.y, newpt.lay - 1)];
 	    if (!(Pt->flags & PR_TARGET) && !(Pt->flags & PR_SOURCE)) {
@@ -942,7 +1153,7 @@ int eval_pt(GRIDP *ept, u_char flags, u_char stage)
 	}
     }
     if (newpt.lay < Num_layers - 1) {
-	if ((node = Nodeloc[newpt.lay + 1][OGRID(newpt.x, newpt.y, newpt.lay + 1)])
+	if ((node = NODELOC(newpt.x, newpt.y, newpt.lay + 1))
 			!= (NODE)NULL) {
 	    Pt = &Obs2[newpt.lay + 1][OGRID(newpt.x, newpt.y, newpt.lay + 1)];
 	    if (!(Pt->flags & PR_TARGET) && !(Pt->flags & PR_SOURCE)) {
@@ -959,13 +1170,34 @@ int eval_pt(GRIDP *ept, u_char flags, u_char stage)
     if (ept->y != newpt.y) thiscost += (Vert[newpt.lay] * SegCost +
 			(1 - Vert[newpt.lay]) * JogCost);
 
+    // The route mask does not exclude positions from the search, but
+    // each step is charged the distance of the position from the
+    // "likely best route", so that the search stays inside the mask
+    // unless it is forced out of it.
+
+    thiscost += RMask[OGRID(newpt.x, newpt.y, 0)] * SegCost;
+
+    // During negotiated rip-up and reroute, positions taken by the
+    // tentative routes of other nets (at the present factor, which
+    // rises with each iteration), and positions that have been
+    // congested in earlier iterations, cost more.
+
+    if (Congest[newpt.lay] != NULL) {
+       cg = &Congest[newpt.lay][OGRID(newpt.x, newpt.y, newpt.lay)];
+       thiscost += cg->pres * PresFactor + cg->hist * HistCost;
+    }
+
     // Add the cost to the cost of the original position
     thiscost += ept->cost;
    
     // Replace node information if cost is minimum
 
+    // For 2nd stage routes.  While negotiating, a net in Obs[] is
+    // an occupant of the position like any tentative route, and
+    // costs no less.
+
     if (Pr->flags & PR_CONFLICT)
-       thiscost += ConflictCost;	// For 2nd stage routes
+       thiscost += MAX(ConflictCost, PresFactor);
 
     if (thiscost < Pr->prdata.cost) {
        Pr->flags &= ~PR_PRED_DMASK;
@@ -1055,7 +1287,7 @@ void writeback_segment(SEG seg, int netnum)
 	 sobs = Obs[layer][OGRID(seg->x1 + 1, seg->y1, layer)];
 	 if ((sobs & OFFSET_TAP) && !(sobs & ROUTED_NET)) {
 	    if (sobs & STUBROUTE_EW) {
-	       dist = Stub[layer][OGRID(seg->x1 + 1, seg->y1, layer)];
+	       dist = STUBDIST(seg->x1 + 1, seg->y1, layer);
 	       if (dist > 0) {
 		  Obs[layer][OGRID(seg->x1 + 1, seg->y1, layer)] |=
 			(NO_NET | ROUTED_NET);
@@ -1067,7 +1299,7 @@ void writeback_segment(SEG seg, int netnum)
 	 sobs = Obs[layer][OGRID(seg->x1 - 1, seg->y1, layer)];
 	 if ((sobs & OFFSET_TAP) && !(sobs & ROUTED_NET)) {
 	    if (sobs & STUBROUTE_EW) {
-	       dist = Stub[layer][OGRID(seg->x1 - 1, seg->y1, layer)];
+	       dist = STUBDIST(seg->x1 - 1, seg->y1, layer);
 	       if (dist < 0) {
 		  Obs[layer][OGRID(seg->x1 - 1, seg->y1, layer)] |=
 			(NO_NET | ROUTED_NET);
@@ -1079,7 +1311,7 @@ void writeback_segment(SEG seg, int netnum)
 	 sobs = Obs[layer][OGRID(seg->x1, seg->y1 + 1, layer)];
 	 if ((sobs & OFFSET_TAP) && !(sobs & ROUTED_NET)) {
 	    if (sobs & STUBROUTE_NS) {
-	       dist = Stub[layer][OGRID(seg->x1, seg->y1 + 1, layer)];
+	       dist = STUBDIST(seg->x1, seg->y1 + 1, layer);
 	       if (dist > 0) {
 		  Obs[layer][OGRID(seg->x1, seg->y1 + 1, layer)] |=
 			(NO_NET | ROUTED_NET);
@@ -1091,7 +1323,7 @@ void writeback_segment(SEG seg, int netnum)
 	 sobs = Obs[layer][OGRID(seg->x1, seg->y1 - 1, layer)];
 	 if ((sobs & OFFSET_TAP) && !(sobs & ROUTED_NET)) {
 	    if (sobs & STUBROUTE_NS) {
-	       dist = Stub[layer][OGRID(seg->x1, seg->y1 - 1, layer)];
+	       dist = STUBDIST(seg->x1, seg->y1 - 1, layer);
 	       if (dist < 0) {
 		  Obs[layer][OGRID(seg->x1, seg->y1 - 1, layer)] |=
 			(NO_NET | ROUTED_NET);
@@ -1107,7 +1339,7 @@ void writeback_segment(SEG seg, int netnum)
 
       sobs = Obs[seg->layer][OGRID(seg->x1, seg->y1, seg->layer)];
       if (sobs & OFFSET_TAP) {
-	 dist = Stub[layer][OGRID(seg->x1, seg->y1, seg->layer)];
+	 dist = STUBDIST(seg->x1, seg->y1, layer);
 	 if (sobs & STUBROUTE_EW) {
 	    if ((dist > 0) && (seg->x1 < (NumChannelsX[seg->layer] - 1))) {
 	       Obs[seg->layer][OGRID(seg->x1 + 1, seg->y1, seg->layer)] |=
@@ -1173,6 +1405,25 @@ void writeback_segment(SEG seg, int netnum)
    }
 }
 
+/*--------------------------------------------------------------*/
+/* stack_proute - return the Obs2[] entry at a position that	*/
+/*		may take a contact moved out of an illegal	*/
+/*		stack.  Positions outside of the route window	*/
+/*		(which a thread's copy of Obs2[] does not	*/
+/*		cover) return an entry that has no route and	*/
+/*		no net, so they are never taken.		*/
+/*--------------------------------------------------------------*/
+
+static PROUTE OffWindow = {0, {(u_int)(-1)}};
+
+static PROUTE *stack_proute(int x, int y, int lay)
+{
+   if ((x < RouteWindow.x1) || (x > RouteWindow.x2) ||
+		(y < RouteWindow.y1) || (y > RouteWindow.y2))
+      return &OffWindow;
+   return &Obs2[lay][OGRID(x, y, lay)];
+}
+
 /*--------------------------------------------------------------*/
 /* commit_proute - turn the potential route into an actual	*/
 /*		route by generating the route segments		*/
@@ -1218,7 +1469,7 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
    // Generate an indexed route, recording the series of predecessors and their
    // positions.
 
-   lrtop = (POINT)malloc(sizeof(struct point_));
+   lrtop = allocPOINT();
    lrtop->x1 = ept->x;
    lrtop->y1 = ept->y;
    lrtop->layer = ept->lay;
@@ -1231,7 +1482,7 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
       dmask = Pr->flags & PR_PRED_DMASK;
       if (dmask == PR_PRED_NONE) break;
 
-      newlr = (POINT)malloc(sizeof(struct point_));
+      newlr = allocPOINT();
       newlr->x1 = lrend->x1;
       newlr->y1 = lrend->y1;
       newlr->layer = lrend->layer;
@@ -1306,7 +1557,7 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 	       // lowest cost, and make sure the position below that
 	       // is available.
 	       dx = cx + 1;	// Check to the right
-	       pri = &Obs2[cl][OGRID(dx, cy, cl)];
+	       pri = stack_proute(dx, cy, cl);
 	       pflags = pri->flags;
 	       cost = pri->prdata.cost;
 	       if (collide && !(pflags & (PR_COST | PR_SOURCE)) &&
@@ -1317,7 +1568,7 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 	       if (pflags & PR_COST) {
 		  pflags &= ~PR_COST;
 		  if ((pflags & PR_PRED_DMASK) != PR_PRED_NONE && cost < mincost) {
-	             pri2 = &Obs2[dl][OGRID(dx, cy, dl)];
+	             pri2 = stack_proute(dx, cy, dl);
 		     p2flags = pri2->flags;
 		     if (p2flags & PR_COST) {
 			p2flags &= ~PR_COST;
@@ -1338,7 +1589,7 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 		  }
 	       }
 	       dx = cx - 1;	// Check to the left
-	       pri = &Obs2[cl][OGRID(dx, cy, cl)];
+	       pri = stack_proute(dx, cy, cl);
 	       pflags = pri->flags;
 	       cost = pri->prdata.cost;
 	       if (collide && !(pflags & (PR_COST | PR_SOURCE)) &&
@@ -1349,7 +1600,7 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 	       if (pflags & PR_COST) {
 		  pflags &= ~PR_COST;
 		  if ((pflags & PR_PRED_DMASK) != PR_PRED_NONE && cost < mincost) {
-	             pri2 = &Obs2[dl][OGRID(dx, cy, dl)];
+	             pri2 = stack_proute(dx, cy, dl);
 		     p2flags = pri2->flags;
 		     if (p2flags & PR_COST) {
 			p2flags &= ~PR_COST;
@@ -1371,7 +1622,7 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 	       }
 
 	       dy = cy + 1;	// Check north
-	       pri = &Obs2[cl][OGRID(cx, dy, cl)];
+	       pri = stack_proute(cx, dy, cl);
 	       pflags = pri->flags;
 	       cost = pri->prdata.cost;
 	       if (collide && !(pflags & (PR_COST | PR_SOURCE)) &&
@@ -1382,7 +1633,7 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 	       if (pflags & PR_COST) {
 		  pflags &= ~PR_COST;
 		  if ((pflags & PR_PRED_DMASK) != PR_PRED_NONE && cost < mincost) {
-	             pri2 = &Obs2[dl][OGRID(cx, dy, dl)];
+	             pri2 = stack_proute(cx, dy, dl);
 		     p2flags = pri2->flags;
 		     if (p2flags & PR_COST) {
 			p2flags &= ~PR_COST;
@@ -1404,7 +1655,7 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 	       }
 
 	       dy = cy - 1;	// Check south
-	       pri = &Obs2[cl][OGRID(cx, dy, cl)];
+	       pri = stack_proute(cx, dy, cl);
 	       pflags = pri->flags;
 	       cost = pri->prdata.cost;
 	       if (collide && !(pflags & (PR_COST | PR_SOURCE)) &&
@@ -1415,7 +1666,7 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 	       if (pflags & PR_COST) {
 		  pflags &= ~PR_COST;
 		  if (pflags & PR_PRED_DMASK != PR_PRED_NONE && cost < mincost) {
-	             pri2 = &Obs2[dl][OGRID(cx, dy, dl)];
+	             pri2 = stack_proute(cx, dy, dl);
 		     p2flags = pri2->flags;
 		     if (p2flags & PR_COST) {
 		        p2flags &= ~PR_COST;
@@ -1443,14 +1694,14 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 	       if (mincost < MAXRT) {
 	          pri = &Obs2[cl][OGRID(minx, miny, cl)];
 
-		  newlr = (POINT)malloc(sizeof(struct point_));
+		  newlr = allocPOINT();
 		  newlr->x1 = minx;
 		  newlr->y1 = miny;
 		  newlr->layer = cl;
 
 	          pri2 = &Obs2[dl][OGRID(minx, miny, dl)];
 
-		  newlr2 = (POINT)malloc(sizeof(struct point_));
+		  newlr2 = allocPOINT();
 		  newlr2->x1 = minx;
 		  newlr2->y1 = miny;
 		  newlr2->layer = dl;
@@ -1465,8 +1716,8 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 		     if (lrnext->x1 == minx && lrnext->y1 == miny &&
 				lrnext->layer == dl) {
 			newlr->next = lrnext;
-			free(lrppre);
-			free(newlr2);
+			freePOINT(lrppre);
+			freePOINT(newlr2);
 			lrppre = lrnext;	// ?
 		     }
 		     else
@@ -1489,13 +1740,13 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 	          dl = lrprev->layer;
 
 	          dx = cx + 1;	// Check to the right
-	          pri = &Obs2[cl][OGRID(dx, cy, cl)];
+	          pri = stack_proute(dx, cy, cl);
 	          pflags = pri->flags;
 		  if (pflags & PR_COST) {
 		     pflags &= ~PR_COST;
 		     if ((pflags & PR_PRED_DMASK) != PR_PRED_NONE &&
 				pri->prdata.cost < mincost) {
-	                pri2 = &Obs2[dl][OGRID(dx, cy, dl)];
+	                pri2 = stack_proute(dx, cy, dl);
 		        p2flags = pri2->flags;
 			if (p2flags & PR_COST) {
 			   p2flags &= ~PR_COST;
@@ -1510,13 +1761,13 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 	          }
 
 	          dx = cx - 1;	// Check to the left
-	          pri = &Obs2[cl][OGRID(dx, cy, cl)];
+	          pri = stack_proute(dx, cy, cl);
 	          pflags = pri->flags;
 		  if (pflags & PR_COST) {
 		     pflags &= ~PR_COST;
 		     if ((pflags & PR_PRED_DMASK) != PR_PRED_NONE &&
 				pri->prdata.cost < mincost) {
-	                pri2 = &Obs2[dl][OGRID(dx, cy, dl)];
+	                pri2 = stack_proute(dx, cy, dl);
 		        p2flags = pri2->flags;
 			if (p2flags & PR_COST) {
 			   p2flags &= ~PR_COST;
@@ -1531,13 +1782,13 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 	          }
 
 	          dy = cy + 1;	// Check north
-	          pri = &Obs2[cl][OGRID(cx, dy, cl)];
+	          pri = stack_proute(cx, dy, cl);
 	          pflags = pri->flags;
 		  if (pflags & PR_COST) {
 		     pflags &= ~PR_COST;
 		     if ((pflags & PR_PRED_DMASK) != PR_PRED_NONE &&
 				pri->prdata.cost < mincost) {
-	                pri2 = &Obs2[dl][OGRID(cx, dy, dl)];
+	                pri2 = stack_proute(cx, dy, dl);
 		        p2flags = pri2->flags;
 			if (p2flags & PR_COST) {
 			   p2flags &= ~PR_COST;
@@ -1552,13 +1803,13 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 	          }
 
 	          dy = cy - 1;	// Check south
-	          pri = &Obs2[cl][OGRID(cx, dy, cl)];
+	          pri = stack_proute(cx, dy, cl);
 	          pflags = pri->flags;
 		  if (pflags & PR_COST) {
 		     pflags &= ~PR_COST;
 		     if ((pflags & PR_PRED_DMASK) != PR_PRED_NONE &&
 				pri->prdata.cost < mincost) {
-	                pri2 = &Obs2[dl][OGRID(cx, dy, dl)];
+	                pri2 = stack_proute(cx, dy, dl);
 		        p2flags = pri2->flags;
 			if (p2flags & PR_COST) {
 			   p2flags &= ~PR_COST;
@@ -1573,12 +1824,12 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 	          }
 
 		  if (mincost < MAXRT) {
-		     newlr = (POINT)malloc(sizeof(struct point_));
+		     newlr = allocPOINT();
 		     newlr->x1 = minx;
 		     newlr->y1 = miny;
 		     newlr->layer = cl;
 
-		     newlr2 = (POINT)malloc(sizeof(struct point_));
+		     newlr2 = allocPOINT();
 		     newlr2->x1 = minx;
 		     newlr2->y1 = miny;
 		     newlr2->layer = dl;
@@ -1596,7 +1847,7 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 				(pri2->flags & PR_TARGET)) && (lrcur == lrtop)) {
 			lrtop = newlr;
 			lrend = newlr;
-			free(lrcur);
+			freePOINT(lrcur);
 			lrcur = newlr;
 		     }
 		     else
@@ -1610,8 +1861,8 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 		     if (lrppre->x1 == minx && lrppre->y1 == miny &&
 				lrppre->layer == dl) {
 			newlr->next = lrppre;
-			free(lrprev);
-			free(newlr2);
+			freePOINT(lrprev);
+			freePOINT(newlr2);
 			lrprev = lrcur;
 		     }
 		     else
@@ -1816,7 +2067,7 @@ int commit_proute(ROUTE rt, GRIDP *ept, u_char stage)
 	 // Clean up allocated memory for the route. . .
 	 while (lrtop != NULL) {
 	    lrnext = lrtop->next;
-	    free(lrtop);
+	    freePOINT(lrtop);
 	    lrtop = lrnext;
 	 }
 	 return rval;	// Success
@@ -1828,7 +2079,7 @@ cleanup:
 
    while (lrtop != NULL) {
       lrnext = lrtop->next;
-      free(lrtop);
+      freePOINT(lrtop);
       lrtop = lrnext;
    }
    return 0;
@@ -22,6 +22,14 @@ NETLIST find_colliding(NET net);
 void    clear_non_source_targets(NET net, POINT *pushlist);
 int     count_targets(NET net);
 
+POINT   allocPOINT();
+void    freePOINT(POINT gpoint);
+void    gheap_push(GRIDP *ept, u_int bound);
+int     gheap_pop(GRIDP *ept);
+int     gheap_key(u_int *key);
+void    gheap_drain(POINT *pushlist);
+void    free_search_memory();
+
 
 #define MAZE_H
 #endif 
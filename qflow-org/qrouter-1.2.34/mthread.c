@@ -0,0 +1,474 @@
+/*--------------------------------------------------------------*/
+/* mthread.c -- parallel routing for the first stage.		*/
+/*								*/
+/* Nets are taken in the order given by create_netorder() and	*/
+/* gathered into batches of nets whose route areas (the area	*/
+/* of all the net's taps, plus a halo) do not touch.  Each net	*/
+/* of a batch is routed by a worker thread with the search	*/
+/* confined to the net's route area, using the thread's own	*/
+/* copy of Obs2[] covering only that area.  Because the areas	*/
+/* of a batch are disjoint, the route of each net depends only	*/
+/* on the nets routed in earlier batches, so the result does	*/
+/* not depend on the number of worker threads or on the order	*/
+/* in which they finish.  It does differ from the result of	*/
+/* routing with a single thread (dofirststage()), which routes	*/
+/* every net in order with the whole grid open to the search.	*/
+/* All reporting, failure handling, and routing of power buses	*/
+/* and of nets that do not fit inside their route area is done	*/
+/* by the main thread, in net order, after each batch.		*/
+/*--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
+#include "qrouter.h"
+#include "qconfig.h"
+#include "node.h"
+#include "maze.h"
+
+THREAD_LOCAL u_char WorkerThread = FALSE;
+
+#ifdef HAVE_PTHREADS
+
+/* Ways that a net in a batch is handled */
+
+#define JOB_NONE	0	// Nothing to route
+#define JOB_PARALLEL	1	// Route in a worker thread
+#define JOB_SERIAL	2	// Route in the main thread, after the batch
+#define JOB_DONE	3	// Net has been taken into a batch
+
+/* Maximum number of nets passed over while gathering a batch */
+#define BATCH_LOOKAHEAD	(4 * MAX_BATCH)
+
+typedef struct routejob_ *ROUTEJOB;
+
+struct routejob_ {
+   NET net;
+   u_char mode;		// JOB_NONE, JOB_PARALLEL, or JOB_SERIAL
+   u_char failed;	// TRUE if a route failed inside the area
+   int result;		// return value of doroute()
+   int routes;		// number of routes completed
+   struct seg_ area;	// grid area open to the search
+};
+
+static struct routejob_ Jobs[MAX_BATCH];
+static int NumJobs = 0;		// Number of jobs in the current batch
+static int NextJob = 0;		// Next job to be taken by a worker
+static int JobsDone = 0;	// Number of jobs finished
+
+static pthread_t *Workers = NULL;
+static int NumWorkers = 0;
+static u_char WorkersQuit = FALSE;
+
+static pthread_mutex_t JobLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t JobReady = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t JobDone = PTHREAD_COND_INITIALIZER;
+
+/* Per-thread storage for the part of Obs2[] inside the route	*/
+/* area, and for the route mask.				*/
+
+static THREAD_LOCAL PROUTE *Band[MAX_LAYERS];
+static THREAD_LOCAL int BandSize[MAX_LAYERS];
+static THREAD_LOCAL int MaskSize = 0;
+
+/*--------------------------------------------------------------*/
+/* net_route_area() ---						*/
+/*								*/
+/* Find the area of the grid to which the search for routes of	*/
+/* "net" will be confined:  The extent of all tap points and	*/
+/* existing routes of the net, plus a halo of "Numpasses"	*/
+/* tracks, which is the extent of the route mask.  Return 0 if	*/
+/* the net cannot be routed inside an area (power buses, or	*/
+/* taps outside of the grid common to all layers), 1 otherwise.	*/
+/*--------------------------------------------------------------*/
+
+static int net_route_area(NET net, SEG area)
+{
+   NODE node;
+   DPOINT ntap;
+   ROUTE rt;
+   SEG seg;
+   int i, pass, maxx, maxy;
+
+   if ((net->netnum == VDD_NET) || (net->netnum == GND_NET)) return 0;
+
+   maxx = NumChannelsX[0] - 1;
+   maxy = NumChannelsY[0] - 1;
+   for (i = 1; i < Num_layers; i++) {
+      if (NumChannelsX[i] - 1 < maxx) maxx = NumChannelsX[i] - 1;
+      if (NumChannelsY[i] - 1 < maxy) maxy = NumChannelsY[i] - 1;
+   }
+
+   area->x1 = net->xmin;
+   area->x2 = net->xmax;
+   area->y1 = net->ymin;
+   area->y2 = net->ymax;
+
+   for (node = net->netnodes; node; node = node->next) {
+      for (pass = 0; pass < 2; pass++) {
+	 ntap = (pass == 0) ? node->taps : node->extend;
+	 for (; ntap; ntap = ntap->next) {
+	    if (ntap->gridx < area->x1) area->x1 = ntap->gridx;
+	    if (ntap->gridx > area->x2) area->x2 = ntap->gridx;
+	    if (ntap->gridy < area->y1) area->y1 = ntap->gridy;
+	    if (ntap->gridy > area->y2) area->y2 = ntap->gridy;
+	 }
+      }
+   }
+   for (rt = net->routes; rt; rt = rt->next) {
+      for (seg = rt->segments; seg; seg = seg->next) {
+	 if (seg->x1 < area->x1) area->x1 = seg->x1;
+	 if (seg->x2 < area->x1) area->x1 = seg->x2;
+	 if (seg->x1 > area->x2) area->x2 = seg->x1;
+	 if (seg->x2 > area->x2) area->x2 = seg->x2;
+	 if (seg->y1 < area->y1) area->y1 = seg->y1;
+	 if (seg->y2 < area->y1) area->y1 = seg->y2;
+	 if (seg->y1 > area->y2) area->y2 = seg->y1;
+	 if (seg->y2 > area->y2) area->y2 = seg->y2;
+      }
+   }
+   if ((area->x1 < 0) || (area->y1 < 0) || (area->x2 > maxx) ||
+		(area->y2 > maxy))
+      return 0;
+
+   area->x1 = MAX(area->x1 - Numpasses, 0);
+   area->y1 = MAX(area->y1 - Numpasses, 0);
+   area->x2 = MIN(area->x2 + Numpasses, maxx);
+   area->y2 = MIN(area->y2 + Numpasses, maxy);
+   return 1;
+}
+
+/*--------------------------------------------------------------*/
+/* areas_touch() ---						*/
+/*								*/
+/* Return TRUE if two route areas overlap or are too close.	*/
+/* Writing a route back to Obs[] may modify positions one track	*/
+/* outside of the route area (see writeback_segment()), so the	*/
+/* guard tracks of two areas in the same batch must not be the	*/
+/* same track:  The areas must be at least two tracks apart.	*/
+/*--------------------------------------------------------------*/
+
+static u_char areas_touch(SEG a, SEG b)
+{
+   if (a->x1 > b->x2 + 2 || b->x1 > a->x2 + 2) return FALSE;
+   if (a->y1 > b->y2 + 2 || b->y1 > a->y2 + 2) return FALSE;
+   return TRUE;
+}
+
+/*--------------------------------------------------------------*/
+/* set_route_area() ---						*/
+/*								*/
+/* Confine the route search of the calling thread to "area".	*/
+/* The thread's copy of Obs2[] holds only the rows of grid	*/
+/* tiles covering the area, but is offset so that it can be	*/
+/* indexed with OGRID() like the full array.  The route mask is	*/
+/* kept full size, as the mask generation is not limited to	*/
+/* the route area.						*/
+/*--------------------------------------------------------------*/
+
+static void set_route_area(SEG area)
+{
+   int i, size;
+
+   RouteWindow.x1 = area->x1;
+   RouteWindow.y1 = area->y1;
+   RouteWindow.x2 = area->x2;
+   RouteWindow.y2 = area->y2;
+
+   for (i = 0; i < Num_layers; i++) {
+      size = ((area->y2 >> GRID_TILE_SHIFT) - (area->y1 >> GRID_TILE_SHIFT)
+		+ 1) * GRID_PAD(NumChannelsX[i]) * GRID_TILE;
+      if (size > BandSize[i]) {
+	 free(Band[i]);
+	 Band[i] = (PROUTE *)malloc(size * sizeof(PROUTE));
+	 if (Band[i] == NULL) {
+	    fprintf(stderr, "Out of memory 12.\n");
+	    exit(12);
+	 }
+	 BandSize[i] = size;
+      }
+      Obs2[i] = Band[i] - OGRID(0, area->y1 & ~GRID_TILE_MASK, i);
+   }
+
+   size = GRIDSIZE(0);
+   if (size != MaskSize) {
+      free(RMask);
+      RMask = (u_char *)malloc(size * sizeof(u_char));
+      if (RMask == NULL) {
+	 fprintf(stderr, "Out of memory 12.\n");
+	 exit(12);
+      }
+      MaskSize = size;
+   }
+}
+
+/*--------------------------------------------------------------*/
+/* route_job() ---						*/
+/*								*/
+/* Route one net in a worker thread.  Failures are recorded in	*/
+/* the job and left for the main thread to handle.		*/
+/*--------------------------------------------------------------*/
+
+static void route_job(ROUTEJOB job)
+{
+   NETLIST nl;
+
+   set_route_area(&job->area);
+
+   FailedNets = (NETLIST)NULL;
+   TotalRoutes = 0;
+
+   job->result = doroute(job->net, (u_char)0, (u_char)0);
+   job->routes = TotalRoutes;
+   job->failed = (FailedNets != (NETLIST)NULL) ? TRUE : FALSE;
+
+   while (FailedNets) {
+      nl = FailedNets->next;
+      free(FailedNets);
+      FailedNets = nl;
+   }
+}
+
+/*--------------------------------------------------------------*/
+/* route_worker() ---						*/
+/*								*/
+/* Main loop of a worker thread:  Take jobs from the current	*/
+/* batch until the batch is exhausted, then wait for the next.	*/
+/*--------------------------------------------------------------*/
+
+static void *route_worker(void *arg)
+{
+   int i, j;
+
+   WorkerThread = TRUE;
+
+   pthread_mutex_lock(&JobLock);
+   while (1) {
+      while (!WorkersQuit && (NextJob >= NumJobs))
+	 pthread_cond_wait(&JobReady, &JobLock);
+      if (WorkersQuit) break;
+
+      j = NextJob++;
+      pthread_mutex_unlock(&JobLock);
+
+      if (Jobs[j].mode == JOB_PARALLEL) route_job(&Jobs[j]);
+
+      pthread_mutex_lock(&JobLock);
+      if (++JobsDone == NumJobs) pthread_cond_signal(&JobDone);
+   }
+   pthread_mutex_unlock(&JobLock);
+
+   // Release the memory held by this thread
+
+   for (i = 0; i < MAX_LAYERS; i++) {
+      free(Band[i]);
+      Band[i] = NULL;
+      BandSize[i] = 0;
+   }
+   free(RMask);
+   RMask = NULL;
+   MaskSize = 0;
+   free_search_memory();
+
+   return NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* stop_workers() ---						*/
+/*--------------------------------------------------------------*/
+
+static void stop_workers()
+{
+   int i;
+
+   pthread_mutex_lock(&JobLock);
+   WorkersQuit = TRUE;
+   pthread_cond_broadcast(&JobReady);
+   pthread_mutex_unlock(&JobLock);
+
+   for (i = 0; i < NumWorkers; i++)
+      pthread_join(Workers[i], NULL);
+
+   free(Workers);
+   Workers = NULL;
+   NumWorkers = 0;
+   WorkersQuit = FALSE;
+}
+
+/*--------------------------------------------------------------*/
+/* start_workers() ---						*/
+/*								*/
+/* Make sure that there are "Numthreads" worker threads.  The	*/
+/* threads are kept between calls.  Return the number of	*/
+/* threads running.						*/
+/*--------------------------------------------------------------*/
+
+static int start_workers()
+{
+   if (NumWorkers == Numthreads) return NumWorkers;
+   if (NumWorkers > 0) stop_workers();
+
+   NumJobs = NextJob = JobsDone = 0;
+
+   Workers = (pthread_t *)malloc(Numthreads * sizeof(pthread_t));
+   for (NumWorkers = 0; NumWorkers < Numthreads; NumWorkers++) {
+      if (pthread_create(&Workers[NumWorkers], NULL, route_worker, NULL) != 0) {
+	 Fprintf(stderr, "Unable to start route thread %d.\n", NumWorkers + 1);
+	 break;
+      }
+   }
+   return NumWorkers;
+}
+
+/*--------------------------------------------------------------*/
+/* dofirststage_parallel() ---					*/
+/*								*/
+/* Route all nets in the first stage using "Numthreads" worker	*/
+/* threads.  Reporting is the same as for dofirststage(), and	*/
+/* the count of nets remaining is updated in "remaining".	*/
+/* Returns the number of batches routed, or -1 if no threads	*/
+/* could be started, in which case nothing has been routed.	*/
+/*--------------------------------------------------------------*/
+
+int dofirststage_parallel(int *remaining)
+{
+   ROUTEJOB job;
+   NET net;
+   struct seg_ *areas;
+   u_char *mode;
+   int *waiting;
+   int i, j, k, n, w, first, result, lastlayer, batches, parnets;
+
+   if (start_workers() == 0) return -1;
+
+   // Find how each net is to be routed, and its route area
+
+   areas = (struct seg_ *)malloc(Numnets * sizeof(struct seg_));
+   mode = (u_char *)malloc(Numnets * sizeof(u_char));
+   waiting = (int *)malloc(BATCH_LOOKAHEAD * sizeof(int));
+
+   for (i = 0; i < Numnets; i++) {
+      net = getnettoroute(i);
+      if ((net == NULL) || (net->netnodes == NULL))
+	 mode[i] = JOB_NONE;
+      else if (net_route_area(net, &areas[i]))
+	 mode[i] = JOB_PARALLEL;
+      else
+	 mode[i] = JOB_SERIAL;
+   }
+
+   batches = parnets = 0;
+   first = 0;
+
+   while (first < Numnets) {
+
+      // Gather a batch of nets whose route areas do not touch.  A net
+      // may be taken ahead of its turn only if its area does not touch
+      // the area of any net before it that is still waiting, so nets
+      // that interact are always routed in the order given.  A net
+      // that must be routed in the main thread ends the batch, so
+      // that it is routed after all of the nets before it.
+
+      n = w = 0;
+      for (i = first; (i < Numnets) && (n < MAX_BATCH); i++) {
+	 if (mode[i] == JOB_DONE) continue;
+
+	 if (mode[i] == JOB_PARALLEL) {
+	    for (j = 0; j < n; j++)
+	       if ((Jobs[j].mode == JOB_PARALLEL) &&
+			areas_touch(&Jobs[j].area, &areas[i]))
+		  break;
+	    k = w;
+	    if (j == n)
+	       for (k = 0; k < w; k++)
+		  if (areas_touch(&areas[waiting[k]], &areas[i]))
+		     break;
+	    if ((j < n) || (k < w)) {
+	       if (w == BATCH_LOOKAHEAD) break;
+	       waiting[w++] = i;
+	       continue;
+	    }
+	 }
+	 else if ((mode[i] == JOB_SERIAL) && ((n > 0) || (w > 0)))
+	    break;
+
+	 job = &Jobs[n++];
+	 job->net = getnettoroute(i);
+	 job->mode = mode[i];
+	 job->failed = FALSE;
+	 if (mode[i] == JOB_PARALLEL) job->area = areas[i];
+	 mode[i] = JOB_DONE;
+
+	 if (job->mode == JOB_SERIAL) break;
+      }
+      while ((first < Numnets) && (mode[first] == JOB_DONE)) first++;
+
+      // Route the batch
+
+      pthread_mutex_lock(&JobLock);
+      NumJobs = n;
+      NextJob = 0;
+      JobsDone = 0;
+      pthread_cond_broadcast(&JobReady);
+      while (JobsDone < NumJobs)
+	 pthread_cond_wait(&JobDone, &JobLock);
+      pthread_mutex_unlock(&JobLock);
+
+      batches++;
+
+      // Collect the results in order
+
+      for (j = 0; j < n; j++) {
+	 job = &Jobs[j];
+	 switch (job->mode) {
+	    case JOB_NONE:
+	       if (job->net && (Verbose > 0))
+		  Fprintf(stdout, "Nothing to do for net %s\n", job->net->netname);
+	       (*remaining)--;
+	       break;
+
+	    case JOB_PARALLEL:
+	       parnets++;
+	       TotalRoutes += job->routes;
+	       lastlayer = -1;
+	       draw_net(job->net, TRUE, &lastlayer);
+	       if (!job->failed) {
+		  stage1_result(job->net, job->result, remaining);
+		  break;
+	       }
+
+	       // The net could not be completed inside its route area.
+	       // Finish it here with the whole grid open to the search.
+
+	       if (Verbose > 1)
+		  Fprintf(stdout, "Net %s did not route inside its area, "
+			"retrying.\n", job->net->netname);
+	       /* fall through */
+
+	    case JOB_SERIAL:
+	       result = doroute(job->net, (u_char)0, (u_char)0);
+	       stage1_result(job->net, result, remaining);
+	       break;
+	 }
+      }
+   }
+
+   free(areas);
+   free(mode);
+   free(waiting);
+
+   if (Verbose > 0)
+      Fprintf(stdout, "Routed %d nets in parallel in %d batches "
+		"using %d threads.\n", parnets, batches, NumWorkers);
+
+   return batches;
+}
+
+#endif /* HAVE_PTHREADS */
+
+/* end of mthread.c */
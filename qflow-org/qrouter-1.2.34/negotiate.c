@@ -0,0 +1,483 @@
+/*--------------------------------------------------------------*/
+/* negotiate.c -- negotiated congestion rip-up and reroute.	*/
+/*								*/
+/* This is an alternative to the one-net-at-a-time rip-up and	*/
+/* reroute of the second stage, in the manner of PathFinder.	*/
+/* Instead of routing a failed net over the nets in its way	*/
+/* and then ripping those nets up for good, all nets that are	*/
+/* in contention are given tentative routes which may share	*/
+/* grid positions with each other.  In each iteration, every	*/
+/* net in contention is ripped up and rerouted against the	*/
+/* others.  Each use of a position by another net costs the	*/
+/* "present" factor, which rises from one iteration to the	*/
+/* next, and each past iteration in which the position was	*/
+/* congested costs the "history" factor (HistCost), so that	*/
+/* the nets which have an alternative give up the contested	*/
+/* positions to the nets which do not.  No tentative route is	*/
+/* written into Obs[] while negotiating.			*/
+/*								*/
+/* Nets routed in Obs[] that the tentative routes cross join	*/
+/* the negotiation.  After each iteration, the nets whose	*/
+/* routes share no position with any other net are legal, and	*/
+/* the iteration with the fewest nets left in contention is	*/
+/* kept as a snapshot.  The state on entry is the first	*/
+/* snapshot, so negotiating never ends with more failing nets	*/
+/* than it started with.  When done, the legal routes of the	*/
+/* snapshot are written into Obs[], and the other nets of the	*/
+/* snapshot are returned to FailedNets for the regular second	*/
+/* stage to finish.						*/
+/*								*/
+/* The congestion costs are kept in the array Congest[], next	*/
+/* to Obs[], which only exists while negotiating, so the cost	*/
+/* function of the search is unchanged otherwise.		*/
+/*--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "qrouter.h"
+#include "qconfig.h"
+#include "node.h"
+#include "maze.h"
+
+CONGEST *Congest[MAX_LAYERS];	// Only allocated while negotiating
+int PresFactor = 0;		// Cost of each other net using a position
+
+#define CONGEST_MARK	0x80	// Position already counted for this net
+#define CONGEST_PRES	0x7f	// Mask for the number of tentative routes
+#define CONGEST_GROWTH	3	// Present cost rises by 3/2 per iteration
+#define CONGEST_STALL	5	// Give up after this many iterations
+				// without reducing the nets in contention
+
+/* A net taking part in the negotiation */
+
+typedef struct negnet_ *NEGNET;
+
+struct negnet_ {
+   NET net;
+   ROUTE saved;		// routes of the net in the best snapshot
+   u_char complete;	// saved routes are a complete route of the net
+   u_char failed;	// net is in contention in the best snapshot
+   u_char legal;	// tentative route shares no position
+   u_char unroutable;	// net cannot be routed at all
+};
+
+/*--------------------------------------------------------------*/
+/* route_usage() ---						*/
+/*								*/
+/* Add "delta" (+1, 0, or -1) to the number of tentative routes	*/
+/* at each grid position used by the routes of "net".  Each	*/
+/* position is counted once, although route segments share	*/
+/* their end points.						*/
+/*								*/
+/* Return the number of positions which the routes of "net"	*/
+/* share with the tentative routes of other nets or with the	*/
+/* routes of other nets already in Obs[].			*/
+/*--------------------------------------------------------------*/
+
+static int route_usage(NET net, int delta)
+{
+   ROUTE rt;
+   SEG seg;
+   CONGEST *cg;
+   int pass, lay, x, y, orignet, shared = 0;
+
+   // Pass 0 counts the positions and marks them, pass 1 removes
+   // the marks.
+
+   for (pass = 0; pass < 2; pass++) {
+      for (rt = net->routes; rt; rt = rt->next) {
+	 for (seg = rt->segments; seg; seg = seg->next) {
+	    lay = seg->layer;
+	    x = seg->x1;
+	    y = seg->y1;
+	    while (1) {
+	       cg = &Congest[lay][OGRID(x, y, lay)];
+	       if (pass == 1)
+		  cg->pres &= ~CONGEST_MARK;
+	       else if (!(cg->pres & CONGEST_MARK)) {
+		  if ((delta > 0) && ((cg->pres & CONGEST_PRES) < CONGEST_PRES))
+		     cg->pres++;
+		  else if ((delta < 0) && ((cg->pres & CONGEST_PRES) > 0))
+		     cg->pres--;
+		  if ((delta >= 0) && (cg->pres > 1)) shared++;
+		  cg->pres |= CONGEST_MARK;
+
+		  orignet = Obs[lay][OGRID(x, y, lay)] & NETNUM_MASK;
+		  if ((orignet != net->netnum) && (orignet > 0) &&
+				(orignet < MAXNETNUM))
+		     shared++;
+	       }
+	       if ((x == seg->x2) && (y == seg->y2)) break;
+
+	       if (x < seg->x2) x++;
+	       else if (x > seg->x2) x--;
+	       if (y < seg->y2) y++;
+	       else if (y > seg->y2) y--;
+	    }
+	 }
+      }
+   }
+   return shared;
+}
+
+/*--------------------------------------------------------------*/
+/* free_routes() ---						*/
+/*								*/
+/* Free a list of routes and their segments.			*/
+/*--------------------------------------------------------------*/
+
+static void free_routes(ROUTE rt)
+{
+   ROUTE rt2;
+   SEG seg;
+
+   while (rt) {
+      rt2 = rt->next;
+      while (rt->segments) {
+	 seg = rt->segments->next;
+	 free(rt->segments);
+	 rt->segments = seg;
+      }
+      free(rt);
+      rt = rt2;
+   }
+}
+
+/*--------------------------------------------------------------*/
+/* copy_routes() ---						*/
+/*								*/
+/* Return a copy of a list of routes and their segments.	*/
+/*--------------------------------------------------------------*/
+
+static ROUTE copy_routes(ROUTE rt)
+{
+   ROUTE newrt, first = NULL, *prt = &first;
+   SEG seg, newseg, *pseg;
+
+   for (; rt; rt = rt->next) {
+      newrt = (ROUTE)malloc(sizeof(struct route_));
+      *newrt = *rt;
+      newrt->next = NULL;
+      pseg = &newrt->segments;
+      for (seg = rt->segments; seg; seg = seg->next) {
+	 newseg = (SEG)malloc(sizeof(struct seg_));
+	 *newseg = *seg;
+	 newseg->next = NULL;
+	 *pseg = newseg;
+	 pseg = &newseg->next;
+      }
+      *prt = newrt;
+      prt = &newrt->next;
+   }
+   return first;
+}
+
+/*--------------------------------------------------------------*/
+/* free_tentative() ---						*/
+/*								*/
+/* Remove the tentative routes of "net", which are not in	*/
+/* Obs[], and restore the net's taps to Nodeloc[] the same way	*/
+/* ripup_net() does.						*/
+/*--------------------------------------------------------------*/
+
+static void free_tentative(NET net)
+{
+   NODE node;
+   DPOINT ntap;
+   int lay, x, y;
+
+   route_usage(net, -1);
+
+   for (node = net->netnodes; node; node = node->next) {
+      for (ntap = node->taps; ntap; ntap = ntap->next) {
+	 lay = ntap->layer;
+	 x = ntap->gridx;
+	 y = ntap->gridy;
+	 SetNodeinfo(x, y, lay)->nodeloc = NODESAV(x, y, lay);
+      }
+   }
+
+   free_routes(net->routes);
+   net->routes = NULL;
+}
+
+/*--------------------------------------------------------------*/
+/* restore_saved() ---						*/
+/*								*/
+/* Replace the routes of "neg->net" (which must not be in	*/
+/* Obs[]) with the routes of the best snapshot, and write them	*/
+/* into Obs[].  A net with a complete route is removed from	*/
+/* Nodeloc[] at its taps, as it is when the net is finished	*/
+/* routing (see next_route_setup()).				*/
+/*--------------------------------------------------------------*/
+
+static void restore_saved(NEGNET neg)
+{
+   NET net = neg->net;
+   NODE node;
+   DPOINT ntap;
+
+   free_tentative(net);
+   if (neg->saved == NULL) return;
+
+   net->routes = neg->saved;
+   neg->saved = NULL;
+   writeback_all_routes(net);
+
+   if (neg->complete) {
+      for (node = net->netnodes; node; node = node->next)
+	 for (ntap = node->taps; ntap; ntap = ntap->next)
+	    SetNodeinfo(ntap->gridx, ntap->gridy, ntap->layer)->nodeloc =
+			(NODE)NULL;
+   }
+}
+
+/*--------------------------------------------------------------*/
+/* add_negnet() ---						*/
+/*								*/
+/* Add "net" to the nets taking part in the negotiation.  The	*/
+/* net's routes, which are in Obs[], are saved as its state in	*/
+/* the best snapshot and then ripped up.  Return FALSE if the	*/
+/* routes could not be ripped up.				*/
+/*--------------------------------------------------------------*/
+
+static u_char add_negnet(NEGNET *negs, int *numnegs, int *maxnegs, NET net,
+		u_char failed)
+{
+   NEGNET neg;
+   ROUTE saved;
+
+   saved = copy_routes(net->routes);
+   if (ripup_net(net, (u_char)1) == FALSE) {
+      free_routes(saved);
+      return FALSE;
+   }
+
+   if (*numnegs == *maxnegs) {
+      *maxnegs = (*maxnegs == 0) ? 64 : (*maxnegs << 1);
+      *negs = (NEGNET)realloc(*negs, *maxnegs * sizeof(struct negnet_));
+   }
+   neg = &(*negs)[(*numnegs)++];
+   neg->net = net;
+   neg->saved = saved;
+   neg->complete = (failed) ? FALSE : TRUE;
+   neg->failed = failed;
+   neg->legal = FALSE;
+   neg->unroutable = FALSE;
+   return TRUE;
+}
+
+/*--------------------------------------------------------------*/
+/* negotiate_congestion() ---					*/
+/*								*/
+/* Negotiated rip-up and reroute of the nets in FailedNets.	*/
+/* Method:							*/
+/* 1) Rip up all failed nets; they take part in the		*/
+/*    negotiation.  Their routes on entry are the first		*/
+/*    snapshot.							*/
+/* 2) Rip up and reroute each net in the negotiation with	*/
+/*    stage = 1, charging the congestion costs at the present	*/
+/*    factor.  Routes are kept as tentative routes.		*/
+/* 3) Add to the history of every congested position.  Nets	*/
+/*    whose routes share no position are legal.  If fewer nets	*/
+/*    are in contention than in the best snapshot, this is the	*/
+/*    new best snapshot.					*/
+/* 4) Nets in Obs[] that tentative routes cross are ripped up	*/
+/*    and take part in the negotiation, too.			*/
+/* 5) Raise the present factor and repeat until no net is in	*/
+/*    contention, "NegIterations" is reached, or the number of	*/
+/*    nets in contention has not gone down in CONGEST_STALL	*/
+/*    iterations in a row.					*/
+/* 6) Restore the best snapshot.  Nets in contention in it	*/
+/*    are put back on FailedNets, in order.			*/
+/*								*/
+/* Return value:  The number of failing nets			*/
+/*--------------------------------------------------------------*/
+
+int
+negotiate_congestion(u_char graphdebug)
+{
+   NETLIST nl, nl2, cnl, *pnl;
+   NEGNET negs, neg;
+   NET net;
+   CONGEST *cg;
+   u_int obsval;
+   int i, j, lay, iter, result, overflow, failcount, numnegs, maxnegs;
+   int bestfail, lastfail, stalled;
+
+   if ((FailedNets == NULL) || (NegIterations <= 0)) return 0;
+
+   for (i = 0; i < Num_layers; i++) {
+      Congest[i] = (CONGEST *)calloc(GRIDSIZE(i), sizeof(CONGEST));
+      if (!Congest[i]) {
+	 fprintf(stderr, "Out of memory 13.\n");
+	 exit(13);
+      }
+   }
+
+   // The failed nets, with whatever partial routes the first stage
+   // made for them, are the first snapshot.  Each is then routed
+   // from scratch.
+
+   negs = NULL;
+   numnegs = maxnegs = 0;
+   while ((nl = FailedNets) != NULL) {
+      FailedNets = nl->next;
+      for (j = 0; j < numnegs; j++)
+	 if (negs[j].net == nl->net) break;
+      if (j == numnegs)
+	 add_negnet(&negs, &numnegs, &maxnegs, nl->net, TRUE);
+      free(nl);
+   }
+   bestfail = numnegs;
+   lastfail = -1;
+   stalled = 0;
+   PresFactor = PresCost;
+
+   for (iter = 1; iter <= NegIterations; iter++) {
+
+      // Reroute every net against the congestion left by all the
+      // other nets.
+
+      for (j = 0; j < numnegs; j++) {
+	 neg = &negs[j];
+	 if (neg->unroutable) continue;
+	 net = neg->net;
+
+	 free_tentative(net);
+	 result = doroute(net, (u_char)1, graphdebug);
+	 while (FailedNets) {
+	    nl2 = FailedNets->next;
+	    free(FailedNets);
+	    FailedNets = nl2;
+	 }
+
+	 if (result != 0) {
+	    // Not routable at all, even over other nets.  Leave it
+	    // to the regular second stage.
+
+	    if (Verbose > 0)
+	       Fprintf(stdout, "Net %s cannot be routed;  no longer "
+			"negotiating.\n", net->netname);
+	    free_tentative(net);
+	    neg->unroutable = TRUE;
+	    continue;
+	 }
+	 route_usage(net, 1);
+      }
+
+      // Find the legal routes now that all nets have been routed, and
+      // count the nets in contention.
+
+      failcount = 0;
+      for (j = 0; j < numnegs; j++) {
+	 neg = &negs[j];
+	 neg->legal = (!neg->unroutable && (route_usage(neg->net, 0) == 0))
+		? TRUE : FALSE;
+	 if (!neg->legal) failcount++;
+      }
+
+      // Count the positions used by more than one net, and remember
+      // them as congested for the following iterations.
+
+      overflow = 0;
+      for (lay = 0; lay < Num_layers; lay++) {
+	 for (i = 0; i < GRIDSIZE(lay); i++) {
+	    cg = &Congest[lay][i];
+	    if (cg->pres == 0) continue;
+	    obsval = Obs[lay][i];
+	    if ((cg->pres > 1) || (((Nodeinfo[lay][i] == NULL) ||
+			(Nodeinfo[lay][i]->nodesav == (NODE)NULL)) &&
+			(obsval & ROUTED_NET) && !(obsval & NO_NET))) {
+	       overflow++;
+	       if (cg->hist < 255) cg->hist++;
+	    }
+	 }
+      }
+
+      Fprintf(stdout, "Negotiation iteration %d:  %d nets, %d in "
+		"contention, overflow %d\n", iter, numnegs, failcount,
+		overflow);
+      Flush(stdout);
+
+      if (failcount < bestfail) {
+	 // New best snapshot
+
+	 for (j = 0; j < numnegs; j++) {
+	    neg = &negs[j];
+	    free_routes(neg->saved);
+	    neg->saved = (neg->legal) ? copy_routes(neg->net->routes) : NULL;
+	    neg->complete = neg->legal;
+	    neg->failed = (neg->legal) ? FALSE : TRUE;
+	 }
+	 bestfail = failcount;
+      }
+
+      // Nets joining the negotiation may keep the count above that of
+      // the best snapshot for a while;  go on as long as it is going
+      // down from one iteration to the next.
+
+      if ((lastfail < 0) || (failcount < lastfail))
+	 stalled = 0;
+      else if (++stalled >= CONGEST_STALL) {
+	 Fprintf(stdout, "Negotiation is not converging.\n");
+	 break;
+      }
+      lastfail = failcount;
+      if ((failcount == 0) || (iter == NegIterations)) break;
+
+      // Nets in Obs[] crossed by tentative routes must negotiate for
+      // their positions, too.
+
+      for (j = 0; j < numnegs; j++) {
+	 if (negs[j].legal || negs[j].unroutable) continue;
+	 cnl = find_colliding(negs[j].net);
+	 while (cnl) {
+	    nl2 = cnl->next;
+	    add_negnet(&negs, &numnegs, &maxnegs, cnl->net, FALSE);
+	    free(cnl);
+	    cnl = nl2;
+	 }
+      }
+
+      PresFactor = (PresFactor * CONGEST_GROWTH) / 2;
+      if (PresFactor > MAXRT / 1000) PresFactor = MAXRT / 1000;
+   }
+
+   // Restore the best snapshot.  Nets in contention in it go back to
+   // the regular second stage.
+
+   for (j = 0; j < numnegs; j++)
+      free_tentative(negs[j].net);
+
+   pnl = &FailedNets;
+   for (j = 0; j < numnegs; j++) {
+      neg = &negs[j];
+      restore_saved(neg);
+      if (neg->failed) {
+	 nl = (NETLIST)malloc(sizeof(struct netlist_));
+	 nl->net = neg->net;
+	 nl->next = NULL;
+	 *pnl = nl;
+	 pnl = &nl->next;
+      }
+   }
+   free(negs);
+   PresFactor = 0;
+
+   for (i = 0; i < Num_layers; i++) {
+      free(Congest[i]);
+      Congest[i] = NULL;
+   }
+
+   failcount = countlist(FailedNets);
+   if (Verbose > 0) {
+      Fprintf(stdout, "Negotiation finished with %d nets left to route.\n",
+		failcount);
+   }
+   return failcount;
+}
+
+/* end of negotiate.c */
@@ -498,22 +498,63 @@ void create_obstructions_from_variable_pitch()
    }
 }
 
+/*--------------------------------------------------------------*/
+/* SetNodeinfo() ---						*/
+/*	Return the node information record of the position at	*/
+/*	(x, y, lay), creating an empty record if the position	*/
+/*	does not have one yet.  Records exist only for the	*/
+/*	positions of node taps and stubs, so that the grid	*/
+/*	itself holds just one pointer per position.		*/
+/*--------------------------------------------------------------*/
+
+NODEINFO
+SetNodeinfo(int x, int y, int lay)
+{
+   NODEINFO *lnodeptr;
+
+   lnodeptr = &NODEIPTR(x, y, lay);
+   if (*lnodeptr == NULL) {
+      *lnodeptr = (NODEINFO)calloc(1, sizeof(struct nodeinfo_));
+      if (*lnodeptr == NULL) {
+	 fprintf(stderr, "Out of memory 14.\n");
+	 exit(14);
+      }
+      NumNodeinfo++;
+   }
+   return *lnodeptr;
+}
+
+/*--------------------------------------------------------------*/
+/* ClearNodeinfo() ---						*/
+/*	Remove the node information record of the position at	*/
+/*	(x, y, lay), if it has one.				*/
+/*--------------------------------------------------------------*/
+
+void
+ClearNodeinfo(int x, int y, int lay)
+{
+   NODEINFO *lnodeptr;
+
+   lnodeptr = &NODEIPTR(x, y, lay);
+   if (*lnodeptr != NULL) {
+      free(*lnodeptr);
+      *lnodeptr = NULL;
+      NumNodeinfo--;
+   }
+}
+
 /*--------------------------------------------------------------*/
 /* disable_gridpos() ---					*/
 /*	Render the position at (x, y, lay) unroutable by	*/
-/*	setting its Obs[] entry to NO_NET and removing it from	*/
-/*	the Nodeloc and Nodesav records.			*/
+/*	setting its Obs[] entry to NO_NET and removing its	*/
+/*	node information (Nodeloc, Nodesav, and Stub).		*/
 /*--------------------------------------------------------------*/
 
 void
 disable_gridpos(int x, int y, int lay)
 {
-   int apos = OGRID(x, y, lay);
-
-   Obs[lay][apos] = (u_int)(NO_NET | OBSTRUCT_MASK);
-   Nodeloc[lay][apos] = NULL;
-   Nodesav[lay][apos] = NULL;
-   Stub[lay][apos] = 0.0;
+   Obs[lay][OGRID(x, y, lay)] = (u_int)(NO_NET | OBSTRUCT_MASK);
+   ClearNodeinfo(x, y, lay);
 }
 
 /*--------------------------------------------------------------*/
@@ -1073,11 +1114,11 @@ void create_obstructions_from_nodes()
 
 			        Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 					= (u_int)node->netnum | dir;
-			        Nodeloc[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			        SetNodeinfo(gridx, gridy, ds->layer)->nodeloc
 					= node;
-			        Nodesav[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			        SetNodeinfo(gridx, gridy, ds->layer)->nodesav
 					= node;
-			        Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			        SetNodeinfo(gridx, gridy, ds->layer)->stub
 					= dist;
 
 			     }
@@ -1106,9 +1147,9 @@ void create_obstructions_from_nodes()
 				// obstruction to resolve the DRC error.
 
 				// Make sure we have marked this as a node.
-			        Nodeloc[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			        SetNodeinfo(gridx, gridy, ds->layer)->nodeloc
 					= node;
-			        Nodesav[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			        SetNodeinfo(gridx, gridy, ds->layer)->nodesav
 					= node;
 			        Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 					= (u_int)node->netnum;
@@ -1117,7 +1158,7 @@ void create_obstructions_from_nodes()
 			           offd = -(sdisty - Obsinfo[ds->layer]
 					[OGRID(gridx, gridy, ds->layer)]);
 				   if (offd >= -offmaxy[ds->layer]) {
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= offd;
 			              Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						|= (STUBROUTE_NS | OFFSET_TAP);
@@ -1128,7 +1169,7 @@ void create_obstructions_from_nodes()
 				   offd = sdisty - Obsinfo[ds->layer]
 					[OGRID(gridx, gridy, ds->layer)];
 				   if (offd <= offmaxy[ds->layer]) {
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= offd;
 			              Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						|= (STUBROUTE_NS | OFFSET_TAP);
@@ -1139,7 +1180,7 @@ void create_obstructions_from_nodes()
 				   offd = -(sdistx - Obsinfo[ds->layer]
 					[OGRID(gridx, gridy, ds->layer)]);
 				   if (offd >= -offmaxx[ds->layer]) {
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= offd;
 			              Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						|= (STUBROUTE_EW | OFFSET_TAP);
@@ -1150,7 +1191,7 @@ void create_obstructions_from_nodes()
 				   offd = sdistx - Obsinfo[ds->layer]
 					[OGRID(gridx, gridy, ds->layer)];
 				   if (offd <= offmaxx[ds->layer]) {
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= offd;
 			              Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						|= (STUBROUTE_EW | OFFSET_TAP);
@@ -1184,9 +1225,9 @@ void create_obstructions_from_nodes()
 					((ds->y2 - dy + EPS) > deltay)) {
 			           Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 					= (u_int)node->netnum;
-			           Nodeloc[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			           SetNodeinfo(gridx, gridy, ds->layer)->nodeloc
 					= node;
-			           Nodesav[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			           SetNodeinfo(gridx, gridy, ds->layer)->nodesav
 					= node;
 				}
 			     }
@@ -1200,12 +1241,7 @@ void create_obstructions_from_nodes()
 			           if ((k & ~PINOBSTRUCTMASK) != (u_int)node->netnum) {
 				       Obs[ds->layer + 1][OGRID(gridx, gridy,
 						ds->layer + 1)] = NO_NET;
-				       Nodeloc[ds->layer + 1][OGRID(gridx, gridy,
-						ds->layer + 1)] = (NODE)NULL;
-				       Nodesav[ds->layer + 1][OGRID(gridx, gridy,
-						ds->layer + 1)] = (NODE)NULL;
-				       Stub[ds->layer + 1][OGRID(gridx, gridy,
-						ds->layer + 1)] = (float)0.0;
+				       ClearNodeinfo(gridx, gridy, ds->layer + 1);
 				   }
 				}
 			     }
@@ -1258,10 +1294,9 @@ void create_obstructions_from_nodes()
 
 			    n2 = NULL;
 			    if (ds->layer > 0)
-			       n2 = Nodeloc[ds->layer - 1][OGRID(gridx, gridy,
-					ds->layer - 1)];
+			       n2 = NODELOC(gridx, gridy, ds->layer - 1);
 			    if (n2 == NULL)
-			       n2 = Nodeloc[ds->layer][OGRID(gridx, gridy, ds->layer)];
+			       n2 = NODELOC(gridx, gridy, ds->layer);
 
 			    else {
 			       // Watch out for the case where a tap crosses
@@ -1269,7 +1304,7 @@ void create_obstructions_from_nodes()
 			       // on top as if it is not there!
 
 			       NODE n3;
-			       n3 = Nodeloc[ds->layer][OGRID(gridx, gridy, ds->layer)];
+			       n3 = NODELOC(gridx, gridy, ds->layer);
 			       if (n3 != NULL && n3 != node) n2 = n3;
 			    }
 
@@ -1452,9 +1487,9 @@ void create_obstructions_from_nodes()
 				if ((k < Numnets) && (dir != STUBROUTE_X)) {
 				   Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 					= (u_int)g->netnum[i] | dir; 
-				   Nodeloc[ds->layer][OGRID(gridx, gridy, ds->layer)]
+				   SetNodeinfo(gridx, gridy, ds->layer)->nodeloc
 					= node;
-				   Nodesav[ds->layer][OGRID(gridx, gridy, ds->layer)]
+				   SetNodeinfo(gridx, gridy, ds->layer)->nodesav
 					= node;
 				}
 				else {
@@ -1463,7 +1498,7 @@ void create_obstructions_from_nodes()
 				   Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 					|= dir;
 				}
-				Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+				SetNodeinfo(gridx, gridy, ds->layer)->stub
 					= dist;
 			    }
 			    else {
@@ -1498,8 +1533,7 @@ void create_obstructions_from_nodes()
 				
 				  if ((k & (STUBROUTE_X | OFFSET_TAP)) != 0)
 				     disable_gridpos(gridx, gridy, ds->layer);
-				  else if (Nodesav[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] != NULL) {
+				  else if (NODESAV(gridx, gridy, ds->layer) != NULL) {
 
 				     // By how much would a tap need to be moved
 				     // to clear the obstructing geometry?
@@ -1515,8 +1549,7 @@ void create_obstructions_from_nodes()
 					   dist = ds->x2 - dx + xdist +
 							LefGetRouteSpacing(ds->layer);
 					   dir = (STUBROUTE_EW | OFFSET_TAP);
-					   Stub[ds->layer][OGRID(gridx, gridy,
-							ds->layer)] = dist;
+					   SetNodeinfo(gridx, gridy, ds->layer)->stub = dist;
 					   Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 							|= dir;
 					}
@@ -1534,8 +1567,7 @@ void create_obstructions_from_nodes()
 					   dist = ds->x1 - dx - xdist -
 							LefGetRouteSpacing(ds->layer);
 					   dir = (STUBROUTE_EW | OFFSET_TAP);
-					   Stub[ds->layer][OGRID(gridx, gridy,
-							ds->layer)] = dist;
+					   SetNodeinfo(gridx, gridy, ds->layer)->stub = dist;
 					   Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 							|= dir;
 					}
@@ -1553,8 +1585,7 @@ void create_obstructions_from_nodes()
 					   dist = ds->y2 - dy + xdist +
 							LefGetRouteSpacing(ds->layer);
 					   dir = (STUBROUTE_NS | OFFSET_TAP);
-					   Stub[ds->layer][OGRID(gridx, gridy,
-							ds->layer)] = dist;
+					   SetNodeinfo(gridx, gridy, ds->layer)->stub = dist;
 					   Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 							|= dir;
 					}
@@ -1571,8 +1602,7 @@ void create_obstructions_from_nodes()
 					   dist = ds->y1 - dy - xdist -
 							LefGetRouteSpacing(ds->layer);
 					   dir = (STUBROUTE_NS | OFFSET_TAP);
-					   Stub[ds->layer][OGRID(gridx, gridy,
-							ds->layer)] = dist;
+					   SetNodeinfo(gridx, gridy, ds->layer)->stub = dist;
 					   Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 							|= dir;
 					}
@@ -1603,32 +1633,24 @@ void create_obstructions_from_nodes()
 					ds->y1) && (dy + xdist < ds->y1)) {
 				     if ((dx - xdist < ds->x2) &&
 						(dx + xdist > ds->x1) &&
-						(Stub[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] == 0.0)) {
-					Stub[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] = ds->y1 - dy;
+						(STUBDIST(gridx, gridy, ds->layer) == 0.0)) {
+					SetNodeinfo(gridx, gridy, ds->layer)->stub = ds->y1 - dy;
 					Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						= node->netnum | STUBROUTE_NS;
-					Nodeloc[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] = node;
-					Nodesav[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] = node;
+					SetNodeinfo(gridx, gridy, ds->layer)->nodeloc = node;
+					SetNodeinfo(gridx, gridy, ds->layer)->nodesav = node;
 				     }
 				  }
 				  if ((dy - xdist - LefGetRouteSpacing(ds->layer) <
 					ds->y2) && (dy - xdist > ds->y2)) {
 				     if ((dx - xdist < ds->x2) &&
 						(dx + xdist > ds->x1) &&
-						(Stub[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] == 0.0)) {
-					Stub[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] = ds->y2 - dy;
+						(STUBDIST(gridx, gridy, ds->layer) == 0.0)) {
+					SetNodeinfo(gridx, gridy, ds->layer)->stub = ds->y2 - dy;
 					Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						= node->netnum | STUBROUTE_NS;
-					Nodeloc[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] = node;
-					Nodesav[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] = node;
+					SetNodeinfo(gridx, gridy, ds->layer)->nodeloc = node;
+					SetNodeinfo(gridx, gridy, ds->layer)->nodesav = node;
 				     }
 				  }
 
@@ -1637,32 +1659,24 @@ void create_obstructions_from_nodes()
 					ds->x1) && (dx + xdist < ds->x1)) {
 				     if ((dy - xdist < ds->y2) &&
 						(dy + xdist > ds->y1) &&
-						(Stub[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] == 0.0)) {
-					Stub[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] = ds->x1 - dx;
+						(STUBDIST(gridx, gridy, ds->layer) == 0.0)) {
+					SetNodeinfo(gridx, gridy, ds->layer)->stub = ds->x1 - dx;
 					Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						= node->netnum | STUBROUTE_EW;
-					Nodeloc[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] = node;
-					Nodesav[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] = node;
+					SetNodeinfo(gridx, gridy, ds->layer)->nodeloc = node;
+					SetNodeinfo(gridx, gridy, ds->layer)->nodesav = node;
 				     }
 				  }
 				  if ((dx - xdist - LefGetRouteSpacing(ds->layer) <
 					ds->x2) && (dx - xdist > ds->x2)) {
 				     if ((dy - xdist < ds->y2) &&
 						(dy + xdist > ds->y1) &&
-						(Stub[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] == 0.0)) {
-					Stub[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] = ds->x2 - dx;
+						(STUBDIST(gridx, gridy, ds->layer) == 0.0)) {
+					SetNodeinfo(gridx, gridy, ds->layer)->stub = ds->x2 - dx;
 					Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						= node->netnum | STUBROUTE_EW;
-					Nodeloc[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] = node;
-					Nodesav[ds->layer][OGRID(gridx, gridy,
-						ds->layer)] = node;
+					SetNodeinfo(gridx, gridy, ds->layer)->nodeloc = node;
+					SetNodeinfo(gridx, gridy, ds->layer)->nodesav = node;
 				     }
 				  }
 			       }
@@ -1752,7 +1766,7 @@ void tap_to_tap_interactions()
 		            dx = (gridx * PitchX[ds->layer]) + Xlowerbound;
 		            dy = (gridy * PitchY[ds->layer]) + Ylowerbound;
 
-			    dist = Stub[ds->layer][OGRID(gridx, gridy, ds->layer)];
+			    dist = STUBDIST(gridx, gridy, ds->layer);
 
 			    /* "de" is the bounding box of a via placed	  */
 			    /* at (gridx, gridy) and offset as specified. */
@@ -1842,9 +1856,9 @@ make_routable(NODE node)
 			    if (orignet & NO_NET) {
 				Obs[ds->layer][OGRID(gridx, gridy, ds->layer)] =
 					g->netnum[i];
-				Nodeloc[ds->layer][OGRID(gridx, gridy, ds->layer)] =
+				SetNodeinfo(gridx, gridy, ds->layer)->nodeloc =
 					node;
-				Nodesav[ds->layer][OGRID(gridx, gridy, ds->layer)] =
+				SetNodeinfo(gridx, gridy, ds->layer)->nodesav =
 					node;
 				return;
 			    }
@@ -1952,7 +1966,7 @@ void adjust_stub_lengths()
 			     dt.y1 = dy - wy;
 			     dt.y2 = dy + wy;
 
-			     dist = Stub[ds->layer][OGRID(gridx, gridy, ds->layer)];
+			     dist = STUBDIST(gridx, gridy, ds->layer);
 
 			     // adjust the route box according to the stub
 			     // or offset geometry, provided that the stub
@@ -2126,13 +2140,13 @@ void adjust_stub_lengths()
 				   if ((orignet & PINOBSTRUCTMASK) == 0) {
 			              Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						|= STUBROUTE_EW;
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= de.x2 - dx;
 				      errbox = FALSE;
 				   }
 				   else if ((orignet & PINOBSTRUCTMASK) == STUBROUTE_EW
 						&& (dist > 0)) {
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= de.x2 - dx;
 				      errbox = FALSE;
 				   }
@@ -2142,7 +2156,7 @@ void adjust_stub_lengths()
 						&= ~STUBROUTE_NS;
 			              Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						|= STUBROUTE_EW;
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= de.x2 - dx;
 				      errbox = FALSE;
 				   }
@@ -2153,13 +2167,13 @@ void adjust_stub_lengths()
 				   if ((orignet & PINOBSTRUCTMASK) == 0) {
 			              Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						|= STUBROUTE_EW;
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= de.x1 - dx;
 				      errbox = FALSE;
 				   }
 				   else if ((orignet & PINOBSTRUCTMASK) == STUBROUTE_EW
 						&& (dist < 0)) {
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= de.x1 - dx;
 				      errbox = FALSE;
 				   }
@@ -2169,7 +2183,7 @@ void adjust_stub_lengths()
 						&= ~STUBROUTE_NS;
 			              Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						|= STUBROUTE_EW;
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= de.x1 - dx;
 				      errbox = FALSE;
 				   }
@@ -2180,13 +2194,13 @@ void adjust_stub_lengths()
 				   if ((orignet & PINOBSTRUCTMASK) == 0) {
 			              Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						|= STUBROUTE_NS;
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= de.y2 - dy;
 				      errbox = FALSE;
 				   }
 				   else if ((orignet & PINOBSTRUCTMASK) == STUBROUTE_NS
 						&& (dist > 0)) {
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= de.y2 - dy;
 				      errbox = FALSE;
 				   }
@@ -2196,7 +2210,7 @@ void adjust_stub_lengths()
 						&= ~STUBROUTE_EW;
 			              Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						|= STUBROUTE_NS;
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= de.y2 - dy;
 				      errbox = FALSE;
 				   }
@@ -2207,13 +2221,13 @@ void adjust_stub_lengths()
 				   if ((orignet & PINOBSTRUCTMASK) == 0) {
 			              Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						|= STUBROUTE_NS;
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= de.y1 - dy;
 				      errbox = FALSE;
 				   }
 				   else if ((orignet & PINOBSTRUCTMASK) == STUBROUTE_NS
 						&& (dist < 0)) {
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= de.y1 - dy;
 				      errbox = FALSE;
 				   }
@@ -2223,7 +2237,7 @@ void adjust_stub_lengths()
 						&= ~STUBROUTE_EW;
 			              Obs[ds->layer][OGRID(gridx, gridy, ds->layer)]
 						|= STUBROUTE_NS;
-			              Stub[ds->layer][OGRID(gridx, gridy, ds->layer)]
+			              SetNodeinfo(gridx, gridy, ds->layer)->stub
 						= de.y1 - dy;
 				      errbox = FALSE;
 				   }
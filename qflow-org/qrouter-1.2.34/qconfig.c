@@ -56,6 +56,16 @@ int     BlockCost = 25;            // Cost of a crossover when node has
 				   // only one tap point
 int 	ConflictCost = 50;	   // Cost of shorting another route
 				   // during the rip-up and reroute stage
+int	HistCost = 10;		   // Cost per past iteration in which a
+				   // position was congested (negotiated
+				   // rip-up and reroute)
+int	PresCost = 5;		   // Initial cost of sharing a position
+				   // with another net (negotiated rip-up
+				   // and reroute)
+int	NegIterations = 0;	   // Maximum number of negotiated rip-up
+				   // and reroute iterations (0 = don't use)
+int	GlobalGcell = 0;	   // Size in tracks of a gcell for global
+				   // routing (0 = don't use)
 
 char    *ViaX[MAX_LAYERS];
 char    *ViaY[MAX_LAYERS];
@@ -291,6 +301,26 @@ int read_config(FILE *fconfig)
 	    OK = 1; BlockCost = iarg;
 	}
 
+	if ((i = sscanf(lineptr, "route conflict cost %d", &iarg)) == 1) {
+	    OK = 1; ConflictCost = iarg;
+	}
+
+	if ((i = sscanf(lineptr, "route history cost %d", &iarg)) == 1) {
+	    OK = 1; HistCost = iarg;
+	}
+
+	if ((i = sscanf(lineptr, "route present cost %d", &iarg)) == 1) {
+	    OK = 1; PresCost = iarg;
+	}
+
+	if ((i = sscanf(lineptr, "negotiate iterations %d", &iarg)) == 1) {
+	    OK = 1; NegIterations = iarg;
+	}
+
+	if ((i = sscanf(lineptr, "global route gcell %d", &iarg)) == 1) {
+	    OK = 1; GlobalGcell = iarg;
+	}
+
 	if ((i = sscanf(lineptr, "do not route node %s\n", sarg)) == 1) {
 	    OK = 1; 
 	    dnr = (STRING)malloc(sizeof(struct string_));
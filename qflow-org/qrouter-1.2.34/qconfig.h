@@ -36,6 +36,10 @@ extern int     JogCost;
 extern int     XverCost;
 extern int     BlockCost;
 extern int     ConflictCost;
+extern int     HistCost;
+extern int     PresCost;
+extern int     NegIterations;
+extern int     GlobalGcell;
 
 extern char    *ViaX[MAX_LAYERS];
 extern char    *ViaY[MAX_LAYERS];
@@ -20,24 +20,24 @@
 #include "lef.h"
 
 int  Pathon = -1;
-int  TotalRoutes = 0;
+THREAD_LOCAL int  TotalRoutes = 0;
 
 NET     *Nlnets;	// list of nets in the design
-NET	CurNet;		// current net to route, used by 2nd stage
+THREAD_LOCAL NET CurNet;	// current net to route, used by 2nd stage
 STRING  DontRoute;      // a list of nets not to route (e.g., power)
 STRING  CriticalNet;    // list of critical nets to route first
 GATE    GateInfo;       // standard cell macro information
 GATE	PinMacro;	// macro definition for a pin
 GATE    Nlgates;	// gate instance information
-NETLIST FailedNets;	// list of nets that failed to route
+THREAD_LOCAL NETLIST FailedNets;	// list of nets that failed to route
+THREAD_LOCAL struct seg_ RouteWindow;	// limits of the route search
 
-u_char *RMask;    	     // mask out best area to route
+THREAD_LOCAL u_char *RMask;    	     // mask out best area to route
 u_int  *Obs[MAX_LAYERS];     // net obstructions in layer
-PROUTE *Obs2[MAX_LAYERS];    // used for pt->pt routes on layer
-float  *Stub[MAX_LAYERS];    // used for stub routing to pins
+THREAD_LOCAL PROUTE *Obs2[MAX_LAYERS];    // used for pt->pt routes on layer
 float  *Obsinfo[MAX_LAYERS]; // temporary array used for detailed obstruction info
-NODE   *Nodeloc[MAX_LAYERS]; // nodes are here. . .
-NODE   *Nodesav[MAX_LAYERS]; // . . . and here (but not to be altered)
+NODEINFO *Nodeinfo[MAX_LAYERS]; // nodes and stub distances, where there are any
+int    NumNodeinfo = 0;	     // number of records in Nodeinfo
 DSEG   UserObs;		     // user-defined obstruction layers
 
 u_char needblock[MAX_LAYERS];
@@ -46,6 +46,7 @@ char *vddnet = NULL;
 char *gndnet = NULL;
 
 int    Numnets = 0;
+int    Numthreads = 1;	// Number of threads used for stage 1 routing
 u_char Verbose = 3;	// Default verbose level
 u_char keepTrying = FALSE;
 u_char forceRoutable = FALSE;
@@ -53,6 +54,7 @@ u_char maskMode = MASK_AUTO;
 u_char mapType = MAP_OBSTRUCT | DRAW_ROUTES;
 
 char DEFfilename[256];
+char ECOfilename[256];	// Routed DEF file to reuse routes from
 
 ScaleRec Scales;	// record of input and output scales
 
@@ -108,8 +110,7 @@ int allocate_obs_array()
    if (Obs[0] != NULL) return;	/* Already been called */
 
    for (i = 0; i < Num_layers; i++) {
-      Obs[i] = (u_int *)calloc(NumChannelsX[i] * NumChannelsY[i],
-			sizeof(u_int));
+      Obs[i] = (u_int *)calloc(GRIDSIZE(i), sizeof(u_int));
       if (!Obs[i]) {
 	 Fprintf(stderr, "Out of memory 4.\n");
 	 return(4);
@@ -118,6 +119,57 @@ int allocate_obs_array()
    return 0;
 }
 
+/*--------------------------------------------------------------*/
+/* route_window_full() ---					*/
+/*								*/
+/* Open the entire grid to the route search.  This is the	*/
+/* normal state;  the window is only reduced in the threads	*/
+/* that route nets in parallel (see mthread.c).			*/
+/*--------------------------------------------------------------*/
+
+void route_window_full()
+{
+   int i;
+
+   RouteWindow.x1 = RouteWindow.y1 = 0;
+   RouteWindow.x2 = RouteWindow.y2 = 0;
+   for (i = 0; i < Num_layers; i++) {
+      if (NumChannelsX[i] - 1 > RouteWindow.x2)
+	 RouteWindow.x2 = NumChannelsX[i] - 1;
+      if (NumChannelsY[i] - 1 > RouteWindow.y2)
+	 RouteWindow.y2 = NumChannelsY[i] - 1;
+   }
+}
+
+/*--------------------------------------------------------------*/
+/* report_grid_memory() ---					*/
+/*								*/
+/* Print the amount of memory taken by the route grid arrays.	*/
+/*--------------------------------------------------------------*/
+
+void report_grid_memory()
+{
+   int i;
+   double obsmem = 0.0, obs2mem = 0.0, nodemem, maskmem;
+
+   for (i = 0; i < Num_layers; i++) {
+      obsmem += (double)GRIDSIZE(i) * sizeof(u_int);
+      obs2mem += (double)GRIDSIZE(i) * sizeof(PROUTE);
+   }
+   nodemem = (double)NumNodeinfo * sizeof(struct nodeinfo_);
+   for (i = 0; i < Num_layers; i++)
+      nodemem += (double)GRIDSIZE(i) * sizeof(NODEINFO);
+   maskmem = (double)GRIDSIZE(0) * sizeof(u_char);
+
+   Fprintf(stdout, "Route grid is %d x %d x %d;  memory used (MB):\n",
+		NumChannelsX[0], NumChannelsY[0], Num_layers);
+   Fprintf(stdout, "   obstructions %.1f, search %.1f, nodes %.1f "
+		"(%d taps and stubs), mask %.1f;  total %.1f\n",
+		obsmem / 1048576.0, obs2mem / 1048576.0, nodemem / 1048576.0,
+		NumNodeinfo, maskmem / 1048576.0,
+		(obsmem + obs2mem + nodemem + maskmem) / 1048576.0);
+}
+
 /*--------------------------------------------------------------*/
 /* countlist ---						*/
 /*   Count the number of entries in a simple linked list	*/
@@ -163,8 +215,9 @@ runqrouter(int argc, char *argv[])
    Scales.iscale = 1;
    Filename[0] = 0;
    DEFfilename[0] = 0;
+   ECOfilename[0] = 0;
 
-   while ((i = getopt(argc, argv, "c:i:hkfv:p:g:r:")) != -1) {
+   while ((i = getopt(argc, argv, "c:i:hkfv:p:g:r:t:e:")) != -1) {
       switch (i) {
 	 case 'c':
 	    configfile = strdup(optarg);
@@ -188,6 +241,17 @@ runqrouter(int argc, char *argv[])
 		Scales.iscale = 1;
 	    }
 	    break;
+	 case 't':
+	    if (sscanf(optarg, "%d", &Numthreads) != 1 || Numthreads < 1) {
+		Fprintf(stderr, "Bad number of threads \"%s\", "
+			"positive integer expected.\n", optarg);
+		Numthreads = 1;
+	    }
+	    break;
+	 case 'e':
+	    strncpy(ECOfilename, optarg, 255);
+	    ECOfilename[255] = '\0';
+	    break;
 	 case 'h':
 	    helpmessage();
 	    return 1;
@@ -277,7 +341,7 @@ runqrouter(int argc, char *argv[])
 
 void reinitialize()
 {
-    int i;
+    int i, j;
     NETLIST nl;
     NET net;
     ROUTE rt;
@@ -290,15 +354,14 @@ void reinitialize()
     // Free up all of the matrices
 
     for (i = 0; i < Num_layers; i++) {
-	free(Stub[i]);
-	free(Nodeloc[i]);
-	free(Nodesav[i]);
+	if (Nodeinfo[i] != NULL)
+	    for (j = 0; j < GRIDSIZE(i); j++)
+		free(Nodeinfo[i][j]);
+	free(Nodeinfo[i]);
 	free(Obs2[i]);
 	free(Obs[i]);
 
-	Stub[i] = NULL;
-	Nodeloc[i] = NULL;
-	Nodesav[i] = NULL;
+	Nodeinfo[i] = NULL;
 	Obs2[i] = NULL;
 	Obs[i] = NULL;
     }
@@ -311,6 +374,10 @@ void reinitialize()
 	free(nl);
     }
 
+    // Free the global routes (see global.c)
+
+    free_global_route();
+
     // Free all net and route information
 
     for (i = 0; i < Numnets; i++) {
@@ -420,42 +487,24 @@ int post_def_setup()
 
    for (i = 0; i < Num_layers; i++) {
 
-      Obsinfo[i] = (float *)calloc(NumChannelsX[i] * NumChannelsY[i],
-			sizeof(float));
+      Obsinfo[i] = (float *)calloc(GRIDSIZE(i), sizeof(float));
       if (!Obsinfo[i]) {
 	 fprintf(stderr, "Out of memory 5.\n");
 	 exit(5);
       }
 
-      Stub[i] = (float *)calloc(NumChannelsX[i] * NumChannelsY[i],
-			sizeof(float));
-      if (!Stub[i]) {
-	 fprintf( stderr, "Out of memory 6.\n");
-	 exit(6);
-      }
-
-      // Nodeloc is the reverse lookup table for nodes
+      // Nodeinfo is the reverse lookup table for nodes, and holds
+      // the stub distances.  It has records only where there are
+      // node taps or stubs.
 
-      Nodeloc[i] = (NODE *)calloc(NumChannelsX[i] * NumChannelsY[i],
-		sizeof(NODE));
-      if (!Nodeloc[i]) {
-         fprintf(stderr, "Out of memory 7.\n");
-         exit(7);
-      }
-
-      Nodesav[i] = (NODE *)calloc(NumChannelsX[i] * NumChannelsY[i],
-		sizeof(NODE));
-      if (!Nodesav[i]) {
-         fprintf(stderr, "Out of memory 8.\n");
-         exit(8);
+      Nodeinfo[i] = (NODEINFO *)calloc(GRIDSIZE(i), sizeof(NODEINFO));
+      if (!Nodeinfo[i]) {
+         fprintf(stderr, "Out of memory 6.\n");
+         exit(6);
       }
    }
    Flush(stdout);
 
-   if (Verbose > 1)
-      Fprintf(stderr, "Diagnostic: memory block is %d bytes\n",
-		sizeof(u_int) * NumChannelsX[0] * NumChannelsY[0]);
-
    /* Be sure to create obstructions from gates first, since we don't	*/
    /* want improperly defined or positioned obstruction layers to over-	*/
    /* write our node list.						*/
@@ -481,13 +530,14 @@ int post_def_setup()
    for (i = 0; i < Num_layers; i++) free(Obsinfo[i]);
 
    for (i = 0; i < Num_layers; i++) {
-      Obs2[i] = (PROUTE *)calloc(NumChannelsX[i] * NumChannelsY[i],
-			sizeof(PROUTE));
+      Obs2[i] = (PROUTE *)calloc(GRIDSIZE(i), sizeof(PROUTE));
       if (!Obs2[i]) {
          fprintf( stderr, "Out of memory 9.\n");
          exit(9);
       }
    }
+   route_window_full();
+   if (Verbose > 0) report_grid_memory();
 
    // Fill in needblock bit fields, which are used by commit_proute
    // when route layers are too large for the grid size, and grid points
@@ -556,7 +606,33 @@ void read_def(char *filename)
    else reinitialize();
 
    Scales.oscale = (double)((float)Scales.iscale * DefRead(DEFfilename));
-   post_def_setup();
+   if (post_def_setup() != 0) return;
+
+   // For an incremental route, reuse the routes of nets which have
+   // not changed since the design was last routed.
+
+   if (ECOfilename[0] != '\0') DefReadEco(ECOfilename);
+}
+
+/*--------------------------------------------------------------*/
+/* stage1_result() ---						*/
+/*								*/
+/* Report the result of the first stage route of "net" and	*/
+/* update the count of nets remaining to be routed.		*/
+/*--------------------------------------------------------------*/
+
+void stage1_result(NET net, int result, int *remaining)
+{
+   if (result == 0) {
+      (*remaining)--;
+      if (Verbose > 0)
+	 Fprintf(stdout, "Finished routing net %s\n", net->netname);
+      Fprintf(stdout, "Nets remaining: %d\n", *remaining);
+   }
+   else {
+      if (Verbose > 0)
+	 Fprintf(stdout, "Failed to route net %s\n", net->netname);
+   }
 }
 
 /*--------------------------------------------------------------*/
@@ -577,24 +653,30 @@ int dofirststage(u_char graphdebug)
       FailedNets = nl;
    }
 
+   // Plan the routes of all nets on a coarse grid first, if asked to.
+   // The global routes only guide the masks, so they are pointless
+   // with any other mask type.
+
+   if ((GlobalGcell > 0) && (maskMode == MASK_AUTO))
+      global_route(GlobalGcell);
+
    // Now find and route all the nets
 
    remaining = Numnets;
+   i = 0;
+
+#ifdef HAVE_PTHREADS
+   // Route in parallel unless the search is being watched
+   if ((Numthreads > 1) && !graphdebug)
+      if (dofirststage_parallel(&remaining) >= 0)
+	 i = Numnets;
+#endif
  
-   for (i = 0; i < Numnets; i++) {
+   for (; i < Numnets; i++) {
       net = getnettoroute(i);
       if ((net != NULL) && (net->netnodes != NULL)) {
 	 result = doroute(net, (u_char)0, graphdebug);
-	 if (result == 0) {
-	    remaining--;
-	    if (Verbose > 0)
-	       Fprintf(stdout, "Finished routing net %s\n", net->netname);
-	    Fprintf(stdout, "Nets remaining: %d\n", remaining);
-	 }
-	 else {
-	    if (Verbose > 0)
-	       Fprintf(stdout, "Failed to route net %s\n", net->netname);
-	 }
+	 stage1_result(net, result, &remaining);
       }
       else {
 	 if (net && (Verbose > 0)) {
@@ -917,7 +999,7 @@ NET getnettoroute(int order)
    net = Nlnets[order]; 
    if (net == NULL) return NULL;
   
-   if (net->flags & NET_IGNORED) return NULL;
+   if (net->flags & (NET_IGNORED | NET_ROUTED)) return NULL;
    if (net->numnodes >= 2) return net;
 
    // Qrouter will route power and ground nets even if the
@@ -1061,6 +1143,11 @@ dosecondstage(u_char graphdebug)
    NETLIST nl, nl2, fn;
    NETLIST Abandoned;	// Abandoned routes---not even trying any more.
 
+   // Negotiate congestion first, if enabled.  Nets it could not
+   // settle are left in FailedNets for the method below.
+
+   if (NegIterations > 0) negotiate_congestion(graphdebug);
+
    origcount = countlist(FailedNets);
    if (FailedNets)
       maxtries = TotalRoutes + ((origcount < 20) ? 20 : origcount) * 8;
@@ -1194,8 +1281,7 @@ dosecondstage(u_char graphdebug)
 
 void initMask()
 {
-   RMask = (u_char *)calloc(NumChannelsX[0] * NumChannelsY[0],
-			sizeof(u_char));
+   RMask = (u_char *)calloc(GRIDSIZE(0), sizeof(u_char));
    if (!RMask) {
       fprintf(stderr, "Out of memory 3.\n");
       exit(3);
@@ -1610,9 +1696,7 @@ void createMask(NET net, u_char slack, u_char halo)
 void fillMask(int value) {
    int i;
 
-   memset((void *)RMask, value,
-		(size_t)(NumChannelsX[0] * NumChannelsY[0]
-		* sizeof(u_char)));
+   memset((void *)RMask, value, (size_t)(GRIDSIZE(0) * sizeof(u_char)));
 }
 
 /*--------------------------------------------------------------*/
@@ -1621,25 +1705,87 @@ void fillMask(int value) {
 /*	stage = 0 is normal routing				*/
 /*	stage = 1 is the rip-up and reroute stage		*/
 /*								*/
+/* The global route of a net (see global.c) is only a hint	*/
+/* for the first stage.  If the net fails with the route mask	*/
+/* made from its global route, the routes made for it are	*/
+/* ripped up and the net is routed again with the regular	*/
+/* route mask.  Later stages always use the regular mask.	*/
+/*								*/
 /*   ARGS: two nodes to be connected				*/
 /*   RETURNS: 0 on success, -1 on failure			*/
 /*   SIDE EFFECTS: 						*/
 /*   AUTHOR and DATE: steve beccue      Fri Aug 8		*/
 /*--------------------------------------------------------------*/
 
+static int doroute_mask(NET net, u_char stage, u_char graphdebug,
+		u_char *globalmask);
+
 int doroute(NET net, u_char stage, u_char graphdebug)
 {
-  POINT gpoint;
-  ROUTE rt1, lrt;
+  ROUTE lrt, newrt, oldrt;
   NETLIST nlist;
-  int result, lastlayer, unroutable;
-  struct routeinfo_ iroute;
+  u_char globalmask;
+  int result;
 
   if (!net) {
      Fprintf(stderr, "doroute():  no net to route.\n");
      return 0;
   }
 
+  for (lrt = net->routes; lrt && lrt->next; lrt = lrt->next);
+
+  globalmask = (stage == (u_char)0) ? TRUE : FALSE;
+  result = doroute_mask(net, stage, graphdebug, &globalmask);
+
+  // doroute_mask() puts the net on FailedNets if any route failed.
+
+  if (!globalmask || (FailedNets == NULL) || (FailedNets->net != net))
+     return result;
+
+  if (Verbose > 1)
+     Fprintf(stdout, "Net %s failed inside its global route, retrying.\n",
+		net->netname);
+
+  while (FailedNets && (FailedNets->net == net)) {
+     nlist = FailedNets->next;
+     free(FailedNets);
+     FailedNets = nlist;
+  }
+
+  // Rip up only the routes made above, then put back any routes
+  // that the net had before, which may share end points with them.
+
+  newrt = (lrt) ? lrt->next : net->routes;
+  if (newrt != NULL) {
+     oldrt = (lrt) ? net->routes : NULL;
+     if (lrt) lrt->next = NULL;
+     net->routes = newrt;
+     ripup_net(net, (u_char)1);
+     net->routes = oldrt;
+     writeback_all_routes(net);
+  }
+
+  globalmask = FALSE;
+  return doroute_mask(net, stage, graphdebug, &globalmask);
+}
+
+/*--------------------------------------------------------------*/
+/* doroute_mask ---						*/
+/*								*/
+/* Route "net" as described for doroute().  If "*globalmask"	*/
+/* is TRUE, the route mask may be made from the global route	*/
+/* of the net;  on return it is TRUE only if it was.		*/
+/*--------------------------------------------------------------*/
+
+static int doroute_mask(NET net, u_char stage, u_char graphdebug,
+		u_char *globalmask)
+{
+  POINT gpoint;
+  ROUTE rt1, lrt;
+  NETLIST nlist;
+  int result, lastlayer, unroutable;
+  struct routeinfo_ iroute;
+
   CurNet = net;				// Global, used by 2nd stage
 
   // Fill out route information record
@@ -1651,6 +1797,7 @@ int doroute(NET net, u_char stage, u_char graphdebug)
   iroute.maxcost = MAXRT;
   iroute.do_pwrbus = (u_char)0;
   iroute.pwrbus_src = 0;
+  iroute.globalmask = *globalmask;
 
   lastlayer = -1;
 
@@ -1658,6 +1805,7 @@ int doroute(NET net, u_char stage, u_char graphdebug)
 
   result = route_setup(&iroute, stage);
   unroutable = result - 1;
+  *globalmask = iroute.globalmask;
   if (graphdebug) highlight_mask();
 
   // Keep going until we are unable to route to a terminal
@@ -1702,7 +1850,7 @@ int doroute(NET net, u_char stage, u_char graphdebug)
         else {
 	   net->routes = rt1;
         }
-        draw_net(net, TRUE, &lastlayer);
+        if (!WorkerThread) draw_net(net, TRUE, &lastlayer);
      }
 
      // For power routing, clear the list of existing pending route
@@ -1712,7 +1860,7 @@ int doroute(NET net, u_char stage, u_char graphdebug)
         while (iroute.glist) {
            gpoint = iroute.glist;
            iroute.glist = iroute.glist->next;
-           free(gpoint);
+           freePOINT(gpoint);
         }
      }
 
@@ -1725,7 +1873,7 @@ int doroute(NET net, u_char stage, u_char graphdebug)
   while (iroute.glist) {
      gpoint = iroute.glist;
      iroute.glist = iroute.glist->next;
-     free(gpoint);
+     freePOINT(gpoint);
   }
 
   /* Route failure due to no taps or similar error---Log it */
@@ -1739,7 +1887,7 @@ int doroute(NET net, u_char stage, u_char graphdebug)
   }
   return result;
   
-} /* doroute() */
+} /* doroute_mask() */
 
 /*--------------------------------------------------------------*/
 /* Catch-all routine when no tap points are found.  This is a	*/
@@ -1826,12 +1974,14 @@ int next_route_setup(struct routeinfo_ *iroute, u_char stage)
      // used for crossover costing of future routes.
 
      for (i = 0; i < Num_layers; i++) {
-        for (x = 0; x < NumChannelsX[i]; x++) {
-	   for (y = 0; y < NumChannelsY[i]; y++) {
-	      node = Nodeloc[i][OGRID(x, y, i)];
+        for (x = RouteWindow.x1; x <= RouteWindow.x2; x++) {
+	   if (x >= NumChannelsX[i]) break;
+	   for (y = RouteWindow.y1; y <= RouteWindow.y2; y++) {
+	      if (y >= NumChannelsY[i]) break;
+	      node = NODELOC(x, y, i);
 	      if (node != (NODE)NULL)
 		 if (node->netnum == iroute->net->netnum)
-		    Nodeloc[i][OGRID(x, y, i)] = (NODE)NULL;
+		    SetNodeinfo(x, y, i)->nodeloc = (NODE)NULL;
 	   }
         }
      }
@@ -1839,7 +1989,7 @@ int next_route_setup(struct routeinfo_ *iroute, u_char stage)
      while (iroute->glist) {
 	gpoint = iroute->glist;
 	iroute->glist = iroute->glist->next;
-	free(gpoint);
+	freePOINT(gpoint);
      }
      return 0;
   }
@@ -1883,11 +2033,14 @@ int route_setup(struct routeinfo_ *iroute, u_char stage)
   PROUTE *Pr;
 
   // Make Obs2[][] a copy of Obs[][].  Convert pin obstructions to
-  // terminal positions for the net being routed.
+  // terminal positions for the net being routed.  Only the part of
+  // the grid inside the route window is needed.
 
   for (i = 0; i < Num_layers; i++) {
-      for (x = 0; x < NumChannelsX[i]; x++) {
-	  for (y = 0; y < NumChannelsY[i]; y++) {
+      for (x = RouteWindow.x1; x <= RouteWindow.x2; x++) {
+	  if (x >= NumChannelsX[i]) break;
+	  for (y = RouteWindow.y1; y <= RouteWindow.y2; y++) {
+	      if (y >= NumChannelsY[i]) break;
 	      netnum = Obs[i][OGRID(x, y, i)] & (~BLOCKED_MASK);
 	      Pr = &Obs2[i][OGRID(x, y, i)];
 	      if (netnum != 0) {
@@ -2005,12 +2158,14 @@ int route_setup(struct routeinfo_ *iroute, u_char stage)
      // used for crossover costing of future routes.
 
      for (i = 0; i < Num_layers; i++) {
-        for (x = 0; x < NumChannelsX[i]; x++) {
-	   for (y = 0; y < NumChannelsY[i]; y++) {
-	      iroute->nsrc = Nodeloc[i][OGRID(x, y, i)];
+        for (x = RouteWindow.x1; x <= RouteWindow.x2; x++) {
+	   if (x >= NumChannelsX[i]) break;
+	   for (y = RouteWindow.y1; y <= RouteWindow.y2; y++) {
+	      if (y >= NumChannelsY[i]) break;
+	      iroute->nsrc = NODELOC(x, y, i);
 	      if (iroute->nsrc != (NODE)NULL)
 		 if (iroute->nsrc->netnum == iroute->net->netnum)
-		    Nodeloc[i][OGRID(x, y, i)] = (NODE)NULL;
+		    SetNodeinfo(x, y, i)->nodeloc = (NODE)NULL;
 	   }
         }
      }
@@ -2018,17 +2173,21 @@ int route_setup(struct routeinfo_ *iroute, u_char stage)
      while (iroute->glist) {
 	gpoint = iroute->glist;
 	iroute->glist = iroute->glist->next;
-	free(gpoint);
+	freePOINT(gpoint);
      }
      return 0;
   }
 
   // Generate a search area mask representing the "likely best route".
+  // If there is a global route and it may be used (see doroute()),
+  // the mask is the net's corridor.
   if ((iroute->do_pwrbus == FALSE) && (maskMode == MASK_AUTO)) {
-     if (stage == 0)
-	createMask(iroute->net, MASK_SMALL, (u_char)Numpasses);
-     else
-	createMask(iroute->net, MASK_LARGE, (u_char)Numpasses);
+     if (iroute->globalmask)
+	iroute->globalmask = createGlobalMask(iroute->net, MASK_SMALL,
+		(u_char)Numpasses);
+     if (!iroute->globalmask)
+	createMask(iroute->net, (stage == 0) ? MASK_SMALL : MASK_LARGE,
+		(u_char)Numpasses);
   }
   else if ((iroute->do_pwrbus == TRUE) || (maskMode == MASK_NONE))
      fillMask((u_char)0);
@@ -2037,13 +2196,15 @@ int route_setup(struct routeinfo_ *iroute, u_char stage)
   else
      createMask(iroute->net, maskMode, (u_char)Numpasses);
 
+  if ((iroute->do_pwrbus == TRUE) || (maskMode != MASK_AUTO))
+     iroute->globalmask = FALSE;
+
   // Heuristic:  Set the initial cost beyond which we stop searching.
   // This value is twice the cost of a direct route across the
   // maximum extent of the source to target, divided by the square
   // root of the number of nodes in the net.  We purposely set this
-  // value low.  It has a severe impact on the total run time of the
-  // algorithm.  If the initial max cost is so low that no route can
-  // be found, it will be doubled on each pass.
+  // value low.  If no route can be found under it, it is doubled,
+  // up to Numpasses times (see route_segs()).
 
   if (iroute->do_pwrbus)
      iroute->maxcost = 20;	// Maybe make this SegCost * row height?
@@ -2083,10 +2244,101 @@ int route_setup(struct routeinfo_ *iroute, u_char stage)
   return (unroutable + 1);
 }
 
+/*--------------------------------------------------------------*/
+/* find_target_bound ---					*/
+/*								*/
+/* Record the grid extents and range of layers of all positions	*/
+/* of "net" that are currently marked as PR_TARGET.  These are	*/
+/* used to compute the lower bound on the remaining route cost	*/
+/* in the A* search.  Returns 0 if no bound can be computed,	*/
+/* (e.g., for the power bus, where every position on the bus is	*/
+/* a target), in which case the search degenerates gracefully	*/
+/* into a plain lowest-cost-first search.			*/
+/*--------------------------------------------------------------*/
+
+static int find_target_bound(NET net, SEG tbox, int *laymin, int *laymax)
+{
+   NODE node;
+   DPOINT ntap;
+   PROUTE *Pr;
+   int pass, found = 0;
+
+   tbox->x1 = NumChannelsX[0];
+   tbox->y1 = NumChannelsY[0];
+   tbox->x2 = tbox->y2 = -1;
+   *laymin = Num_layers;
+   *laymax = -1;
+
+   for (node = net->netnodes; node; node = node->next) {
+      for (pass = 0; pass < 2; pass++) {
+	 ntap = (pass == 0) ? node->taps : node->extend;
+	 for (; ntap; ntap = ntap->next) {
+	    Pr = &Obs2[ntap->layer][OGRID(ntap->gridx, ntap->gridy, ntap->layer)];
+	    if (!(Pr->flags & PR_TARGET)) continue;
+	    if (ntap->gridx < tbox->x1) tbox->x1 = ntap->gridx;
+	    if (ntap->gridx > tbox->x2) tbox->x2 = ntap->gridx;
+	    if (ntap->gridy < tbox->y1) tbox->y1 = ntap->gridy;
+	    if (ntap->gridy > tbox->y2) tbox->y2 = ntap->gridy;
+	    if (ntap->layer < *laymin) *laymin = ntap->layer;
+	    if (ntap->layer > *laymax) *laymax = ntap->layer;
+	    found = 1;
+	 }
+      }
+   }
+   return found;
+}
+
+/*--------------------------------------------------------------*/
+/* route_bound ---						*/
+/*								*/
+/* Lower bound on the cost of routing from grid position "pt"	*/
+/* to the nearest target:  The manhattan distance to the target	*/
+/* extents at the cheapest cost of a single step, plus one via	*/
+/* for each layer between "pt" and the target layers.  This	*/
+/* never overestimates the true cost, and it changes by no more	*/
+/* than the cost of a step between neighboring positions, so	*/
+/* the first target taken off the search queue is the lowest-	*/
+/* cost route.							*/
+/*--------------------------------------------------------------*/
+
+static u_int route_bound(GRIDP *pt, SEG tbox, int laymin, int laymax,
+		int stepcost)
+{
+   u_int bound = 0;
+
+   if (pt->x < tbox->x1) bound += tbox->x1 - pt->x;
+   else if (pt->x > tbox->x2) bound += pt->x - tbox->x2;
+   if (pt->y < tbox->y1) bound += tbox->y1 - pt->y;
+   else if (pt->y > tbox->y2) bound += pt->y - tbox->y2;
+   bound *= stepcost;
+
+   if (pt->lay < laymin) bound += (laymin - pt->lay) * ViaCost;
+   else if (pt->lay > laymax) bound += (pt->lay - laymax) * ViaCost;
+
+   return bound;
+}
+
 /*--------------------------------------------------------------*/
 /* route_segs - detailed route from node to node using onestep	*/
 /*	method   						*/
 /*								*/
+/* The search is a single best-first (A*) sweep over the grid.	*/
+/* Positions are taken off a priority queue in order of route	*/
+/* cost plus a lower bound on the cost remaining to the nearest	*/
+/* target (see route_bound()), so the first target reached is	*/
+/* the minimum-cost route, and positions that cannot improve on	*/
+/* it are never expanded.  The queue is seeded from the list	*/
+/* iroute->glist, and positions left unexpanded are returned on	*/
+/* the same list so that the next route of the same net can	*/
+/* resume the search from there.				*/
+/*								*/
+/* The search is limited to positions whose cost plus bound	*/
+/* does not exceed iroute->maxcost.  When the limit is reached	*/
+/* it is doubled, up to Numpasses times, after which the route	*/
+/* fails.  In the first stage, positions outside the route	*/
+/* mask halo are not expanded at all.  Together, these keep an	*/
+/* unroutable net from expanding the entire grid before failing.	*/
+/*								*/
 /*   ARGS: ROUTE, ready to add segments to do route		*/
 /*   RETURNS: NULL if failed, manhattan distance if success	*/
 /*   SIDE EFFECTS: 						*/
@@ -2095,298 +2347,216 @@ int route_setup(struct routeinfo_ *iroute, u_char stage)
 
 int route_segs(struct routeinfo_ *iroute, u_char stage, u_char graphdebug)
 {
-  POINT gpoint, gunproc;
-  SEG  seg;
-  int  i, j, k, o;
-  int  x, y;
-  int  pass, maskpass;
-  u_int forbid;
-  GRIDP best, curpt;
-  int  result, rval;
-  u_char first = (u_char)1;
+  POINT gpoint, masked;
+  int  i, o;
+  int  laymin, laymax, stepcost, expanded, pass;
+  u_int forbid, key, limit;
+  GRIDP curpt, newpt;
+  struct seg_ tbox;
+  int  rval;
   u_char check_order[6];
-  u_char max_reached;
+  u_char bounded;
   PROUTE *Pr;
 
-  best.cost = MAXRT;
-  best.x = 0;
-  best.y = 0;
-  best.lay = 0;
-  gunproc = (POINT)NULL;
-  maskpass = 0;
-  
-  for (pass = 0; pass < Numpasses; pass++) {
-
-    max_reached = (u_char)0;
-    if (!first && (Verbose > 2)) {
-       Fprintf(stdout, "\n");
-       first = (u_char)1;
-    }
-    if (Verbose > 2) {
-       Fprintf(stdout, "Pass %d", pass + 1);
-       Fprintf(stdout, " (maxcost is %d)\n", iroute->maxcost);
-    }
-
-    while (gpoint = iroute->glist) {
-
-      iroute->glist = gpoint->next;
-
-      curpt.x = gpoint->x1;
-      curpt.y = gpoint->y1;
-      curpt.lay = gpoint->layer;
-
-      if (graphdebug) highlight(curpt.x, curpt.y);
-	
-      Pr = &Obs2[curpt.lay][OGRID(curpt.x, curpt.y, curpt.lay)];
-
-      // ignore grid positions that have already been processed
-      if (Pr->flags & PR_PROCESSED) {
-	 free(gpoint);
-	 continue;
-      }
+  // Lower bound on the cost to reach a target.  No planar step
+  // costs less than the cheaper of a segment or a jog.
 
-      if (Pr->flags & PR_COST)
-	 curpt.cost = Pr->prdata.cost;	// Route points, including target
-      else
-	 curpt.cost = 0;			// For source tap points
+  bounded = (iroute->do_pwrbus == FALSE) &&
+		find_target_bound(iroute->net, &tbox, &laymin, &laymax);
+  stepcost = MIN(SegCost, JogCost);
 
-      // if the grid position is the destination, save the position and
-      // cost if minimum.
+  // Seed the search queue with the pending positions (the source
+  // and any positions left unexpanded by the last search).
 
-      if (Pr->flags & PR_TARGET) {
+  while ((gpoint = iroute->glist) != NULL) {
+     iroute->glist = gpoint->next;
+     curpt.x = gpoint->x1;
+     curpt.y = gpoint->y1;
+     curpt.lay = gpoint->layer;
+     freePOINT(gpoint);
 
- 	 if (curpt.cost < best.cost) {
-	    if (first) {
-	       if (Verbose > 2)
-		  Fprintf(stdout, "Found a route of cost ");
-	       first = (u_char)0;
-	    }
-	    else if (Verbose > 2) {
-	       Fprintf(stdout, "|");
-	       Fprintf(stdout, "%d", curpt.cost);
-	       Flush(stdout);
-	    }
+     Pr = &Obs2[curpt.lay][OGRID(curpt.x, curpt.y, curpt.lay)];
+     if (Pr->flags & PR_PROCESSED) continue;
+     if (Pr->flags & PR_COST)
+	curpt.cost = Pr->prdata.cost;	// Route points, including target
+     else
+	curpt.cost = 0;			// For source tap points
+     if (curpt.cost >= MAXRT) continue;
 
-	    // This position may be on a route, not at a terminal, so
-	    // record it.
-	    best.x = curpt.x;
-	    best.y = curpt.y;
-	    best.lay = curpt.lay;
-	    best.cost = curpt.cost;
+     gheap_push(&curpt, (bounded) ? route_bound(&curpt, &tbox, laymin,
+		laymax, stepcost) : 0);
+  }
 
-	    // If a complete route has been found, then there's no point
-	    // in searching paths with a greater cost than this one.
-	    if (best.cost < iroute->maxcost) iroute->maxcost = best.cost;
-	 }
+  expanded = 0;
+  rval = -1;
+  pass = 1;
+  limit = (u_int)iroute->maxcost;
+  masked = (POINT)NULL;
+
+  while (gheap_key(&key)) {
+
+     // Quick check:  Limit maximum cost to limit search space.
+     // Positions beyond the limit stay on the queue, and are
+     // returned with the unexpanded positions if the route fails.
+
+     if (key > limit) {
+	if ((++pass > Numpasses) || (limit > MAXRT)) break;
+	limit <<= 1;
+	iroute->maxcost = (int)limit;
+	if (Verbose > 2)
+	   Fprintf(stdout, "Pass %d (maxcost is %d)\n", pass, (int)limit);
+	continue;
+     }
+     gheap_pop(&curpt);
 
-         // Don't continue processing from the target
-	 Pr->flags |= PR_PROCESSED;
-	 free(gpoint);
-	 continue;
-      }
+     if (graphdebug) highlight(curpt.x, curpt.y);
 
-      if (curpt.cost < MAXRT) {
+     Pr = &Obs2[curpt.lay][OGRID(curpt.x, curpt.y, curpt.lay)];
 
-	 // Severely limit the search space by not processing anything that
-	 // is not under the current route mask, which identifies a narrow
-	 // "best route" solution.
+     // Ignore grid positions that have already been processed.  This
+     // includes stale queue entries for positions that were queued
+     // again after their cost was lowered.
 
-	 if (RMask[OGRID(curpt.x, curpt.y, 0)] > (u_char)maskpass) {
-	    gpoint->next = gunproc;
-	    gunproc = gpoint;
-	    continue;
-	 }
+     if (Pr->flags & PR_PROCESSED) continue;
 
-         // Quick check:  Limit maximum cost to limit search space
-         // Move the point onto the "unprocessed" stack and we'll pick up
-         // from this point on the next pass, if needed.
+     if (Pr->flags & PR_COST)
+	curpt.cost = Pr->prdata.cost;
+     else
+	curpt.cost = 0;
+
+     // In the first stage, do not search outside of the route mask.
+     // Masked positions are returned with the unexpanded positions.
+
+     if ((stage == (u_char)0) && (RMask[OGRID(curpt.x, curpt.y, 0)]
+		>= (u_char)Numpasses)) {
+	gpoint = allocPOINT();
+	gpoint->x1 = curpt.x;
+	gpoint->y1 = curpt.y;
+	gpoint->layer = curpt.lay;
+	gpoint->next = masked;
+	masked = gpoint;
+	continue;
+     }
 
-         if (curpt.cost > iroute->maxcost) {
-	    max_reached = (u_char)1;
-	    gpoint->next = gunproc;
-	    gunproc = gpoint;
-	    continue;
-	 }
-      }
-      free(gpoint);
+     // The first target taken off the queue is the best route.
 
-      // check east/west/north/south, and bottom to top
+     if (Pr->flags & PR_TARGET) {
+	Pr->flags |= PR_PROCESSED;
+	if (Verbose > 2)
+	   Fprintf(stdout, "Found a route of cost %d after expanding %d "
+			"positions\n", curpt.cost, expanded);
 
-      // 1st optimization:  Direction of route on current layer is preferred.
-      o = LefGetRouteOrientation(curpt.lay);
-      forbid = Obs[curpt.lay][OGRID(curpt.x, curpt.y, curpt.lay)] & BLOCKED_MASK;
+	if ((rval = commit_proute(iroute->rt, &curpt, stage)) != 1) {
+	   rval = -1;
+	   break;
+	}
+	if (Verbose > 2) {
+	   Fprintf(stdout, "Commit to a route of cost %d\n", Pr->prdata.cost);
+	   Fprintf(stdout, "Between positions (%d %d) and (%d %d)\n",
+			curpt.x, curpt.y, iroute->nsrctap->gridx,
+			iroute->nsrctap->gridy);
+	}
+	break;		/* route success */
+     }
+     expanded++;
 
-      if (o == 1) {			// horizontal routes---check EAST and WEST first
-	 check_order[0] = (forbid & BLOCKED_E) ? 0 : EAST;
-	 check_order[1] = (forbid & BLOCKED_W) ? 0 : WEST;
-	 check_order[2] = UP;
-	 check_order[3] = DOWN;
-	 check_order[4] = (forbid & BLOCKED_N) ? 0 : NORTH;
-	 check_order[5] = (forbid & BLOCKED_S) ? 0 : SOUTH;
-      }
-      else {				// vertical routes---check NORTH and SOUTH first
-	 check_order[0] = (forbid & BLOCKED_N) ? 0 : NORTH;
-	 check_order[1] = (forbid & BLOCKED_S) ? 0 : SOUTH;
-	 check_order[2] = UP;
-	 check_order[3] = DOWN;
-	 check_order[4] = (forbid & BLOCKED_E) ? 0 : EAST;
-	 check_order[5] = (forbid & BLOCKED_W) ? 0 : WEST;
-      }
+     // check east/west/north/south, and bottom to top
 
-      // Check order is from 0 (1st priority) to 5 (last priority).  However, this
-      // is a stack system, so the last one placed on the stack is the first to be
-      // pulled and processed.  Therefore we evaluate and drop positions to check
-      // on the stack in reverse order (5 to 0).
-
-      for (i = 5; i >= 0; i--) {
-	 switch (check_order[i]) {
-	    case EAST:
-               if ((curpt.x + 1) < NumChannelsX[curpt.lay]) {
-         	  if ((result = eval_pt(&curpt, PR_PRED_W, stage)) == 1) {
-         	     gpoint = (POINT)malloc(sizeof(struct point_));
-         	     gpoint->x1 = curpt.x + 1;
-         	     gpoint->y1 = curpt.y;
-         	     gpoint->layer = curpt.lay;
-         	     gpoint->next = iroute->glist;
-         	     iroute->glist = gpoint;
-                   }
-               }
-	       break;
-
-	    case WEST:
-               if ((curpt.x - 1) >= 0) {
-         	  if ((result = eval_pt(&curpt, PR_PRED_E, stage)) == 1) {
-         	     gpoint = (POINT)malloc(sizeof(struct point_));
-         	     gpoint->x1 = curpt.x - 1;
-         	     gpoint->y1 = curpt.y;
-         	     gpoint->layer = curpt.lay;
-         	     gpoint->next = iroute->glist;
-         	     iroute->glist = gpoint;
-                  }
-               }
-	       break;
-         
-	    case SOUTH:
-               if ((curpt.y - 1) >= 0) {
-         	  if ((result = eval_pt(&curpt, PR_PRED_N, stage)) == 1) {
-         	     gpoint = (POINT)malloc(sizeof(struct point_));
-         	     gpoint->x1 = curpt.x;
-         	     gpoint->y1 = curpt.y - 1;
-         	     gpoint->layer = curpt.lay;
-         	     gpoint->next = iroute->glist;
-         	     iroute->glist = gpoint;
-                   }
-               }
-	       break;
-
-	    case NORTH:
-               if ((curpt.y + 1) < NumChannelsY[curpt.lay]) {
-         	  if ((result = eval_pt(&curpt, PR_PRED_S, stage)) == 1) {
-         	     gpoint = (POINT)malloc(sizeof(struct point_));
-         	     gpoint->x1 = curpt.x;
-         	     gpoint->y1 = curpt.y + 1;
-         	     gpoint->layer = curpt.lay;
-         	     gpoint->next = iroute->glist;
-         	     iroute->glist = gpoint;
-                  }
-               }
-	       break;
-      
-	    case DOWN:
-               if (curpt.lay > 0) {
-         	  if ((result = eval_pt(&curpt, PR_PRED_U, stage)) == 1) {
-         	     gpoint = (POINT)malloc(sizeof(struct point_));
-         	     gpoint->x1 = curpt.x;
-         	     gpoint->y1 = curpt.y;
-         	     gpoint->layer = curpt.lay - 1;
-         	     gpoint->next = iroute->glist;
-         	     iroute->glist = gpoint;
-         	  }
-               }
-	       break;
-         
-	    case UP:
-               if (curpt.lay < (Num_layers - 1)) {
-         	  if ((result = eval_pt(&curpt, PR_PRED_D, stage)) == 1) {
-         	     gpoint = (POINT)malloc(sizeof(struct point_));
-         	     gpoint->x1 = curpt.x;
-         	     gpoint->y1 = curpt.y;
-         	     gpoint->layer = curpt.lay + 1;
-         	     gpoint->next = iroute->glist;
-         	     iroute->glist = gpoint;
-         	  }
-               }
-	       break;
-            }
-         }
-
-      // Mark this node as processed
-      Pr->flags |= PR_PROCESSED;
-
-    } // while stack is not empty
-
-    while (iroute->glist) {
-       gpoint = iroute->glist;
-       iroute->glist = iroute->glist->next;
-       free(gpoint);
-    }
+     // 1st optimization:  Direction of route on current layer is preferred.
+     o = LefGetRouteOrientation(curpt.lay);
+     forbid = Obs[curpt.lay][OGRID(curpt.x, curpt.y, curpt.lay)] & BLOCKED_MASK;
 
-    // If we found a route, save it and return
+     if (o == 1) {			// horizontal routes---check EAST and WEST first
+	check_order[0] = (forbid & BLOCKED_E) ? 0 : EAST;
+	check_order[1] = (forbid & BLOCKED_W) ? 0 : WEST;
+	check_order[2] = UP;
+	check_order[3] = DOWN;
+	check_order[4] = (forbid & BLOCKED_N) ? 0 : NORTH;
+	check_order[5] = (forbid & BLOCKED_S) ? 0 : SOUTH;
+     }
+     else {				// vertical routes---check NORTH and SOUTH first
+	check_order[0] = (forbid & BLOCKED_N) ? 0 : NORTH;
+	check_order[1] = (forbid & BLOCKED_S) ? 0 : SOUTH;
+	check_order[2] = UP;
+	check_order[3] = DOWN;
+	check_order[4] = (forbid & BLOCKED_E) ? 0 : EAST;
+	check_order[5] = (forbid & BLOCKED_W) ? 0 : WEST;
+     }
 
-    if (best.cost <= iroute->maxcost) {
-	curpt.x = best.x;
-	curpt.y = best.y;
-	curpt.lay = best.lay;
-	if ((rval = commit_proute(iroute->rt, &curpt, stage)) != 1) break;
-	if (Verbose > 2) {
-	   Fprintf(stdout, "\nCommit to a route of cost %d\n", best.cost);
-	   Fprintf(stdout, "Between positions (%d %d) and (%d %d)\n",
-			best.x, best.y, curpt.x, curpt.y);
+     for (i = 0; i < 6; i++) {
+	newpt = curpt;
+	switch (check_order[i]) {
+	   case EAST:
+	      if ((curpt.x + 1) >= NumChannelsX[curpt.lay]) continue;
+	      if ((curpt.x + 1) > RouteWindow.x2) continue;
+	      if (eval_pt(&curpt, PR_PRED_W, stage) != 1) continue;
+	      newpt.x++;
+	      break;
+
+	   case WEST:
+	      if ((curpt.x - 1) < RouteWindow.x1) continue;
+	      if (eval_pt(&curpt, PR_PRED_E, stage) != 1) continue;
+	      newpt.x--;
+	      break;
+
+	   case SOUTH:
+	      if ((curpt.y - 1) < RouteWindow.y1) continue;
+	      if (eval_pt(&curpt, PR_PRED_N, stage) != 1) continue;
+	      newpt.y--;
+	      break;
+
+	   case NORTH:
+	      if ((curpt.y + 1) >= NumChannelsY[curpt.lay]) continue;
+	      if ((curpt.y + 1) > RouteWindow.y2) continue;
+	      if (eval_pt(&curpt, PR_PRED_S, stage) != 1) continue;
+	      newpt.y++;
+	      break;
+
+	   case DOWN:
+	      if (curpt.lay <= 0) continue;
+	      if (eval_pt(&curpt, PR_PRED_U, stage) != 1) continue;
+	      newpt.lay--;
+	      break;
+
+	   case UP:
+	      if (curpt.lay >= (Num_layers - 1)) continue;
+	      if (eval_pt(&curpt, PR_PRED_D, stage) != 1) continue;
+	      newpt.lay++;
+	      break;
+
+	   default:
+	      continue;
 	}
-	goto done;	/* route success */
-    }
-
-    // Continue loop to next pass if any positions were ignored due to
-    // masking or due to exceeding maxcost.
 
-    // If the cost of the route exceeded maxcost at one or more locations,
-    // then increase maximum cost for next pass.
+	// Position got a lower cost, so (re)queue it.
+	newpt.cost = Obs2[newpt.lay][OGRID(newpt.x, newpt.y, newpt.lay)].prdata.cost;
+	if (newpt.cost < MAXRT)
+	   gheap_push(&newpt, (bounded) ? route_bound(&newpt, &tbox, laymin,
+			laymax, stepcost) : 0);
+     }
 
-    if (max_reached == (u_char)1) {
-       iroute->maxcost <<= 1;
-       // Cost overflow;  we're probably completely hosed long before this.
-       if (iroute->maxcost > MAXRT) break;
-    }
-    else
-       maskpass++;			// Increase the mask size
+     // Mark this node as processed
+     Pr->flags |= PR_PROCESSED;
 
-    if (gunproc == NULL) break;		// route failure not due to limiting
-					// search to maxcost or to masking
+  } // while queue is not empty
 
-    // Regenerate the stack of unprocessed nodes
-    iroute->glist = gunproc;
-    gunproc = NULL;
-    
-  } // pass
-  
-  if (!first && (Verbose > 2)) {
-     Fprintf(stdout, "\n");
-     Flush(stdout);
-  }
-  if (Verbose > 1) {
-     Fprintf(stderr, "Fell through %d passes\n", pass);
-  }
-  if (!iroute->do_pwrbus && (Verbose > 2)) {
-     Fprintf(stderr, "(%g,%g) net=%s\n",
+  if (rval < 0) {
+     if (Verbose > 1)
+	Fprintf(stderr, "Search failed after expanding %d positions\n",
+			expanded);
+     if (!iroute->do_pwrbus && (Verbose > 2)) {
+	Fprintf(stderr, "(%g,%g) net=%s\n",
 		iroute->nsrctap->x, iroute->nsrctap->y, iroute->net->netname);
+     }
   }
-  rval = -1;
 
-done:
-  
-  // Regenerate the stack of unprocessed nodes
-  iroute->glist = gunproc;
-  gunproc = NULL;
+  // Return the unexpanded positions for the next route of this net.
+  gheap_drain(&iroute->glist);
+  while ((gpoint = masked) != NULL) {
+     masked = gpoint->next;
+     gpoint->next = iroute->glist;
+     iroute->glist = gpoint;
+  }
   return rval;
   
 } /* route_segs() */
@@ -2458,14 +2628,14 @@ void cleanup_net(NET net)
 	       lf = segf->layer;
 	       fcheck = (lf != layer && lf != layer - 1) ? FALSE : TRUE;
 	       // We're going to remove the contact so it can't be a tap
-	       if (Nodesav[lf][OGRID(segf->x1, segf->y1, lf)] != NULL)
+	       if (NODESAV(segf->x1, segf->y1, lf) != NULL)
 		  fcheck = FALSE;
 	    }
 	    if (segl && (segl->segtype & ST_VIA)) {
 	       ll = segl->layer;
 	       lcheck = (ll != layer && ll != layer - 1) ? FALSE : TRUE;
 	       // We're going to remove the contact so it can't be a tap
-	       if (Nodesav[ll][OGRID(segl->x1, segl->y1, ll)] != NULL)
+	       if (NODESAV(segl->x1, segl->y1, ll) != NULL)
 		  lcheck = FALSE;
 	    }
 	    if (fcheck == FALSE && lcheck == FALSE) continue;
@@ -2638,18 +2808,18 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 	       if ((special == (u_char)0) && (Verbose > 2))
 		  Fprintf(stdout, "Stub route distance %g to terminal"
 				" at %d %d (%d)\n",
-				Stub[layer][OGRID(seg->x1, seg->y1, layer)],
+				STUBDIST(seg->x1, seg->y1, layer),
 				seg->x1, seg->y1, layer);
 
 	       dc = Xlowerbound + (double)seg->x1 * PitchX[layer];
 	       x = (int)((REPS(dc)) * oscale);
 	       if (dir1 == STUBROUTE_EW)
-		  dc += Stub[layer][OGRID(seg->x1, seg->y1, layer)];
+		  dc += STUBDIST(seg->x1, seg->y1, layer);
 	       x2 = (int)((REPS(dc)) * oscale);
 	       dc = Ylowerbound + (double)seg->y1 * PitchY[layer];
 	       y = (int)((REPS(dc)) * oscale);
 	       if (dir1 == STUBROUTE_NS)
-		  dc += Stub[layer][OGRID(seg->x1, seg->y1, layer)];
+		  dc += STUBDIST(seg->x1, seg->y1, layer);
 	       y2 = (int)((REPS(dc)) * oscale);
 	       if (dir1 == STUBROUTE_EW) {
 		  horizontal = TRUE;
@@ -2670,7 +2840,7 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 		     tdir = Obs[layer][OGRID(seg->x1 + 1, seg->y1, layer)];
 		     if ((tdir & ~PINOBSTRUCTMASK) ==
 					(net->netnum | ROUTED_NET)) {
-			if (Stub[layer][OGRID(seg->x1, seg->y1, layer)] +
+			if (STUBDIST(seg->x1, seg->y1, layer) +
 					LefGetRouteKeepout(layer) >= PitchX[layer]) {
 		      	   dc = Xlowerbound + (double)(seg->x1 + 1)
 					* PitchX[layer];
@@ -2682,7 +2852,7 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 		     tdir = Obs[layer][OGRID(seg->x1 - 1, seg->y1, layer)];
 		     if ((tdir & ~PINOBSTRUCTMASK) ==
 					(net->netnum | ROUTED_NET)) {
-			if (-Stub[layer][OGRID(seg->x1, seg->y1, layer)] +
+			if (-STUBDIST(seg->x1, seg->y1, layer) +
 					LefGetRouteKeepout(layer) >= PitchX[layer]) {
 		      	   dc = Xlowerbound + (double)(seg->x1 - 1)
 					* PitchX[layer];
@@ -2730,7 +2900,7 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 		     tdir = Obs[layer][OGRID(seg->x1, seg->y1 + 1, layer)];
 		     if ((tdir & ~PINOBSTRUCTMASK) ==
 						(net->netnum | ROUTED_NET)) {
-			if (Stub[layer][OGRID(seg->x1, seg->y1, layer)] +
+			if (STUBDIST(seg->x1, seg->y1, layer) +
 					LefGetRouteKeepout(layer) >= PitchY[layer]) {
 		      	   dc = Ylowerbound + (double)(seg->y1 + 1)
 					* PitchY[layer];
@@ -2742,7 +2912,7 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 		     tdir = Obs[layer][OGRID(seg->x1, seg->y1 - 1, layer)];
 		     if ((tdir & ~PINOBSTRUCTMASK) ==
 						(net->netnum | ROUTED_NET)) {
-			if (-Stub[layer][OGRID(seg->x1, seg->y1, layer)] +
+			if (-STUBDIST(seg->x1, seg->y1, layer) +
 					LefGetRouteKeepout(layer) >= PitchY[layer]) {
 		      	   dc = Ylowerbound + (double)(seg->y1 - 1)
 					* PitchY[layer];
@@ -2807,11 +2977,10 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 	       if (dir1 == 0 && lastseg) {
 		  dir1 = Obs[lastseg->layer][OGRID(lastseg->x2, lastseg->y2,
 					lastseg->layer)] & PINOBSTRUCTMASK;
-		  offset1 = Stub[lastseg->layer][OGRID(lastseg->x2,
-					lastseg->y2, lastseg->layer)];
+		  offset1 = STUBDIST(lastseg->x2, lastseg->y2, lastseg->layer);
 	       }
 	       else
-		  offset1 = Stub[seg->layer][OGRID(seg->x1, seg->y1, seg->layer)];
+		  offset1 = STUBDIST(seg->x1, seg->y1, seg->layer);
 
 	       // Offset was calculated for vias;  plain metal routes
 	       // typically will need less offset distance, so subtract off
@@ -2844,11 +3013,10 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 		  dir2 = Obs[seg->next->layer][OGRID(seg->next->x1,
 					seg->next->y1, seg->next->layer)] &
 					PINOBSTRUCTMASK;
-		  offset2 = Stub[seg->next->layer][OGRID(seg->next->x1,
-					seg->next->y1, seg->next->layer)];
+		  offset2 = STUBDIST(seg->next->x1, seg->next->y1, seg->next->layer);
 	       }
 	       else
-		  offset2 = Stub[seg->layer][OGRID(seg->x2, seg->y2, seg->layer)];
+		  offset2 = STUBDIST(seg->x2, seg->y2, seg->layer);
 
 	       // Offset was calculated for vias;  plain metal routes
 	       // typically will need less offset distance, so subtract off
@@ -3101,18 +3269,18 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 		if ((special == (u_char)0) && (Verbose > 2))
 		   Fprintf(stdout, "Stub route distance %g to terminal"
 				" at %d %d (%d)\n",
-				Stub[layer][OGRID(seg->x2, seg->y2, layer)],
+				STUBDIST(seg->x2, seg->y2, layer),
 				seg->x2, seg->y2, layer);
 
 		dc = Xlowerbound + (double)seg->x2 * PitchX[layer];
 		x = (int)((REPS(dc)) * oscale);
 		if (dir2 == STUBROUTE_EW)
-		   dc += Stub[layer][OGRID(seg->x2, seg->y2, layer)];
+		   dc += STUBDIST(seg->x2, seg->y2, layer);
 		x2 = (int)((REPS(dc)) * oscale);
 		dc = Ylowerbound + (double)seg->y2 * PitchY[layer];
 		y = (int)((REPS(dc)) * oscale);
 		if (dir2 == STUBROUTE_NS)
-		   dc += Stub[layer][OGRID(seg->x2, seg->y2, layer)];
+		   dc += STUBDIST(seg->x2, seg->y2, layer);
 		y2 = (int)((REPS(dc)) * oscale);
 		if (dir2 == STUBROUTE_EW) {
 		   horizontal = TRUE;
@@ -3127,7 +3295,7 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 		      tdir = Obs[layer][OGRID(seg->x2 + 1, seg->y2, layer)];
 		      if ((tdir & ~PINOBSTRUCTMASK) ==
 						(net->netnum | ROUTED_NET)) {
-			 if (Stub[layer][OGRID(seg->x2, seg->y2, layer)] +
+			 if (STUBDIST(seg->x2, seg->y2, layer) +
 					LefGetRouteKeepout(layer) >= PitchX[layer]) {
 		      	    dc = Xlowerbound + (double)(seg->x2 + 1)
 					* PitchX[layer];
@@ -3139,7 +3307,7 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 		      tdir = Obs[layer][OGRID(seg->x2 - 1, seg->y2, layer)];
 		      if ((tdir & ~PINOBSTRUCTMASK) ==
 						(net->netnum | ROUTED_NET)) {
-			 if (-Stub[layer][OGRID(seg->x2, seg->y2, layer)] +
+			 if (-STUBDIST(seg->x2, seg->y2, layer) +
 					LefGetRouteKeepout(layer) >= PitchX[layer]) {
 		      	    dc = Xlowerbound + (double)(seg->x2 - 1)
 					* PitchX[layer];
@@ -3187,7 +3355,7 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 		      tdir = Obs[layer][OGRID(seg->x2, seg->y2 + 1, layer)];
 		      if ((tdir & ~PINOBSTRUCTMASK) ==
 						(net->netnum | ROUTED_NET)) {
-			 if (Stub[layer][OGRID(seg->x2, seg->y2, layer)] +
+			 if (STUBDIST(seg->x2, seg->y2, layer) +
 					LefGetRouteKeepout(layer) >= PitchY[layer]) {
 		      	    dc = Ylowerbound + (double)(seg->y2 + 1)
 					* PitchY[layer];
@@ -3199,7 +3367,7 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 		      tdir = Obs[layer][OGRID(seg->x2, seg->y2 - 1, layer)];
 		      if ((tdir & ~PINOBSTRUCTMASK) ==
 						(net->netnum | ROUTED_NET)) {
-			 if (-Stub[layer][OGRID(seg->x2, seg->y2, layer)] +
+			 if (-STUBDIST(seg->x2, seg->y2, layer) +
 					LefGetRouteKeepout(layer) >= PitchY[layer]) {
 		      	    dc = Ylowerbound + (double)(seg->y2 - 1)
 					* PitchY[layer];
@@ -3295,7 +3463,7 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 				0.5 * LefGetViaWidth(seg->layer, lastseg->layer, 1) -
 				0.5 * LefGetViaWidth(prevseg->layer, lastseg->layer, 1) -
 				(prevseg->x1 - seg->x1) *
-				Stub[seg->layer][OGRID(seg->x2, seg->y2, layer)])
+				STUBDIST(seg->x2, seg->y2, seg->layer))
 				< LefGetRouteSpacing(lastseg->layer)) {
 			      if (special == (u_char)0) {
 				 rt->flags |= RT_STUB;
@@ -3313,7 +3481,7 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 				0.5 * LefGetViaWidth(seg->layer, lastseg->layer, 0) -
 				0.5 * LefGetViaWidth(prevseg->layer, lastseg->layer, 0)
 				- (prevseg->y1 - seg->y1) *
-				Stub[seg->layer][OGRID(seg->x2, seg->y2, layer)])
+				STUBDIST(seg->x2, seg->y2, seg->layer))
 				< LefGetRouteSpacing(lastseg->layer)) {
 			      if (special == (u_char)0) {
 				 rt->flags |= RT_STUB;
@@ -3333,7 +3501,7 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 				0.5 * LefGetViaWidth(seg->layer, lastseg->layer, 1) -
 				0.5 * LefGetRouteWidth(prevseg->layer) -
 				(prevseg->x1 - seg->x1) *
-				Stub[seg->layer][OGRID(seg->x2, seg->y2, layer)])
+				STUBDIST(seg->x2, seg->y2, seg->layer))
 				< LefGetRouteSpacing(lastseg->layer)) {
 			      if (special == (u_char)0) {
 				 rt->flags |= RT_STUB;
@@ -3351,7 +3519,7 @@ emit_routed_net(FILE *Cmd, NET net, u_char special, double oscale, int iscale)
 				0.5 * LefGetViaWidth(seg->layer, lastseg->layer, 0) -
 				0.5 * LefGetRouteWidth(prevseg->layer) -
 				(prevseg->y1 - seg->y1) *
-				Stub[seg->layer][OGRID(seg->x2, seg->y2, layer)])
+				STUBDIST(seg->x2, seg->y2, seg->layer))
 				< LefGetRouteSpacing(lastseg->layer)) {
 			      if (special == (u_char)0) {
 				 rt->flags |= RT_STUB;
@@ -3606,6 +3774,8 @@ void helpmessage()
 	Fprintf(stdout, "\t-i <file>\t\t\tPrint route names and pitches and exit.\n");
 	Fprintf(stdout, "\t-p <name>\t\t\tSpecify global power bus name.\n");
 	Fprintf(stdout, "\t-g <name>\t\t\tSpecify global ground bus name.\n");
+	Fprintf(stdout, "\t-t <threads>\t\t\tNumber of threads for stage 1 routing.\n");
+	Fprintf(stdout, "\t-e <file>\t\t\tReuse unchanged routes from a routed DEF file.\n");
 	Fprintf(stdout, "\n");
     }
 #ifdef TCL_QROUTER
@@ -7,7 +7,24 @@
 
 #ifndef QROUTER_H
 
-#define OGRID(x, y, layer) ((int)((x) + ((y) * NumChannelsX[(layer)])))
+// Grid arrays are stored in square tiles of GRID_TILE x GRID_TILE
+// positions, tile rows first, so that the neighbors of a position in
+// both directions are usually close in memory.  Each layer array is
+// padded out to a whole number of tiles, which is GRIDSIZE(layer)
+// positions;  use it and not NumChannelsX * NumChannelsY to allocate.
+
+#define GRID_TILE_SHIFT	3
+#define GRID_TILE	(1 << GRID_TILE_SHIFT)
+#define GRID_TILE_MASK	(GRID_TILE - 1)
+#define GRID_PAD(n)	(((n) + GRID_TILE_MASK) & ~GRID_TILE_MASK)
+
+#define OGRID(x, y, layer) ((int)(((((y) >> GRID_TILE_SHIFT) * \
+		GRID_PAD(NumChannelsX[(layer)]) + ((x) & ~GRID_TILE_MASK) + \
+		((y) & GRID_TILE_MASK)) << GRID_TILE_SHIFT) + \
+		((x) & GRID_TILE_MASK)))
+#define GRIDSIZE(layer) (GRID_PAD(NumChannelsX[(layer)]) * \
+		GRID_PAD(NumChannelsY[(layer)]))
+
 #define MIN(x, y) (((x) < (y)) ? (x) : (y))
 #define MAX(x, y) (((x) > (y)) ? (x) : (y))
 #define ABSDIFF(x, y) (((x) > (y)) ? ((x) - (y)) : ((y) - (x)))
@@ -51,6 +68,18 @@ typedef unsigned long  u_long;
 /* Max reasonable line length */
 #define MAX_LINE_LEN    2048
 
+/* Maximum number of nets routed together in one parallel batch */
+#define MAX_BATCH	256
+
+/* Storage class for variables holding the state of a single route,	*/
+/* which must be private to each thread when routing in parallel.	*/
+
+#ifdef HAVE_PTHREADS
+#define THREAD_LOCAL	__thread
+#else
+#define THREAD_LOCAL
+#endif
+
 /* Default configuration filename */
 #define  CONFIGFILENAME        "route.cfg" 
 
@@ -120,6 +149,16 @@ struct proute_ {        // partial route
 #define PR_TARGET	0x40		// This is a target node
 #define PR_COST		0x80		// if 1, use prdata.cost, not prdata.net
 
+// Negotiated congestion record of a grid position, used by the
+// negotiated rip-up and reroute of the second stage (see negotiate.c)
+
+typedef struct congest_ CONGEST;
+
+struct congest_ {
+   u_char hist;		// number of iterations the position was congested
+   u_char pres;		// number of tentative routes using the position
+};
+
 // Linked string list
 
 typedef struct string_ *STRING;
@@ -208,6 +247,27 @@ struct node_ {
   int	  branchy;		// position of the node branch in y
 };
 
+// Information about a grid position that belongs to a node tap or
+// stub.  Only such positions have a record;  Nodeinfo[] is NULL
+// everywhere else.
+
+typedef struct nodeinfo_ *NODEINFO;
+
+struct nodeinfo_ {
+   NODE nodeloc;	// node at this position, for reverse lookup
+   NODE nodesav;	// copy of nodeloc used for restoring nodeloc
+			// after net rip-up
+   float stub;		// stub route distance to the pin
+};
+
+#define NODEIPTR(x, y, l) (Nodeinfo[(l)][OGRID((x), (y), (l))])
+#define NODELOC(x, y, l)  (NODEIPTR(x, y, l) ? \
+		NODEIPTR(x, y, l)->nodeloc : (NODE)NULL)
+#define NODESAV(x, y, l)  (NODEIPTR(x, y, l) ? \
+		NODEIPTR(x, y, l)->nodesav : (NODE)NULL)
+#define STUBDIST(x, y, l) (NODEIPTR(x, y, l) ? \
+		NODEIPTR(x, y, l)->stub : (float)0.0)
+
 // these are instances of gates in the netlist.  The description of a 
 // given gate (the macro) is held in GateInfo.  The same structure is
 // used for both the macro and the instance records.
@@ -260,6 +320,7 @@ struct net_ {
 #define NET_IGNORED  		4	// net is ignored by router
 #define NET_STUB     		8	// Net has at least one stub
 #define NET_VERTICAL_TRUNK	16	// Trunk line is (preferred) vertical
+#define NET_ROUTED		32	// Routes reused from an ECO file
 
 // List of nets, used to maintain a list of failed routes
 
@@ -279,6 +340,7 @@ struct routeinfo_ {
    DPOINT nsrctap;
    int maxcost;
    u_char do_pwrbus;
+   u_char globalmask;	// mask is (or may be) made from the global route
    int pwrbus_src;
    struct seg_ bbox;
 };
@@ -355,9 +417,13 @@ struct routeinfo_ {
 
 extern STRING  DontRoute;
 extern STRING  CriticalNet;
-extern NET     CurNet;
-extern NETLIST FailedNets;	// nets that have failed the first pass
+extern THREAD_LOCAL NET     CurNet;
+extern THREAD_LOCAL NETLIST FailedNets;	// nets that have failed the first pass
+extern THREAD_LOCAL int     TotalRoutes;
+extern THREAD_LOCAL u_char  WorkerThread;	// TRUE in parallel route threads
+extern THREAD_LOCAL struct seg_ RouteWindow;	// grid area open to the search
 extern char    DEFfilename[];
+extern char    ECOfilename[];
 extern ScaleRec Scales;
 
 extern GATE   GateInfo;		// standard cell macro information
@@ -365,20 +431,21 @@ extern GATE   PinMacro;		// macro definition for a pin
 extern GATE   Nlgates;
 extern NET    *Nlnets;
 
-extern u_char *RMask;
+extern THREAD_LOCAL u_char *RMask;
 extern u_int  *Obs[MAX_LAYERS];		// obstructions by layer, y, x
-extern PROUTE *Obs2[MAX_LAYERS]; 	// working copy of Obs 
+extern THREAD_LOCAL PROUTE *Obs2[MAX_LAYERS]; 	// working copy of Obs 
+extern CONGEST *Congest[MAX_LAYERS];	// negotiated congestion, by layer
+extern int    PresFactor;		// negotiated present congestion cost
 extern float  *Obsinfo[MAX_LAYERS];	// temporary detailed obstruction info
-extern float  *Stub[MAX_LAYERS];	// stub route distances to pins
-extern NODE   *Nodeloc[MAX_LAYERS];	// nodes are attached to grid points
-					// for reverse lookup
-extern NODE   *Nodesav[MAX_LAYERS];	// copy of Nodeloc used for restoring
-					// Nodeloc after net rip-up
+extern NODEINFO *Nodeinfo[MAX_LAYERS];	// nodes and stub distances by
+					// grid point (sparse)
+extern int    NumNodeinfo;		// number of Nodeinfo records
 extern DSEG  UserObs;			// user-defined obstruction layers
 
 extern u_char needblock[MAX_LAYERS];
 
 extern int    Numnets;
+extern int    Numthreads;
 
 extern u_char Verbose;
 extern u_char keepTrying;
@@ -405,11 +472,23 @@ extern char *gndnet;
 
 extern int    set_num_channels();
 extern int    allocate_obs_array();
+void   report_grid_memory();
+
+NODEINFO SetNodeinfo(int x, int y, int lay);
+void   ClearNodeinfo(int x, int y, int lay);
 
 NET    getnettoroute();
+int    countlist(NETLIST net);
 int    dofirststage(u_char graphdebug);
 int    dosecondstage(u_char graphdebug);
+void   route_window_full();
+int    dofirststage_parallel(int *remaining);
+void   stage1_result(NET net, int result, int *remaining);
 int    route_net_ripup(NET net, u_char graphdebug);
+int    negotiate_congestion(u_char graphdebug);
+int    global_route(int gcell);
+void   free_global_route();
+void   print_congestion_map(FILE *f);
 
 void   read_lef(char *filename);
 void   read_def(char *filename);
@@ -429,6 +508,7 @@ int    set_route_to_net(NET net, ROUTE rt, int newflags, POINT *pushlist,
 
 void   initMask();
 void   createMask(NET net, u_char slack, u_char halo);
+u_char createGlobalMask(NET net, u_char slack, u_char halo);
 void   fillMask();
 
 void   pathstart(FILE *cmd, int layer, int x, int y, u_char special, double oscale,
@@ -444,6 +524,7 @@ void   highlight_dest();
 void   highlight(int, int);
 int    recalc_spacing();
 void   draw_layout();
+void   draw_net(NET net, u_char single, int *lastlayer);
 
 void   helpmessage();
 
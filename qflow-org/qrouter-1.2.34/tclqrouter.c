@@ -49,6 +49,8 @@ extern int qrouter_stage1();
 extern int qrouter_stage2();
 extern int qrouter_writedef();
 extern int qrouter_readdef();
+extern int qrouter_readeco();
+extern int qrouter_global();
 extern int qrouter_readlef();
 extern int qrouter_readconfig();
 extern int qrouter_failing();
@@ -77,6 +79,8 @@ static cmdstruct qrouter_commands[] =
    {"stage2", (void *)qrouter_stage2},
    {"write_def", (void *)qrouter_writedef},
    {"read_def", (void *)qrouter_readdef},
+   {"read_eco", (void *)qrouter_readeco},
+   {"global_route", (void *)qrouter_global},
    {"read_lef", (void *)qrouter_readlef},
    {"read_config", (void *)qrouter_readconfig},
    {"layer_info", (void *)qrouter_layerinfo},
@@ -156,6 +160,14 @@ void tcl_vprintf(FILE *f, const char *fmt, va_list args_in)
    char *outptr, *bigstr = NULL, *finalstr = NULL;
    int i, nchars, result, escapes = 0, limit;
 
+   /* The interpreter may only be called from the main thread.  Output	*/
+   /* from route worker threads goes directly to the terminal.		*/
+
+   if (WorkerThread) {
+      vfprintf(f, fmt, args_in);
+      return;
+   }
+
    /* If we are printing an error message, we want to bring attention	*/
    /* to it by mapping the console window and raising it, as necessary.	*/
    /* I'd rather do this internally than by Tcl_Eval(), but I can't	*/
@@ -232,6 +244,11 @@ void tcl_stdflush(FILE *f)
    Tcl_SavedResult state;
    static char stdstr[] = "::flush stdxxx";
    char *stdptr = stdstr + 11;
+
+   if (WorkerThread) {
+      fflush(f);
+      return;
+   }
     
    Tcl_SaveResult(qrouterinterp, &state);
    strcpy(stdptr, (f == stderr) ? "err" : "out");
@@ -722,10 +739,10 @@ int qrouter_stage1(ClientData clientData, Tcl_Interp *interp,
     NET net = NULL;
 
     static char *subCmds[] = {
-	"debug", "mask", "route", "force", NULL
+	"debug", "mask", "route", "force", "negotiate", NULL
     };
     enum SubIdx {
-	DebugIdx, MaskIdx, RouteIdx, ForceIdx
+	DebugIdx, MaskIdx, RouteIdx, ForceIdx, NegotiateIdx
     };
    
     static char *maskSubCmds[] = {
@@ -752,6 +769,21 @@ int qrouter_stage1(ClientData clientData, Tcl_Interp *interp,
 		case ForceIdx:
 		    forceRoutable = TRUE;
 		    break;
+
+		case NegotiateIdx:
+		    if (i >= objc - 1) {
+			Tcl_WrongNumArgs(interp, 0, objv, "negotiate ?iterations?");
+			return TCL_ERROR;
+		    }
+		    i++;
+		    result = Tcl_GetIntFromObj(interp, objv[i], &val);
+		    if (result != TCL_OK) return result;
+		    else if (val < 0) {
+			Tcl_SetResult(interp, "Bad iteration count", NULL);
+			return TCL_ERROR;
+		    }
+		    NegIterations = val;
+		    break;
 	
 		case RouteIdx:
 		    if (i >= objc - 1) {
@@ -840,6 +872,10 @@ int qrouter_stage1(ClientData clientData, Tcl_Interp *interp,
 /*  stage2 route <net>	Route net named <net> only.	*/
 /*							*/
 /*  stage2 force	Force a terminal to be routable	*/
+/*							*/
+/*  stage2 negotiate <n> Negotiate congestion for up to	*/
+/*			<n> iterations before the rip-	*/
+/*			up and reroute (0 = don't).	*/
 /*------------------------------------------------------*/
 
 int qrouter_stage2(ClientData clientData, Tcl_Interp *interp,
@@ -1131,6 +1167,99 @@ int qrouter_readdef(ClientData clientData, Tcl_Interp *interp,
     return QrouterTagCallback(interp, objc, objv);
 }
 
+/*------------------------------------------------------*/
+/* Command "read_eco"					*/
+/*							*/
+/* Reuse the routes of a previously routed DEF file	*/
+/* for all nets that have not changed since.  Must be	*/
+/* run after "read_def" and before "stage1".		*/
+/*							*/
+/* Options:						*/
+/*							*/
+/*	read_eco <filename>				*/
+/*							*/
+/* Returns the number of nets whose routes were reused.	*/
+/*------------------------------------------------------*/
+
+int qrouter_readeco(ClientData clientData, Tcl_Interp *interp,
+	int objc, Tcl_Obj *CONST objv[])
+{
+    int kept;
+
+    if (objc != 2) {
+	Tcl_WrongNumArgs(interp, 1, objv, "filename");
+	return TCL_ERROR;
+    }
+    if (Nlnets == NULL) {
+	Tcl_SetResult(interp, "No DEF file has been read!", NULL);
+	return TCL_ERROR;
+    }
+    kept = DefReadEco(Tcl_GetString(objv[1]));
+    if (kept < 0) {
+	Tcl_SetResult(interp, "Cannot read ECO file.", NULL);
+	return TCL_ERROR;
+    }
+
+    // Redisplay
+    draw_layout();
+
+    Tcl_SetObjResult(interp, Tcl_NewIntObj(kept));
+    return QrouterTagCallback(interp, objc, objv);
+}
+
+/*------------------------------------------------------*/
+/* Command "global_route"				*/
+/*							*/
+/* Make a coarse global route of all nets, so that	*/
+/* the detailed routes of the following stages are	*/
+/* confined to the corridors found.  Must be run after	*/
+/* "read_def" and before "stage1".			*/
+/*							*/
+/* Options:						*/
+/*							*/
+/*	global_route [<gcell>]				*/
+/*	global_route map				*/
+/*							*/
+/* <gcell> is the size of a gcell in tracks, and is	*/
+/* remembered for "stage1".  "map" prints the		*/
+/* congestion map of the last global route.		*/
+/*							*/
+/* Returns the overflow of the global route.		*/
+/*------------------------------------------------------*/
+
+int qrouter_global(ClientData clientData, Tcl_Interp *interp,
+	int objc, Tcl_Obj *CONST objv[])
+{
+    int gcell, result;
+
+    if (objc > 2) {
+	Tcl_WrongNumArgs(interp, 1, objv, "[gcell|map]");
+	return TCL_ERROR;
+    }
+    if (objc == 2) {
+	if (!strcmp(Tcl_GetString(objv[1]), "map")) {
+	    print_congestion_map(stdout);
+	    return QrouterTagCallback(interp, objc, objv);
+	}
+	result = Tcl_GetIntFromObj(interp, objv[1], &gcell);
+	if (result != TCL_OK) return result;
+	if (gcell <= 0) {
+	    Tcl_SetResult(interp, "Gcell size must be positive.", NULL);
+	    return TCL_ERROR;
+	}
+	GlobalGcell = gcell;
+    }
+    if (Nlnets == NULL) {
+	Tcl_SetResult(interp, "No DEF file has been read!", NULL);
+	return TCL_ERROR;
+    }
+    if (GlobalGcell <= 0) GlobalGcell = 8;
+
+    result = global_route(GlobalGcell);
+    Tcl_SetObjResult(interp, Tcl_NewIntObj(result));
+    return QrouterTagCallback(interp, objc, objv);
+}
+
 /*------------------------------------------------------*/
 /* Command "write_def"					*/
 /*------------------------------------------------------*/
@@ -1860,6 +1989,8 @@ int qrouter_gnd(ClientData clientData, Tcl_Interp *interp,
 /*	cost crossover					*/
 /*	cost block					*/
 /*	cost conflict					*/
+/*	cost history					*/
+/*	cost present					*/
 /*------------------------------------------------------*/
 
 int qrouter_cost(ClientData clientData, Tcl_Interp *interp,
@@ -1869,10 +2000,11 @@ int qrouter_cost(ClientData clientData, Tcl_Interp *interp,
 
     static char *subCmds[] = {
 	"segment", "via", "jog", "crossover",
-	"block", "conflict", NULL
+	"block", "conflict", "history", "present", NULL
     };
     enum SubIdx {
-	SegIdx, ViaIdx, JogIdx, XOverIdx, BlockIdx, ConflictIdx
+	SegIdx, ViaIdx, JogIdx, XOverIdx, BlockIdx, ConflictIdx, HistoryIdx,
+	PresentIdx
     };
    
     value = 0;
@@ -1936,6 +2068,20 @@ int qrouter_cost(ClientData clientData, Tcl_Interp *interp,
 	    else
 		ConflictCost = value;
 	    break;
+
+	case HistoryIdx:
+	    if (objc == 2)
+		Tcl_SetObjResult(interp, Tcl_NewIntObj(HistCost));
+	    else
+		HistCost = value;
+	    break;
+
+	case PresentIdx:
+	    if (objc == 2)
+		Tcl_SetObjResult(interp, Tcl_NewIntObj(PresCost));
+	    else
+		PresCost = value;
+	    break;
     }
 
     return QrouterTagCallback(interp, objc, objv);
@@ -2006,8 +2152,7 @@ int qrouter_congested(ClientData clientData, Tcl_Interp *interp,
     else
 	entries = 0;
 
-    Congestion = (float *)calloc(NumChannelsX[0] * NumChannelsY[0],
-			sizeof(float));
+    Congestion = (float *)calloc(GRIDSIZE(0), sizeof(float));
 
     // Use net bounding boxes to estimate congestion
 
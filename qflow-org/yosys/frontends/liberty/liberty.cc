@@ -428,6 +428,10 @@ struct LibertyFrontend : public Frontend {
 		log("    -setattr <attribute_name>\n");
 		log("        set the specified attribute (to the value 1) on all loaded modules\n");
 		log("\n");
+		log("The parsed liberty file is shared with the other passes of this run. If\n");
+		log("the environment variable YOSYS_LIBERTY_CACHE names a directory, the parse\n");
+		log("tree is also stored there and reused while the file is unchanged.\n");
+		log("\n");
 	}
 	virtual void execute(std::istream *&f, std::string filename, std::vector<std::string> args, RTLIL::Design *design)
 	{
@@ -466,10 +470,20 @@ struct LibertyFrontend : public Frontend {
 		}
 		extra_args(f, filename, args, argidx);
 
-		LibertyParser parser(*f);
+		// liberty files are parsed through the cache, so that dfflibmap
+		// and later runs can reuse the parse tree
+		LibertyAst *ast;
+		std::unique_ptr<LibertyParser> parser;
+		if (dynamic_cast<std::ifstream*>(f) != NULL)
+			ast = LibertyCache::load(filename);
+		else {
+			parser.reset(new LibertyParser(*f));
+			ast = parser->ast;
+		}
+
 		int cell_count = 0;
 
-		for (auto cell : parser.ast->children)
+		for (auto cell : ast->children)
 		{
 			if (cell->id != "cell" || cell->args.size() != 1)
 				continue;
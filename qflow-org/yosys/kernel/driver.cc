@@ -204,6 +204,10 @@ int main(int argc, char **argv)
 		printf("    -m module_file\n");
 		printf("        load the specified module (aka plugin)\n");
 		printf("\n");
+		printf("    -j jobs\n");
+		printf("        run module-local passes (such as opt_clean or proc_mux) on up to\n");
+		printf("        this many modules in parallel, using worker processes\n");
+		printf("\n");
 		printf("    -X\n");
 		printf("        enable tracing of core data structure changes. for debugging\n");
 		printf("\n");
@@ -233,7 +237,7 @@ int main(int argc, char **argv)
 	}
 
 	int opt;
-	while ((opt = getopt(argc, argv, "MXAQTVSm:f:Hh:b:o:p:l:L:qv:tds:c:")) != -1)
+	while ((opt = getopt(argc, argv, "MXAQTVSm:f:Hh:b:o:p:l:L:qv:tds:c:j:")) != -1)
 	{
 		switch (opt)
 		{
@@ -307,6 +311,9 @@ int main(int argc, char **argv)
 		case 'd':
 			timing_details = true;
 			break;
+		case 'j':
+			yosys_pass_jobs = std::max(atoi(optarg), 1);
+			break;
 		case 's':
 			scriptfile = optarg;
 			scriptfile_tcl = false;
@@ -20,10 +20,21 @@
 #include "kernel/yosys.h"
 #include "kernel/satgen.h"
 
+#include "backends/ilang/ilang_backend.h"
+
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <errno.h>
+#include <fstream>
+#include <sstream>
+
+#if !defined(_WIN32) && !defined(EMSCRIPTEN)
+#  define YOSYS_FORK_PASSES
+#  include <unistd.h>
+#  include <signal.h>
+#  include <sys/wait.h>
+#endif
 
 YOSYS_NAMESPACE_BEGIN
 
@@ -45,6 +56,7 @@ Pass::Pass(std::string name, std::string short_help) : pass_name(name), short_he
 	first_queued_pass = this;
 	call_counter = 0;
 	runtime_ns = 0;
+	module_local = false;
 }
 
 void Pass::run_register()
@@ -127,6 +139,8 @@ void Pass::cmd_error(const std::vector<std::string> &args, size_t argidx, std::s
 			msg.c_str(), command_text.c_str(), error_pos, "");
 }
 
+static void restrict_selection_to_pass_worker(RTLIL::Design *design);
+
 void Pass::extra_args(std::vector<std::string> args, size_t argidx, RTLIL::Design *design, bool select)
 {
 	for (; argidx < args.size(); argidx++)
@@ -140,6 +154,7 @@ void Pass::extra_args(std::vector<std::string> args, size_t argidx, RTLIL::Desig
 			cmd_error(args, argidx, "Extra argument.");
 
 		handle_extra_select_args(this, args, argidx, args.size(), design);
+		restrict_selection_to_pass_worker(design);
 		break;
 	}
 	// cmd_log_args(args);
@@ -207,6 +222,352 @@ void Pass::call(RTLIL::Design *design, std::string command)
 	call(design, args);
 }
 
+#ifdef YOSYS_FORK_PASSES
+
+// Module-local passes are run in forked worker processes, one module per
+// worker. Each worker logs to its own file and, if the module changed,
+// writes it back in ilang format. The parent merges the workers in module
+// order, so the result and the log do not depend on which one finishes
+// first. Forking keeps the IdString table and the log buffers private to
+// each worker, so they need no locking.
+
+static bool in_pass_worker = false;
+static std::string pass_worker_module;
+
+struct PassWorker
+{
+	RTLIL::Module *module;
+	std::string tempdir;
+	pid_t pid;
+	int index;
+};
+
+static std::string read_worker_file(std::string filename)
+{
+	std::ifstream f(filename.c_str(), std::ios::binary);
+	std::stringstream buf;
+	buf << f.rdbuf();
+	return buf.str();
+}
+
+static void remove_worker_tempdir(std::string tempdir)
+{
+	remove((tempdir + "/log").c_str());
+	remove((tempdir + "/module.il").c_str());
+	remove((tempdir + "/modules").c_str());
+	remove((tempdir + "/scratchpad").c_str());
+	remove(tempdir.c_str());
+}
+
+// a worker evaluates the selection of the pass like a serial run would,
+// so that selection arguments are not resolved inside its module, and
+// then only keeps what is selected in its own module
+static void restrict_selection_to_pass_worker(RTLIL::Design *design)
+{
+	if (!in_pass_worker)
+		return;
+
+	RTLIL::Selection &sel = design->selection_stack.back();
+	RTLIL::Selection new_sel(false);
+
+	if (sel.selected_whole_module(pass_worker_module))
+		new_sel.selected_modules.insert(pass_worker_module);
+	else if (sel.selected_members.count(pass_worker_module))
+		new_sel.selected_members[pass_worker_module] = sel.selected_members.at(pass_worker_module);
+
+	sel = new_sel;
+}
+
+static std::string module_dump(RTLIL::Design *design, RTLIL::Module *module)
+{
+	std::stringstream ss;
+	ILANG_BACKEND::dump_module(ss, "", module, design, false);
+	return ss.str();
+}
+
+static std::vector<RTLIL::IdString> module_order(RTLIL::Design *design)
+{
+	std::vector<RTLIL::IdString> order;
+	for (auto &it : design->modules_)
+		order.push_back(it.first);
+	return order;
+}
+
+static void run_pass_worker(std::vector<std::string> args, RTLIL::Design *design, PassWorker &worker)
+{
+	in_pass_worker = true;
+	echo_mode = false;
+
+	FILE *logfile = fopen((worker.tempdir + "/log").c_str(), "w");
+	log_files.clear();
+	log_streams.clear();
+	log_errfile = NULL;
+	log_hasher = NULL;
+	if (logfile != NULL)
+		log_files.push_back(logfile);
+
+	dict<std::string, std::string> old_scratchpad = design->scratchpad;
+	RTLIL::IdString name = worker.module->name;
+
+	std::string before = module_dump(design, worker.module);
+	std::vector<RTLIL::IdString> order_before = module_order(design);
+
+	// give each module its own log section, as the logs of all
+	// workers are replayed one after the other
+	header_count.back() = worker.index;
+	log_header("Running `%s' on module `%s'.\n", args[0].c_str(), log_id(name));
+	log_push();
+
+	pass_worker_module = name.str();
+	design->selection_stack.push_back(design->selection_stack.back());
+	restrict_selection_to_pass_worker(design);
+	Pass::call(design, args);
+
+	log_pop();
+
+	RTLIL::Module *module = design->module(name);
+	if (module == NULL)
+		log_error("Module `%s' was removed by a module-local pass.\n", log_id(name));
+
+	// a module that was only sorted (like opt_clean does) is shipped
+	// as well, so that the parent ends up with the same order
+	if (module_dump(design, module) != before) {
+		std::ofstream f((worker.tempdir + "/module.il").c_str());
+		f << stringf("autoidx %d\n", autoidx);
+		ILANG_BACKEND::dump_module(f, "", module, design, false);
+	}
+
+	std::vector<RTLIL::IdString> order = module_order(design);
+	if (order != order_before) {
+		std::ofstream f((worker.tempdir + "/modules").c_str());
+		for (auto &it : order)
+			f << it.str() << "\n";
+	}
+
+	std::ofstream f((worker.tempdir + "/scratchpad").c_str(), std::ios::binary);
+	for (auto &it : design->scratchpad)
+		if (old_scratchpad.count(it.first) == 0 || old_scratchpad.at(it.first) != it.second)
+			f << it.first.size() << " " << it.second.size() << "\n" << it.first << it.second;
+	f.close();
+
+	if (logfile != NULL)
+		fclose(logfile);
+	_exit(0);
+}
+
+// the ilang frontend adds everything in the order of the file, and a dict
+// or pool visits the entry that was added last first, so a module read
+// back from its dump comes out in reverse order and is turned around here
+template<typename K, typename T, typename OPS>
+static void reverse_read_order(dict<K, T, OPS> &d)
+{
+	std::vector<std::pair<K, T>> items(d.begin(), d.end());
+	d.clear();
+	for (auto &it : items)
+		d.insert(it);
+}
+
+template<typename K, typename OPS>
+static void reverse_read_order(pool<K, OPS> &p)
+{
+	std::vector<K> items(p.begin(), p.end());
+	p.clear();
+	for (auto &it : items)
+		p.insert(it);
+}
+
+static void reverse_read_order(RTLIL::SwitchRule *sw)
+{
+	reverse_read_order(sw->attributes);
+	for (auto cs : sw->cases)
+		for (auto child : cs->switches)
+			reverse_read_order(child);
+}
+
+static void reverse_read_order(RTLIL::Module *module)
+{
+	reverse_read_order(module->attributes);
+	reverse_read_order(module->avail_parameters);
+	reverse_read_order(module->wires_);
+	reverse_read_order(module->cells_);
+	reverse_read_order(module->memories);
+	reverse_read_order(module->processes);
+
+	for (auto &it : module->wires_)
+		reverse_read_order(it.second->attributes);
+	for (auto &it : module->memories)
+		reverse_read_order(it.second->attributes);
+	for (auto &it : module->cells_) {
+		reverse_read_order(it.second->attributes);
+		reverse_read_order(it.second->parameters);
+		reverse_read_order(it.second->connections_);
+	}
+	for (auto &it : module->processes) {
+		reverse_read_order(it.second->attributes);
+		for (auto sw : it.second->root_case.switches)
+			reverse_read_order(sw);
+	}
+}
+
+static void swap_module_contents(RTLIL::Design *design, RTLIL::Module *module, RTLIL::Module *new_module)
+{
+	log_assert(module->refcount_wires_ == 0 && module->refcount_cells_ == 0);
+
+	module->attributes.swap(new_module->attributes);
+	module->avail_parameters.swap(new_module->avail_parameters);
+	module->wires_.swap(new_module->wires_);
+	module->cells_.swap(new_module->cells_);
+	module->connections_.swap(new_module->connections_);
+	module->memories.swap(new_module->memories);
+	module->processes.swap(new_module->processes);
+	module->ports.swap(new_module->ports);
+
+	for (auto &it : module->wires_)
+		it.second->module = module;
+	for (auto &it : module->cells_)
+		it.second->module = module;
+
+	for (auto mon : module->monitors)
+		mon->notify_blackout(module);
+	for (auto mon : design->monitors)
+		mon->notify_blackout(module);
+}
+
+static bool merge_pass_worker(RTLIL::Design *design, PassWorker &worker)
+{
+	int status = 0;
+	waitpid(worker.pid, &status, 0);
+
+	std::string text = read_worker_file(worker.tempdir + "/log");
+	if (!text.empty())
+		log("%s", text.c_str());
+
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+		return false;
+
+	std::string scratchpad = read_worker_file(worker.tempdir + "/scratchpad");
+	for (size_t pos = 0; pos < scratchpad.size();) {
+		size_t key_len, value_len, eol = scratchpad.find('\n', pos);
+		if (eol == std::string::npos || sscanf(scratchpad.c_str() + pos, "%zu %zu", &key_len, &value_len) != 2)
+			break;
+		design->scratchpad[scratchpad.substr(eol+1, key_len)] = scratchpad.substr(eol+1+key_len, value_len);
+		pos = eol + 1 + key_len + value_len;
+	}
+
+	std::string filename = worker.tempdir + "/module.il";
+	std::ifstream f(filename.c_str());
+	if (!f.fail())
+	{
+		RTLIL::Design *worker_design = new RTLIL::Design;
+
+		// read the module without any trace in the log, but make sure
+		// that an error while reading it still reaches the console
+		std::vector<FILE*> backup_log_files;
+		std::vector<std::ostream*> backup_log_streams;
+		FILE *backup_log_errfile = log_errfile;
+		backup_log_files.swap(log_files);
+		backup_log_streams.swap(log_streams);
+		if (log_errfile == NULL)
+			log_errfile = stderr;
+		log_push();
+		Frontend::frontend_call(worker_design, &f, filename, "ilang");
+		log_pop();
+		log_errfile = backup_log_errfile;
+		backup_log_files.swap(log_files);
+		backup_log_streams.swap(log_streams);
+
+		RTLIL::Module *new_module = worker_design->module(worker.module->name);
+		log_assert(new_module != NULL);
+		reverse_read_order(new_module);
+		swap_module_contents(design, worker.module, new_module);
+		delete worker_design;
+	}
+
+	// the pass reordered the modules of the design (design->sort())
+	std::stringstream order(read_worker_file(worker.tempdir + "/modules"));
+	dict<RTLIL::IdString, int> order_index;
+	for (std::string line; std::getline(order, line);)
+		order_index[RTLIL::IdString(line)] = GetSize(order_index);
+	if (!order_index.empty())
+		design->modules_.sort([&](RTLIL::IdString a, RTLIL::IdString b) {
+			return order_index.at(a) < order_index.at(b);
+		});
+
+	return true;
+}
+
+static bool call_module_local(Pass *pass, std::vector<std::string> args, RTLIL::Design *design)
+{
+	if (yosys_pass_jobs < 2 || !pass->module_local || in_pass_worker || !design->selected_active_module.empty())
+		return false;
+
+	// the selection may be given on the command line of the pass, so every
+	// module gets a worker and the pass itself decides what is selected
+	// (see restrict_selection_to_pass_worker())
+	std::vector<RTLIL::Module*> modules;
+	for (auto &it : design->modules_)
+		if (!it.second->get_bool_attribute("\\blackbox"))
+			modules.push_back(it.second);
+
+	if (GetSize(modules) < 2)
+		return false;
+
+	log_header("Running `%s' on %d modules with up to %d jobs.\n", args[0].c_str(), GetSize(modules), yosys_pass_jobs);
+	log_push();
+
+	// the workers inherit the stdio buffers, so flush them before forking
+	log_flush();
+	fflush(stdout);
+	fflush(stderr);
+
+	std::vector<PassWorker> workers(GetSize(modules));
+	size_t next_worker = 0;
+	bool ok = true;
+
+	for (size_t i = 0; i < workers.size(); i++)
+	{
+		while (next_worker < workers.size() && int(next_worker - i) < yosys_pass_jobs) {
+			PassWorker &worker = workers[next_worker++];
+			worker.module = modules[next_worker-1];
+			worker.index = next_worker-1;
+			worker.tempdir = make_temp_dir("/tmp/yosys-pass-XXXXXX");
+			worker.pid = fork();
+			if (worker.pid < 0)
+				log_error("Can't fork worker process: %s\n", strerror(errno));
+			if (worker.pid == 0)
+				run_pass_worker(args, design, worker);
+		}
+
+		ok = merge_pass_worker(design, workers[i]);
+		remove_worker_tempdir(workers[i].tempdir);
+
+		if (!ok) {
+			for (size_t j = i+1; j < next_worker; j++) {
+				kill(workers[j].pid, SIGTERM);
+				waitpid(workers[j].pid, NULL, 0);
+				remove_worker_tempdir(workers[j].tempdir);
+			}
+			log_error("Command `%s' failed on module `%s'.\n", args[0].c_str(), log_id(workers[i].module));
+		}
+	}
+
+	log_pop();
+	return true;
+}
+
+#else
+
+static void restrict_selection_to_pass_worker(RTLIL::Design*)
+{
+}
+
+static bool call_module_local(Pass*, std::vector<std::string>, RTLIL::Design*)
+{
+	return false;
+}
+
+#endif
+
 void Pass::call(RTLIL::Design *design, std::vector<std::string> args)
 {
 	if (args.size() == 0 || args[0][0] == '#')
@@ -224,7 +585,8 @@ void Pass::call(RTLIL::Design *design, std::vector<std::string> args)
 
 	size_t orig_sel_stack_pos = design->selection_stack.size();
 	auto state = pass_register[args[0]]->pre_execute();
-	pass_register[args[0]]->execute(args, design);
+	if (!call_module_local(pass_register[args[0]], args, design))
+		pass_register[args[0]]->execute(args, design);
 	pass_register[args[0]]->post_execute(state);
 	while (design->selection_stack.size() > orig_sel_stack_pos)
 		design->selection_stack.pop_back();
@@ -36,6 +36,11 @@ struct Pass
 	int call_counter;
 	int64_t runtime_ns;
 
+	// set by passes that only read and change the module they are working
+	// on. Pass::call() runs such passes on several modules in parallel when
+	// yosys_pass_jobs is larger than one.
+	bool module_local;
+
 	struct pre_post_exec_state_t {
 		Pass *parent_pass;
 		int64_t begin_ns;
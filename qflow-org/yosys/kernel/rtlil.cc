@@ -2523,7 +2523,6 @@ void RTLIL::SigSpec::unpack() const
 			that->bits_.push_back(RTLIL::SigBit(c, i));
 
 	that->chunks_.clear();
-	that->hash_ = 0;
 }
 
 void RTLIL::SigSpec::updhash() const
@@ -2534,19 +2533,52 @@ void RTLIL::SigSpec::updhash() const
 		return;
 
 	cover("kernel.rtlil.sigspec.hash");
-	that->pack();
 
 	that->hash_ = mkhash_init;
-	for (auto &c : that->chunks_)
-		if (c.wire == NULL) {
-			for (auto &v : c.data)
-				that->hash_ = mkhash(that->hash_, v);
-		} else {
-			that->hash_ = mkhash(that->hash_, c.wire->name.index_);
-			that->hash_ = mkhash(that->hash_, c.offset);
-			that->hash_ = mkhash(that->hash_, c.width);
+
+	if (packed())
+	{
+		for (auto &c : that->chunks_)
+			if (c.wire == NULL) {
+				for (auto &v : c.data)
+					that->hash_ = mkhash(that->hash_, v);
+			} else {
+				that->hash_ = mkhash(that->hash_, c.wire->name.index_);
+				that->hash_ = mkhash(that->hash_, c.offset);
+				that->hash_ = mkhash(that->hash_, c.width);
+			}
+	}
+	else
+	{
+		// hash the runs of wire bits as the chunks pack() would create,
+		// so that the hash does not depend on the representation
+		RTLIL::Wire *run_wire = NULL;
+		int run_offset = 0, run_width = 0;
+
+		for (auto &bit : that->bits_) {
+			if (run_wire != NULL && bit.wire == run_wire && bit.offset == run_offset + run_width) {
+				run_width++;
+				continue;
+			}
+			if (run_wire != NULL) {
+				that->hash_ = mkhash(that->hash_, run_wire->name.index_);
+				that->hash_ = mkhash(that->hash_, run_offset);
+				that->hash_ = mkhash(that->hash_, run_width);
+			}
+			run_wire = bit.wire;
+			run_offset = bit.offset;
+			run_width = 1;
+			if (bit.wire == NULL)
+				that->hash_ = mkhash(that->hash_, bit.data);
 		}
 
+		if (run_wire != NULL) {
+			that->hash_ = mkhash(that->hash_, run_wire->name.index_);
+			that->hash_ = mkhash(that->hash_, run_offset);
+			that->hash_ = mkhash(that->hash_, run_width);
+		}
+	}
+
 	if (that->hash_ == 0)
 		that->hash_ = 1;
 }
@@ -2556,6 +2588,7 @@ void RTLIL::SigSpec::sort()
 	unpack();
 	cover("kernel.rtlil.sigspec.sort");
 	std::sort(bits_.begin(), bits_.end());
+	hash_ = 0;
 }
 
 void RTLIL::SigSpec::sort_and_unify()
@@ -2606,6 +2639,7 @@ void RTLIL::SigSpec::replace(const dict<RTLIL::SigBit, RTLIL::SigBit> &rules, RT
 			other->bits_[i] = it->second;
 	}
 
+	other->hash_ = 0;
 	other->check();
 }
 
@@ -2630,6 +2664,7 @@ void RTLIL::SigSpec::replace(const std::map<RTLIL::SigBit, RTLIL::SigBit> &rules
 			other->bits_[i] = it->second;
 	}
 
+	other->hash_ = 0;
 	other->check();
 }
 
@@ -2696,10 +2731,12 @@ void RTLIL::SigSpec::remove2(const pool<RTLIL::SigBit> &pattern, RTLIL::SigSpec
 
 	bits_.swap(new_bits);
 	width_ = GetSize(bits_);
+	hash_ = 0;
 
 	if (other != NULL) {
 		other->bits_.swap(new_other_bits);
 		other->width_ = GetSize(other->bits_);
+		other->hash_ = 0;
 	}
 
 	check();
@@ -2720,18 +2757,19 @@ RTLIL::SigSpec RTLIL::SigSpec::extract(const pool<RTLIL::SigBit> &pattern, const
 
 	log_assert(other == NULL || width_ == other->width_);
 
-	std::vector<RTLIL::SigBit> bits_match = to_sigbit_vector();
 	RTLIL::SigSpec ret;
 
 	if (other) {
-		std::vector<RTLIL::SigBit> bits_other = other->to_sigbit_vector();
-		for (int i = 0; i < width_; i++)
-			if (bits_match[i].wire && pattern.count(bits_match[i]))
-				ret.append_bit(bits_other[i]);
+		auto it_other = other->begin();
+		for (auto &bit : *this) {
+			if (bit.wire && pattern.count(bit))
+				ret.append_bit(*it_other);
+			++it_other;
+		}
 	} else {
-		for (int i = 0; i < width_; i++)
-			if (bits_match[i].wire && pattern.count(bits_match[i]))
-				ret.append_bit(bits_match[i]);
+		for (auto &bit : *this)
+			if (bit.wire && pattern.count(bit))
+				ret.append_bit(bit);
 	}
 
 	ret.check();
@@ -2751,6 +2789,7 @@ void RTLIL::SigSpec::replace(int offset, const RTLIL::SigSpec &with)
 
 	for (int i = 0; i < with.width_; i++)
 		bits_.at(offset + i) = with.bits_.at(i);
+	hash_ = 0;
 
 	check();
 }
@@ -2788,6 +2827,7 @@ void RTLIL::SigSpec::remove_const()
 		width_ = bits_.size();
 	}
 
+	hash_ = 0;
 	check();
 }
 
@@ -2803,15 +2843,38 @@ void RTLIL::SigSpec::remove(int offset, int length)
 
 	bits_.erase(bits_.begin() + offset, bits_.begin() + offset + length);
 	width_ = bits_.size();
+	hash_ = 0;
 
 	check();
 }
 
 RTLIL::SigSpec RTLIL::SigSpec::extract(int offset, int length) const
 {
-	unpack();
-	cover("kernel.rtlil.sigspec.extract_pos");
-	return std::vector<RTLIL::SigBit>(bits_.begin() + offset, bits_.begin() + offset + length);
+	log_assert(offset >= 0);
+	log_assert(length >= 0);
+	log_assert(offset + length <= width_);
+
+	if (!packed()) {
+		cover("kernel.rtlil.sigspec.extract_pos.unpacked");
+		return std::vector<RTLIL::SigBit>(bits_.begin() + offset, bits_.begin() + offset + length);
+	}
+
+	cover("kernel.rtlil.sigspec.extract_pos.packed");
+
+	RTLIL::SigSpec ret;
+	for (auto &c : chunks_) {
+		if (length == 0)
+			break;
+		if (offset >= c.width) {
+			offset -= c.width;
+			continue;
+		}
+		int n = std::min(c.width - offset, length);
+		ret.append(c.extract(offset, n));
+		offset = 0;
+		length -= n;
+	}
+	return ret;
 }
 
 void RTLIL::SigSpec::append(const RTLIL::SigSpec &signal)
@@ -2850,6 +2913,7 @@ void RTLIL::SigSpec::append(const RTLIL::SigSpec &signal)
 		bits_.insert(bits_.end(), signal.bits_.begin(), signal.bits_.end());
 
 	width_ += signal.width_;
+	hash_ = 0;
 	check();
 }
 
@@ -2881,6 +2945,7 @@ void RTLIL::SigSpec::append_bit(const RTLIL::SigBit &bit)
 	}
 
 	width_++;
+	hash_ = 0;
 	check();
 }
 
@@ -2997,18 +3062,23 @@ bool RTLIL::SigSpec::operator ==(const RTLIL::SigSpec &other) const
 	if (width_ != other.width_)
 		return false;
 
-	pack();
-	other.pack();
-
-	if (chunks_.size() != chunks_.size())
-		return false;
-
 	updhash();
 	other.updhash();
 
 	if (hash_ != other.hash_)
 		return false;
 
+	if (!packed() && !other.packed()) {
+		cover("kernel.rtlil.sigspec.comp_eq.unpacked");
+		return bits_ == other.bits_;
+	}
+
+	pack();
+	other.pack();
+
+	if (chunks_.size() != other.chunks_.size())
+		return false;
+
 	for (size_t i = 0; i < chunks_.size(); i++)
 		if (chunks_[i] != other.chunks_[i]) {
 			cover("kernel.rtlil.sigspec.comp_eq.hash_collision");
@@ -3039,7 +3109,13 @@ bool RTLIL::SigSpec::is_fully_const() const
 {
 	cover("kernel.rtlil.sigspec.is_fully_const");
 
-	pack();
+	if (!packed()) {
+		for (auto &bit : bits_)
+			if (bit.wire != NULL)
+				return false;
+		return true;
+	}
+
 	for (auto it = chunks_.begin(); it != chunks_.end(); it++)
 		if (it->width > 0 && it->wire != NULL)
 			return false;
@@ -3050,7 +3126,13 @@ bool RTLIL::SigSpec::is_fully_zero() const
 {
 	cover("kernel.rtlil.sigspec.is_fully_zero");
 
-	pack();
+	if (!packed()) {
+		for (auto &bit : bits_)
+			if (bit.wire != NULL || bit.data != RTLIL::State::S0)
+				return false;
+		return true;
+	}
+
 	for (auto it = chunks_.begin(); it != chunks_.end(); it++) {
 		if (it->width > 0 && it->wire != NULL)
 			return false;
@@ -3065,7 +3147,13 @@ bool RTLIL::SigSpec::is_fully_def() const
 {
 	cover("kernel.rtlil.sigspec.is_fully_def");
 
-	pack();
+	if (!packed()) {
+		for (auto &bit : bits_)
+			if (bit.wire != NULL || (bit.data != RTLIL::State::S0 && bit.data != RTLIL::State::S1))
+				return false;
+		return true;
+	}
+
 	for (auto it = chunks_.begin(); it != chunks_.end(); it++) {
 		if (it->width > 0 && it->wire != NULL)
 			return false;
@@ -3080,7 +3168,13 @@ bool RTLIL::SigSpec::is_fully_undef() const
 {
 	cover("kernel.rtlil.sigspec.is_fully_undef");
 
-	pack();
+	if (!packed()) {
+		for (auto &bit : bits_)
+			if (bit.wire != NULL || (bit.data != RTLIL::State::Sx && bit.data != RTLIL::State::Sz))
+				return false;
+		return true;
+	}
+
 	for (auto it = chunks_.begin(); it != chunks_.end(); it++) {
 		if (it->width > 0 && it->wire != NULL)
 			return false;
@@ -3095,7 +3189,13 @@ bool RTLIL::SigSpec::has_const() const
 {
 	cover("kernel.rtlil.sigspec.has_const");
 
-	pack();
+	if (!packed()) {
+		for (auto &bit : bits_)
+			if (bit.wire == NULL)
+				return true;
+		return false;
+	}
+
 	for (auto it = chunks_.begin(); it != chunks_.end(); it++)
 		if (it->width > 0 && it->wire == NULL)
 			return true;
@@ -3106,7 +3206,13 @@ bool RTLIL::SigSpec::has_marked_bits() const
 {
 	cover("kernel.rtlil.sigspec.has_marked_bits");
 
-	pack();
+	if (!packed()) {
+		for (auto &bit : bits_)
+			if (bit.wire == NULL && bit.data == RTLIL::State::Sm)
+				return true;
+		return false;
+	}
+
 	for (auto it = chunks_.begin(); it != chunks_.end(); it++)
 		if (it->width > 0 && it->wire == NULL) {
 			for (size_t i = 0; i < it->data.size(); i++)
@@ -3211,7 +3317,9 @@ std::set<RTLIL::SigBit> RTLIL::SigSpec::to_sigbit_set() const
 {
 	cover("kernel.rtlil.sigspec.to_sigbit_set");
 
-	pack();
+	if (!packed())
+		return std::set<RTLIL::SigBit>(bits_.begin(), bits_.end());
+
 	std::set<RTLIL::SigBit> sigbits;
 	for (auto &c : chunks_)
 		for (int i = 0; i < c.width; i++)
@@ -3223,7 +3331,9 @@ pool<RTLIL::SigBit> RTLIL::SigSpec::to_sigbit_pool() const
 {
 	cover("kernel.rtlil.sigspec.to_sigbit_pool");
 
-	pack();
+	if (!packed())
+		return pool<RTLIL::SigBit>(bits_.begin(), bits_.end());
+
 	pool<RTLIL::SigBit> sigbits;
 	for (auto &c : chunks_)
 		for (int i = 0; i < c.width; i++)
@@ -3235,22 +3345,29 @@ std::vector<RTLIL::SigBit> RTLIL::SigSpec::to_sigbit_vector() const
 {
 	cover("kernel.rtlil.sigspec.to_sigbit_vector");
 
-	unpack();
-	return bits_;
+	if (!packed())
+		return bits_;
+
+	std::vector<RTLIL::SigBit> sigbits;
+	sigbits.reserve(width_);
+	for (auto &c : chunks_)
+		for (int i = 0; i < c.width; i++)
+			sigbits.push_back(RTLIL::SigBit(c, i));
+	return sigbits;
 }
 
 std::map<RTLIL::SigBit, RTLIL::SigBit> RTLIL::SigSpec::to_sigbit_map(const RTLIL::SigSpec &other) const
 {
 	cover("kernel.rtlil.sigspec.to_sigbit_map");
 
-	unpack();
-	other.unpack();
-
 	log_assert(width_ == other.width_);
 
 	std::map<RTLIL::SigBit, RTLIL::SigBit> new_map;
-	for (int i = 0; i < width_; i++)
-		new_map[bits_[i]] = other.bits_[i];
+	auto it_other = other.begin();
+	for (auto &bit : *this) {
+		new_map[bit] = *it_other;
+		++it_other;
+	}
 
 	return new_map;
 }
@@ -3259,14 +3376,14 @@ dict<RTLIL::SigBit, RTLIL::SigBit> RTLIL::SigSpec::to_sigbit_dict(const RTLIL::S
 {
 	cover("kernel.rtlil.sigspec.to_sigbit_dict");
 
-	unpack();
-	other.unpack();
-
 	log_assert(width_ == other.width_);
 
 	dict<RTLIL::SigBit, RTLIL::SigBit> new_map;
-	for (int i = 0; i < width_; i++)
-		new_map[bits_[i]] = other.bits_[i];
+	auto it_other = other.begin();
+	for (auto &bit : *this) {
+		new_map[bit] = *it_other;
+		++it_other;
+	}
 
 	return new_map;
 }
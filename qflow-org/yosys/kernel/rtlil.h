@@ -566,6 +566,11 @@ struct RTLIL::SigSpecConstIterator : public std::iterator<std::input_iterator_ta
 	const RTLIL::SigSpec *sig_p;
 	int index;
 
+	// position in the chunks of a packed signal, so that iterating over a
+	// const SigSpec does not need to expand it to single bits
+	mutable int chunk_index, chunk_offset, chunk_pos;
+	mutable RTLIL::SigBit chunk_bit;
+
 	inline const RTLIL::SigBit &operator*() const;
 	inline bool operator!=(const RTLIL::SigSpecConstIterator &other) const { return index != other.index; }
 	inline bool operator==(const RTLIL::SigSpecIterator &other) const { return index == other.index; }
@@ -575,6 +580,8 @@ struct RTLIL::SigSpecConstIterator : public std::iterator<std::input_iterator_ta
 struct RTLIL::SigSpec
 {
 private:
+	friend struct RTLIL::SigSpecConstIterator;
+
 	int width_;
 	unsigned long hash_;
 	std::vector<RTLIL::SigChunk> chunks_; // LSB at index 0
@@ -639,14 +646,14 @@ public:
 	inline int size() const { return width_; }
 	inline bool empty() const { return width_ == 0; }
 
-	inline RTLIL::SigBit &operator[](int index) { inline_unpack(); return bits_.at(index); }
+	inline RTLIL::SigBit &operator[](int index) { inline_unpack(); hash_ = 0; return bits_.at(index); }
 	inline const RTLIL::SigBit &operator[](int index) const { inline_unpack(); return bits_.at(index); }
 
 	inline RTLIL::SigSpecIterator begin() { RTLIL::SigSpecIterator it; it.sig_p = this; it.index = 0; return it; }
 	inline RTLIL::SigSpecIterator end() { RTLIL::SigSpecIterator it; it.sig_p = this; it.index = width_; return it; }
 
-	inline RTLIL::SigSpecConstIterator begin() const { RTLIL::SigSpecConstIterator it; it.sig_p = this; it.index = 0; return it; }
-	inline RTLIL::SigSpecConstIterator end() const { RTLIL::SigSpecConstIterator it; it.sig_p = this; it.index = width_; return it; }
+	inline RTLIL::SigSpecConstIterator begin() const { RTLIL::SigSpecConstIterator it; it.sig_p = this; it.index = 0; it.chunk_pos = -1; return it; }
+	inline RTLIL::SigSpecConstIterator end() const { RTLIL::SigSpecConstIterator it; it.sig_p = this; it.index = width_; it.chunk_pos = -1; return it; }
 
 	void sort();
 	void sort_and_unify();
@@ -1265,7 +1272,21 @@ inline RTLIL::SigBit &RTLIL::SigSpecIterator::operator*() const {
 }
 
 inline const RTLIL::SigBit &RTLIL::SigSpecConstIterator::operator*() const {
-	return (*sig_p)[index];
+	if (!sig_p->packed())
+		return sig_p->bits_[index];
+	if (chunk_pos < 0 || chunk_pos > index) {
+		chunk_index = 0, chunk_offset = 0, chunk_pos = 0;
+		while (sig_p->chunks_[chunk_index].width == 0)
+			chunk_index++;
+	}
+	while (chunk_pos < index) {
+		int step = std::min(index - chunk_pos, sig_p->chunks_[chunk_index].width - chunk_offset);
+		chunk_offset += step, chunk_pos += step;
+		while (chunk_offset == sig_p->chunks_[chunk_index].width)
+			chunk_index++, chunk_offset = 0;
+	}
+	chunk_bit = RTLIL::SigBit(sig_p->chunks_[chunk_index], chunk_offset);
+	return chunk_bit;
 }
 
 inline RTLIL::SigBit::SigBit(const RTLIL::SigSpec &sig) {
@@ -39,7 +39,7 @@ struct SigPool
 		bits.clear();
 	}
 
-	void add(RTLIL::SigSpec sig)
+	void add(const RTLIL::SigSpec &sig)
 	{
 		for (auto &bit : sig)
 			if (bit.wire != NULL)
@@ -52,7 +52,7 @@ struct SigPool
 			bits.insert(bit);
 	}
 
-	void del(RTLIL::SigSpec sig)
+	void del(const RTLIL::SigSpec &sig)
 	{
 		for (auto &bit : sig)
 			if (bit.wire != NULL)
@@ -352,18 +352,22 @@ struct SigMap
 	// internal helper function
 	void map_bit(RTLIL::SigBit &bit) const
 	{
-		if (bit.wire && bits.count(bit) > 0)
-			bit = bits.at(bit)->map_to;
+		if (bit.wire) {
+			auto it = bits.find(bit);
+			if (it != bits.end())
+				bit = it->second->map_to;
+		}
 	}
 
-	void add(RTLIL::SigSpec from, RTLIL::SigSpec to)
+	void add(const RTLIL::SigSpec &from, const RTLIL::SigSpec &to)
 	{
 		log_assert(GetSize(from) == GetSize(to));
 
-		for (int i = 0; i < GetSize(from); i++)
+		auto it_to = to.begin();
+		for (auto &bf : from)
 		{
-			RTLIL::SigBit &bf = from[i];
-			RTLIL::SigBit &bt = to[i];
+			RTLIL::SigBit bt = *it_to;
+			++it_to;
 
 			if (bf.wire == NULL)
 				continue;
@@ -378,7 +382,7 @@ struct SigMap
 		}
 	}
 
-	void add(RTLIL::SigSpec sig)
+	void add(const RTLIL::SigSpec &sig)
 	{
 		for (auto &bit : sig) {
 			register_bit(bit);
@@ -386,7 +390,7 @@ struct SigMap
 		}
 	}
 
-	void del(RTLIL::SigSpec sig)
+	void del(const RTLIL::SigSpec &sig)
 	{
 		for (auto &bit : sig)
 			unregister_bit(bit);
@@ -51,6 +51,7 @@ YOSYS_NAMESPACE_BEGIN
 
 int autoidx = 1;
 int yosys_xtrace = 0;
+int yosys_pass_jobs = 1;
 RTLIL::Design *yosys_design = NULL;
 CellTypes yosys_celltypes;
 
@@ -232,6 +232,7 @@ int GetSize(RTLIL::Wire *wire);
 
 extern int autoidx;
 extern int yosys_xtrace;
+extern int yosys_pass_jobs;
 
 YOSYS_NAMESPACE_END
 
@@ -25,6 +25,138 @@
 USING_YOSYS_NAMESPACE
 PRIVATE_NAMESPACE_BEGIN
 
+// A hash of everything the opt_* passes read and write in a module.
+// Some passes change cell types and parameters in place, which no
+// RTLIL::Monitor hook reports, so the modules are compared by content.
+static unsigned int module_fingerprint(RTLIL::Module *module)
+{
+	unsigned int h = mkhash_init;
+
+	auto hash_const = [&](const RTLIL::Const &value) {
+		h = mkhash(h, value.flags);
+		h = mkhash(h, GetSize(value.bits));
+		for (auto bit : value.bits)
+			h = mkhash(h, bit);
+	};
+
+	auto hash_attributes = [&](const dict<RTLIL::IdString, RTLIL::Const> &attributes) {
+		h = mkhash(h, GetSize(attributes));
+		for (auto &it : attributes) {
+			h = mkhash(h, it.first.index_);
+			hash_const(it.second);
+		}
+	};
+
+	hash_attributes(module->attributes);
+
+	h = mkhash(h, GetSize(module->wires_));
+	for (auto &it : module->wires_) {
+		RTLIL::Wire *wire = it.second;
+		h = mkhash(h, wire->name.index_);
+		h = mkhash(h, wire->width);
+		h = mkhash(h, wire->start_offset);
+		h = mkhash(h, wire->port_id);
+		h = mkhash(h, wire->port_input + 2*wire->port_output + 4*wire->upto);
+		hash_attributes(wire->attributes);
+	}
+
+	h = mkhash(h, GetSize(module->memories));
+	for (auto &it : module->memories) {
+		h = mkhash(h, it.first.index_);
+		h = mkhash(h, it.second->width);
+		h = mkhash(h, it.second->size);
+		h = mkhash(h, it.second->start_offset);
+	}
+
+	h = mkhash(h, GetSize(module->cells_));
+	for (auto &it : module->cells_) {
+		RTLIL::Cell *cell = it.second;
+		h = mkhash(h, cell->name.index_);
+		h = mkhash(h, cell->type.index_);
+		h = mkhash(h, GetSize(cell->parameters));
+		for (auto &param : cell->parameters) {
+			h = mkhash(h, param.first.index_);
+			hash_const(param.second);
+		}
+		h = mkhash(h, GetSize(cell->connections()));
+		for (auto &conn : cell->connections()) {
+			h = mkhash(h, conn.first.index_);
+			h = mkhash(h, conn.second.hash());
+		}
+		hash_attributes(cell->attributes);
+	}
+
+	h = mkhash(h, GetSize(module->connections()));
+	for (auto &conn : module->connections()) {
+		h = mkhash(h, conn.first.hash());
+		h = mkhash(h, conn.second.hash());
+	}
+
+	return h;
+}
+
+// Finds the modules changed by a round of opt_* passes. A module that
+// the passes left as it was is a fixed point of the round, so the next
+// round only needs to walk the changed modules.
+struct OptDirtyModules
+{
+	RTLIL::Design *design;
+	dict<RTLIL::Module*, unsigned int> fingerprints;
+	RTLIL::Selection orig_sel, sel;
+	bool restricted;
+
+	OptDirtyModules(RTLIL::Design *design) : design(design), restricted(false)
+	{
+		orig_sel = design->selection_stack.back();
+		start_round();
+	}
+
+	// remember the modules of the coming round as they are now
+	void start_round()
+	{
+		fingerprints.clear();
+		for (auto module : design->modules())
+			if ((restricted ? sel : orig_sel).selected_module(module->name))
+				fingerprints[module] = module_fingerprint(module);
+	}
+
+	// run an opt_* pass on the modules of the current round
+	void call(std::string command)
+	{
+		if (restricted)
+			Pass::call_on_selection(design, sel, command);
+		else
+			Pass::call(design, command);
+	}
+
+	// restrict the next round to the part of the original selection that
+	// lies in the changed modules. when a pass reported a change but no
+	// module differs, keep the current selection.
+	void next_round()
+	{
+		pool<RTLIL::Module*> dirty;
+		for (auto &it : fingerprints)
+			if (design->module(it.first->name) == it.first && module_fingerprint(it.first) != it.second)
+				dirty.insert(it.first);
+
+		if (!dirty.empty())
+		{
+			sel = RTLIL::Selection(false);
+			for (auto module : dirty) {
+				if (orig_sel.selected_whole_module(module->name))
+					sel.selected_modules.insert(module->name);
+				else if (orig_sel.selected_members.count(module->name))
+					sel.selected_members[module->name] = orig_sel.selected_members.at(module->name);
+			}
+			restricted = true;
+
+			log("Changes in %d module%s, restricting the next round to %s.\n", GetSize(dirty),
+					GetSize(dirty) == 1 ? "" : "s", GetSize(dirty) == 1 ? "it" : "them");
+		}
+		start_round();
+	}
+};
+
 struct OptPass : public Pass {
 	OptPass() : Pass("opt", "perform simple optimizations") { }
 	virtual void help()
@@ -58,6 +190,9 @@ struct OptPass : public Pass {
 		log("        opt_clean [-purge]\n");
 		log("    while <changed design in opt_rmdff>\n");
 		log("\n");
+		log("Only the modules that were changed in the previous round are processed\n");
+		log("again when the passes are rerun.\n");
+		log("\n");
 		log("Note: Options in square brackets (such as [-keepdc]) are passed through to\n");
 		log("the opt_* commands when given to 'opt'.\n");
 		log("\n");
@@ -124,33 +259,38 @@ struct OptPass : public Pass {
 
 		if (fast_mode)
 		{
+			OptDirtyModules rounds(design);
 			while (1) {
-				Pass::call(design, "opt_const" + opt_const_args);
-				Pass::call(design, "opt_share" + opt_share_args);
+				rounds.call("opt_const" + opt_const_args);
+				rounds.call("opt_share" + opt_share_args);
 				design->scratchpad_unset("opt.did_something");
-				Pass::call(design, "opt_rmdff");
+				rounds.call("opt_rmdff");
 				if (design->scratchpad_get_bool("opt.did_something") == false)
 					break;
-				Pass::call(design, "opt_clean" + opt_clean_args);
+				rounds.call("opt_clean" + opt_clean_args);
 				log_header("Rerunning OPT passes. (Removed registers in this run.)\n");
+				rounds.next_round();
 			}
-			Pass::call(design, "opt_clean" + opt_clean_args);
+			rounds.call("opt_clean" + opt_clean_args);
 		}
 		else
 		{
 			Pass::call(design, "opt_const" + opt_const_args);
 			Pass::call(design, "opt_share -nomux" + opt_share_args);
+
+			OptDirtyModules rounds(design);
 			while (1) {
 				design->scratchpad_unset("opt.did_something");
-				Pass::call(design, "opt_muxtree");
-				Pass::call(design, "opt_reduce" + opt_reduce_args);
-				Pass::call(design, "opt_share" + opt_share_args);
-				Pass::call(design, "opt_rmdff");
-				Pass::call(design, "opt_clean" + opt_clean_args);
-				Pass::call(design, "opt_const" + opt_const_args);
+				rounds.call("opt_muxtree");
+				rounds.call("opt_reduce" + opt_reduce_args);
+				rounds.call("opt_share" + opt_share_args);
+				rounds.call("opt_rmdff");
+				rounds.call("opt_clean" + opt_clean_args);
+				rounds.call("opt_const" + opt_const_args);
 				if (design->scratchpad_get_bool("opt.did_something") == false)
 					break;
 				log_header("Rerunning OPT passes. (Maybe there is more to do..)\n");
+				rounds.next_round();
 			}
 		}
 
@@ -358,7 +358,7 @@ void rmunused_module(RTLIL::Module *module, bool purge_mode, bool verbose)
 }
 
 struct OptCleanPass : public Pass {
-	OptCleanPass() : Pass("opt_clean", "remove unused cells and wires") { }
+	OptCleanPass() : Pass("opt_clean", "remove unused cells and wires") { module_local = true; }
 	virtual void help()
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
@@ -418,7 +418,7 @@ struct OptCleanPass : public Pass {
 } OptCleanPass;
 
 struct CleanPass : public Pass {
-	CleanPass() : Pass("clean", "remove unused cells and wires") { }
+	CleanPass() : Pass("clean", "remove unused cells and wires") { module_local = true; }
 	virtual void help()
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
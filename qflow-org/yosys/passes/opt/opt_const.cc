@@ -1057,7 +1057,7 @@ void replace_const_cells(RTLIL::Design *design, RTLIL::Module *module, bool cons
 }
 
 struct OptConstPass : public Pass {
-	OptConstPass() : Pass("opt_const", "perform const folding") { }
+	OptConstPass() : Pass("opt_const", "perform const folding") { module_local = true; }
 	virtual void help()
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
@@ -448,7 +448,7 @@ struct OptMuxtreeWorker
 };
 
 struct OptMuxtreePass : public Pass {
-	OptMuxtreePass() : Pass("opt_muxtree", "eliminate dead trees in multiplexer trees") { }
+	OptMuxtreePass() : Pass("opt_muxtree", "eliminate dead trees in multiplexer trees") { module_local = true; }
 	virtual void help()
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
@@ -328,7 +328,7 @@ struct OptReduceWorker
 };
 
 struct OptReducePass : public Pass {
-	OptReducePass() : Pass("opt_reduce", "simplify large MUXes and AND/OR gates") { }
+	OptReducePass() : Pass("opt_reduce", "simplify large MUXes and AND/OR gates") { module_local = true; }
 	virtual void help()
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
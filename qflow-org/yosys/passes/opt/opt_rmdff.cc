@@ -177,7 +177,7 @@ delete_dff:
 }
 
 struct OptRmdffPass : public Pass {
-	OptRmdffPass() : Pass("opt_rmdff", "remove DFFs with constant inputs") { }
+	OptRmdffPass() : Pass("opt_rmdff", "remove DFFs with constant inputs") { module_local = true; }
 	virtual void help()
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
@@ -287,7 +287,7 @@ struct OptShareWorker
 };
 
 struct OptSharePass : public Pass {
-	OptSharePass() : Pass("opt_share", "consolidate identical cells") { }
+	OptSharePass() : Pass("opt_share", "consolidate identical cells") { module_local = true; }
 	virtual void help()
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
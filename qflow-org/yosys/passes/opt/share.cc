@@ -60,6 +60,40 @@ struct ShareWorker
 
 	std::vector<std::pair<RTLIL::SigBit, RTLIL::SigBit>> exclusive_ctrls;
 
+	// One SAT problem for the whole module. The input cones of the control
+	// signals are imported only once and every query is passed as an
+	// assumption, so the solver keeps its learned clauses between queries.
+	ezSatPtr ez;
+	SatGen satgen;
+	pool<RTLIL::Cell*> sat_cells_imported;
+	pool<std::pair<RTLIL::SigBit, RTLIL::SigBit>> sat_exclusive_ctrls;
+
+	// query results, keyed by the ezSAT literal of the query. An unsat result
+	// stays valid when more cells are imported, a sat result only until then.
+	int sat_generation;
+	dict<int, std::pair<int, bool>> sat_cache;
+
+	bool sat_solve(int expr, const std::vector<int> &model_expr, std::vector<bool> &model_values)
+	{
+		auto it = sat_cache.find(expr);
+		if (it != sat_cache.end()) {
+			if (!it->second.second)
+				return false;
+			if (it->second.first == sat_generation && model_expr.empty())
+				return true;
+		}
+
+		bool result = ez->solve(model_expr, model_values, expr);
+		sat_cache[expr] = std::pair<int, bool>(sat_generation, result);
+		return result;
+	}
+
+	bool sat_solve(int expr)
+	{
+		std::vector<bool> model_values;
+		return sat_solve(expr, std::vector<int>(), model_values);
+	}
+
 
 	// ------------------------------------------------------------------------------
 	// Find terminal bits -- i.e. bits that do not (exclusively) feed into a mux tree
@@ -1065,7 +1099,7 @@ struct ShareWorker
 	}
 
 	ShareWorker(ShareWorkerConfig config, RTLIL::Design *design, RTLIL::Module *module) :
-			config(config), design(design), module(module), mi(module)
+			config(config), design(design), module(module), mi(module), satgen(ez.get(), &modwalker.sigmap), sat_generation(0)
 	{
 	#ifndef NDEBUG
 		bool before_scc = module_has_scc();
@@ -1184,9 +1218,6 @@ struct ShareWorker
 				optimize_activation_patterns(filtered_cell_activation_patterns);
 				optimize_activation_patterns(filtered_other_cell_activation_patterns);
 
-				ezSatPtr ez;
-				SatGen satgen(ez.get(), &modwalker.sigmap);
-
 				pool<RTLIL::Cell*> sat_cells;
 				std::set<RTLIL::SigBit> bits_queue;
 
@@ -1223,7 +1254,10 @@ struct ShareWorker
 								continue;
 							// log("      Adding cell %s (%s) to SAT problem.\n", log_id(pbit.cell), log_id(pbit.cell->type));
 							bits_queue.insert(modwalker.cell_inputs[pbit.cell].begin(), modwalker.cell_inputs[pbit.cell].end());
-							satgen.importCell(pbit.cell);
+							if (sat_cells_imported.insert(pbit.cell).second) {
+								satgen.importCell(pbit.cell);
+								sat_generation++;
+							}
 							sat_cells.insert(pbit.cell);
 						}
 
@@ -1232,40 +1266,39 @@ struct ShareWorker
 				}
 
 				for (auto it : exclusive_ctrls)
-					if (satgen.importedSigBit(it.first) && satgen.importedSigBit(it.second)) {
+					if (!sat_exclusive_ctrls.count(it) && satgen.importedSigBit(it.first) && satgen.importedSigBit(it.second)) {
 						log("      Adding exclusive control bits: %s vs. %s\n", log_signal(it.first), log_signal(it.second));
 						int sub1 = satgen.importSigBit(it.first);
 						int sub2 = satgen.importSigBit(it.second);
 						ez->assume(ez->NOT(ez->AND(sub1, sub2)));
+						sat_exclusive_ctrls.insert(it);
+						sat_generation++;
 					}
 
-				if (!ez->solve(ez->expression(ez->OpOr, cell_active))) {
+				if (!sat_solve(ez->expression(ez->OpOr, cell_active))) {
 					log("      According to the SAT solver the cell %s is never active. Sharing is pointless, we simply remove it.\n", log_id(cell));
 					cells_to_remove.insert(cell);
 					break;
 				}
 
-				if (!ez->solve(ez->expression(ez->OpOr, other_cell_active))) {
+				if (!sat_solve(ez->expression(ez->OpOr, other_cell_active))) {
 					log("      According to the SAT solver the cell %s is never active. Sharing is pointless, we simply remove it.\n", log_id(other_cell));
 					cells_to_remove.insert(other_cell);
 					shareable_cells.erase(other_cell);
 					continue;
 				}
 
-				ez->non_incremental();
-
 				all_ctrl_signals.sort_and_unify();
 				std::vector<int> sat_model = satgen.importSigSpec(all_ctrl_signals);
 				std::vector<bool> sat_model_values;
 
 				int sub1 = ez->expression(ez->OpOr, cell_active);
 				int sub2 = ez->expression(ez->OpOr, other_cell_active);
-				ez->assume(ez->AND(sub1, sub2));
 
 				log("      Size of SAT problem: %d cells, %d variables, %d clauses\n",
 						GetSize(sat_cells), ez->numCnfVariables(), ez->numCnfClauses());
 
-				if (ez->solve(sat_model, sat_model_values)) {
+				if (sat_solve(ez->AND(sub1, sub2), sat_model, sat_model_values)) {
 					log("      According to the SAT solver this pair of cells can not be shared.\n");
 					log("      Model from SAT solver: %s = %d'", log_signal(all_ctrl_signals), GetSize(sat_model_values));
 					for (int i = GetSize(sat_model_values)-1; i >= 0; i--)
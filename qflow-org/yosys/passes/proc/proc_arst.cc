@@ -202,7 +202,7 @@ restart_proc_arst:
 }
 
 struct ProcArstPass : public Pass {
-	ProcArstPass() : Pass("proc_arst", "detect asynchronous resets") { }
+	ProcArstPass() : Pass("proc_arst", "detect asynchronous resets") { module_local = true; }
 	virtual void help()
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
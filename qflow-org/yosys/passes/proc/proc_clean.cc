@@ -142,7 +142,7 @@ void proc_clean(RTLIL::Module *mod, RTLIL::Process *proc, int &total_count)
 }
 
 struct ProcCleanPass : public Pass {
-	ProcCleanPass() : Pass("proc_clean", "remove empty parts of processes") { }
+	ProcCleanPass() : Pass("proc_clean", "remove empty parts of processes") { module_local = true; }
 	virtual void help()
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
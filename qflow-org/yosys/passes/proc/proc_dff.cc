@@ -356,7 +356,7 @@ void proc_dff(RTLIL::Module *mod, RTLIL::Process *proc, ConstEval &ce)
 }
 
 struct ProcDffPass : public Pass {
-	ProcDffPass() : Pass("proc_dff", "extract flip-flops from processes") { }
+	ProcDffPass() : Pass("proc_dff", "extract flip-flops from processes") { module_local = true; }
 	virtual void help()
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
@@ -279,7 +279,7 @@ void proc_dlatch(proc_dlatch_db_t &db, RTLIL::Process *proc)
 }
 
 struct ProcDlatchPass : public Pass {
-	ProcDlatchPass() : Pass("proc_dlatch", "extract latches from processes") { }
+	ProcDlatchPass() : Pass("proc_dlatch", "extract latches from processes") { module_local = true; }
 	virtual void help()
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
@@ -86,7 +86,7 @@ void proc_init(RTLIL::Module *mod, RTLIL::Process *proc)
 }
 
 struct ProcInitPass : public Pass {
-	ProcInitPass() : Pass("proc_init", "convert initial block to init attributes") { }
+	ProcInitPass() : Pass("proc_init", "convert initial block to init attributes") { module_local = true; }
 	virtual void help()
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
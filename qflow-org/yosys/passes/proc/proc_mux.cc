@@ -261,7 +261,7 @@ void proc_mux(RTLIL::Module *mod, RTLIL::Process *proc)
 }
 
 struct ProcMuxPass : public Pass {
-	ProcMuxPass() : Pass("proc_mux", "convert decision trees to multiplexers") { }
+	ProcMuxPass() : Pass("proc_mux", "convert decision trees to multiplexers") { module_local = true; }
 	virtual void help()
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
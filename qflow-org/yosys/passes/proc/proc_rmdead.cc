@@ -64,7 +64,7 @@ void proc_rmdead(RTLIL::SwitchRule *sw, int &counter)
 }
 
 struct ProcRmdeadPass : public Pass {
-	ProcRmdeadPass() : Pass("proc_rmdead", "eliminate dead trees in decision trees") { }
+	ProcRmdeadPass() : Pass("proc_rmdead", "eliminate dead trees in decision trees") { module_local = true; }
 	virtual void help()
 	{
 		//   |---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|---v---|
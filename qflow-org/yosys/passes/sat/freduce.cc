@@ -224,6 +224,20 @@ struct FindReducedInputs
 	}
 };
 
+struct ReductionSession
+{
+	ezSatPtr ez;
+	SatGen satgen;
+
+	std::set<RTLIL::Cell*> cells;
+	std::set<RTLIL::SigBit> pi_bits;
+
+	ReductionSession(SigMap &sigmap) : satgen(ez.get(), &sigmap)
+	{
+		satgen.model_undef = true;
+	}
+};
+
 struct PerformReduction
 {
 	SigMap &sigmap;
@@ -231,8 +245,9 @@ struct PerformReduction
 	std::set<std::pair<RTLIL::SigBit, RTLIL::SigBit>> &inv_pairs;
 	pool<SigBit> recursion_guard;
 
-	ezSatPtr ez;
-	SatGen satgen;
+	ReductionSession &session;
+	ezSAT *ez;
+	SatGen &satgen;
 
 	std::vector<int> sat_pi, sat_out, sat_def;
 	std::vector<RTLIL::SigBit> out_bits, pi_bits;
@@ -240,7 +255,7 @@ struct PerformReduction
 	std::vector<int> out_depth;
 	int cone_size;
 
-	int register_cone_worker(std::set<RTLIL::Cell*> &celldone, std::map<RTLIL::SigBit, int> &sigdepth, RTLIL::SigBit out)
+	int register_cone_worker(std::map<RTLIL::SigBit, int> &sigdepth, RTLIL::SigBit out)
 	{
 		if (out.wire == NULL)
 			return 0;
@@ -258,19 +273,20 @@ struct PerformReduction
 
 		if (drivers.count(out) != 0) {
 			std::pair<RTLIL::Cell*, std::set<RTLIL::SigBit>> &drv = drivers.at(out);
-			if (celldone.count(drv.first) == 0) {
+			if (session.cells.count(drv.first) == 0) {
 				if (!satgen.importCell(drv.first))
 					log_error("Can't create SAT model for cell %s (%s)!\n", RTLIL::id2cstr(drv.first->name), RTLIL::id2cstr(drv.first->type));
-				celldone.insert(drv.first);
+				session.cells.insert(drv.first);
 			}
 			int max_child_depth = 0;
 			for (auto &bit : drv.second)
-				max_child_depth = std::max(register_cone_worker(celldone, sigdepth, bit), max_child_depth);
+				max_child_depth = std::max(register_cone_worker(sigdepth, bit), max_child_depth);
 			sigdepth[out] = max_child_depth + 1;
 		} else {
 			pi_bits.push_back(out);
 			sat_pi.push_back(satgen.importSigSpec(out).front());
-			ez->assume(ez->NOT(satgen.importUndefSigSpec(out).front()));
+			if (session.pi_bits.insert(out).second)
+				ez->assume(ez->NOT(satgen.importUndefSigSpec(out).front()));
 			sigdepth[out] = 0;
 		}
 
@@ -278,16 +294,14 @@ struct PerformReduction
 		return sigdepth.at(out);
 	}
 
-	PerformReduction(SigMap &sigmap, drivers_t &drivers, std::set<std::pair<RTLIL::SigBit, RTLIL::SigBit>> &inv_pairs, std::vector<RTLIL::SigBit> &bits, int cone_size) :
-			sigmap(sigmap), drivers(drivers), inv_pairs(inv_pairs), satgen(ez.get(), &sigmap), out_bits(bits), cone_size(cone_size)
+	PerformReduction(SigMap &sigmap, drivers_t &drivers, std::set<std::pair<RTLIL::SigBit, RTLIL::SigBit>> &inv_pairs, ReductionSession &session,
+			std::vector<RTLIL::SigBit> &bits, int cone_size) : sigmap(sigmap), drivers(drivers), inv_pairs(inv_pairs), session(session),
+			ez(session.ez.get()), satgen(session.satgen), out_bits(bits), cone_size(cone_size)
 	{
-		satgen.model_undef = true;
-
-		std::set<RTLIL::Cell*> celldone;
 		std::map<RTLIL::SigBit, int> sigdepth;
 
 		for (auto &bit : bits) {
-			out_depth.push_back(register_cone_worker(celldone, sigdepth, bit));
+			out_depth.push_back(register_cone_worker(sigdepth, bit));
 			sat_out.push_back(satgen.importSigSpec(bit).front());
 			sat_def.push_back(ez->NOT(satgen.importUndefSigSpec(bit).front()));
 		}
@@ -642,6 +656,7 @@ struct FreduceWorker
 		int bits_count = 0;
 		int bits_full_count = 0;
 		std::map<std::vector<RTLIL::SigBit>, std::vector<RTLIL::SigBit>> buckets;
+		FindReducedInputs infinder(sigmap, drivers);
 		for (auto &batch : batches)
 		{
 			for (auto &bit : batch)
@@ -654,7 +669,6 @@ struct FreduceWorker
 			log("  Finding reduced input cone for signal batch %s%c\n",
 					log_signal(batch), verbose_level ? ':' : '.');
 
-			FindReducedInputs infinder(sigmap, drivers);
 			for (auto &bit : batch) {
 				std::vector<RTLIL::SigBit> inputs;
 				infinder.analyze(inputs, bit, 100 * bits_full_count / bits_full_total);
@@ -667,6 +681,7 @@ struct FreduceWorker
 
 		int bucket_count = 0;
 		std::vector<std::vector<equiv_bit_t>> equiv;
+		ReductionSession session(sigmap);
 		for (auto &bucket : buckets)
 		{
 			bucket_count++;
@@ -676,12 +691,12 @@ struct FreduceWorker
 
 			if (bucket.first.size() == 0) {
 				log("  Finding const values for bucket %s%c\n", log_signal(bucket.second), verbose_level ? ':' : '.');
-				PerformReduction worker(sigmap, drivers, inv_pairs, bucket.second, bucket.first.size());
+				PerformReduction worker(sigmap, drivers, inv_pairs, session, bucket.second, bucket.first.size());
 				for (size_t idx = 0; idx < bucket.second.size(); idx++)
 					worker.analyze_const(equiv, idx);
 			} else {
 				log("  Trying to shatter bucket %s%c\n", log_signal(bucket.second), verbose_level ? ':' : '.');
-				PerformReduction worker(sigmap, drivers, inv_pairs, bucket.second, bucket.first.size());
+				PerformReduction worker(sigmap, drivers, inv_pairs, session, bucket.second, bucket.first.size());
 				worker.analyze(equiv, 100 * bucket_count / (buckets.size() + 1));
 			}
 		}
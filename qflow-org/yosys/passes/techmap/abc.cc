@@ -47,6 +47,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdarg.h>
 #include <cerrno>
 #include <sstream>
 #include <climits>
@@ -54,6 +55,7 @@
 #ifndef _WIN32
 #  include <unistd.h>
 #  include <dirent.h>
+#  include <sys/wait.h>
 #endif
 
 #include "frontends/blif/blifparse.h"
@@ -104,6 +106,55 @@ std::map<RTLIL::SigBit, int> signal_map;
 bool clk_polarity, en_polarity;
 RTLIL::SigSpec clk_sig, en_sig;
 
+typedef std::tuple<bool, RTLIL::SigSpec, bool, RTLIL::SigSpec> clkdomain_t;
+
+// one ABC run: a module (or one clock domain of a module) from extraction
+// until its results are re-integrated
+struct abc_job
+{
+	RTLIL::Module *module;
+	std::vector<RTLIL::Cell*> cells;
+	std::string clk_str;
+	clkdomain_t clk_domain;
+	bool dff_mode, log_only;
+
+	// log output of the extraction, printed when the job is re-integrated
+	std::vector<std::pair<bool, std::string>> log_lines;
+
+	int map_autoidx;
+	std::vector<gate_t> signal_list;
+	bool clk_polarity, en_polarity;
+	RTLIL::SigSpec clk_sig, en_sig;
+	std::string tempdir_name, abc_command;
+	FILE *abc_pipe;
+
+	abc_job(RTLIL::Module *module) : module(module), dff_mode(false), log_only(false), map_autoidx(0),
+			clk_polarity(true), en_polarity(true), abc_pipe(NULL) { }
+};
+
+// extraction runs ahead of the re-integration of earlier jobs, so
+// everything it has to say is kept here and logged in job order
+std::vector<std::pair<bool, std::string>> deferred_log;
+
+void defer_log(const char *format, ...) YS_ATTRIBUTE(format(printf, 1, 2));
+void defer_log_header(const char *format, ...) YS_ATTRIBUTE(format(printf, 1, 2));
+
+void defer_log(const char *format, ...)
+{
+	va_list ap;
+	va_start(ap, format);
+	deferred_log.push_back(std::pair<bool, std::string>(false, vstringf(format, ap)));
+	va_end(ap);
+}
+
+void defer_log_header(const char *format, ...)
+{
+	va_list ap;
+	va_start(ap, format);
+	deferred_log.push_back(std::pair<bool, std::string>(true, vstringf(format, ap)));
+	va_end(ap);
+}
+
 int map_signal(RTLIL::SigBit bit, gate_type_t gate_type = G(NONE), int in1 = -1, int in2 = -1, int in3 = -1, int in4 = -1)
 {
 	assign_map.apply(bit);
@@ -439,10 +490,10 @@ void handle_loops()
 			bool first_line = true;
 			for (int id2 : edges[id1]) {
 				if (first_line)
-					log("Breaking loop using new signal %s: %s -> %s\n", log_signal(RTLIL::SigSpec(wire)),
+					defer_log("Breaking loop using new signal %s: %s -> %s\n", log_signal(RTLIL::SigSpec(wire)),
 							log_signal(signal_list[id1].bit), log_signal(signal_list[id2].bit));
 				else
-					log("                               %*s  %s -> %s\n", int(strlen(log_signal(RTLIL::SigSpec(wire)))), "",
+					defer_log("                               %*s  %s -> %s\n", int(strlen(log_signal(RTLIL::SigSpec(wire)))), "",
 							log_signal(signal_list[id1].bit), log_signal(signal_list[id2].bit));
 				first_line = false;
 			}
@@ -475,6 +526,276 @@ void handle_loops()
 		fclose(dot_f);
 }
 
+// binary AIGER writer for the extracted gate netlist (see
+// http://fmv.jku.at/aiger/FORMAT). The gates are decomposed into AND nodes
+// while the netlist is written, so ABC does not need to parse and strash a
+// BLIF text file. Inputs, latches and outputs keep their "n<id>" names in
+// the symbol table, so the mapped netlist refers to the same signals.
+
+struct aig_builder
+{
+	std::vector<std::pair<int, int>> ands;
+	int first_and_var;
+
+	int make_and(int a, int b)
+	{
+		if (a == 0 || b == 0 || a == (b ^ 1))
+			return 0;
+		if (a == 1 || a == b)
+			return b;
+		if (b == 1)
+			return a;
+		ands.push_back(a > b ? std::pair<int, int>(a, b) : std::pair<int, int>(b, a));
+		return 2 * (first_and_var + GetSize(ands) - 1);
+	}
+
+	int make_or(int a, int b)
+	{
+		return make_and(a ^ 1, b ^ 1) ^ 1;
+	}
+
+	int make_xor(int a, int b)
+	{
+		return make_or(make_and(a, b ^ 1), make_and(a ^ 1, b));
+	}
+
+	int make_mux(int a, int b, int s)
+	{
+		return make_or(make_and(s ^ 1, a), make_and(s, b));
+	}
+};
+
+void aiger_put_delta(FILE *f, unsigned int x)
+{
+	while (x & ~0x7f) {
+		fputc((x & 0x7f) | 0x80, f);
+		x >>= 7;
+	}
+	fputc(x, f);
+}
+
+int write_aiger_netlist(FILE *f, int &count_input, int &count_output, int &count_ands)
+{
+	std::vector<int> lits(GetSize(signal_list), -1);
+	std::vector<int> inputs, latches, outputs;
+	aig_builder aig;
+	int num_vars = 0;
+
+	for (auto &si : signal_list) {
+		if (si.type != G(NONE))
+			continue;
+		if (si.bit.wire == NULL)
+			lits[si.id] = si.bit == RTLIL::State::S1 ? 1 : 0;
+		else if (si.is_port) {
+			lits[si.id] = 2 * ++num_vars;
+			inputs.push_back(si.id);
+		} else
+			lits[si.id] = 0;
+	}
+
+	for (auto &si : signal_list)
+		if (si.type == G(FF)) {
+			lits[si.id] = 2 * ++num_vars;
+			latches.push_back(si.id);
+		}
+
+	aig.first_and_var = num_vars + 1;
+
+	// handle_loops() left the combinational part acyclic, so a depth-first
+	// walk from every gate creates the AND nodes in topological order
+	std::vector<int> stack;
+	for (auto &root : signal_list)
+	{
+		if (lits[root.id] >= 0)
+			continue;
+
+		lits[root.id] = -2;
+		stack.push_back(root.id);
+		while (!stack.empty())
+		{
+			gate_t &si = signal_list[stack.back()];
+			int in[4] = { si.in1, si.in2, si.in3, si.in4 };
+			int pending = -1;
+
+			// descend into one fan-in at a time, so that the nodes marked
+			// on the stack are always ancestors of the top node
+			for (int i = 0; i < 4 && pending < 0; i++)
+				if (in[i] >= 0 && lits[in[i]] < 0)
+					pending = in[i];
+			if (pending >= 0) {
+				if (lits[pending] == -2)
+					log_error("Found combinational loop at %s while writing AIG.\n", log_signal(signal_list[pending].bit));
+				lits[pending] = -2;
+				stack.push_back(pending);
+				continue;
+			}
+
+			int a = in[0] >= 0 ? lits[in[0]] : 0;
+			int b = in[1] >= 0 ? lits[in[1]] : 0;
+			int c = in[2] >= 0 ? lits[in[2]] : 0;
+			int d = in[3] >= 0 ? lits[in[3]] : 0;
+			int y;
+
+			switch (si.type) {
+			case G(BUF):  y = a; break;
+			case G(NOT):  y = a ^ 1; break;
+			case G(AND):  y = aig.make_and(a, b); break;
+			case G(NAND): y = aig.make_and(a, b) ^ 1; break;
+			case G(OR):   y = aig.make_or(a, b); break;
+			case G(NOR):  y = aig.make_or(a, b) ^ 1; break;
+			case G(XOR):  y = aig.make_xor(a, b); break;
+			case G(XNOR): y = aig.make_xor(a, b) ^ 1; break;
+			case G(MUX):  y = aig.make_mux(a, b, c); break;
+			case G(AOI3): y = aig.make_or(aig.make_and(a, b), c) ^ 1; break;
+			case G(OAI3): y = aig.make_and(aig.make_or(a, b), c) ^ 1; break;
+			case G(AOI4): y = aig.make_or(aig.make_and(a, b), aig.make_and(c, d)) ^ 1; break;
+			case G(OAI4): y = aig.make_and(aig.make_or(a, b), aig.make_or(c, d)) ^ 1; break;
+			default: log_abort();
+			}
+
+			lits[si.id] = y;
+			stack.pop_back();
+		}
+	}
+
+	for (auto &si : signal_list)
+		if (si.is_port && si.type != G(NONE))
+			outputs.push_back(si.id);
+
+	count_input = GetSize(inputs);
+	count_output = GetSize(outputs);
+
+	fprintf(f, "aig %d %d %d %d %d\n", num_vars + GetSize(aig.ands), count_input, GetSize(latches), count_output, GetSize(aig.ands));
+	for (int id : latches)
+		fprintf(f, "%d\n", lits[signal_list[id].in1]);
+	for (int id : outputs)
+		fprintf(f, "%d\n", lits[id]);
+
+	for (int i = 0; i < GetSize(aig.ands); i++) {
+		unsigned int lhs = 2 * (aig.first_and_var + i);
+		aiger_put_delta(f, lhs - aig.ands[i].first);
+		aiger_put_delta(f, aig.ands[i].first - aig.ands[i].second);
+	}
+
+	for (int i = 0; i < GetSize(inputs); i++)
+		fprintf(f, "i%d n%d\n", i, inputs[i]);
+	for (int i = 0; i < GetSize(latches); i++)
+		fprintf(f, "l%d n%d\n", i, latches[i]);
+	for (int i = 0; i < GetSize(outputs); i++)
+		fprintf(f, "o%d n%d\n", i, outputs[i]);
+	fprintf(f, "c\nyosys abc pass\n");
+
+	int count_gates = 0;
+	for (auto &si : signal_list)
+		if (si.type != G(NONE))
+			count_gates++;
+
+	count_ands = GetSize(aig.ands);
+	return count_gates;
+}
+
+int write_blif_netlist(FILE *f, int &count_input, int &count_output)
+{
+	count_input = 0;
+	count_output = 0;
+
+	fprintf(f, ".model netlist\n");
+
+	fprintf(f, ".inputs");
+	for (auto &si : signal_list) {
+		if (!si.is_port || si.type != G(NONE))
+			continue;
+		fprintf(f, " n%d", si.id);
+		count_input++;
+	}
+	if (count_input == 0)
+		fprintf(f, " dummy_input\n");
+	fprintf(f, "\n");
+
+	fprintf(f, ".outputs");
+	for (auto &si : signal_list) {
+		if (!si.is_port || si.type == G(NONE))
+			continue;
+		fprintf(f, " n%d", si.id);
+		count_output++;
+	}
+	fprintf(f, "\n");
+
+	for (auto &si : signal_list)
+		fprintf(f, "# n%-5d %s\n", si.id, log_signal(si.bit));
+
+	for (auto &si : signal_list) {
+		if (si.bit.wire == NULL) {
+			fprintf(f, ".names n%d\n", si.id);
+			if (si.bit == RTLIL::State::S1)
+				fprintf(f, "1\n");
+		}
+	}
+
+	int count_gates = 0;
+	for (auto &si : signal_list) {
+		if (si.type == G(BUF)) {
+			fprintf(f, ".names n%d n%d\n", si.in1, si.id);
+			fprintf(f, "1 1\n");
+		} else if (si.type == G(NOT)) {
+			fprintf(f, ".names n%d n%d\n", si.in1, si.id);
+			fprintf(f, "0 1\n");
+		} else if (si.type == G(AND)) {
+			fprintf(f, ".names n%d n%d n%d\n", si.in1, si.in2, si.id);
+			fprintf(f, "11 1\n");
+		} else if (si.type == G(NAND)) {
+			fprintf(f, ".names n%d n%d n%d\n", si.in1, si.in2, si.id);
+			fprintf(f, "0- 1\n");
+			fprintf(f, "-0 1\n");
+		} else if (si.type == G(OR)) {
+			fprintf(f, ".names n%d n%d n%d\n", si.in1, si.in2, si.id);
+			fprintf(f, "-1 1\n");
+			fprintf(f, "1- 1\n");
+		} else if (si.type == G(NOR)) {
+			fprintf(f, ".names n%d n%d n%d\n", si.in1, si.in2, si.id);
+			fprintf(f, "00 1\n");
+		} else if (si.type == G(XOR)) {
+			fprintf(f, ".names n%d n%d n%d\n", si.in1, si.in2, si.id);
+			fprintf(f, "01 1\n");
+			fprintf(f, "10 1\n");
+		} else if (si.type == G(XNOR)) {
+			fprintf(f, ".names n%d n%d n%d\n", si.in1, si.in2, si.id);
+			fprintf(f, "00 1\n");
+			fprintf(f, "11 1\n");
+		} else if (si.type == G(MUX)) {
+			fprintf(f, ".names n%d n%d n%d n%d\n", si.in1, si.in2, si.in3, si.id);
+			fprintf(f, "1-0 1\n");
+			fprintf(f, "-11 1\n");
+		} else if (si.type == G(AOI3)) {
+			fprintf(f, ".names n%d n%d n%d n%d\n", si.in1, si.in2, si.in3, si.id);
+			fprintf(f, "-00 1\n");
+			fprintf(f, "0-0 1\n");
+		} else if (si.type == G(OAI3)) {
+			fprintf(f, ".names n%d n%d n%d n%d\n", si.in1, si.in2, si.in3, si.id);
+			fprintf(f, "00- 1\n");
+			fprintf(f, "--0 1\n");
+		} else if (si.type == G(AOI4)) {
+			fprintf(f, ".names n%d n%d n%d n%d n%d\n", si.in1, si.in2, si.in3, si.in4, si.id);
+			fprintf(f, "-0-0 1\n");
+			fprintf(f, "-00- 1\n");
+			fprintf(f, "0--0 1\n");
+			fprintf(f, "0-0- 1\n");
+		} else if (si.type == G(OAI4)) {
+			fprintf(f, ".names n%d n%d n%d n%d n%d\n", si.in1, si.in2, si.in3, si.in4, si.id);
+			fprintf(f, "00-- 1\n");
+			fprintf(f, "--00 1\n");
+		} else if (si.type == G(FF)) {
+			fprintf(f, ".latch n%d n%d\n", si.in1, si.id);
+		} else if (si.type != G(NONE))
+			log_abort();
+		if (si.type != G(NONE))
+			count_gates++;
+	}
+
+	fprintf(f, ".end\n");
+	return count_gates;
+}
+
 std::string add_echos_to_abc_cmd(std::string str)
 {
 	std::string new_str, token;
@@ -590,35 +911,47 @@ struct abc_output_filter
 	}
 };
 
-void abc_module(RTLIL::Design *design, RTLIL::Module *current_module, std::string script_file, std::string exe_file,
-		std::string liberty_file, std::string constr_file, bool cleanup, int lut_mode, int lut_mode2, bool dff_mode, std::string clk_str,
-		bool keepff, std::string delay_target, bool fast_mode, const std::vector<RTLIL::Cell*> &cells, bool show_tempdir)
+void abc_extract(abc_job &job, std::string script_file, std::string exe_file, std::string liberty_file, std::string constr_file,
+		bool cleanup, int lut_mode, int lut_mode2, bool keepff, std::string delay_target, bool fast_mode, bool show_tempdir, bool aig_mode)
 {
-	module = current_module;
+	std::string clk_str = job.clk_str;
+	std::string input_file = aig_mode ? "input.aig" : "input.blif";
+	bool dff_mode = job.dff_mode;
+
+	module = job.module;
 	map_autoidx = autoidx++;
 
 	signal_map.clear();
 	signal_list.clear();
+	deferred_log.swap(job.log_lines);
+
+	assign_map.set(module);
 
 	if (clk_str != "$")
 	{
-		assign_map.set(module);
-
 		clk_polarity = true;
 		clk_sig = RTLIL::SigSpec();
 
 		en_polarity = true;
 		en_sig = RTLIL::SigSpec();
 	}
+	else
+	{
+		clk_polarity = std::get<0>(job.clk_domain);
+		clk_sig = assign_map(std::get<1>(job.clk_domain));
+		en_polarity = std::get<2>(job.clk_domain);
+		en_sig = assign_map(std::get<3>(job.clk_domain));
+		dff_mode = !clk_sig.empty();
+	}
 
 	std::string tempdir_name = "/tmp/yosys-abc-XXXXXX";
 	if (!cleanup)
 		tempdir_name[0] = tempdir_name[4] = '_';
 	tempdir_name = make_temp_dir(tempdir_name);
-	log_header("Extracting gate netlist of module `%s' to `%s/input.blif'..\n",
-			module->name.c_str(), replace_tempdir(tempdir_name, tempdir_name, show_tempdir).c_str());
+	defer_log_header("Extracting gate netlist of module `%s' to `%s/%s'..\n",
+			module->name.c_str(), replace_tempdir(tempdir_name, tempdir_name, show_tempdir).c_str(), input_file.c_str());
 
-	std::string abc_script = stringf("read_blif %s/input.blif; ", tempdir_name.c_str());
+	std::string abc_script = stringf("%s %s/%s; ", aig_mode ? "read_aiger" : "read_blif", tempdir_name.c_str(), input_file.c_str());
 
 	if (!liberty_file.empty()) {
 		abc_script += stringf("read_lib -w %s; ", liberty_file.c_str());
@@ -689,16 +1022,16 @@ void abc_module(RTLIL::Design *design, RTLIL::Module *current_module, std::strin
 	if (dff_mode || !clk_str.empty())
 	{
 		if (clk_sig.size() == 0)
-			log("No%s clock domain found. Not extracting any FF cells.\n", clk_str.empty() ? "" : " matching");
+			defer_log("No%s clock domain found. Not extracting any FF cells.\n", clk_str.empty() ? "" : " matching");
 		else {
-			log("Found%s %s clock domain: %s", clk_str.empty() ? "" : " matching", clk_polarity ? "posedge" : "negedge", log_signal(clk_sig));
+			defer_log("Found%s %s clock domain: %s", clk_str.empty() ? "" : " matching", clk_polarity ? "posedge" : "negedge", log_signal(clk_sig));
 			if (en_sig.size() != 0)
-				log(", enabled by %s%s", en_polarity ? "" : "!", log_signal(en_sig));
-			log("\n");
+				defer_log(", enabled by %s%s", en_polarity ? "" : "!", log_signal(en_sig));
+			defer_log("\n");
 		}
 	}
 
-	for (auto c : cells)
+	for (auto c : job.cells)
 		extract_cell(c, keepff);
 
 	for (auto &wire_it : module->wires_) {
@@ -718,117 +1051,27 @@ void abc_module(RTLIL::Design *design, RTLIL::Module *current_module, std::strin
 
 	handle_loops();
 
-	std::string buffer = stringf("%s/input.blif", tempdir_name.c_str());
-	f = fopen(buffer.c_str(), "wt");
+	std::string buffer = stringf("%s/%s", tempdir_name.c_str(), input_file.c_str());
+	f = fopen(buffer.c_str(), aig_mode ? "wb" : "wt");
 	if (f == NULL)
 		log_error("Opening %s for writing failed: %s\n", buffer.c_str(), strerror(errno));
 
-	fprintf(f, ".model netlist\n");
-
-	int count_input = 0;
-	fprintf(f, ".inputs");
-	for (auto &si : signal_list) {
-		if (!si.is_port || si.type != G(NONE))
-			continue;
-		fprintf(f, " n%d", si.id);
-		count_input++;
-	}
-	if (count_input == 0)
-		fprintf(f, " dummy_input\n");
-	fprintf(f, "\n");
-
-	int count_output = 0;
-	fprintf(f, ".outputs");
-	for (auto &si : signal_list) {
-		if (!si.is_port || si.type == G(NONE))
-			continue;
-		fprintf(f, " n%d", si.id);
-		count_output++;
-	}
-	fprintf(f, "\n");
-
-	for (auto &si : signal_list)
-		fprintf(f, "# n%-5d %s\n", si.id, log_signal(si.bit));
-
-	for (auto &si : signal_list) {
-		if (si.bit.wire == NULL) {
-			fprintf(f, ".names n%d\n", si.id);
-			if (si.bit == RTLIL::State::S1)
-				fprintf(f, "1\n");
-		}
-	}
-
-	int count_gates = 0;
-	for (auto &si : signal_list) {
-		if (si.type == G(BUF)) {
-			fprintf(f, ".names n%d n%d\n", si.in1, si.id);
-			fprintf(f, "1 1\n");
-		} else if (si.type == G(NOT)) {
-			fprintf(f, ".names n%d n%d\n", si.in1, si.id);
-			fprintf(f, "0 1\n");
-		} else if (si.type == G(AND)) {
-			fprintf(f, ".names n%d n%d n%d\n", si.in1, si.in2, si.id);
-			fprintf(f, "11 1\n");
-		} else if (si.type == G(NAND)) {
-			fprintf(f, ".names n%d n%d n%d\n", si.in1, si.in2, si.id);
-			fprintf(f, "0- 1\n");
-			fprintf(f, "-0 1\n");
-		} else if (si.type == G(OR)) {
-			fprintf(f, ".names n%d n%d n%d\n", si.in1, si.in2, si.id);
-			fprintf(f, "-1 1\n");
-			fprintf(f, "1- 1\n");
-		} else if (si.type == G(NOR)) {
-			fprintf(f, ".names n%d n%d n%d\n", si.in1, si.in2, si.id);
-			fprintf(f, "00 1\n");
-		} else if (si.type == G(XOR)) {
-			fprintf(f, ".names n%d n%d n%d\n", si.in1, si.in2, si.id);
-			fprintf(f, "01 1\n");
-			fprintf(f, "10 1\n");
-		} else if (si.type == G(XNOR)) {
-			fprintf(f, ".names n%d n%d n%d\n", si.in1, si.in2, si.id);
-			fprintf(f, "00 1\n");
-			fprintf(f, "11 1\n");
-		} else if (si.type == G(MUX)) {
-			fprintf(f, ".names n%d n%d n%d n%d\n", si.in1, si.in2, si.in3, si.id);
-			fprintf(f, "1-0 1\n");
-			fprintf(f, "-11 1\n");
-		} else if (si.type == G(AOI3)) {
-			fprintf(f, ".names n%d n%d n%d n%d\n", si.in1, si.in2, si.in3, si.id);
-			fprintf(f, "-00 1\n");
-			fprintf(f, "0-0 1\n");
-		} else if (si.type == G(OAI3)) {
-			fprintf(f, ".names n%d n%d n%d n%d\n", si.in1, si.in2, si.in3, si.id);
-			fprintf(f, "00- 1\n");
-			fprintf(f, "--0 1\n");
-		} else if (si.type == G(AOI4)) {
-			fprintf(f, ".names n%d n%d n%d n%d n%d\n", si.in1, si.in2, si.in3, si.in4, si.id);
-			fprintf(f, "-0-0 1\n");
-			fprintf(f, "-00- 1\n");
-			fprintf(f, "0--0 1\n");
-			fprintf(f, "0-0- 1\n");
-		} else if (si.type == G(OAI4)) {
-			fprintf(f, ".names n%d n%d n%d n%d n%d\n", si.in1, si.in2, si.in3, si.in4, si.id);
-			fprintf(f, "00-- 1\n");
-			fprintf(f, "--00 1\n");
-		} else if (si.type == G(FF)) {
-			fprintf(f, ".latch n%d n%d\n", si.in1, si.id);
-		} else if (si.type != G(NONE))
-			log_abort();
-		if (si.type != G(NONE))
-			count_gates++;
+	int count_input = 0, count_output = 0;
+
+	if (aig_mode) {
+		int count_ands = 0;
+		int count_gates = write_aiger_netlist(f, count_input, count_output, count_ands);
+		defer_log("Extracted %d gates and %d wires to an AIG with %d inputs, %d outputs and %d AND nodes.\n",
+				count_gates, GetSize(signal_list), count_input, count_output, count_ands);
+	} else {
+		int count_gates = write_blif_netlist(f, count_input, count_output);
+		defer_log("Extracted %d gates and %d wires to a netlist network with %d inputs and %d outputs.\n",
+				count_gates, GetSize(signal_list), count_input, count_output);
 	}
-
-	fprintf(f, ".end\n");
 	fclose(f);
 
-	log("Extracted %d gates and %d wires to a netlist network with %d inputs and %d outputs.\n",
-			count_gates, GetSize(signal_list), count_input, count_output);
-	log_push();
-
 	if (count_output > 0)
 	{
-		log_header("Executing ABC.\n");
-
 		buffer = stringf("%s/stdcells.genlib", tempdir_name.c_str());
 		f = fopen(buffer.c_str(), "wt");
 		if (f == NULL)
@@ -868,11 +1111,74 @@ void abc_module(RTLIL::Design *design, RTLIL::Module *current_module, std::strin
 			fclose(f);
 		}
 
-		buffer = stringf("%s -s -f %s/abc.script 2>&1", exe_file.c_str(), tempdir_name.c_str());
+		// started here, collected in abc_reintegrate()
+		job.abc_command = stringf("%s -s -f %s/abc.script 2>&1", exe_file.c_str(), tempdir_name.c_str());
+		job.abc_pipe = popen(job.abc_command.c_str(), "r");
+		if (job.abc_pipe == NULL)
+			log_error("ABC: execution of command \"%s\" failed: %s.\n", job.abc_command.c_str(), strerror(errno));
+	}
+
+	job.map_autoidx = map_autoidx;
+	job.signal_list.swap(signal_list);
+	job.clk_polarity = clk_polarity;
+	job.clk_sig = clk_sig;
+	job.en_polarity = en_polarity;
+	job.en_sig = en_sig;
+	job.tempdir_name = tempdir_name;
+	deferred_log.swap(job.log_lines);
+	signal_map.clear();
+}
+
+void abc_reintegrate(RTLIL::Design *design, abc_job &job, std::string script_file, std::string liberty_file,
+		bool cleanup, int lut_mode, bool show_tempdir)
+{
+	module = job.module;
+	map_autoidx = job.map_autoidx;
+	signal_list.swap(job.signal_list);
+	clk_polarity = job.clk_polarity;
+	clk_sig = job.clk_sig;
+	en_polarity = job.en_polarity;
+	en_sig = job.en_sig;
+
+	std::string tempdir_name = job.tempdir_name;
+	std::string buffer;
+
+	for (auto &line : job.log_lines)
+		if (line.first)
+			log_header("%s", line.second.c_str());
+		else
+			log("%s", line.second.c_str());
+	job.log_lines.clear();
+
+	if (job.log_only)
+		return;
+
+	log_push();
+
+	if (!job.abc_command.empty())
+	{
+		log_header("Executing ABC.\n");
+
+		buffer = job.abc_command;
 		log("Running ABC command: %s\n", replace_tempdir(buffer, tempdir_name, show_tempdir).c_str());
 
 		abc_output_filter filt(tempdir_name, show_tempdir);
-		int ret = run_command(buffer, std::bind(&abc_output_filter::next_line, filt, std::placeholders::_1));
+		std::string line;
+		char logbuf[128];
+		while (fgets(logbuf, 128, job.abc_pipe) != NULL) {
+			line += logbuf;
+			if (!line.empty() && line.back() == '\n')
+				filt.next_line(line), line.clear();
+		}
+		if (!line.empty())
+			filt.next_line(line);
+
+		int ret = pclose(job.abc_pipe);
+		job.abc_pipe = NULL;
+#ifndef _WIN32
+		if (ret >= 0)
+			ret = WEXITSTATUS(ret);
+#endif
 		if (ret != 0)
 			log_error("ABC: execution of command \"%s\" failed: return code %d.\n", buffer.c_str(), ret);
 
@@ -1256,6 +1562,19 @@ struct AbcPass : public Pass {
 		log("        this attribute is a unique integer for each ABC process started. This\n");
 		log("        is useful for debugging the partitioning of clock domains.\n");
 		log("\n");
+		log("    -j <num>\n");
+		log("        run up to <num> ABC processes at the same time. the netlists of the\n");
+		log("        following modules are extracted while ABC works on the earlier ones.\n");
+		log("        the results are re-integrated and logged in the usual order. the\n");
+		log("        clock domains of one module (see -dff) are still mapped one after\n");
+		log("        the other. the default is 1.\n");
+		log("\n");
+		log("    -aig\n");
+		log("        pass the extracted netlist to ABC as a binary AIGER file instead of\n");
+		log("        BLIF. the gates are decomposed into AND nodes and inverters while the\n");
+		log("        file is written, which is much smaller and faster to read for large\n");
+		log("        netlists. scripts given with -script receive a strashed network.\n");
+		log("\n");
 		log("When neither -liberty nor -lut is used, the Yosys standard cell library is\n");
 		log("loaded into ABC before the ABC script is executed.\n");
 		log("\n");
@@ -1273,8 +1592,8 @@ struct AbcPass : public Pass {
 		std::string exe_file = proc_self_dirname() + "yosys-abc";
 		std::string script_file, liberty_file, constr_file, clk_str, delay_target;
 		bool fast_mode = false, dff_mode = false, keepff = false, cleanup = true;
-		bool show_tempdir = false;
-		int lut_mode = 0, lut_mode2 = 0;
+		bool show_tempdir = false, aig_mode = false;
+		int lut_mode = 0, lut_mode2 = 0, max_jobs = 1;
 		markgroups = false;
 
 		map_mux4 = false;
@@ -1373,6 +1692,14 @@ struct AbcPass : public Pass {
 				markgroups = true;
 				continue;
 			}
+			if (arg == "-j" && argidx+1 < args.size()) {
+				max_jobs = std::max(atoi(args[++argidx].c_str()), 1);
+				continue;
+			}
+			if (arg == "-aig") {
+				aig_mode = true;
+				continue;
+			}
 			break;
 		}
 		extra_args(args, argidx, design);
@@ -1382,11 +1709,23 @@ struct AbcPass : public Pass {
 		if (!constr_file.empty() && liberty_file.empty())
 			log_cmd_error("Got -constr but no -liberty!\n");
 
+		std::vector<abc_job> jobs;
+
 		for (auto mod : design->selected_modules())
-			if (mod->processes.size() > 0)
-				log("Skipping module %s as it contains processes.\n", log_id(mod));
-			else if (!dff_mode || !clk_str.empty())
-				abc_module(design, mod, script_file, exe_file, liberty_file, constr_file, cleanup, lut_mode, lut_mode2, dff_mode, clk_str, keepff, delay_target, fast_mode, mod->selected_cells(), show_tempdir);
+			if (mod->processes.size() > 0) {
+				abc_job job(mod);
+				defer_log("Skipping module %s as it contains processes.\n", log_id(mod));
+				job.log_only = true;
+				job.log_lines.swap(deferred_log);
+				jobs.push_back(job);
+			}
+			else if (!dff_mode || !clk_str.empty()) {
+				abc_job job(mod);
+				job.cells = mod->selected_cells();
+				job.clk_str = clk_str;
+				job.dff_mode = dff_mode;
+				jobs.push_back(job);
+			}
 			else
 			{
 				assign_map.set(mod);
@@ -1399,7 +1738,6 @@ struct AbcPass : public Pass {
 				std::set<RTLIL::Cell*> expand_queue_up, next_expand_queue_up;
 				std::set<RTLIL::Cell*> expand_queue_down, next_expand_queue_down;
 
-				typedef std::tuple<bool, RTLIL::SigSpec, bool, RTLIL::SigSpec> clkdomain_t;
 				std::map<clkdomain_t, std::vector<RTLIL::Cell*>> assigned_cells;
 				std::map<RTLIL::Cell*, clkdomain_t> assigned_cells_reverse;
 
@@ -1519,23 +1857,55 @@ struct AbcPass : public Pass {
 					assigned_cells_reverse[cell] = key;
 				}
 
-				log_header("Summary of detected clock domains:\n");
+				defer_log_header("Summary of detected clock domains:\n");
 				for (auto &it : assigned_cells)
-					log("  %d cells in clk=%s%s, en=%s%s\n", GetSize(it.second),
+					defer_log("  %d cells in clk=%s%s, en=%s%s\n", GetSize(it.second),
 							std::get<0>(it.first) ? "" : "!", log_signal(std::get<1>(it.first)),
 							std::get<2>(it.first) ? "" : "!", log_signal(std::get<3>(it.first)));
 
+				abc_job summary(mod);
+				summary.log_only = true;
+				summary.log_lines.swap(deferred_log);
+				jobs.push_back(summary);
+
+				// the clock domains of a module are mapped one after the
+				// other, each one extracted after the last is re-integrated
 				for (auto &it : assigned_cells) {
-					clk_polarity = std::get<0>(it.first);
-					clk_sig = assign_map(std::get<1>(it.first));
-					en_polarity = std::get<2>(it.first);
-					en_sig = assign_map(std::get<3>(it.first));
-					abc_module(design, mod, script_file, exe_file, liberty_file, constr_file, cleanup, lut_mode, lut_mode2,
-							!clk_sig.empty(), "$", keepff, delay_target, fast_mode, it.second, show_tempdir);
-					assign_map.set(mod);
+					abc_job job(mod);
+					job.cells = it.second;
+					job.clk_str = "$";
+					job.clk_domain = it.first;
+					jobs.push_back(job);
 				}
 			}
 
+		// Extract ahead of the re-integration while fewer than max_jobs ABC
+		// processes are running. Jobs are re-integrated (and their log
+		// printed) in the original order, so the result does not depend
+		// on which ABC process finishes first.
+		size_t next_job = 0;
+		int running = 0;
+		for (size_t i = 0; i < jobs.size(); i++)
+		{
+			while (next_job < jobs.size() && running < max_jobs) {
+				bool module_busy = false;
+				for (size_t j = i; j < next_job; j++)
+					if (!jobs[j].log_only && jobs[j].module == jobs[next_job].module)
+						module_busy = true;
+				if (module_busy)
+					break;
+				if (!jobs[next_job].log_only)
+					abc_extract(jobs[next_job], script_file, exe_file, liberty_file, constr_file, cleanup,
+							lut_mode, lut_mode2, keepff, delay_target, fast_mode, show_tempdir, aig_mode);
+				if (jobs[next_job].abc_pipe != NULL)
+					running++;
+				next_job++;
+			}
+			if (jobs[i].abc_pipe != NULL)
+				running--;
+			abc_reintegrate(design, jobs[i], script_file, liberty_file, cleanup, lut_mode, show_tempdir);
+		}
+
 		assign_map.clear();
 		signal_list.clear();
 		signal_map.clear();
@@ -477,6 +477,10 @@ struct DfflibmapPass : public Pass {
 		log("to the internal cell types that best match the cells found in the given\n");
 		log("liberty file.\n");
 		log("\n");
+		log("The parsed liberty file is shared with the other passes of this run. If\n");
+		log("the environment variable YOSYS_LIBERTY_CACHE names a directory, the parse\n");
+		log("tree is also stored there and reused while the file is unchanged.\n");
+		log("\n");
 	}
 	virtual void execute(std::vector<std::string> args, RTLIL::Design *design)
 	{
@@ -509,29 +513,30 @@ struct DfflibmapPass : public Pass {
 		f.open(liberty_file.c_str());
 		if (f.fail())
 			log_cmd_error("Can't open liberty file `%s': %s\n", liberty_file.c_str(), strerror(errno));
-		LibertyParser libparser(f);
 		f.close();
 
-		find_cell(libparser.ast, "$_DFF_N_", false, false, false, false, prepare_mode);
-		find_cell(libparser.ast, "$_DFF_P_", true, false, false, false, prepare_mode);
-
-		find_cell(libparser.ast, "$_DFF_NN0_", false, true, false, false, prepare_mode);
-		find_cell(libparser.ast, "$_DFF_NN1_", false, true, false, true, prepare_mode);
-		find_cell(libparser.ast, "$_DFF_NP0_", false, true, true, false, prepare_mode);
-		find_cell(libparser.ast, "$_DFF_NP1_", false, true, true, true, prepare_mode);
-		find_cell(libparser.ast, "$_DFF_PN0_", true, true, false, false, prepare_mode);
-		find_cell(libparser.ast, "$_DFF_PN1_", true, true, false, true, prepare_mode);
-		find_cell(libparser.ast, "$_DFF_PP0_", true, true, true, false, prepare_mode);
-		find_cell(libparser.ast, "$_DFF_PP1_", true, true, true, true, prepare_mode);
-
-		find_cell_sr(libparser.ast, "$_DFFSR_NNN_", false, false, false, prepare_mode);
-		find_cell_sr(libparser.ast, "$_DFFSR_NNP_", false, false, true, prepare_mode);
-		find_cell_sr(libparser.ast, "$_DFFSR_NPN_", false, true, false, prepare_mode);
-		find_cell_sr(libparser.ast, "$_DFFSR_NPP_", false, true, true, prepare_mode);
-		find_cell_sr(libparser.ast, "$_DFFSR_PNN_", true, false, false, prepare_mode);
-		find_cell_sr(libparser.ast, "$_DFFSR_PNP_", true, false, true, prepare_mode);
-		find_cell_sr(libparser.ast, "$_DFFSR_PPN_", true, true, false, prepare_mode);
-		find_cell_sr(libparser.ast, "$_DFFSR_PPP_", true, true, true, prepare_mode);
+		LibertyAst *libast = LibertyCache::load(liberty_file);
+
+		find_cell(libast, "$_DFF_N_", false, false, false, false, prepare_mode);
+		find_cell(libast, "$_DFF_P_", true, false, false, false, prepare_mode);
+
+		find_cell(libast, "$_DFF_NN0_", false, true, false, false, prepare_mode);
+		find_cell(libast, "$_DFF_NN1_", false, true, false, true, prepare_mode);
+		find_cell(libast, "$_DFF_NP0_", false, true, true, false, prepare_mode);
+		find_cell(libast, "$_DFF_NP1_", false, true, true, true, prepare_mode);
+		find_cell(libast, "$_DFF_PN0_", true, true, false, false, prepare_mode);
+		find_cell(libast, "$_DFF_PN1_", true, true, false, true, prepare_mode);
+		find_cell(libast, "$_DFF_PP0_", true, true, true, false, prepare_mode);
+		find_cell(libast, "$_DFF_PP1_", true, true, true, true, prepare_mode);
+
+		find_cell_sr(libast, "$_DFFSR_NNN_", false, false, false, prepare_mode);
+		find_cell_sr(libast, "$_DFFSR_NNP_", false, false, true, prepare_mode);
+		find_cell_sr(libast, "$_DFFSR_NPN_", false, true, false, prepare_mode);
+		find_cell_sr(libast, "$_DFFSR_NPP_", false, true, true, prepare_mode);
+		find_cell_sr(libast, "$_DFFSR_PNN_", true, false, false, prepare_mode);
+		find_cell_sr(libast, "$_DFFSR_PNP_", true, false, true, prepare_mode);
+		find_cell_sr(libast, "$_DFFSR_PPN_", true, true, false, prepare_mode);
+		find_cell_sr(libast, "$_DFFSR_PPP_", true, true, true, prepare_mode);
 
 		// try to implement as many cells as possible just by inverting
 		// the SET and RESET pins. If necessary, implement cell types
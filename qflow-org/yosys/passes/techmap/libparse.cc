@@ -27,6 +27,8 @@
 
 #ifndef FILTERLIB
 #include "kernel/log.h"
+#include <sys/stat.h>
+#include <map>
 #endif
 
 using namespace Yosys;
@@ -232,6 +234,238 @@ void LibertyParser::error()
 	log_error("Syntax error in line %d.\n", line);
 }
 
+#define LIBERTY_CACHE_MAGIC "YSLIBAST"
+#define LIBERTY_CACHE_VERSION 1
+
+namespace {
+
+struct LibertyCacheEntry
+{
+	long long size, mtime;
+	LibertyAst *ast;
+};
+
+std::map<std::string, LibertyCacheEntry> liberty_cache;
+
+// 64 bit FNV-1a hash of the file contents
+bool liberty_file_hash(std::string filename, uint64_t &hash)
+{
+	FILE *f = fopen(filename.c_str(), "rb");
+	if (f == NULL)
+		return false;
+
+	std::vector<unsigned char> buffer(1 << 20);
+	size_t n;
+
+	hash = 0xcbf29ce484222325ULL;
+	while ((n = fread(buffer.data(), 1, buffer.size(), f)) > 0)
+		for (size_t i = 0; i < n; i++) {
+			hash ^= buffer[i];
+			hash *= 0x100000001b3ULL;
+		}
+
+	fclose(f);
+	return true;
+}
+
+void cache_put_int(std::string &buf, uint32_t v)
+{
+	for (int i = 0; i < 4; i++)
+		buf += char((v >> (8*i)) & 0xff);
+}
+
+void cache_put_string(std::string &buf, const std::string &str)
+{
+	cache_put_int(buf, str.size());
+	buf += str;
+}
+
+void cache_put_ast(std::string &buf, LibertyAst *ast)
+{
+	cache_put_string(buf, ast->id);
+	cache_put_string(buf, ast->value);
+	cache_put_int(buf, ast->args.size());
+	for (auto &arg : ast->args)
+		cache_put_string(buf, arg);
+	cache_put_int(buf, ast->children.size());
+	for (auto child : ast->children)
+		cache_put_ast(buf, child);
+}
+
+struct LibertyCacheReader
+{
+	const unsigned char *p, *end;
+
+	bool get_int(uint32_t &v)
+	{
+		if (end - p < 4)
+			return false;
+		v = p[0] | (p[1] << 8) | (p[2] << 16) | (uint32_t(p[3]) << 24);
+		p += 4;
+		return true;
+	}
+
+	bool get_string(std::string &str)
+	{
+		uint32_t len;
+		if (!get_int(len) || uint32_t(end - p) < len)
+			return false;
+		str.assign((const char*)p, len);
+		p += len;
+		return true;
+	}
+
+	LibertyAst *get_ast()
+	{
+		LibertyAst *ast = new LibertyAst;
+		uint32_t count;
+
+		// every arg takes at least 4 bytes and every child at least 16, so
+		// larger counts come from a damaged file and must not be allocated
+		if (!get_string(ast->id) || !get_string(ast->value) || !get_int(count) || count > uint32_t(end - p) / 4)
+			goto failed;
+		ast->args.resize(count);
+		for (auto &arg : ast->args)
+			if (!get_string(arg))
+				goto failed;
+
+		if (!get_int(count) || count > uint32_t(end - p) / 16)
+			goto failed;
+		ast->children.reserve(count);
+		for (uint32_t i = 0; i < count; i++) {
+			LibertyAst *child = get_ast();
+			if (child == NULL)
+				goto failed;
+			ast->children.push_back(child);
+		}
+		return ast;
+
+	failed:
+		delete ast;
+		return NULL;
+	}
+};
+
+std::string liberty_cache_header(uint64_t hash)
+{
+	std::string header = LIBERTY_CACHE_MAGIC;
+	cache_put_int(header, LIBERTY_CACHE_VERSION);
+	cache_put_int(header, hash & 0xffffffff);
+	cache_put_int(header, hash >> 32);
+	return header;
+}
+
+LibertyAst *liberty_cache_read(std::string cache_file, uint64_t hash)
+{
+	struct stat st;
+	if (stat(cache_file.c_str(), &st) != 0)
+		return NULL;
+
+	FILE *f = fopen(cache_file.c_str(), "rb");
+	if (f == NULL)
+		return NULL;
+
+	std::vector<unsigned char> data(st.st_size);
+	size_t n = fread(data.data(), 1, data.size(), f);
+	fclose(f);
+	if (n != data.size())
+		return NULL;
+
+	std::string header = liberty_cache_header(hash);
+	if (data.size() < header.size() || memcmp(data.data(), header.data(), header.size()))
+		return NULL;
+
+	LibertyCacheReader reader;
+	reader.p = data.data() + header.size();
+	reader.end = data.data() + data.size();
+
+	LibertyAst *ast = reader.get_ast();
+	if (ast != NULL && reader.p != reader.end) {
+		delete ast;
+		ast = NULL;
+	}
+	return ast;
+}
+
+void liberty_cache_write(std::string cache_dir, std::string cache_file, uint64_t hash, LibertyAst *ast)
+{
+	std::string buf = liberty_cache_header(hash);
+	cache_put_ast(buf, ast);
+
+	// write to a temporary file first, so that concurrent runs never
+	// see a partially written cache file
+	std::string temp_file = make_temp_file(cache_dir + "/.yosys_libcache_XXXXXX");
+	FILE *f = fopen(temp_file.c_str(), "wb");
+	if (f == NULL) {
+		log("Can't write liberty cache file `%s': %s\n", temp_file.c_str(), strerror(errno));
+		return;
+	}
+
+	bool ok = fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+	ok = (fclose(f) == 0) && ok;
+#ifndef _WIN32
+	chmod(temp_file.c_str(), 0644);
+#endif
+
+	if (ok && rename(temp_file.c_str(), cache_file.c_str()) == 0)
+		log("Stored parsed liberty data in `%s'.\n", cache_file.c_str());
+	else {
+		log("Can't write liberty cache file `%s': %s\n", cache_file.c_str(), strerror(errno));
+		remove(temp_file.c_str());
+	}
+}
+
+} /* namespace */
+
+LibertyAst *LibertyCache::load(std::string filename)
+{
+	struct stat st;
+	if (stat(filename.c_str(), &st) != 0)
+		log_error("Can't open liberty file `%s': %s\n", filename.c_str(), strerror(errno));
+
+	auto it = liberty_cache.find(filename);
+	if (it != liberty_cache.end()) {
+		if (it->second.size == (long long)st.st_size && it->second.mtime == (long long)st.st_mtime) {
+			log("Using liberty data of `%s' parsed earlier in this run.\n", filename.c_str());
+			return it->second.ast;
+		}
+		delete it->second.ast;
+		liberty_cache.erase(it);
+	}
+
+	LibertyCacheEntry &entry = liberty_cache[filename];
+	entry.size = st.st_size;
+	entry.mtime = st.st_mtime;
+	entry.ast = NULL;
+
+	const char *cache_dir = getenv("YOSYS_LIBERTY_CACHE");
+	std::string cache_file;
+	uint64_t hash = 0;
+
+	if (cache_dir != NULL && *cache_dir && liberty_file_hash(filename, hash)) {
+		cache_file = stringf("%s/%016llx.ysl", cache_dir, (unsigned long long)hash);
+		entry.ast = liberty_cache_read(cache_file, hash);
+		if (entry.ast != NULL) {
+			log("Loaded parsed liberty data from `%s'.\n", cache_file.c_str());
+			return entry.ast;
+		}
+	}
+
+	std::ifstream f;
+	f.open(filename.c_str());
+	if (f.fail())
+		log_error("Can't open liberty file `%s': %s\n", filename.c_str(), strerror(errno));
+
+	LibertyParser parser(f);
+	entry.ast = parser.ast;
+	parser.ast = NULL;
+
+	if (entry.ast != NULL && !cache_file.empty())
+		liberty_cache_write(cache_dir, cache_file, hash, entry.ast);
+
+	return entry.ast;
+}
+
 #else
 
 void LibertyParser::error()
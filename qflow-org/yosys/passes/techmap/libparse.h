@@ -50,6 +50,16 @@ namespace Yosys
 		LibertyAst *parse();
 		void error();
 	};
+
+	// Parse trees of liberty files, shared by all passes in one yosys run.
+	// If the YOSYS_LIBERTY_CACHE environment variable names a directory, the
+	// trees are also stored there in a binary form keyed by a hash of the
+	// file contents, so that later runs do not need to parse the file again.
+	// The returned trees are owned by the cache and must not be deleted.
+	struct LibertyCache
+	{
+		static LibertyAst *load(std::string filename);
+	};
 }
 
 #endif
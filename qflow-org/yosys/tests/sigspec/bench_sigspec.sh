@@ -0,0 +1,99 @@
+#!/bin/bash
+#
+# bench_sigspec.sh --- time a LUT netlist flow for two builds of yosys.
+#
+# The netlist is random logic of <luts> LUTs with 1 to 4 inputs and
+# <luts>/20 flops, read as BLIF.  lut2mux turns every LUT into a tree of
+# $_MUX_ cells, and the opt passes then spend their time in SigMap and
+# SigPool lookups and in SigSpec hashing and comparison, which is what
+# changes in RTLIL::SigSpec show up in.  The two builds are run in turn
+# <runs> times.  The script prints the user time that yosys reports at
+# the end of each run and the lowest one of each build, and checks that
+# both builds write the same netlist.  On a busy machine single runs can
+# differ by several seconds, so use enough runs.
+#
+# Usage:  bench_sigspec.sh <before_yosys> <after_yosys> [<luts> [<runs>]]
+#
+
+if [ $# -lt 2 ]; then
+	echo "Usage:  bench_sigspec.sh <before_yosys> <after_yosys> [<luts> [<runs>]]"
+	exit 1
+fi
+
+BEFORE=$1
+AFTER=$2
+LUTS=${3:-40000}
+RUNS=${4:-5}
+
+TMP=${TMPDIR:-/tmp}/bench_sigspec.$$
+mkdir -p $TMP || exit 1
+
+awk -v n=$LUTS 'BEGIN {
+	srand(1);
+	nin = 64; nff = int(n / 20);
+	printf(".model top\n.inputs clk");
+	for (i = 0; i < nin; i++) printf(" in%d", i);
+	printf("\n.outputs");
+	for (i = 0; i < 32; i++) printf(" out%d", i);
+	printf("\n");
+	for (i = 0; i < nin; i++) sig[nsigs++] = "in" i;
+	for (i = 0; i < nff; i++) sig[nsigs++] = "q" i;
+	split("1 2 2 3 4", width);
+	for (i = 0; i < n; i++) {
+		k = width[1 + int(rand() * 5)];
+		# k different inputs out of all signals so far
+		line = ".names";
+		delete used;
+		for (j = 0; j < k; j++) {
+			do s = int(rand() * nsigs); while (s in used);
+			used[s] = 1;
+			line = line " " sig[s];
+		}
+		print line " n" i;
+		rows = 1 + int(rand() * 3);
+		for (r = 0; r < rows; r++) {
+			row = "";
+			for (j = 0; j < k; j++) row = row substr("01-", 1 + int(rand() * 3), 1);
+			print row " 1";
+		}
+		sig[nsigs++] = "n" i;
+	}
+	for (i = 0; i < nff; i++)
+		printf(".latch n%d q%d re clk 0\n", int(rand() * n), i);
+	for (i = 0; i < 32; i++)
+		printf(".names n%d out%d\n1 1\n", n - 1 - i, i);
+	print ".end";
+}' > $TMP/bench.blif
+
+echo "run     before    after   (user seconds)"
+for run in `seq $RUNS`; do
+	printf "%3d  " $run
+	for build in before after; do
+		if [ $build = before ]; then yosys=$BEFORE; else yosys=$AFTER; fi
+		$yosys -ql $TMP/$build.log -p "read_blif $TMP/bench.blif; lut2mux; opt; wreduce;
+			simplemap; opt -full; opt_clean -purge; write_blif $TMP/$build.blif" || exit 1
+		sed -n 's/^CPU: user \([0-9.]*\)s.*/\1/p' $TMP/$build.log > $TMP/$build.time
+		printf "  %8.2f" `cat $TMP/$build.time`
+		cat $TMP/$build.time >> $TMP/$build.times
+	done
+	echo
+done
+printf "min  "
+for build in before after; do
+	printf "  %8.2f" `sort -n $TMP/$build.times | head -1`
+done
+echo
+for build in before after; do
+	printf "%-8s" $build
+	grep '^Time spent: ' $TMP/$build.log
+done
+
+if cmp -s $TMP/before.blif $TMP/after.blif; then
+	echo "The written netlists are the same."
+else
+	echo "The written netlists differ!"
+	rm -rf $TMP
+	exit 1
+fi
+
+rm -rf $TMP
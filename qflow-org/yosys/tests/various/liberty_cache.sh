@@ -0,0 +1,36 @@
+#!/bin/bash
+#
+# Load liberty_cache.lib through the liberty cache (YOSYS_LIBERTY_CACHE)
+# and compare the result with a run that parses the file.  A cache file
+# with a damaged element count must be ignored and the file parsed again.
+#
+set -e
+cmds="read_liberty liberty_cache.lib; read_verilog liberty_cache.v; proc;
+dfflibmap -liberty liberty_cache.lib; write_ilang"
+
+rm -rf liberty_cache.d
+mkdir liberty_cache.d
+
+../../yosys -ql liberty_cache_parse.log -p "$cmds liberty_cache_parse.il"
+
+export YOSYS_LIBERTY_CACHE=liberty_cache.d
+../../yosys -ql liberty_cache_store.log -p "$cmds liberty_cache_store.il"
+grep -q "Stored parsed liberty data" liberty_cache_store.log
+../../yosys -ql liberty_cache_load.log -p "$cmds liberty_cache_load.il"
+grep -q "Loaded parsed liberty data" liberty_cache_load.log
+cmp liberty_cache_parse.il liberty_cache_store.il
+cmp liberty_cache_parse.il liberty_cache_load.il
+
+# set the argument count of the root group to 0xfffffff0
+cache=$(echo liberty_cache.d/*.ysl)
+idlen=$(od -An -tu4 -j20 -N4 $cache)
+valuelen=$(od -An -tu4 -j$((24 + idlen)) -N4 $cache)
+printf '\360\377\377\377' | dd of=$cache bs=1 seek=$((28 + idlen + valuelen)) conv=notrunc 2> /dev/null
+../../yosys -ql liberty_cache_damaged.log -p "$cmds liberty_cache_damaged.il"
+if grep -q "Loaded parsed liberty data" liberty_cache_damaged.log; then
+	echo "damaged liberty cache file was loaded"
+	exit 1
+fi
+cmp liberty_cache_parse.il liberty_cache_damaged.il
+
+rm -rf liberty_cache.d liberty_cache_*.il
@@ -0,0 +1,4 @@
+module liberty_cache (input clk, a, b, c, output reg q);
+    always @(posedge clk)
+        q <= ~(a & b) | c;
+endmodule
@@ -0,0 +1,34 @@
+#!/bin/bash
+#
+# Run pass_jobs.ys serially and with two jobs and compare the results.
+# The workers number new objects from the same autoidx, so the names of
+# generated wires and cells differ between the runs.  Apart from those
+# numbers the netlists must be the same, and they are checked to be
+# equivalent.
+#
+# The second part runs "opt_clean -purge top" on pass_jobs_sel.v.  Only
+# the unused wire of top may be removed, and as opt_clean sorts the
+# design, the modules must come back in the same order as in a serial
+# run.  The input is read from a dump, so it is not sorted yet.
+#
+set -e
+for j in 1 2; do
+	../../yosys -ql pass_jobs_j$j.log -j $j -p "script pass_jobs.ys; write_ilang pass_jobs_j$j.il"
+	grep -v '^autoidx' pass_jobs_j$j.il | sed -E 's/\$[0-9]+/$N/g' | sort > pass_jobs_j$j.txt
+done
+cmp pass_jobs_j1.txt pass_jobs_j2.txt
+for j in 1 2; do
+	../../yosys -ql pass_jobs_flat$j.log -p "read_ilang pass_jobs_j$j.il; hierarchy -top top; flatten; hierarchy -top top; write_ilang pass_jobs_flat$j.il"
+done
+../../yosys -ql pass_jobs_eqv.log -p "read_ilang pass_jobs_flat1.il; rename top gold;
+read_ilang pass_jobs_flat2.il; rename top gate; miter -equiv -flatten -make_assert gold gate miter;
+sat -verify -prove-asserts -set-init-zero -seq 5 miter"
+rm -f pass_jobs_j[12].il pass_jobs_j[12].txt pass_jobs_flat[12].il
+
+../../yosys -ql pass_jobs_sel.log -p "read_verilog pass_jobs_sel.v; hierarchy -top top; proc; dump -o pass_jobs_sel.il"
+for j in 1 2; do
+	../../yosys -ql pass_jobs_sel_j$j.log -j $j -p "read_ilang pass_jobs_sel.il; opt_clean -purge top;
+	select -assert-none top/unused; select -assert-count 1 sub/unused; dump -o pass_jobs_sel_j$j.il"
+done
+cmp pass_jobs_sel_j1.il pass_jobs_sel_j2.il
+rm -f pass_jobs_sel.il pass_jobs_sel_j[12].il
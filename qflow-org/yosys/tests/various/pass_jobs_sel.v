@@ -0,0 +1,9 @@
+module top (input [3:0] a, b, output [3:0] y, z);
+    wire [3:0] unused = a ^ b;
+    sub u1 (.a(a), .b(b), .y(y));
+    sub u2 (.a(b), .b(a), .y(z));
+endmodule
+module sub (input [3:0] a, b, output [3:0] y);
+    wire [3:0] t = a & b, unused = a | b;
+    assign y = t;
+endmodule
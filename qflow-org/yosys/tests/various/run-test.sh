@@ -4,3 +4,7 @@ for x in *.ys; do
 	echo "Running $x.."
 	../../yosys -ql ${x%.ys}.log $x
 done
+echo "Running pass_jobs.sh.."
+bash pass_jobs.sh
+echo "Running liberty_cache.sh.."
+bash liberty_cache.sh